@@ -880,6 +880,20 @@ window.updateSensorFormFields = function updateSensorFormFields() {
         i2cAddressField.required = false;
     }
     
+    // FFT window and bands only apply to the FIFO-streamed LIS3DH
+    const vibrationConfig = document.getElementById('sensor-vibration-config');
+    if (vibrationConfig) {
+        vibrationConfig.style.display = (protocol === 'I2C' && sensorType === 'LIS3DH') ? 'flex' : 'none';
+    }
+    
+    // Temperature compensation applies to EZO pH, EC and DO circuits
+    const ezoConfig = document.getElementById('sensor-ezo-config');
+    if (ezoConfig) {
+        const compensated = protocol === 'I2C' && ['EZO_PH', 'EZO_EC', 'EZO_DO'].includes(sensorType);
+        ezoConfig.style.display = compensated ? 'flex' : 'none';
+        if (compensated) populateEzoCompensationOptions();
+    }
+    
     // Show/hide data parsing section based on protocol
     const dataParsingSection = document.getElementById('data-parsing-section');
     if (protocol === 'I2C' || protocol === 'UART' || protocol === 'One-Wire' || protocol === 'Digital Counter' || protocol === 'SPI') {
@@ -972,7 +986,9 @@ window.pollSensorNow = function pollSensorNow() {
         const baudElement = document.getElementById('sensor-uart-baud');
         const commandElement = document.getElementById('sensor-command');
         
+        const framingElement = document.getElementById('sensor-uart-framing');
         sensorConfig.baudRate = baudElement ? parseInt(baudElement.value) || 9600 : 9600;
+        sensorConfig.uartFraming = framingElement ? framingElement.value || '8N1' : '8N1';
         sensorConfig.command = commandElement ? commandElement.value || '' : '';
         
         const pins = getPinsForProtocol('UART');
@@ -1288,7 +1304,7 @@ window.populateMultiValueFields = function populateMultiValueFields(values) {
                     <input type="number" 
                            id="multi-register-${index}" 
                            value="${register}" 
-                           min="3" max="65535">
+                           min="3" max="127">
                 </div>
                 <div class="multi-value-units">${value.units}</div>
                 <div class="calibration-note">
@@ -1324,11 +1340,26 @@ window.updateDataParsingFields = function updateDataParsingFields() {
     }
 }
 
+// Other configured sensors as temperature sources for EZO compensation (keeps the current choice)
+function populateEzoCompensationOptions() {
+    const select = document.getElementById('sensor-ezo-compensation');
+    const selected = select.value;
+    select.innerHTML = '<option value="">None</option>';
+    sensorConfigData.forEach((sensor, index) => {
+        if (index === editingSensorIndex) return;
+        const option = document.createElement('option');
+        option.value = sensor.name;
+        option.textContent = `${sensor.name} (${sensor.type})`;
+        select.appendChild(option);
+    });
+    select.value = selected;
+}
+
 // Helper function to get the number of consecutive registers a sensor needs
 window.getRegisterCountForSensor = function getRegisterCountForSensor(sensorType) {
     // Multi-output sensors that need consecutive registers
     const multiOutputSensors = {
-        'LIS3DH': 3,        // X, Y, Z axes (3 consecutive registers)
+        'LIS3DH': 27,       // X, Y, Z window means, then RMS, peak, crest, dominant frequency and 4 band RMS per axis
         'LIS3DH_SPI': 3,    // X, Y, Z axes on SPI (3 consecutive registers)
         'SHT30': 2,         // Temperature, Humidity (2 consecutive registers)
         'BME280': 3,        // Temperature, Humidity, Pressure (3 consecutive registers)
@@ -1402,6 +1433,8 @@ window.editSensor = function editSensor(index) {
             break;
         case 'UART':
             document.getElementById('sensor-uart-polling').value = sensor.pollingFrequency || 1000;
+            document.getElementById('sensor-uart-baud').value = (sensor.uartBaud || 9600).toString();
+            document.getElementById('sensor-uart-framing').value = sensor.uartFraming || '8N1';
             break;
         case 'One-Wire':
             document.getElementById('sensor-onewire-polling').value = sensor.pollingFrequency || 1000;
@@ -1425,12 +1458,18 @@ window.editSensor = function editSensor(index) {
     // Load pin assignments if they exist
     if (sensor.protocol === 'I2C' && sensor.sdaPin !== undefined && sensor.sclPin !== undefined) {
         document.getElementById('sensor-i2c-pins').value = `${sensor.sdaPin},${sensor.sclPin}`;
+        document.getElementById('sensor-fft-points').value = (sensor.fftPoints === 512 ? 512 : 256).toString();
+        document.getElementById('sensor-vibration-bands').value = sensor.vibrationBands || '';
+        populateEzoCompensationOptions();
+        document.getElementById('sensor-ezo-compensation').value = sensor.ezoCompensation || '';
     } else if (sensor.protocol === 'UART' && sensor.txPin !== undefined && sensor.rxPin !== undefined) {
         document.getElementById('sensor-uart-pins').value = `${sensor.txPin},${sensor.rxPin}`;
     } else if (sensor.protocol === 'Analog Voltage' && sensor.analogPin !== undefined) {
         document.getElementById('sensor-analog-pin').value = sensor.analogPin.toString();
     } else if (sensor.protocol === 'One-Wire' && sensor.oneWirePin !== undefined) {
         document.getElementById('sensor-onewire-pin').value = sensor.oneWirePin.toString();
+        document.getElementById('sensor-onewire-id').value = sensor.oneWireRom || '';
+        document.getElementById('sensor-onewire-resolution').value = (sensor.oneWireResolution || 12).toString();
         
         // Load One-Wire specific settings
         setTimeout(() => {
@@ -1742,8 +1781,9 @@ window.saveSensor = function saveSensor() {
         return;
     }
     
-    if (modbusRegister > 65535) {
-        showToast('Modbus register must be 65535 or lower', 'error');
+    // Sensor values are served from the 128-register input image
+    if (modbusRegister > 127) {
+        showToast('Modbus register must be 127 or lower', 'error');
         return;
     }
     
@@ -1967,6 +2007,13 @@ window.saveSensor = function saveSensor() {
                 pinAssignments.sdaPin = sdaPin;
                 pinAssignments.sclPin = sclPin;
             }
+            if (type === 'LIS3DH') {
+                pinAssignments.fftPoints = parseInt(document.getElementById('sensor-fft-points').value) || 256;
+                pinAssignments.vibrationBands = document.getElementById('sensor-vibration-bands').value.trim();
+            }
+            if (['EZO_PH', 'EZO_EC', 'EZO_DO'].includes(type)) {
+                pinAssignments.ezoCompensation = document.getElementById('sensor-ezo-compensation').value;
+            }
             break;
             
         case 'UART':
@@ -1976,6 +2023,8 @@ window.saveSensor = function saveSensor() {
                 pinAssignments.uartTxPin = txPin;
                 pinAssignments.uartRxPin = rxPin;
             }
+            pinAssignments.uartBaud = parseInt(document.getElementById('sensor-uart-baud').value) || 9600;
+            pinAssignments.uartFraming = document.getElementById('sensor-uart-framing').value || '8N1';
             break;
             
         case 'Analog Voltage':
@@ -2003,6 +2052,8 @@ window.saveSensor = function saveSensor() {
             pinAssignments.oneWireCommand = oneWireCommand;
             pinAssignments.oneWireInterval = oneWireInterval;
             pinAssignments.oneWireConversionTime = oneWireConversionTime;
+            pinAssignments.oneWireRom = document.getElementById('sensor-onewire-id').value.trim();
+            pinAssignments.oneWireResolution = parseInt(document.getElementById('sensor-onewire-resolution').value) || 12;
             break;
             
         case 'Digital Counter':
@@ -2844,6 +2895,57 @@ function updateProtocolSensorFlow(protocol, sensors, containerId) {
                     </div>`;
             }
             
+            // Vibration features of the last FIFO window (RMS/peak in 0.1 mg, crest x100 on Modbus)
+            if (sensor.vibration) {
+                const v = sensor.vibration;
+                const axes = (values, digits) => values.map(x => x.toFixed(digits)).join(' / ');
+                dataflowHTML += `
+                    <div class="value-dataflow ${staleData ? 'stale-data' : ''}">
+                        <div class="value-label">Vibration X / Y / Z (${v.samples} samples, ${v.window_ms} ms)</div>
+                        <div class="dataflow-chain">
+                            <div class="dataflow-step raw-step">
+                                <div class="step-label">RMS (mg)</div>
+                                <div class="step-value">${axes(v.rms_mg, 1)}</div>
+                            </div>
+                            <div class="dataflow-step raw-step">
+                                <div class="step-label">Peak (mg)</div>
+                                <div class="step-value">${axes(v.peak_mg, 1)}</div>
+                            </div>
+                            <div class="dataflow-step calibrated-step">
+                                <div class="step-label">Crest</div>
+                                <div class="step-value">${axes(v.crest, 2)}</div>
+                            </div>
+                            <div class="dataflow-arrow">→</div>
+                            <div class="dataflow-step modbus-step">
+                                <div class="step-label">Modbus Reg ${v.modbus_register}-${v.modbus_register + 8}</div>
+                            </div>
+                        </div>
+                    </div>`;
+                
+                // Spectrum of the same window (dominant frequency 0.1 Hz, band RMS 0.1 mg on Modbus)
+                if (v.dominant_hz) {
+                    const bandSteps = (v.bands || []).map(band => `
+                            <div class="dataflow-step raw-step">
+                                <div class="step-label">${band.low_hz}-${band.high_hz} Hz (mg)</div>
+                                <div class="step-value">${axes(band.rms_mg, 1)}</div>
+                            </div>`).join('');
+                    dataflowHTML += `
+                    <div class="value-dataflow ${staleData ? 'stale-data' : ''}">
+                        <div class="value-label">Spectrum X / Y / Z (${v.fft_points}-point FFT)</div>
+                        <div class="dataflow-chain">
+                            <div class="dataflow-step calibrated-step">
+                                <div class="step-label">Dominant (Hz)</div>
+                                <div class="step-value">${axes(v.dominant_hz, 1)}</div>
+                            </div>${bandSteps}
+                            <div class="dataflow-arrow">→</div>
+                            <div class="dataflow-step modbus-step">
+                                <div class="step-label">Modbus Reg ${v.modbus_register + 9}-${v.modbus_register + 23}</div>
+                            </div>
+                        </div>
+                    </div>`;
+                }
+            }
+            
             dataflowHTML += `</div>`;
             
         } else if (isMultiValue) {
@@ -3974,7 +4076,8 @@ window.renderIOConfigTable = function renderIOConfigTable(ioConfig) {
                                         // New multi-condition format
                                         conditionStr = rule.trigger.conditions.map((cond, cidx) => {
                                             const operator = cond.nextOperator || 'AND';
-                                            const condStr = `Reg ${cond.register} ${cond.condition} ${cond.value}`;
+                                            const hyst = cond.hysteresis > 0 ? ` (hyst ${cond.hysteresis})` : '';
+                                            const condStr = `Reg ${cond.register} ${cond.condition} ${cond.value}${hyst}`;
                                             return cidx === 0 ? condStr : `${operator} ${condStr}`;
                                         }).join(' ');
                                     } else if (rule.trigger.modbusRegister !== undefined) {
@@ -3982,6 +4085,11 @@ window.renderIOConfigTable = function renderIOConfigTable(ioConfig) {
                                         conditionStr = `Reg ${rule.trigger.modbusRegister} ${rule.trigger.condition} ${rule.trigger.triggerValue}`;
                                     }
                                     
+                                    const delays = [];
+                                    if (rule.trigger.onDelayMs > 0) delays.push(`on ${rule.trigger.onDelayMs}ms`);
+                                    if (rule.trigger.offDelayMs > 0) delays.push(`off ${rule.trigger.offDelayMs}ms`);
+                                    if (delays.length > 0) conditionStr += ` [delay ${delays.join(', ')}]`;
+                                    
                                     return `
                                         <div class="rule-display" id="rule-${pin.gpPin}-${idx}">
                                             <small>
@@ -4688,6 +4796,8 @@ window.showAddPinModal = function showAddPinModal() {
     document.getElementById('add-pin-action-type').value = 'set_output';
     document.getElementById('add-pin-action-value').value = 'true';
     document.getElementById('add-pin-pulse-duration').value = '100';
+    document.getElementById('add-pin-on-delay').value = '0';
+    document.getElementById('add-pin-off-delay').value = '0';
     document.getElementById('add-pin-invert').checked = false;
     
     // Reset multi-condition form (condition-0)
@@ -4696,6 +4806,7 @@ window.showAddPinModal = function showAddPinModal() {
         condition0.querySelector('.condition-register').value = '';
         condition0.querySelector('.condition-operator').value = '==';
         condition0.querySelector('.condition-value').value = '';
+        condition0.querySelector('.condition-hysteresis').value = '0';
     }
     
     // Clear extra conditions
@@ -4748,6 +4859,10 @@ window.addCondition = function addCondition(operator) {
                     <label>Value</label>
                     <input type="number" class="condition-value" placeholder="Value">
                 </div>
+                <div class="form-group">
+                    <label>Hysteresis</label>
+                    <input type="number" class="condition-hysteresis" min="0" value="0">
+                </div>
                 <button type="button" class="btn-condition-delete" onclick="removeCondition(${conditionIndex})">Delete</button>
             </div>
         </div>
@@ -4821,13 +4936,15 @@ window.confirmAddPin = function confirmAddPin() {
         const register = parseInt(elem.querySelector('.condition-register').value);
         const operator = elem.querySelector('.condition-operator').value;
         const value = parseInt(elem.querySelector('.condition-value').value);
+        const hysteresis = parseInt(elem.querySelector('.condition-hysteresis').value) || 0;
         
         // Only add if register is specified
         if (!isNaN(register) && register >= 0) {
             conditions.push({
                 register: register,
                 condition: operator,
-                value: value
+                value: value,
+                hysteresis: Math.max(0, hysteresis)
             });
         }
     }
@@ -4837,6 +4954,8 @@ window.confirmAddPin = function confirmAddPin() {
         const actionType = document.getElementById('add-pin-action-type').value;
         const actionValue = document.getElementById('add-pin-action-value').value === 'true';
         const pulseDuration = parseInt(document.getElementById('add-pin-pulse-duration').value) || 100;
+        const onDelayMs = Math.max(0, parseInt(document.getElementById('add-pin-on-delay').value) || 0);
+        const offDelayMs = Math.max(0, parseInt(document.getElementById('add-pin-off-delay').value) || 0);
         
         // Build conditions array with logic operators
         const conditionsArray = [];
@@ -4850,6 +4969,7 @@ window.confirmAddPin = function confirmAddPin() {
                 register: cond.register,
                 condition: cond.condition,
                 value: cond.value,
+                hysteresis: cond.hysteresis,
                 nextOperator: nextOp
             });
         }
@@ -4859,7 +4979,9 @@ window.confirmAddPin = function confirmAddPin() {
             enabled: true,
             description: `Control based on ${conditions.length} condition(s)`,
             trigger: {
-                conditions: conditionsArray
+                conditions: conditionsArray,
+                onDelayMs: onDelayMs,
+                offDelayMs: offDelayMs
             },
             action: {
                 type: actionType,
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * Calibration Program - calibration expressions compiled to RPN bytecode
+ *
+ * Expressions such as "0.5*x^2 + 2*(x-1)" are parsed once when the sensor
+ * configuration is loaded or changed. The per-sample path is then a small
+ * stack interpreter: no String objects, no heap, no re-parsing.
+ *
+ * Grammar (usual precedence, '^' right-associative and above unary minus):
+ *   expr    := term (('+' | '-') term)*
+ *   term    := unary (('*' | '/') unary)*
+ *   unary   := ('-' | '+') unary | power
+ *   power   := primary ('^' unary)?
+ *   primary := number | 'x' | func '(' expr ')' | '(' expr ')'
+ *   func    := sin | cos | tan | sqrt | log (base 10) | ln | exp
+ *
+ * Sub-expressions without 'x' are folded to a single constant at compile time.
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+static const uint8_t CAL_MAX_CODE = 48;        // Bytecode bytes per program
+static const uint8_t CAL_MAX_CONSTANTS = 12;   // Constant pool entries per program
+static const uint8_t CAL_MAX_STACK = 12;       // Evaluation stack depth
+static const uint8_t CAL_MAX_NESTING = 16;     // Parenthesis/function nesting (bounds compiler recursion)
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+enum class CalOpcode : uint8_t {
+    PUSH_CONST = 0,  // Followed by a constant pool index
+    PUSH_X,
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    POW,
+    NEG,
+    SIN,
+    COS,
+    TAN,
+    SQRT,
+    LOG10,
+    LN,
+    EXP
+};
+
+enum class CalCompileResult : uint8_t {
+    OK = 0,
+    EMPTY,               // Blank expression (caller falls back to linear calibration)
+    SYNTAX_ERROR,
+    UNKNOWN_FUNCTION,
+    UNBALANCED_PARENS,
+    TOO_LONG,            // Bytecode or constant pool full
+    TOO_DEEP             // Evaluation stack would overflow
+};
+
+// ============================================================================
+// CALIBRATION PROGRAM
+// ============================================================================
+
+class CalibrationProgram {
+private:
+    uint8_t code[CAL_MAX_CODE];
+    uint8_t length;
+    uint8_t constantCount;
+    float constants[CAL_MAX_CONSTANTS];
+
+    // Compiler state (only meaningful during compile())
+    struct Compiler {
+        const char* expr;
+        const char* pos;
+        CalCompileResult error;
+        uint8_t depth;
+        uint8_t nesting;
+        // Shadow stack: whether each slot is a folded constant and where its code starts
+        bool isConst[CAL_MAX_STACK];
+        uint8_t codeStart[CAL_MAX_STACK];
+    };
+
+    static float applyUnary(CalOpcode op, float a) {
+        switch (op) {
+            case CalOpcode::NEG:   return -a;
+            case CalOpcode::SIN:   return sinf(a);
+            case CalOpcode::COS:   return cosf(a);
+            case CalOpcode::TAN:   return tanf(a);
+            case CalOpcode::SQRT:  return sqrtf(a);
+            case CalOpcode::LOG10: return log10f(a);
+            case CalOpcode::LN:    return logf(a);
+            case CalOpcode::EXP:   return expf(a);
+            default:               return a;
+        }
+    }
+
+    static float applyBinary(CalOpcode op, float a, float b) {
+        switch (op) {
+            case CalOpcode::ADD: return a + b;
+            case CalOpcode::SUB: return a - b;
+            case CalOpcode::MUL: return a * b;
+            case CalOpcode::DIV: return a / b;
+            case CalOpcode::POW: return powf(a, b);
+            default:             return a;
+        }
+    }
+
+    void fail(Compiler& c, CalCompileResult error) {
+        if (c.error == CalCompileResult::OK) c.error = error;
+    }
+
+    void skipSpaces(Compiler& c) {
+        while (*c.pos == ' ' || *c.pos == '\t') c.pos++;
+    }
+
+    bool emitByte(Compiler& c, uint8_t byte) {
+        if (length >= CAL_MAX_CODE) {
+            fail(c, CalCompileResult::TOO_LONG);
+            return false;
+        }
+        code[length++] = byte;
+        return true;
+    }
+
+    bool pushSlot(Compiler& c, bool constant, uint8_t start) {
+        if (c.depth >= CAL_MAX_STACK) {
+            fail(c, CalCompileResult::TOO_DEEP);
+            return false;
+        }
+        c.isConst[c.depth] = constant;
+        c.codeStart[c.depth] = start;
+        c.depth++;
+        return true;
+    }
+
+    void emitConst(Compiler& c, float value) {
+        if (constantCount >= CAL_MAX_CONSTANTS) {
+            fail(c, CalCompileResult::TOO_LONG);
+            return;
+        }
+        uint8_t start = length;
+        if (!emitByte(c, (uint8_t)CalOpcode::PUSH_CONST)) return;
+        if (!emitByte(c, constantCount)) return;
+        constants[constantCount++] = value;
+        pushSlot(c, true, start);
+    }
+
+    void emitX(Compiler& c) {
+        uint8_t start = length;
+        if (emitByte(c, (uint8_t)CalOpcode::PUSH_X)) {
+            pushSlot(c, false, start);
+        }
+    }
+
+    // A constant operand is always the last entry in the pool and the last two code bytes
+    float popConst(Compiler& c) {
+        c.depth--;
+        length = c.codeStart[c.depth];
+        return constants[--constantCount];
+    }
+
+    void emitUnary(Compiler& c, CalOpcode op) {
+        if (c.error != CalCompileResult::OK || c.depth < 1) return;
+        if (c.isConst[c.depth - 1]) {
+            emitConst(c, applyUnary(op, popConst(c)));
+            return;
+        }
+        emitByte(c, (uint8_t)op);  // Slot stays in place and stays non-constant
+    }
+
+    void emitBinary(Compiler& c, CalOpcode op) {
+        if (c.error != CalCompileResult::OK || c.depth < 2) return;
+        if (c.isConst[c.depth - 1] && c.isConst[c.depth - 2]) {
+            float b = popConst(c);
+            float a = popConst(c);
+            emitConst(c, applyBinary(op, a, b));
+            return;
+        }
+        if (emitByte(c, (uint8_t)op)) {
+            c.depth--;
+            c.isConst[c.depth - 1] = false;
+        }
+    }
+
+    bool matchWord(Compiler& c, const char* word) {
+        const char* p = c.pos;
+        while (*word) {
+            if (tolower((unsigned char)*p) != *word) return false;
+            p++;
+            word++;
+        }
+        if (isalnum((unsigned char)*p) || *p == '_') return false;
+        c.pos = p;
+        return true;
+    }
+
+    void parseExpr(Compiler& c);
+
+    void parsePrimary(Compiler& c) {
+        skipSpaces(c);
+        char ch = *c.pos;
+
+        if (isdigit((unsigned char)ch) || ch == '.') {
+            char* end = nullptr;
+            float value = strtof(c.pos, &end);
+            if (end == c.pos) {
+                fail(c, CalCompileResult::SYNTAX_ERROR);
+                return;
+            }
+            c.pos = end;
+            emitConst(c, value);
+            return;
+        }
+
+        if (ch == '(') {
+            c.pos++;
+            parseExpr(c);
+            skipSpaces(c);
+            if (*c.pos != ')') {
+                fail(c, CalCompileResult::UNBALANCED_PARENS);
+                return;
+            }
+            c.pos++;
+            return;
+        }
+
+        if (isalpha((unsigned char)ch)) {
+            static const struct { const char* name; CalOpcode op; } functions[] = {
+                { "sin", CalOpcode::SIN },   { "cos", CalOpcode::COS },
+                { "tan", CalOpcode::TAN },   { "sqrt", CalOpcode::SQRT },
+                { "log", CalOpcode::LOG10 }, { "ln", CalOpcode::LN },
+                { "exp", CalOpcode::EXP }
+            };
+            if (matchWord(c, "x")) {
+                emitX(c);
+                return;
+            }
+            for (unsigned int f = 0; f < sizeof(functions) / sizeof(functions[0]); f++) {
+                if (matchWord(c, functions[f].name)) {
+                    skipSpaces(c);
+                    if (*c.pos != '(') {
+                        fail(c, CalCompileResult::SYNTAX_ERROR);
+                        return;
+                    }
+                    c.pos++;
+                    parseExpr(c);
+                    skipSpaces(c);
+                    if (*c.pos != ')') {
+                        fail(c, CalCompileResult::UNBALANCED_PARENS);
+                        return;
+                    }
+                    c.pos++;
+                    emitUnary(c, functions[f].op);
+                    return;
+                }
+            }
+            fail(c, CalCompileResult::UNKNOWN_FUNCTION);
+            return;
+        }
+
+        fail(c, CalCompileResult::SYNTAX_ERROR);
+    }
+
+    void parseUnary(Compiler& c);
+
+    void parsePower(Compiler& c) {
+        parsePrimary(c);
+        if (c.error != CalCompileResult::OK) return;
+        skipSpaces(c);
+        if (*c.pos == '^') {
+            c.pos++;
+            parseUnary(c);  // Right-associative: x^2^3 = x^(2^3)
+            emitBinary(c, CalOpcode::POW);
+        }
+    }
+
+    void parseTerm(Compiler& c) {
+        parseUnary(c);
+        while (c.error == CalCompileResult::OK) {
+            skipSpaces(c);
+            char ch = *c.pos;
+            if (ch != '*' && ch != '/') break;
+            c.pos++;
+            parseUnary(c);
+            emitBinary(c, ch == '*' ? CalOpcode::MUL : CalOpcode::DIV);
+        }
+    }
+
+public:
+    CalibrationProgram() { clear(); }
+
+    void clear() {
+        length = 0;
+        constantCount = 0;
+    }
+
+    bool isEmpty() const { return length == 0; }
+    uint8_t getCodeLength() const { return length; }
+
+    /**
+     * Compile an expression in 'x' into this program
+     * On failure the program is left empty, so callers fall back to linear calibration.
+     *
+     * @param expr Expression text (NUL-terminated)
+     * @param errorOffset Optional: character offset where parsing stopped
+     */
+    CalCompileResult compile(const char* expr, uint16_t* errorOffset = nullptr) {
+        clear();
+        Compiler c;
+        c.expr = expr ? expr : "";
+        c.pos = c.expr;
+        c.error = CalCompileResult::OK;
+        c.depth = 0;
+        c.nesting = 0;
+
+        skipSpaces(c);
+        if (*c.pos == '\0') {
+            if (errorOffset) *errorOffset = 0;
+            return CalCompileResult::EMPTY;
+        }
+
+        parseExpr(c);
+        skipSpaces(c);
+        if (c.error == CalCompileResult::OK && *c.pos != '\0') {
+            fail(c, *c.pos == ')' ? CalCompileResult::UNBALANCED_PARENS : CalCompileResult::SYNTAX_ERROR);
+        }
+        if (c.error == CalCompileResult::OK && c.depth != 1) {
+            fail(c, CalCompileResult::SYNTAX_ERROR);
+        }
+
+        if (errorOffset) *errorOffset = (uint16_t)(c.pos - c.expr);
+        if (c.error != CalCompileResult::OK) clear();
+        return c.error;
+    }
+
+    /**
+     * Run the program for one sample. Allocation-free; the stack depth was
+     * bounded at compile time.
+     */
+    float evaluate(float x) const {
+        float stack[CAL_MAX_STACK];
+        uint8_t sp = 0;
+        uint8_t pc = 0;
+
+        while (pc < length) {
+            CalOpcode op = (CalOpcode)code[pc++];
+            switch (op) {
+                case CalOpcode::PUSH_CONST: stack[sp++] = constants[code[pc++]]; break;
+                case CalOpcode::PUSH_X:     stack[sp++] = x; break;
+                case CalOpcode::ADD:   sp--; stack[sp - 1] += stack[sp]; break;
+                case CalOpcode::SUB:   sp--; stack[sp - 1] -= stack[sp]; break;
+                case CalOpcode::MUL:   sp--; stack[sp - 1] *= stack[sp]; break;
+                case CalOpcode::DIV:   sp--; stack[sp - 1] /= stack[sp]; break;
+                case CalOpcode::POW:   sp--; stack[sp - 1] = powf(stack[sp - 1], stack[sp]); break;
+                default:               stack[sp - 1] = applyUnary(op, stack[sp - 1]); break;
+            }
+        }
+        return sp ? stack[0] : 0.0f;
+    }
+
+    static const char* resultString(CalCompileResult result) {
+        switch (result) {
+            case CalCompileResult::OK:                return "OK";
+            case CalCompileResult::EMPTY:             return "Empty expression";
+            case CalCompileResult::SYNTAX_ERROR:      return "Syntax error";
+            case CalCompileResult::UNKNOWN_FUNCTION:  return "Unknown function or variable";
+            case CalCompileResult::UNBALANCED_PARENS: return "Unbalanced parentheses";
+            case CalCompileResult::TOO_LONG:          return "Expression too long";
+            case CalCompileResult::TOO_DEEP:          return "Expression nested too deeply";
+            default:                                  return "Unknown";
+        }
+    }
+};
+
+inline void CalibrationProgram::parseUnary(Compiler& c) {
+    skipSpaces(c);
+    if (*c.pos == '-') {
+        c.pos++;
+        parseUnary(c);
+        emitUnary(c, CalOpcode::NEG);
+    } else if (*c.pos == '+') {
+        c.pos++;
+        parseUnary(c);
+    } else {
+        parsePower(c);
+    }
+}
+
+inline void CalibrationProgram::parseExpr(Compiler& c) {
+    if (++c.nesting > CAL_MAX_NESTING) {
+        fail(c, CalCompileResult::TOO_DEEP);
+        return;
+    }
+    parseTerm(c);
+    while (c.error == CalCompileResult::OK) {
+        skipSpaces(c);
+        char ch = *c.pos;
+        if (ch != '+' && ch != '-') break;
+        c.pos++;
+        parseTerm(c);
+        emitBinary(c, ch == '+' ? CalOpcode::ADD : CalOpcode::SUB);
+    }
+    c.nesting--;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+
+/**
+ * Fixed Point - Q16.16 arithmetic for the sensor sample path
+ *
+ * The RP2040's Cortex-M0+ has no FPU, so every float multiply, add and
+ * int<->float conversion is a library call. Sensors configured with
+ * "fixedPoint": true keep their linear channels in Q16.16 from the raw bus
+ * counts to the Modbus register:
+ *
+ *   counts -> engineering units (Q16) -> slope*x + offset (Q16) -> value*100
+ *
+ * Channels with a calibration expression, and slopes/offsets that Q16.16
+ * cannot represent closely enough, stay on the float path. The float
+ * rawValue/calibratedValue fields are still filled (one conversion each) for
+ * the web UI and the rule engine.
+ *
+ * Range is +/-32767.99998 with a resolution of 1/65536; results saturate
+ * instead of wrapping.
+ */
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+typedef int32_t q16_t;
+
+static const q16_t Q16_ONE = 65536;
+static const q16_t Q16_MAX = INT32_MAX;
+static const q16_t Q16_MIN = INT32_MIN;
+
+// Largest relative error accepted when quantizing a calibration slope
+static const float Q16_SLOPE_TOLERANCE = 1e-4f;
+
+/**
+ * Linear calibration y = slope*x + offset with precomputed coefficients
+ * The slope keeps as many fractional bits as its magnitude allows (16-30), so
+ * small slopes such as 0.001 are not rounded to a handful of significant bits.
+ */
+struct LinearQ16 {
+    int32_t slope;       // Fixed point with slopeShift fractional bits
+    uint8_t slopeShift;
+    q16_t offset;        // Q16.16
+};
+
+// ============================================================================
+// CONVERSIONS
+// ============================================================================
+
+inline q16_t q16Saturate(int64_t value) {
+    if (value > Q16_MAX) return Q16_MAX;
+    if (value < Q16_MIN) return Q16_MIN;
+    return (q16_t)value;
+}
+
+// Round to nearest; out-of-range values saturate
+inline q16_t q16FromFloat(float value) {
+    float scaled = value * 65536.0f;
+    if (scaled >= 2147483647.0f) return Q16_MAX;
+    if (scaled <= -2147483648.0f) return Q16_MIN;
+    return (q16_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f);
+}
+
+inline float q16ToFloat(q16_t value) {
+    return (float)value * (1.0f / 65536.0f);
+}
+
+/**
+ * Modbus register encoding: value * 100, truncated toward zero
+ * Matches (int)(floatValue * 100) of the float path without 64-bit math.
+ */
+inline int32_t q16ToHundredths(q16_t value) {
+    int32_t whole = value >> 16;                  // floor
+    uint32_t fraction = (uint32_t)value & 0xFFFF;
+    uint32_t scaledFraction = fraction * 100;
+    int32_t result = whole * 100 + (int32_t)(scaledFraction >> 16);
+    if (value < 0 && (scaledFraction & 0xFFFF) != 0) {
+        result += 1;  // floor -> truncate toward zero
+    }
+    return result;
+}
+
+// ============================================================================
+// LINEAR CALIBRATION
+// ============================================================================
+
+/**
+ * Quantize a float slope/offset pair
+ * @return false if the pair does not fit Q16.16 within Q16_SLOPE_TOLERANCE
+ *         (caller keeps the channel on the float path)
+ */
+inline bool q16PrepareLinear(float slope, float offset, LinearQ16& out) {
+    if (fabsf(slope) >= 32767.0f || fabsf(offset) >= 32767.0f) return false;
+    uint8_t shift = 30;
+    while (shift > 16 && fabsf(slope) * (float)(1UL << shift) >= 2147483647.0f) {
+        shift--;
+    }
+    float scaled = slope * (float)(1UL << shift);
+    out.slope = (int32_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f);
+    out.slopeShift = shift;
+    out.offset = q16FromFloat(offset);
+    float quantized = (float)out.slope / (float)(1UL << shift);
+    return fabsf(quantized - slope) <= fabsf(slope) * Q16_SLOPE_TOLERANCE;
+}
+
+inline q16_t q16ApplyLinear(const LinearQ16& cal, q16_t x) {
+    int64_t product = (int64_t)cal.slope * x + (1LL << (cal.slopeShift - 1));  // Round to nearest
+    return q16Saturate((product >> cal.slopeShift) + cal.offset);
+}
+
+// ============================================================================
+// SENSOR SCALING (raw counts -> engineering units)
+// ============================================================================
+
+/**
+ * SHT30 temperature: -45 + 175 * raw / 65535 degC
+ * x/65535 is computed as x + (x >> 16) (error < 1 LSB for 16-bit raw values)
+ */
+inline q16_t q16FromSht30Temperature(uint16_t raw) {
+    int32_t scaled = 175 * (int32_t)raw;
+    return scaled + (scaled >> 16) - 45 * Q16_ONE;
+}
+
+// SHT30 relative humidity: 100 * raw / 65535 %
+inline q16_t q16FromSht30Humidity(uint16_t raw) {
+    int32_t scaled = 100 * (int32_t)raw;
+    return scaled + (scaled >> 16);
+}
+
+// LIS3DH 10-bit normal mode, +/-2g: 3.906 mg per count
+// Scale kept with 20 fractional bits; 512 * scale still fits in int32
+static const int32_t LIS3DH_MG_PER_COUNT_Q20 = 4095738;  // round(3.906 * 2^20)
+
+inline q16_t q16FromLis3dhCounts(int16_t counts) {
+    return ((int32_t)counts * LIS3DH_MG_PER_COUNT_Q20) >> 4;
+}
+
+// Mean of `count` samples from their sum (FIFO windows); keeps the sub-count fraction
+inline q16_t q16FromLis3dhCountSum(int32_t sum, uint16_t count) {
+    if (count == 0) return 0;
+    return q16Saturate((((int64_t)sum * LIS3DH_MG_PER_COUNT_Q20) >> 4) / count);
+}
+
+// 12-bit ADC to volts (3.3 V reference): raw * 3.3 / 4095
+inline q16_t q16FromAdc12Volts(uint16_t raw) {
+    return (q16_t)(((uint32_t)raw * 216322UL) >> 12);  // 216322 = 3.3 * 65536 * 4096 / 4095
+}
+
+// 12-bit ADC to millivolts; exact match of raw * 3300 / 4095 for raw 0-4095
+inline uint16_t adc12ToMillivolts(uint16_t raw) {
+    return (uint16_t)(((uint32_t)raw * 845007UL) >> 20);
+}
@@ -3,6 +3,7 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <cstring>
+#include "logging.h"
 
 /**
  * I2C Bus Manager - Advanced Multi-Bus, Multi-Pin I2C Polling System
@@ -12,14 +13,20 @@
  * - Groups sensors by bus and pin pair for sequential polling
  * - Handles atomic pin switching before each transaction
  * - Prevents conflicts through per-bus, per-pin sequencing
- * - Supports both hardware I2C buses on RP2040
+ * - Drives both RP2040 controllers: I2C0 pairs on Wire, I2C1 pairs on Wire1
  * - Dynamically configured from sensors.json
+ *
+ * Each controller keeps its own pin pair and counters, so a sensor on an I2C1
+ * pair never forces an I2C0 sensor to re-pin (and vice versa); pins are only
+ * switched between pairs of the same controller.
  * 
  * Usage:
  * 1. Call i2cBusManager.initialize() in setup() after loading sensor config
  * 2. Call i2cBusManager.discoverActiveBuses() to map all configured sensors
- * 3. In main loop, call i2cBusManager.processNextSensor() for sequential polling
- * 4. Call i2cBusManager.performAtomicRead() for actual I2C transactions
+ * 3. Call i2cBusManager.performAtomicTransaction() for actual I2C transactions
+ *
+ * When each sensor is triggered and collected is decided by the sensor
+ * scheduler (sensor_scheduler.h); the bus manager only owns the pins.
  */
 
 // ============================================================================
@@ -66,8 +73,6 @@ struct I2CPinPair {
 struct I2CSensorNode {
     uint8_t sensorIndex;      // Index into configuredSensors array
     I2CPinPair pinPair;       // Which pin pair this sensor uses
-    uint32_t lastPollMs;      // When this sensor was last polled
-    bool pollNeeded;          // Set to true when polling interval has elapsed
 };
 
 /**
@@ -80,7 +85,8 @@ enum class I2CTransactionResult : uint8_t {
     ERROR_NACK = 3,
     ERROR_TIMEOUT = 4,
     ERROR_READ_FAILED = 5,
-    ERROR_SENSOR_NOT_CONFIGURED = 6
+    ERROR_SENSOR_NOT_CONFIGURED = 6,
+    PENDING = 7               // Device still converting, collect again later
 };
 
 // ============================================================================
@@ -108,21 +114,56 @@ static const I2CPinPair RP2040_I2C_PIN_PAIRS[] = {
 
 static const uint8_t RP2040_I2C_PIN_PAIRS_COUNT = sizeof(RP2040_I2C_PIN_PAIRS) / sizeof(I2CPinPair);
 
+static const uint8_t RP2040_I2C_CONTROLLER_COUNT = 2;
+
+inline const char* i2cBusName(I2CBusId bus) {
+    switch (bus) {
+        case I2CBusId::I2C0: return "I2C0";
+        case I2CBusId::I2C1: return "I2C1";
+        default:             return "UNKNOWN";
+    }
+}
+
+// Re-poll interval and limit when a device answers COLLECT with "still processing"
+static const uint32_t I2C_NOT_READY_RETRY_MS = 50;
+static const uint8_t I2C_MAX_NOT_READY_RETRIES = 10;
+
+/**
+ * One RP2040 I2C controller and the pin pair it is currently routed to
+ */
+struct I2CController {
+    TwoWire* wire;
+    int sdaPin;                 // -1 until the first transaction
+    int sclPin;
+    
+    uint32_t transactionCount;
+    uint32_t transactionErrors;
+    
+    // Pin-pair switches (end/begin + settle delay)
+    uint32_t pinSwitchCount;
+    uint32_t pinSwitchTimeUs;   // Total time spent switching
+    uint32_t maxPinSwitchUs;
+    
+    void reset(TwoWire* controllerWire) {
+        memset(this, 0, sizeof(I2CController));
+        wire = controllerWire;
+        sdaPin = -1;
+        sclPin = -1;
+    }
+};
+
 // ============================================================================
 // I2C BUS MANAGER CLASS
 // ============================================================================
 
 class I2CBusManager {
 private:
-    // Current I2C bus state
-    int currentSdaPin;
-    int currentSclPin;
-    I2CBusId currentBusId;
+    // Wire (I2C0) and Wire1 (I2C1), indexed by I2CBusId
+    I2CController controllers[RP2040_I2C_CONTROLLER_COUNT];
     
-    // Sensor nodes for sequential polling
+    // Sensors grouped by pin pair
     I2CSensorNode sensorNodes[10];  // Max 10 sensors (matches MAX_SENSORS)
     uint8_t sensorNodeCount;
-    uint8_t nextSensorToPolIndex;   // Round-robin poll index
     
     // Active pin pairs discovered from sensor configuration
     I2CPinPair activePinPairs[13];  // Max pin pairs on RP2040
@@ -134,15 +175,18 @@ private:
     
     // For debugging
     uint32_t lastDiscoveryMs;
-    uint32_t transactionCount;
-    uint32_t transactionErrors;
+    
+    // Transactions refused because the pins are not an RP2040 I2C pair
+    uint32_t invalidPinErrors;
     
 public:
     I2CBusManager() 
-        : currentSdaPin(-1), currentSclPin(-1), currentBusId(I2CBusId::UNKNOWN),
-          sensorNodeCount(0), nextSensorToPolIndex(0), activePinPairCount(0),
+        : sensorNodeCount(0), activePinPairCount(0),
           isInitialized(false), busDiscoveryComplete(false),
-          lastDiscoveryMs(0), transactionCount(0), transactionErrors(0) {}
+          lastDiscoveryMs(0), invalidPinErrors(0) {
+        controllers[0].reset(&Wire);
+        controllers[1].reset(&Wire1);
+    }
     
     /**
      * Initialize the I2C bus manager
@@ -150,10 +194,9 @@ public:
      */
     void initialize() {
         isInitialized = true;
-        currentSdaPin = -1;
-        currentSclPin = -1;
-        currentBusId = I2CBusId::UNKNOWN;
-        nextSensorToPolIndex = 0;
+        controllers[0].reset(&Wire);
+        controllers[1].reset(&Wire1);
+        invalidPinErrors = 0;
         Serial.println("[I2C Manager] Initialized");
     }
     
@@ -164,12 +207,11 @@ public:
      * This function:
      * 1. Scans all configured sensors
      * 2. Groups them by I2C bus and pin pair
-     * 3. Builds round-robin polling sequence
+     * 3. Records the pin pair of every I2C sensor
      */
     void discoverActiveBuses(const struct SensorConfig* sensors, uint8_t sensorCount) {
         sensorNodeCount = 0;
         activePinPairCount = 0;
-        nextSensorToPolIndex = 0;
         memset(sensorNodes, 0, sizeof(sensorNodes));
         memset(activePinPairs, 0, sizeof(activePinPairs));
         
@@ -180,7 +222,7 @@ public:
             if (!sensors[i].enabled) continue;
             
             // Only process I2C protocol sensors
-            if (strcmp(sensors[i].protocol, "I2C") != 0) continue;
+            if (sensors[i].protocolId != SensorProtocol::I2C) continue;
             
             int sda = sensors[i].sdaPin;
             int scl = sensors[i].sclPin;
@@ -207,13 +249,10 @@ public:
             
             sensorNodes[sensorNodeCount].sensorIndex = i;
             sensorNodes[sensorNodeCount].pinPair = activePinPairs[pinPairIndex];
-            sensorNodes[sensorNodeCount].lastPollMs = 0;
-            sensorNodes[sensorNodeCount].pollNeeded = true;
             
             Serial.printf("  [OK] Sensor %d (%s): Bus=%s, SDA=%d SCL=%d, Addr=0x%02X, Interval=%ldms\n",
                         i, sensors[i].name,
-                        sensors[i].sdaPin <= 3 || sensors[i].sdaPin == 16 || sensors[i].sdaPin == 20 ? 
-                            (sensors[i].sdaPin <= 1 ? "I2C0" : "I2C1") : "I2C0",
+                        i2cBusName(activePinPairs[pinPairIndex].bus),
                         sda, scl,
                         sensors[i].i2cAddress,
                         sensors[i].updateInterval);
@@ -254,11 +293,21 @@ public:
     }
     
     /**
-     * Atomically switch to a new I2C pin pair and perform a transaction
+     * Controller object for a pin pair: Wire for I2C0 pairs, Wire1 for I2C1
+     * pairs. Pins that are not an RP2040 I2C pair map to Wire; transactions
+     * on them are refused by performAtomicTransaction().
+     */
+    TwoWire* getWireForPins(int sda, int scl) const {
+        I2CBusId bus = getBusIdForPins(sda, scl);
+        return bus == I2CBusId::I2C1 ? controllers[1].wire : controllers[0].wire;
+    }
+    
+    /**
+     * Atomically switch the pair's controller to the pair and perform a transaction
      * This is the core function for conflict-free I2C operations
      * 
-     * @param sda New SDA pin (-1 to skip switch)
-     * @param scl New SCL pin (-1 to skip switch)
+     * @param sda SDA pin of the sensor
+     * @param scl SCL pin of the sensor
      * @param transactionCallback Function to execute after pin switch
      * @return Result of transaction
      */
@@ -266,10 +315,17 @@ public:
         int sda, int scl,
         std::function<I2CTransactionResult()> transactionCallback) {
         
+        I2CBusId bus = getBusIdForPins(sda, scl);
+        if (bus == I2CBusId::UNKNOWN) {
+            invalidPinErrors++;
+            return I2CTransactionResult::ERROR_PIN_SWITCH_FAILED;
+        }
+        I2CController& controller = controllers[(uint8_t)bus];
+        
         // Only switch pins if necessary
-        if (sda >= 0 && scl >= 0 && (currentSdaPin != sda || currentSclPin != scl)) {
-            if (!switchI2CPins(sda, scl)) {
-                transactionErrors++;
+        if (controller.sdaPin != sda || controller.sclPin != scl) {
+            if (!switchI2CPins(controller, bus, sda, scl)) {
+                controller.transactionErrors++;
                 return I2CTransactionResult::ERROR_PIN_SWITCH_FAILED;
             }
         }
@@ -277,50 +333,41 @@ public:
         // Perform the actual transaction
         I2CTransactionResult result = transactionCallback();
         
-        if (result != I2CTransactionResult::SUCCESS) {
-            transactionErrors++;
+        if (result != I2CTransactionResult::SUCCESS && result != I2CTransactionResult::PENDING) {
+            controller.transactionErrors++;
         }
-        transactionCount++;
+        controller.transactionCount++;
         
         return result;
     }
     
     /**
-     * Get the next sensor that needs polling (round-robin)
-     * Returns sensor index, or 255 if no sensor needs polling
+     * True if the pair's controller is currently routed to it (no switch needed)
      */
-    uint8_t getNextSensorToPoll(const struct SensorConfig* sensors) {
-        if (sensorNodeCount == 0) return 255;
-        
-        uint32_t now = millis();
-        uint8_t attempts = 0;
-        
-        while (attempts < sensorNodeCount) {
-            I2CSensorNode& node = sensorNodes[nextSensorToPolIndex];
-            const SensorConfig& sensor = sensors[node.sensorIndex];
-            
-            // Check if polling interval has elapsed
-            if (now - node.lastPollMs >= sensor.updateInterval) {
-                node.pollNeeded = true;
-            }
-            
-            if (node.pollNeeded) {
-                node.lastPollMs = now;
-                node.pollNeeded = false;
-                
-                uint8_t sensorIdx = node.sensorIndex;
-                nextSensorToPolIndex = (nextSensorToPolIndex + 1) % sensorNodeCount;
-                
-                return sensorIdx;
-            }
-            
-            // Move to next sensor
-            nextSensorToPolIndex = (nextSensorToPolIndex + 1) % sensorNodeCount;
-            attempts++;
-        }
-        
-        return 255;  // No sensor needs polling yet
+    bool isCurrentPinPair(int sda, int scl) const {
+        I2CBusId bus = getBusIdForPins(sda, scl);
+        if (bus == I2CBusId::UNKNOWN) return false;
+        const I2CController& controller = controllers[(uint8_t)bus];
+        return controller.sdaPin == sda && controller.sclPin == scl;
+    }
+    
+    const I2CController& getController(I2CBusId bus) const {
+        return controllers[bus == I2CBusId::I2C1 ? 1 : 0];
+    }
+    
+    // Totals over both controllers
+    uint32_t getTransactionCount() const { return controllers[0].transactionCount + controllers[1].transactionCount; }
+    uint32_t getTransactionErrors() const {
+        return controllers[0].transactionErrors + controllers[1].transactionErrors + invalidPinErrors;
     }
+    uint32_t getPinSwitchCount() const { return controllers[0].pinSwitchCount + controllers[1].pinSwitchCount; }
+    uint32_t getPinSwitchTimeUs() const { return controllers[0].pinSwitchTimeUs + controllers[1].pinSwitchTimeUs; }
+    uint32_t getMaxPinSwitchUs() const {
+        return controllers[0].maxPinSwitchUs > controllers[1].maxPinSwitchUs ? controllers[0].maxPinSwitchUs
+                                                                            : controllers[1].maxPinSwitchUs;
+    }
+    uint32_t getInvalidPinErrors() const { return invalidPinErrors; }
+    uint8_t getActivePinPairCount() const { return activePinPairCount; }
     
     /**
      * Get I2C pin pair for a sensor
@@ -358,8 +405,20 @@ public:
         Serial.printf("Discovery Complete: %s\n", busDiscoveryComplete ? "Yes" : "No");
         Serial.printf("Active Sensors: %d\n", sensorNodeCount);
         Serial.printf("Active Pin Pairs: %d\n", activePinPairCount);
-        Serial.printf("Current Pin: SDA=%d SCL=%d\n", currentSdaPin, currentSclPin);
-        Serial.printf("Transactions: %lu (Errors: %lu)\n", transactionCount, transactionErrors);
+        if (invalidPinErrors > 0) {
+            Serial.printf("Refused (not an I2C pin pair): %lu\n", invalidPinErrors);
+        }
+        
+        for (uint8_t c = 0; c < RP2040_I2C_CONTROLLER_COUNT; c++) {
+            const I2CController& controller = controllers[c];
+            Serial.printf("\n%s (%s): SDA=%d SCL=%d\n", i2cBusName((I2CBusId)c), c == 0 ? "Wire" : "Wire1",
+                        controller.sdaPin, controller.sclPin);
+            Serial.printf("  Transactions: %lu (Errors: %lu)\n", controller.transactionCount, controller.transactionErrors);
+            Serial.printf("  Pin Switches: %lu (Total: %lu us, Avg: %lu us, Max: %lu us)\n",
+                        controller.pinSwitchCount, controller.pinSwitchTimeUs,
+                        controller.pinSwitchCount > 0 ? controller.pinSwitchTimeUs / controller.pinSwitchCount : 0UL,
+                        controller.maxPinSwitchUs);
+        }
         
         Serial.println("\nActive Pin Pairs:");
         for (uint8_t i = 0; i < activePinPairCount; i++) {
@@ -367,56 +426,70 @@ public:
                         i,
                         activePinPairs[i].sda,
                         activePinPairs[i].scl,
-                        activePinPairs[i].bus == I2CBusId::I2C0 ? "I2C0" : "I2C1");
+                        i2cBusName(activePinPairs[i].bus));
         }
         
-        Serial.println("\nSensor Polling Sequence:");
+        Serial.println("\nSensors:");
         for (uint8_t i = 0; i < sensorNodeCount; i++) {
-            Serial.printf("  Sensor %d: Index=%d SDA=%d SCL=%d LastPoll=%ldms\n",
+            Serial.printf("  Sensor %d: Index=%d SDA=%d SCL=%d\n",
                         i,
                         sensorNodes[i].sensorIndex,
                         sensorNodes[i].pinPair.sda,
-                        sensorNodes[i].pinPair.scl,
-                        sensorNodes[i].lastPollMs);
+                        sensorNodes[i].pinPair.scl);
         }
         Serial.println("===================================\n");
     }
     
 private:
     /**
-     * Switch to a new I2C pin pair
-     * Handles Wire.end() and Wire.begin() with new pins
+     * Route one controller to a new pin pair of that controller
+     * Handles end() and begin() with new pins on the controller's TwoWire;
+     * refuses a pair that does not belong to `bus`
      */
-    bool switchI2CPins(int sda, int scl) {
+    bool switchI2CPins(I2CController& controller, I2CBusId bus, int sda, int scl) {
         // Don't switch if already on correct pins
-        if (currentSdaPin == sda && currentSclPin == scl) {
+        if (controller.sdaPin == sda && controller.sclPin == scl) {
             return true;
         }
         
-        Serial.printf("[I2C Manager] Switching pins: SDA %d->%d, SCL %d->%d\n",
-                    currentSdaPin, sda, currentSclPin, scl);
+        // The pair must be one of this controller's (see RP2040_I2C_PIN_PAIRS)
+        if (getBusIdForPins(sda, scl) != bus) {
+            return false;
+        }
+        
+        LOG_DEBUG("[I2C Manager] Switching %s pins: SDA %d->%d, SCL %d->%d\n",
+                  i2cBusName(bus), controller.sdaPin, sda, controller.sclPin, scl);
+        uint32_t startUs = micros();
+        TwoWire& wire = *controller.wire;
         
         // End current I2C bus
-        if (currentSdaPin >= 0 || currentSclPin >= 0) {
-            Wire.end();
+        if (controller.sdaPin >= 0 || controller.sclPin >= 0) {
+            wire.end();
             delayMicroseconds(100);  // Small delay for pin release
         }
         
-        // Configure new pins
-        Wire.setSDA(sda);
-        Wire.setSCL(scl);
+        // Configure new pins (rejected if they do not belong to this controller)
+        if (!wire.setSDA(sda) || !wire.setSCL(scl)) {
+            controller.sdaPin = -1;
+            controller.sclPin = -1;
+            return false;
+        }
         
         // Initialize I2C bus on new pins
-        Wire.begin();
-        // Note: Wire.begin() returns void on RP2040, so no error checking available
+        wire.begin();
+        // Note: begin() returns void on RP2040, so no error checking available
         
         // Small delay for bus stabilization
         delay(10);
         
         // Update current state
-        currentSdaPin = sda;
-        currentSclPin = scl;
-        currentBusId = getBusIdForPins(sda, scl);
+        controller.sdaPin = sda;
+        controller.sclPin = scl;
+        
+        uint32_t elapsedUs = micros() - startUs;
+        controller.pinSwitchCount++;
+        controller.pinSwitchTimeUs += elapsedUs;
+        if (elapsedUs > controller.maxPinSwitchUs) controller.maxPinSwitchUs = elapsedUs;
         
         return true;
     }
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Logging - leveled Serial output for hot paths
+ *
+ * Two filters apply to every LOG_* call:
+ *
+ *   LOG_LEVEL        compile time (build flag -DLOG_LEVEL=n). Calls above it
+ *                    expand to nothing: no format string in flash, no
+ *                    argument evaluation, no branch.
+ *   logRuntimeLevel  runtime, from the serial "loglevel <n>" command; can
+ *                    only narrow what LOG_LEVEL compiled in.
+ *
+ * LOG_<LEVEL>_EVERY(ms, ...) additionally rate-limits one call site: at most
+ * one line per `ms`, followed by how many were dropped since the last one.
+ * Each site keeps its own static state, so a site must only be reached from
+ * one core.
+ *
+ * Levels: per-event messages (a rule fired, an output changed, a client
+ * connected) are INFO; per-pass or per-transaction detail is DEBUG/TRACE and
+ * is compiled out of the default build.
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_TRACE 5
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Runtime level (defaults to LOG_LEVEL, defined in main.cpp)
+extern uint8_t logRuntimeLevel;
+
+// ============================================================================
+// RATE LIMITING
+// ============================================================================
+
+/**
+ * Per-call-site state of a LOG_*_EVERY macro
+ */
+struct LogRateLimit {
+    uint32_t lastMs;
+    uint32_t suppressed;
+    bool started;
+
+    /**
+     * @return true if the site may print now; `dropped` is the number of
+     *         lines skipped since it last printed
+     */
+    bool allow(uint32_t nowMs, uint32_t intervalMs, uint32_t& dropped) {
+        if (started && nowMs - lastMs < intervalMs) {
+            suppressed++;
+            return false;
+        }
+        dropped = suppressed;
+        suppressed = 0;
+        lastMs = nowMs;
+        started = true;
+        return true;
+    }
+};
+
+inline const char* logLevelName(uint8_t level) {
+    switch (level) {
+        case LOG_LEVEL_NONE:  return "none";
+        case LOG_LEVEL_ERROR: return "error";
+        case LOG_LEVEL_WARN:  return "warn";
+        case LOG_LEVEL_INFO:  return "info";
+        case LOG_LEVEL_DEBUG: return "debug";
+        default:              return "trace";
+    }
+}
+
+// ============================================================================
+// MACROS
+// ============================================================================
+
+#define LOG_AT(level, ...) \
+    do { if (logRuntimeLevel >= (level)) Serial.printf(__VA_ARGS__); } while (0)
+
+#define LOG_EVERY_AT(level, intervalMs, ...) \
+    do { \
+        static LogRateLimit logRate_ = { 0, 0, false }; \
+        uint32_t logDropped_ = 0; \
+        if (logRuntimeLevel >= (level) && logRate_.allow(millis(), (intervalMs), logDropped_)) { \
+            Serial.printf(__VA_ARGS__); \
+            if (logDropped_ > 0) Serial.printf("  (%lu similar lines suppressed)\n", (unsigned long)logDropped_); \
+        } \
+    } while (0)
+
+#define LOG_DISABLED(...) do { } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...)            LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_ERROR_EVERY(ms, ...)  LOG_EVERY_AT(LOG_LEVEL_ERROR, ms, __VA_ARGS__)
+#else
+#define LOG_ERROR(...)            LOG_DISABLED()
+#define LOG_ERROR_EVERY(ms, ...)  LOG_DISABLED()
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...)             LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_WARN_EVERY(ms, ...)   LOG_EVERY_AT(LOG_LEVEL_WARN, ms, __VA_ARGS__)
+#else
+#define LOG_WARN(...)             LOG_DISABLED()
+#define LOG_WARN_EVERY(ms, ...)   LOG_DISABLED()
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...)             LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_INFO_EVERY(ms, ...)   LOG_EVERY_AT(LOG_LEVEL_INFO, ms, __VA_ARGS__)
+#else
+#define LOG_INFO(...)             LOG_DISABLED()
+#define LOG_INFO_EVERY(ms, ...)   LOG_DISABLED()
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...)            LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_DEBUG_EVERY(ms, ...)  LOG_EVERY_AT(LOG_LEVEL_DEBUG, ms, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...)            LOG_DISABLED()
+#define LOG_DEBUG_EVERY(ms, ...)  LOG_DISABLED()
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_TRACE
+#define LOG_TRACE(...)            LOG_AT(LOG_LEVEL_TRACE, __VA_ARGS__)
+#define LOG_TRACE_EVERY(ms, ...)  LOG_EVERY_AT(LOG_LEVEL_TRACE, ms, __VA_ARGS__)
+#else
+#define LOG_TRACE(...)            LOG_DISABLED()
+#define LOG_TRACE_EVERY(ms, ...)  LOG_DISABLED()
+#endif
@@ -0,0 +1,547 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstring>
+
+/**
+ * One-Wire Bus Manager - multi-drop DS18B20 strings on bit-banged GPIOs
+ *
+ * Every GPIO used by a 1-Wire sensor is a bus that can carry many devices.
+ * The first time a pin is used, the ROM search (0xF0) enumerates the devices
+ * on it and caches their 64-bit IDs; measurements then address devices by
+ * Match ROM without searching again.
+ *
+ *   startConversion()  one broadcast Skip ROM + Convert T for the whole pin;
+ *                      sensors triggered while it runs share the conversion
+ *   pollConversion()   devices hold read slots low until all are done
+ *   readScratchpad()   Match ROM + Read Scratchpad, 9 bytes, CRC8-checked
+ *
+ * A string of DS18B20s on one pin therefore costs a single conversion wait
+ * per round instead of one per sensor. The pin is searched again when a
+ * reset gets no presence pulse or a device stops answering, so replaced
+ * probes are picked up without a restart.
+ *
+ * Sensors select their device by ROM ("oneWireRom" in sensors.json) or, when
+ * none is set, by their position among the pin's sensors (search order).
+ *
+ * DS18B20 resolution (9-12 bit) is written to the configuration register by
+ * writeResolution(); lower resolutions convert 2x/4x/8x faster. The register
+ * is not copied to EEPROM (no wear, no strong pull-up): a device that lost
+ * power reports 12 bit again and is reconfigured by its sensor.
+ *
+ * Core 1 only. The terminal on core 0 uses it with core 1 parked.
+ *
+ * Include after sys_init.h (needs DriverStatus).
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+static const uint8_t ONE_WIRE_MAX_BUSES = 4;           // Pins with 1-Wire sensors
+static const uint8_t ONE_WIRE_MAX_DEVICES = 16;        // Devices per pin
+static const uint8_t ONE_WIRE_ROM_BYTES = 8;
+static const uint8_t DS18B20_SCRATCHPAD_BYTES = 9;
+
+// ROM and function commands
+static const uint8_t ONE_WIRE_CMD_SEARCH_ROM = 0xF0;
+static const uint8_t ONE_WIRE_CMD_MATCH_ROM = 0x55;
+static const uint8_t ONE_WIRE_CMD_SKIP_ROM = 0xCC;
+static const uint8_t DS18B20_CMD_CONVERT_T = 0x44;
+static const uint8_t DS18B20_CMD_WRITE_SCRATCHPAD = 0x4E;
+static const uint8_t DS18B20_CMD_READ_SCRATCHPAD = 0xBE;
+
+static const uint8_t DS18B20_MIN_RESOLUTION = 9;
+static const uint8_t DS18B20_MAX_RESOLUTION = 12;
+
+// Maximum conversion time per resolution (datasheet tCONV, rounded up)
+inline uint32_t ds18b20ConversionMs(uint8_t resolutionBits) {
+    switch (resolutionBits) {
+        case 9:  return 94;
+        case 10: return 188;
+        case 11: return 375;
+        default: return 750;
+    }
+}
+
+// Scratchpad byte 4: 0 R1 R0 1 1 1 1 1
+inline uint8_t ds18b20ConfigRegister(uint8_t resolutionBits) {
+    return (uint8_t)(((resolutionBits - DS18B20_MIN_RESOLUTION) & 0x03) << 5) | 0x1F;
+}
+
+inline uint8_t ds18b20ResolutionFromConfig(uint8_t configRegister) {
+    return DS18B20_MIN_RESOLUTION + ((configRegister >> 5) & 0x03);
+}
+
+// ============================================================================
+// CRC8 (Dallas/Maxim, x^8 + x^5 + x^4 + 1, reflected)
+// ============================================================================
+
+static const uint8_t ONE_WIRE_CRC8_TABLE[256] = {
+    0x00, 0x5E, 0xBC, 0xE2, 0x61, 0x3F, 0xDD, 0x83, 0xC2, 0x9C, 0x7E, 0x20, 0xA3, 0xFD, 0x1F, 0x41,
+    0x9D, 0xC3, 0x21, 0x7F, 0xFC, 0xA2, 0x40, 0x1E, 0x5F, 0x01, 0xE3, 0xBD, 0x3E, 0x60, 0x82, 0xDC,
+    0x23, 0x7D, 0x9F, 0xC1, 0x42, 0x1C, 0xFE, 0xA0, 0xE1, 0xBF, 0x5D, 0x03, 0x80, 0xDE, 0x3C, 0x62,
+    0xBE, 0xE0, 0x02, 0x5C, 0xDF, 0x81, 0x63, 0x3D, 0x7C, 0x22, 0xC0, 0x9E, 0x1D, 0x43, 0xA1, 0xFF,
+    0x46, 0x18, 0xFA, 0xA4, 0x27, 0x79, 0x9B, 0xC5, 0x84, 0xDA, 0x38, 0x66, 0xE5, 0xBB, 0x59, 0x07,
+    0xDB, 0x85, 0x67, 0x39, 0xBA, 0xE4, 0x06, 0x58, 0x19, 0x47, 0xA5, 0xFB, 0x78, 0x26, 0xC4, 0x9A,
+    0x65, 0x3B, 0xD9, 0x87, 0x04, 0x5A, 0xB8, 0xE6, 0xA7, 0xF9, 0x1B, 0x45, 0xC6, 0x98, 0x7A, 0x24,
+    0xF8, 0xA6, 0x44, 0x1A, 0x99, 0xC7, 0x25, 0x7B, 0x3A, 0x64, 0x86, 0xD8, 0x5B, 0x05, 0xE7, 0xB9,
+    0x8C, 0xD2, 0x30, 0x6E, 0xED, 0xB3, 0x51, 0x0F, 0x4E, 0x10, 0xF2, 0xAC, 0x2F, 0x71, 0x93, 0xCD,
+    0x11, 0x4F, 0xAD, 0xF3, 0x70, 0x2E, 0xCC, 0x92, 0xD3, 0x8D, 0x6F, 0x31, 0xB2, 0xEC, 0x0E, 0x50,
+    0xAF, 0xF1, 0x13, 0x4D, 0xCE, 0x90, 0x72, 0x2C, 0x6D, 0x33, 0xD1, 0x8F, 0x0C, 0x52, 0xB0, 0xEE,
+    0x32, 0x6C, 0x8E, 0xD0, 0x53, 0x0D, 0xEF, 0xB1, 0xF0, 0xAE, 0x4C, 0x12, 0x91, 0xCF, 0x2D, 0x73,
+    0xCA, 0x94, 0x76, 0x28, 0xAB, 0xF5, 0x17, 0x49, 0x08, 0x56, 0xB4, 0xEA, 0x69, 0x37, 0xD5, 0x8B,
+    0x57, 0x09, 0xEB, 0xB5, 0x36, 0x68, 0x8A, 0xD4, 0x95, 0xCB, 0x29, 0x77, 0xF4, 0xAA, 0x48, 0x16,
+    0xE9, 0xB7, 0x55, 0x0B, 0x88, 0xD6, 0x34, 0x6A, 0x2B, 0x75, 0x97, 0xC9, 0x4A, 0x14, 0xF6, 0xA8,
+    0x74, 0x2A, 0xC8, 0x96, 0x15, 0x4B, 0xA9, 0xF7, 0xB6, 0xE8, 0x0A, 0x54, 0xD7, 0x89, 0x6B, 0x35
+};
+
+inline uint8_t oneWireCrc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc = ONE_WIRE_CRC8_TABLE[crc ^ data[i]];
+    }
+    return crc;
+}
+
+// ============================================================================
+// ROM ID STRINGS
+// ============================================================================
+
+/**
+ * ROM ID -> 16 hex digits, family code first ("28FF641E0F0000A1")
+ */
+inline void oneWireRomToString(const uint8_t* rom, char* out /* 17 bytes */) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    for (uint8_t i = 0; i < ONE_WIRE_ROM_BYTES; i++) {
+        out[2 * i] = HEX_DIGITS[rom[i] >> 4];
+        out[2 * i + 1] = HEX_DIGITS[rom[i] & 0x0F];
+    }
+    out[2 * ONE_WIRE_ROM_BYTES] = '\0';
+}
+
+/**
+ * 16 hex digits (separators '-', ':' and ' ' allowed) -> ROM ID
+ * @return false (and an all-zero ROM) if the string is empty or malformed
+ */
+inline bool oneWireRomFromString(const char* text, uint8_t* rom) {
+    memset(rom, 0, ONE_WIRE_ROM_BYTES);
+    if (text == nullptr) return false;
+    uint8_t digits = 0;
+    for (const char* p = text; *p != '\0'; p++) {
+        char c = *p;
+        if (c == '-' || c == ':' || c == ' ') continue;
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') nibble = c - '0';
+        else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+        else break;
+        if (digits >= 2 * ONE_WIRE_ROM_BYTES) break;
+        rom[digits / 2] |= (digits % 2 == 0) ? (nibble << 4) : nibble;
+        digits++;
+    }
+    if (digits != 2 * ONE_WIRE_ROM_BYTES) {
+        memset(rom, 0, ONE_WIRE_ROM_BYTES);
+        return false;
+    }
+    return true;
+}
+
+inline bool oneWireRomIsSet(const uint8_t* rom) {
+    for (uint8_t i = 0; i < ONE_WIRE_ROM_BYTES; i++) {
+        if (rom[i] != 0) return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * Counters of one 1-Wire pin
+ */
+struct OneWireBusStats {
+    uint32_t searches;
+    uint32_t conversions;        // Broadcast Convert T issued
+    uint32_t sharedConversions;  // Triggers that joined a conversion already running
+    uint32_t reads;
+    uint32_t crcErrors;
+    uint32_t noPresence;         // Resets without a presence pulse
+};
+
+// ============================================================================
+// ONE-WIRE BUS MANAGER CLASS
+// ============================================================================
+
+class OneWireBusManager {
+private:
+    struct Bus {
+        int pin;
+        bool searched;
+        uint8_t deviceCount;
+        uint8_t roms[ONE_WIRE_MAX_DEVICES][ONE_WIRE_ROM_BYTES];
+
+        // Broadcast conversion in progress
+        bool converting;
+        uint32_t conversionStartMs;
+        uint32_t conversionMs;   // Slowest device on the pin (largest wait any sensor asked for)
+        bool lineQuiet;          // No reset since Convert T: read slots report busy/done
+
+        OneWireBusStats stats;
+    };
+
+    Bus buses[ONE_WIRE_MAX_BUSES];
+    uint8_t busCount;
+
+    // Wrap-safe "a is at or after b"
+    static bool reached(uint32_t a, uint32_t b) {
+        return (int32_t)(a - b) >= 0;
+    }
+
+    Bus* findBus(int pin) {
+        for (uint8_t i = 0; i < busCount; i++) {
+            if (buses[i].pin == pin) return &buses[i];
+        }
+        return nullptr;
+    }
+
+    Bus* findOrAddBus(int pin) {
+        Bus* bus = findBus(pin);
+        if (bus != nullptr || pin < 0 || busCount >= ONE_WIRE_MAX_BUSES) return bus;
+        bus = &buses[busCount++];
+        memset(bus, 0, sizeof(Bus));
+        bus->pin = pin;
+        return bus;
+    }
+
+    // ---- Bit timing (standard speed) ----
+
+    // Reset pulse; true if a device answered with a presence pulse
+    static bool resetPulse(int pin) {
+        pinMode(pin, OUTPUT);
+        digitalWrite(pin, LOW);
+        delayMicroseconds(480);
+        pinMode(pin, INPUT_PULLUP);
+        delayMicroseconds(70);
+        bool presence = !digitalRead(pin);
+        delayMicroseconds(410);
+        return presence;
+    }
+
+    static void writeBit(int pin, bool bit) {
+        pinMode(pin, OUTPUT);
+        digitalWrite(pin, LOW);
+        if (bit) {
+            delayMicroseconds(6);
+            pinMode(pin, INPUT_PULLUP);
+            delayMicroseconds(64);
+        } else {
+            delayMicroseconds(60);
+            pinMode(pin, INPUT_PULLUP);
+            delayMicroseconds(10);
+        }
+    }
+
+    static void writeByte(int pin, uint8_t value) {
+        for (int bit = 0; bit < 8; bit++) {
+            writeBit(pin, (value >> bit) & 1);
+        }
+    }
+
+    static bool readBit(int pin) {
+        pinMode(pin, OUTPUT);
+        digitalWrite(pin, LOW);
+        delayMicroseconds(3);
+        pinMode(pin, INPUT_PULLUP);
+        delayMicroseconds(10);
+        bool bit = digitalRead(pin);
+        delayMicroseconds(53);
+        return bit;
+    }
+
+    static uint8_t readByte(int pin) {
+        uint8_t value = 0;
+        for (int bit = 0; bit < 8; bit++) {
+            if (readBit(pin)) {
+                value |= (1 << bit);
+            }
+        }
+        return value;
+    }
+
+    // Reset + Match ROM, or Skip ROM when the device is alone on the pin
+    bool select(Bus& bus, const uint8_t* rom) {
+        if (!reset(bus)) return false;
+        if (rom != nullptr && bus.deviceCount > 1) {
+            writeByte(bus.pin, ONE_WIRE_CMD_MATCH_ROM);
+            for (uint8_t i = 0; i < ONE_WIRE_ROM_BYTES; i++) {
+                writeByte(bus.pin, rom[i]);
+            }
+        } else {
+            writeByte(bus.pin, ONE_WIRE_CMD_SKIP_ROM);
+        }
+        return true;
+    }
+
+    bool reset(Bus& bus) {
+        bus.lineQuiet = false;
+        if (!resetPulse(bus.pin)) {
+            bus.stats.noPresence++;
+            bus.searched = false;  // Devices gone or line fault: enumerate again
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * ROM search (Maxim AN187): one pass per device, each pass follows the
+     * previous pass's path up to its last unexplored 0/1 branch
+     */
+    void search(Bus& bus) {
+        bus.deviceCount = 0;
+        bus.searched = true;
+        bus.stats.searches++;
+
+        uint8_t rom[ONE_WIRE_ROM_BYTES] = {0};
+        int lastDiscrepancy = -1;
+        while (bus.deviceCount < ONE_WIRE_MAX_DEVICES) {
+            if (!reset(bus)) return;
+            writeByte(bus.pin, ONE_WIRE_CMD_SEARCH_ROM);
+
+            int lastZero = -1;
+            for (int bit = 0; bit < 64; bit++) {
+                bool idBit = readBit(bus.pin);
+                bool complementBit = readBit(bus.pin);
+                if (idBit && complementBit) return;  // Nobody took part (device left mid-search)
+
+                bool direction;
+                if (idBit != complementBit) {
+                    direction = idBit;  // All remaining devices agree
+                } else {
+                    // Discrepancy: repeat the previous choice before the last
+                    // branch point, take 1 at it, 0 after it
+                    if (bit < lastDiscrepancy) direction = (rom[bit / 8] >> (bit % 8)) & 1;
+                    else direction = (bit == lastDiscrepancy);
+                    if (!direction) lastZero = bit;
+                }
+
+                if (direction) rom[bit / 8] |= (1 << (bit % 8));
+                else rom[bit / 8] &= ~(1 << (bit % 8));
+                writeBit(bus.pin, direction);
+            }
+
+            if (oneWireCrc8(rom, ONE_WIRE_ROM_BYTES - 1) != rom[ONE_WIRE_ROM_BYTES - 1]) {
+                bus.stats.crcErrors++;
+                bus.searched = false;  // Retry on the next conversion
+                return;
+            }
+            memcpy(bus.roms[bus.deviceCount++], rom, ONE_WIRE_ROM_BYTES);
+
+            lastDiscrepancy = lastZero;
+            if (lastDiscrepancy < 0) return;  // No branch left unexplored
+        }
+    }
+
+public:
+    OneWireBusManager() : busCount(0) {
+        memset(buses, 0, sizeof(buses));
+    }
+
+    /**
+     * Forget all pins (device lists, conversions), e.g. after the sensor
+     * configuration changed
+     */
+    void reset() {
+        busCount = 0;
+        memset(buses, 0, sizeof(buses));
+    }
+
+    /**
+     * Start a temperature conversion on every device of the pin
+     * Runs the ROM search first if the pin has not been enumerated yet. The
+     * conversion runs as long as the slowest device needs (the largest
+     * conversionMs any sensor on the pin has passed).
+     * @return OK (issued or joined), ERROR_BUS if no device answered or all
+     *         ONE_WIRE_MAX_BUSES pins are taken
+     */
+    DriverStatus startConversion(int pin, uint32_t nowMs, uint32_t conversionMs) {
+        Bus* bus = findOrAddBus(pin);
+        if (bus == nullptr) return DriverStatus::ERROR_BUS;
+
+        if (conversionMs > bus->conversionMs) {
+            bus->conversionMs = conversionMs;
+        }
+        if (isConverting(pin, nowMs)) {
+            bus->stats.sharedConversions++;
+            return DriverStatus::OK;
+        }
+
+        if (!bus->searched) {
+            search(*bus);
+        }
+        if (!reset(*bus)) return DriverStatus::ERROR_BUS;
+        writeByte(pin, ONE_WIRE_CMD_SKIP_ROM);
+        writeByte(pin, DS18B20_CMD_CONVERT_T);
+        bus->converting = true;
+        bus->conversionStartMs = nowMs;
+        bus->lineQuiet = true;
+        bus->stats.conversions++;
+        return DriverStatus::OK;
+    }
+
+    /**
+     * True while a conversion started on the pin is still running (a trigger
+     * now would join it)
+     */
+    bool isConverting(int pin, uint32_t nowMs) {
+        Bus* bus = findBus(pin);
+        return bus != nullptr && bus->converting &&
+               !reached(nowMs, bus->conversionStartMs + bus->conversionMs);
+    }
+
+    /**
+     * @param conversionMs the caller's own device conversion time; a faster
+     *        device is done before the slowest one on the pin
+     * @return OK once the conversion is complete, PENDING while the devices
+     *         still report busy
+     */
+    DriverStatus pollConversion(int pin, uint32_t nowMs, uint32_t conversionMs) {
+        Bus* bus = findBus(pin);
+        if (bus == nullptr || !bus->converting) return DriverStatus::OK;
+        if (reached(nowMs, bus->conversionStartMs + bus->conversionMs)) {
+            bus->converting = false;
+            return DriverStatus::OK;
+        }
+        if (reached(nowMs, bus->conversionStartMs + conversionMs)) {
+            return DriverStatus::OK;
+        }
+        // After another reset the read slots no longer report conversion state
+        if (bus->lineQuiet && readBit(pin)) {
+            bus->converting = false;
+            return DriverStatus::OK;
+        }
+        return DriverStatus::PENDING;
+    }
+
+    /**
+     * Device addressed by a sensor: its configured ROM if present on the pin,
+     * otherwise the slot-th device in search order
+     * @return nullptr if there is no such device (pin searched again next time)
+     */
+    const uint8_t* deviceRom(int pin, const uint8_t* configuredRom, uint8_t slot) {
+        Bus* bus = findOrAddBus(pin);
+        if (bus == nullptr) return nullptr;
+        if (!bus->searched) {
+            search(*bus);
+        }
+        if (oneWireRomIsSet(configuredRom)) {
+            for (uint8_t i = 0; i < bus->deviceCount; i++) {
+                if (memcmp(bus->roms[i], configuredRom, ONE_WIRE_ROM_BYTES) == 0) return bus->roms[i];
+            }
+        } else if (slot < bus->deviceCount) {
+            return bus->roms[slot];
+        }
+        bus->searched = false;
+        return nullptr;
+    }
+
+    /**
+     * Read and CRC-check one device's scratchpad (Skip ROM if it is the only
+     * device on the pin)
+     * @return OK, ERROR_BUS on no presence, ERROR_READ on a CRC mismatch
+     */
+    DriverStatus readScratchpad(int pin, const uint8_t* rom, uint8_t* scratchpad) {
+        Bus* bus = findOrAddBus(pin);
+        if (bus == nullptr) return DriverStatus::ERROR_BUS;
+        if (!select(*bus, rom)) return DriverStatus::ERROR_BUS;
+        writeByte(pin, DS18B20_CMD_READ_SCRATCHPAD);
+
+        bool allOnes = true;
+        for (uint8_t i = 0; i < DS18B20_SCRATCHPAD_BYTES; i++) {
+            scratchpad[i] = readByte(pin);
+            if (scratchpad[i] != 0xFF) allOnes = false;
+        }
+        bus->stats.reads++;
+
+        if (oneWireCrc8(scratchpad, DS18B20_SCRATCHPAD_BYTES - 1) != scratchpad[DS18B20_SCRATCHPAD_BYTES - 1]) {
+            bus->stats.crcErrors++;
+            if (allOnes) bus->searched = false;  // Addressed device did not answer
+            return DriverStatus::ERROR_READ;
+        }
+        return DriverStatus::OK;
+    }
+
+    /**
+     * Set a DS18B20's resolution (configuration register, TH/TL kept)
+     * @return OK once read back, ERROR_BUS/ERROR_READ as readScratchpad()
+     */
+    DriverStatus writeResolution(int pin, const uint8_t* rom, uint8_t resolutionBits) {
+        uint8_t scratchpad[DS18B20_SCRATCHPAD_BYTES];
+        DriverStatus status = readScratchpad(pin, rom, scratchpad);
+        if (status != DriverStatus::OK) return status;
+
+        uint8_t config = ds18b20ConfigRegister(resolutionBits);
+        if (scratchpad[4] == config) return DriverStatus::OK;
+
+        Bus* bus = findBus(pin);
+        if (!select(*bus, rom)) return DriverStatus::ERROR_BUS;
+        writeByte(pin, DS18B20_CMD_WRITE_SCRATCHPAD);
+        writeByte(pin, scratchpad[2]);  // TH alarm
+        writeByte(pin, scratchpad[3]);  // TL alarm
+        writeByte(pin, config);
+
+        status = readScratchpad(pin, rom, scratchpad);
+        if (status != DriverStatus::OK) return status;
+        return scratchpad[4] == config ? DriverStatus::OK : DriverStatus::ERROR_READ;
+    }
+
+    /**
+     * Enumerate the pin now (terminal)
+     * @return devices found, -1 if no pin slot is free
+     */
+    int rescan(int pin) {
+        Bus* bus = findOrAddBus(pin);
+        if (bus == nullptr) return -1;
+        search(*bus);
+        return bus->deviceCount;
+    }
+
+    uint8_t getDeviceCount(int pin) {
+        Bus* bus = findBus(pin);
+        return bus != nullptr ? bus->deviceCount : 0;
+    }
+
+    const uint8_t* getDevice(int pin, uint8_t index) {
+        Bus* bus = findBus(pin);
+        return (bus != nullptr && index < bus->deviceCount) ? bus->roms[index] : nullptr;
+    }
+
+    /**
+     * Print device lists and counters per pin
+     */
+    void printDiagnostics() const {
+        Serial.println("\n=== One-Wire Buses ===");
+        if (busCount == 0) {
+            Serial.println("No pins in use");
+        }
+        for (uint8_t i = 0; i < busCount; i++) {
+            const Bus& bus = buses[i];
+            Serial.printf("GP%d: %d device(s)%s%s\n", bus.pin, bus.deviceCount,
+                          bus.searched ? "" : " (search pending)",
+                          bus.converting ? ", converting" : "");
+            for (uint8_t d = 0; d < bus.deviceCount; d++) {
+                char rom[2 * ONE_WIRE_ROM_BYTES + 1];
+                oneWireRomToString(bus.roms[d], rom);
+                Serial.printf("  [%d] %s\n", d, rom);
+            }
+            Serial.printf("  Searches: %lu, Conversions: %lu (shared: %lu), Reads: %lu, CRC errors: %lu, No presence: %lu\n",
+                          bus.stats.searches, bus.stats.conversions, bus.stats.sharedConversions,
+                          bus.stats.reads, bus.stats.crcErrors, bus.stats.noPresence);
+        }
+        Serial.println("======================\n");
+    }
+};
+
+// Global instance
+extern OneWireBusManager oneWireBusManager;
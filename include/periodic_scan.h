@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Periodic Scan - fixed-period release of a job from the main loop
+ *
+ * due() is polled every loop pass and returns true once per period. The
+ * schedule is anchored to the first release, so releases stay on a fixed
+ * grid (start + n * period) instead of drifting by each pass's latency.
+ *
+ * Jitter is how late a release is against its grid point; it is bounded by
+ * the longest loop pass (HTTP, Modbus) and reported so it can be checked
+ * against what the job needs. A release later than a whole period skips the
+ * missed grid points rather than bursting to catch up; those count as
+ * overruns.
+ *
+ * Times are micros(). Core 0 only.
+ */
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+struct PeriodicScanStats {
+    uint32_t periodUs;
+    uint32_t scans;
+    uint32_t overruns;             // Grid points skipped because a release came a period late
+    uint32_t lastJitterUs;         // Release time minus grid point
+    uint32_t maxJitterUs;
+    uint32_t avgJitterUs;          // Since the last setPeriod()
+    uint32_t lastDurationUs;       // due() to finish()
+    uint32_t maxDurationUs;
+};
+
+// ============================================================================
+// PERIODIC SCAN CLASS
+// ============================================================================
+
+class PeriodicScan {
+private:
+    uint32_t nextUs;
+    uint32_t startUs;
+    bool started;
+    uint64_t totalJitterUs;
+    PeriodicScanStats stats;
+
+public:
+    PeriodicScan() : nextUs(0), startUs(0), started(false), totalJitterUs(0) {
+        memset(&stats, 0, sizeof(stats));
+        stats.periodUs = 10000;
+    }
+
+    /**
+     * Set the period; restarts the grid and the statistics
+     */
+    void setPeriod(uint32_t periodUs) {
+        memset(&stats, 0, sizeof(stats));
+        stats.periodUs = periodUs > 0 ? periodUs : 1;
+        totalJitterUs = 0;
+        started = false;
+    }
+
+    /**
+     * @return true if a scan should run now; follow it with finish()
+     */
+    bool due(uint32_t nowUs) {
+        if (!started) {
+            nextUs = nowUs;
+            started = true;
+        }
+        if ((int32_t)(nowUs - nextUs) < 0) return false;
+
+        uint32_t jitter = nowUs - nextUs;
+        nextUs += stats.periodUs;
+        if (jitter >= stats.periodUs) {
+            uint32_t missed = jitter / stats.periodUs;
+            nextUs += missed * stats.periodUs;
+            stats.overruns += missed;
+        }
+
+        stats.scans++;
+        stats.lastJitterUs = jitter;
+        if (jitter > stats.maxJitterUs) stats.maxJitterUs = jitter;
+        totalJitterUs += jitter;
+        stats.avgJitterUs = (uint32_t)(totalJitterUs / stats.scans);
+        startUs = nowUs;
+        return true;
+    }
+
+    void finish(uint32_t nowUs) {
+        stats.lastDurationUs = nowUs - startUs;
+        if (stats.lastDurationUs > stats.maxDurationUs) stats.maxDurationUs = stats.lastDurationUs;
+    }
+
+    const PeriodicScanStats& getStats() const { return stats; }
+};
+
+// Global instance
+extern PeriodicScan globalRuleScan;
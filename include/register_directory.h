@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Arduino.h>
+#include "register_store.h"
+
+/**
+ * Register Directory - what backs each Modbus register address
+ *
+ * Rebuilt by applySensorPresets() whenever the sensor configuration changes,
+ * so looking up an address is one array index instead of a scan over the
+ * configured sensors. Precedence, highest first:
+ *
+ *   ANALOG_INPUT    0-2, ADC channels (ioStatus.aIn[])
+ *   SENSOR          a sensor's modbusRegisterCount registers from its
+ *                   modbusRegister; the lower sensor index wins an overlap.
+ *                   Only addresses inside the input register image
+ *                   (REGISTER_STORE_INPUT_REGISTERS) are mapped; mapSensor()
+ *                   returns how many fell outside so the caller can warn
+ *   COIL            100-200, IO pin output states
+ *   INPUT_REGISTER  anything else inside the register store
+ *
+ * readRegisterValue() resolves an entry to a value; storeSensorRegisters()
+ * publishes the SENSOR entries through the same function, so rules, the
+ * status JSON and the Modbus image agree on which source owns an address.
+ *
+ * Core 0 only.
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+// Addresses covered (input image and the coils); higher addresses resolve to NONE
+static const uint16_t REGISTER_DIRECTORY_SIZE = 256;
+
+static const uint16_t REGISTER_DIRECTORY_ANALOG_INPUTS = 3;
+static const uint16_t REGISTER_DIRECTORY_COIL_FIRST = 100;
+static const uint16_t REGISTER_DIRECTORY_COIL_LAST = 200;
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+enum class RegisterSourceKind : uint8_t {
+    NONE = 0,
+    ANALOG_INPUT = 1,     // index = ADC channel
+    SENSOR = 2,           // index = sensor, channel = register offset (0-2 A-C, 3+ features)
+    COIL = 3,
+    INPUT_REGISTER = 4
+};
+
+struct RegisterSource {
+    RegisterSourceKind kind;
+    uint8_t index;
+    uint8_t channel;
+};
+
+// ============================================================================
+// REGISTER DIRECTORY CLASS
+// ============================================================================
+
+class RegisterDirectory {
+private:
+    RegisterSource entries[REGISTER_DIRECTORY_SIZE];
+    uint16_t sensorAddresses[REGISTER_DIRECTORY_SIZE];  // Addresses owned by a sensor, ascending
+    uint16_t sensorAddressCount;
+
+    static void set(RegisterSource& entry, RegisterSourceKind kind, uint8_t index, uint8_t channel) {
+        entry.kind = kind;
+        entry.index = index;
+        entry.channel = channel;
+    }
+
+public:
+    RegisterDirectory() : sensorAddressCount(0) {
+        clear();
+    }
+
+    /**
+     * Start a rebuild: coils and the plain input image only
+     */
+    void clear() {
+        for (uint16_t address = 0; address < REGISTER_DIRECTORY_SIZE; address++) {
+            RegisterSourceKind kind = RegisterSourceKind::NONE;
+            if (address >= REGISTER_DIRECTORY_COIL_FIRST && address <= REGISTER_DIRECTORY_COIL_LAST) {
+                kind = RegisterSourceKind::COIL;
+            } else if (address < REGISTER_STORE_INPUT_REGISTERS) {
+                kind = RegisterSourceKind::INPUT_REGISTER;
+            }
+            set(entries[address], kind, 0, 0);
+        }
+        sensorAddressCount = 0;
+    }
+
+    /**
+     * Map `count` registers from `first` to a sensor; call in sensor index
+     * order, addresses already owned by a sensor are left alone
+     * @return registers past the input image, which are not mapped (they
+     *         could be neither published nor read back consistently)
+     */
+    uint8_t mapSensor(uint8_t sensorIndex, int first, uint8_t count) {
+        if (first < 0) return 0;
+        uint8_t outside = 0;
+        for (uint8_t channel = 0; channel < count; channel++) {
+            uint32_t address = (uint32_t)first + channel;
+            if (address >= REGISTER_STORE_INPUT_REGISTERS) {
+                outside++;
+                continue;
+            }
+            if (entries[address].kind == RegisterSourceKind::SENSOR) continue;
+            set(entries[address], RegisterSourceKind::SENSOR, sensorIndex, channel);
+        }
+        return outside;
+    }
+
+    /**
+     * Finish a rebuild: ADC channels take 0-2, then list the sensor addresses
+     */
+    void finish() {
+        for (uint16_t channel = 0; channel < REGISTER_DIRECTORY_ANALOG_INPUTS; channel++) {
+            set(entries[channel], RegisterSourceKind::ANALOG_INPUT, (uint8_t)channel, 0);
+        }
+        sensorAddressCount = 0;
+        for (uint16_t address = 0; address < REGISTER_DIRECTORY_SIZE; address++) {
+            if (entries[address].kind == RegisterSourceKind::SENSOR) {
+                sensorAddresses[sensorAddressCount++] = address;
+            }
+        }
+    }
+
+    const RegisterSource& lookup(uint16_t address) const {
+        static const RegisterSource none = { RegisterSourceKind::NONE, 0, 0 };
+        return address < REGISTER_DIRECTORY_SIZE ? entries[address] : none;
+    }
+
+    uint16_t getSensorAddressCount() const { return sensorAddressCount; }
+    uint16_t getSensorAddress(uint16_t i) const { return sensorAddresses[i < sensorAddressCount ? i : 0]; }
+};
+
+// Global instance
+extern RegisterDirectory registerDirectory;
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoModbus.h>
+
+/**
+ * Register Store - change-tracked source of the Modbus input image
+ *
+ * Producers (IO sampling, sensor snapshot) write values here instead of
+ * straight into the Modbus image. A value that differs from the stored one
+ * sets its bit in a dirty bitmap and bumps the store version; unchanged
+ * values cost one compare. publish() then writes only the dirty entries to
+ * the shared image, so an idle module does no Modbus writes at all.
+ *
+ * Core 0 only (Modbus image, IO sampling and the snapshot reader all run in
+ * loop()).
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+// Size of the input register image configured in setupModbus(); room for
+// accelerometer feature blocks (27 registers per LIS3DH)
+static const uint16_t REGISTER_STORE_INPUT_REGISTERS = 128;
+static const uint16_t REGISTER_STORE_DISCRETE_INPUTS = 16;
+
+// Window over which the publish rate is measured
+static const uint32_t REGISTER_STORE_RATE_WINDOW_MS = 1000;
+
+// ============================================================================
+// REGISTER STORE
+// ============================================================================
+
+class RegisterStore {
+private:
+    static const uint16_t INPUT_WORDS = (REGISTER_STORE_INPUT_REGISTERS + 31) / 32;
+    static const uint16_t DISCRETE_WORDS = (REGISTER_STORE_DISCRETE_INPUTS + 31) / 32;
+
+    uint16_t inputRegisters[REGISTER_STORE_INPUT_REGISTERS];
+    uint8_t discreteInputs[REGISTER_STORE_DISCRETE_INPUTS];
+    uint32_t inputDirty[INPUT_WORDS];
+    uint32_t discreteDirty[DISCRETE_WORDS];
+
+    uint32_t version;           // Bumped on every stored change
+    uint32_t publishedVersion;  // Version last written to the image
+
+    // Statistics
+    uint32_t totalPublished;    // Registers/inputs written to the image since boot
+    uint32_t windowPublished;
+    uint32_t windowStartMs;
+    uint32_t publishRate;       // Writes per second over the last full window
+
+    static void markDirty(uint32_t* bitmap, uint16_t index) {
+        bitmap[index >> 5] |= (1UL << (index & 31));
+    }
+
+public:
+    RegisterStore() {
+        memset(inputRegisters, 0, sizeof(inputRegisters));
+        memset(discreteInputs, 0, sizeof(discreteInputs));
+        memset(inputDirty, 0, sizeof(inputDirty));
+        memset(discreteDirty, 0, sizeof(discreteDirty));
+        version = 0;
+        publishedVersion = 0;
+        totalPublished = 0;
+        windowPublished = 0;
+        windowStartMs = 0;
+        publishRate = 0;
+    }
+
+    /**
+     * Store an input register value, marking it dirty if it changed
+     * @return false if the address is outside the store
+     */
+    bool setInputRegister(uint16_t address, uint16_t value) {
+        if (address >= REGISTER_STORE_INPUT_REGISTERS) return false;
+        if (inputRegisters[address] != value) {
+            inputRegisters[address] = value;
+            markDirty(inputDirty, address);
+            version++;
+        }
+        return true;
+    }
+
+    /**
+     * Store a discrete input state, marking it dirty if it changed
+     * @return false if the address is outside the store
+     */
+    bool setDiscreteInput(uint16_t address, bool value) {
+        if (address >= REGISTER_STORE_DISCRETE_INPUTS) return false;
+        if (discreteInputs[address] != (uint8_t)value) {
+            discreteInputs[address] = value;
+            markDirty(discreteDirty, address);
+            version++;
+        }
+        return true;
+    }
+
+    /**
+     * Mark every entry dirty so the next publish() rewrites the whole image
+     */
+    void invalidate() {
+        for (uint16_t w = 0; w < INPUT_WORDS; w++) inputDirty[w] = 0xFFFFFFFFUL;
+        for (uint16_t w = 0; w < DISCRETE_WORDS; w++) discreteDirty[w] = 0xFFFFFFFFUL;
+        version++;
+    }
+
+    /**
+     * Write dirty entries to the Modbus image and clear their bits
+     * Cost is O(1) when nothing changed, otherwise O(changed entries).
+     * @return number of entries written
+     */
+    uint16_t publish(ModbusServer& image) {
+        uint16_t written = 0;
+
+        if (version != publishedVersion) {
+            for (uint16_t w = 0; w < INPUT_WORDS; w++) {
+                uint32_t bits = inputDirty[w];
+                inputDirty[w] = 0;
+                while (bits) {
+                    uint16_t address = (w << 5) + __builtin_ctz(bits);
+                    bits &= bits - 1;
+                    if (address >= REGISTER_STORE_INPUT_REGISTERS) break;
+                    image.inputRegisterWrite(address, inputRegisters[address]);
+                    written++;
+                }
+            }
+            for (uint16_t w = 0; w < DISCRETE_WORDS; w++) {
+                uint32_t bits = discreteDirty[w];
+                discreteDirty[w] = 0;
+                while (bits) {
+                    uint16_t address = (w << 5) + __builtin_ctz(bits);
+                    bits &= bits - 1;
+                    if (address >= REGISTER_STORE_DISCRETE_INPUTS) break;
+                    image.discreteInputWrite(address, discreteInputs[address]);
+                    written++;
+                }
+            }
+            publishedVersion = version;
+        }
+
+        totalPublished += written;
+        windowPublished += written;
+        uint32_t now = millis();
+        if (now - windowStartMs >= REGISTER_STORE_RATE_WINDOW_MS) {
+            publishRate = (uint32_t)((uint64_t)windowPublished * 1000 / (now - windowStartMs));
+            windowPublished = 0;
+            windowStartMs = now;
+        }
+        return written;
+    }
+
+    uint16_t getInputRegister(uint16_t address) const {
+        return address < REGISTER_STORE_INPUT_REGISTERS ? inputRegisters[address] : 0;
+    }
+
+    uint32_t getVersion() const { return version; }
+    uint32_t getTotalPublished() const { return totalPublished; }
+    uint32_t getPublishRate() const { return publishRate; }
+};
@@ -0,0 +1,566 @@
+#pragma once
+
+#include <Arduino.h>
+#include "sys_init.h"
+#include "timer_wheel.h"
+
+/**
+ * Rule Engine - compiled form of the per-pin I/O automation rules
+ *
+ * compile() runs whenever the I/O configuration is loaded or posted and
+ * flattens the enabled rules of every output pin into one table, grouped by
+ * pin and sorted by priority within a pin (ties keep their configured order).
+ * Every register a clause reads becomes one watched register, with a reverse
+ * index from the register to the rules that depend on it:
+ *
+ *   scan()          one read per watched register; a changed value marks
+ *                   its dependent rules (and their pins) dirty
+ *   evaluate()      conditions of a dirty rule, from the values read by scan();
+ *                   a clean rule returns its cached result
+ *   condition()     evaluate() after the rule's on/off delay; this is what
+ *                   the actions act on
+ *
+ * Time-based behaviour runs off one TimerWheel, two timers per rule:
+ *
+ *   DELAY   a pending on-delay or off-delay; armed when the raw conditions
+ *           change, cancelled if they change back before it expires
+ *   PULSE   end of a PULSE_OUTPUT; startPulse() arms it, processTimers()
+ *           hands the expired rule back to main.cpp to restore the output
+ *
+ * processTimers() runs once per pass and costs only the timers that expire,
+ * so waiting rules are never polled. A clause with a hysteresis band, once
+ * met, stays met until its register is back past the trigger value by the
+ * band (>, >= and <, <= only).
+ *
+ * evaluateIOAutomationRules() walks only dirty pins, so a pass where no input
+ * changed costs one read per distinct register and nothing else. Anything
+ * that changes an output behind the rules' back (web UI, override unlock)
+ * calls markPinDirty() so the pin's rules are applied again.
+ *
+ * Global rules (IOConfig::globalRules) compile into a group of their own
+ * after the pin groups, also sorted by priority, with action.targetPins
+ * resolved to output pin indices. They are not tied to a pin's dirty flag:
+ * evaluateIOAutomationRules() walks the whole group on a fixed period and
+ * resolves conflicts between them through claim():
+ *
+ *   beginClaims()   start of a global scan
+ *   claim()         first rule (in priority order) to act on a pin this
+ *                   scan owns it; later ones are refused and counted
+ *
+ * Indices refer to ioConfig.pins[], IOPin::rules[] and globalRules[], which
+ * compile() leaves in their configured order. Core 0 only.
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+static const uint8_t RULE_ENGINE_RULES_PER_PIN = 5;   // IOPin::rules[5]
+static const uint8_t RULE_ENGINE_MAX_CLAUSES = 3;     // IOTrigger::conditions[3]
+static const uint16_t RULE_ENGINE_CAPACITY = MAX_IO_PINS * RULE_ENGINE_RULES_PER_PIN + MAX_IO_RULES;
+static const uint16_t RULE_ENGINE_MAX_REFERENCES = RULE_ENGINE_CAPACITY * RULE_ENGINE_MAX_CLAUSES;
+
+// Window over which evaluations per second are measured
+static const uint32_t RULE_ENGINE_RATE_WINDOW_MS = 1000;
+
+// CompiledRule::pinIndex of a global rule
+static const uint8_t RULE_ENGINE_GLOBAL = 0xFF;
+static const uint16_t RULE_ENGINE_NO_CLAIM = 0xFFFF;
+
+// Timers per rule: timer id = rule * RULE_TIMER_KINDS + kind
+static const uint8_t RULE_TIMER_DELAY = 0;
+static const uint8_t RULE_TIMER_PULSE = 1;
+static const uint8_t RULE_TIMER_KINDS = 2;
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+typedef int32_t (*RuleRegisterReader)(uint16_t address);
+
+struct CompiledRule;
+typedef void (*RulePulseHandler)(const CompiledRule& rule);
+
+struct CompiledClause {
+    uint16_t watch;                // Index into the watched registers
+    TriggerCondition condition;
+    int32_t triggerValue;
+    LogicOperator nextOperator;
+    int32_t hysteresis;
+    bool met;                      // Result at the last evaluation, selects the hysteresis edge
+};
+
+struct CompiledRule {
+    uint8_t pinIndex;              // ioConfig.pins[], RULE_ENGINE_GLOBAL for a global rule
+    uint8_t ruleIndex;             // IOPin::rules[] or IOConfig::globalRules[]
+    uint8_t priority;
+    uint8_t clauseCount;
+    CompiledClause clauses[RULE_ENGINE_MAX_CLAUSES];
+    bool dirty;
+    bool result;                   // Conditions at the last evaluation
+    uint32_t onDelayMs;
+    uint32_t offDelayMs;
+    bool state;                    // result, after the on/off delay
+    uint8_t targets[IO_RULE_MAX_TARGETS];  // Output pin indices driven (a pin rule: its own pin)
+    uint8_t targetCount;
+    uint8_t pulseDriven;           // Bit t: targets[t] is being pulsed
+    uint8_t pulseRestore;          // Bit t: state of targets[t] to return to when the pulse ends
+};
+
+/**
+ * Rules of one pin: table[first .. first + count - 1], priority order
+ */
+struct CompiledPin {
+    uint16_t first;
+    uint8_t count;
+    bool dirty;
+};
+
+struct WatchedRegister {
+    uint16_t address;
+    int32_t value;
+    uint16_t firstDependent;       // Into dependents[]
+    uint16_t dependentCount;
+};
+
+struct RuleEngineStats {
+    uint32_t scans;
+    uint32_t evaluations;          // Rule conditions evaluated
+    uint32_t skipped;              // Rules passed over because no input changed
+    uint32_t registerReads;
+    uint32_t changedRegisters;
+    uint32_t evaluationsPerSecond; // Over the last RULE_ENGINE_RATE_WINDOW_MS
+    uint32_t skippedPerSecond;
+    uint32_t lastCompileMs;
+    uint32_t delayedChanges;       // Condition changes applied by an expired on/off delay
+    uint32_t delaysCancelled;      // Delays abandoned because the conditions changed back
+    uint32_t pulsesCompleted;
+    uint32_t conflicts;            // Global rule actions refused because a higher-priority rule owned the pin
+};
+
+// ============================================================================
+// RULE ENGINE CLASS
+// ============================================================================
+
+class RuleEngine {
+private:
+    CompiledRule table[RULE_ENGINE_CAPACITY];
+    uint16_t ruleCount;
+    CompiledPin pins[MAX_IO_PINS];
+    uint8_t pinCount;
+    uint16_t globalFirst;          // Global rules: table[globalFirst .. globalFirst + globalCount - 1]
+    uint16_t globalCount;
+    uint16_t claimedBy[MAX_IO_PINS];   // Rule owning each pin in the current global scan
+
+    WatchedRegister watched[RULE_ENGINE_MAX_REFERENCES];
+    uint16_t watchedCount;
+    uint16_t dependents[RULE_ENGINE_MAX_REFERENCES];   // Rule indices, grouped per watched register
+    bool primed;                   // Watched values hold a first read
+
+    TimerWheel<RULE_ENGINE_CAPACITY * RULE_TIMER_KINDS> timers;
+
+    RuleEngineStats stats;
+    uint32_t windowStartMs;
+    uint32_t windowEvaluations;
+    uint32_t windowSkipped;
+
+    uint16_t watchIndex(uint16_t address) {
+        for (uint16_t w = 0; w < watchedCount; w++) {
+            if (watched[w].address == address) return w;
+        }
+        watched[watchedCount].address = address;
+        watched[watchedCount].value = 0;
+        watched[watchedCount].dependentCount = 0;
+        return watchedCount++;
+    }
+
+    void markRuleDirty(uint16_t r) {
+        table[r].dirty = true;
+        if (table[r].pinIndex != RULE_ENGINE_GLOBAL) pins[table[r].pinIndex].dirty = true;
+    }
+
+    /**
+     * Insert `rule` into the group starting at table[first] by priority
+     * (equal priorities stay in configured order)
+     * @return where it landed, or -1 if the table is full
+     */
+    int16_t insertRule(const IORule& rule, uint16_t first, uint8_t pinIndex, uint8_t ruleIndex) {
+        if (ruleCount >= RULE_ENGINE_CAPACITY) return -1;
+        uint16_t at = ruleCount;
+        while (at > first && table[at - 1].priority > rule.priority) {
+            table[at] = table[at - 1];
+            at--;
+        }
+        CompiledRule& compiled = table[at];
+        compiled.pinIndex = pinIndex;
+        compiled.ruleIndex = ruleIndex;
+        compiled.priority = rule.priority;
+        compiled.clauseCount = rule.trigger.conditionCount < RULE_ENGINE_MAX_CLAUSES
+                             ? rule.trigger.conditionCount : RULE_ENGINE_MAX_CLAUSES;
+        for (uint8_t c = 0; c < compiled.clauseCount; c++) {
+            const ConditionClause& clause = rule.trigger.conditions[c];
+            compiled.clauses[c].watch = watchIndex(clause.modbusRegister);
+            compiled.clauses[c].condition = clause.condition;
+            compiled.clauses[c].triggerValue = clause.triggerValue;
+            compiled.clauses[c].nextOperator = clause.nextOperator;
+            compiled.clauses[c].hysteresis = clause.hysteresis > 0 ? clause.hysteresis : 0;
+            compiled.clauses[c].met = false;
+        }
+        compiled.dirty = true;
+        compiled.result = false;
+        compiled.onDelayMs = rule.trigger.onDelayMs;
+        compiled.offDelayMs = rule.trigger.offDelayMs;
+        compiled.state = false;
+        compiled.targetCount = 0;
+        compiled.pulseDriven = 0;
+        compiled.pulseRestore = 0;
+        ruleCount++;
+        return at;
+    }
+
+    // Index of the output pin with GP number `gpPin`, or -1
+    static int16_t outputPinIndex(const IOConfig& config, uint8_t pinCount, uint8_t gpPin) {
+        for (uint8_t p = 0; p < pinCount; p++) {
+            if (config.pins[p].gpPin == gpPin && !config.pins[p].isInput) return p;
+        }
+        return -1;
+    }
+
+    static uint16_t timerId(uint16_t r, uint8_t kind) {
+        return r * RULE_TIMER_KINDS + kind;
+    }
+
+    // A met clause only clears once the value is `hysteresis` back past the trigger
+    static bool clauseMet(const CompiledClause& clause, int32_t value) {
+        int32_t triggerValue = clause.triggerValue;
+        if (clause.met && clause.hysteresis > 0) {
+            switch (clause.condition) {
+                case TriggerCondition::GREATER_THAN:
+                case TriggerCondition::GREATER_EQUAL:
+                    triggerValue -= clause.hysteresis;
+                    break;
+                case TriggerCondition::LESS_THAN:
+                case TriggerCondition::LESS_EQUAL:
+                    triggerValue += clause.hysteresis;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return compare(value, clause.condition, triggerValue);
+    }
+
+    static bool compare(int32_t value, TriggerCondition condition, int32_t triggerValue) {
+        switch (condition) {
+            case TriggerCondition::EQUAL:         return value == triggerValue;
+            case TriggerCondition::NOT_EQUAL:     return value != triggerValue;
+            case TriggerCondition::LESS_THAN:     return value < triggerValue;
+            case TriggerCondition::GREATER_THAN:  return value > triggerValue;
+            case TriggerCondition::LESS_EQUAL:    return value <= triggerValue;
+            case TriggerCondition::GREATER_EQUAL: return value >= triggerValue;
+        }
+        return false;
+    }
+
+public:
+    RuleEngine() : ruleCount(0), pinCount(0), globalFirst(0), globalCount(0), watchedCount(0), primed(false),
+                   windowStartMs(0), windowEvaluations(0), windowSkipped(0) {
+        memset(&stats, 0, sizeof(stats));
+        beginClaims();
+    }
+
+    /**
+     * Rebuild the rule table and register index from the configuration
+     * Every rule starts dirty, so the first scan applies all of them.
+     * Pending delays and pulses are dropped.
+     */
+    void compile(const IOConfig& config) {
+        timers.clear();
+        ruleCount = 0;
+        watchedCount = 0;
+        pinCount = config.pinCount < MAX_IO_PINS ? config.pinCount : MAX_IO_PINS;
+
+        for (uint8_t p = 0; p < pinCount; p++) {
+            const IOPin& pin = config.pins[p];
+            pins[p].first = ruleCount;
+            pins[p].count = 0;
+            pins[p].dirty = false;
+            if (pin.isInput) continue;
+
+            uint8_t rules = pin.ruleCount < RULE_ENGINE_RULES_PER_PIN ? pin.ruleCount : RULE_ENGINE_RULES_PER_PIN;
+            for (uint8_t j = 0; j < rules; j++) {
+                if (!pin.rules[j].enabled) continue;
+                int16_t r = insertRule(pin.rules[j], pins[p].first, p, j);
+                if (r < 0) break;
+                // A pin rule drives its own pin
+                table[r].targets[0] = p;
+                table[r].targetCount = 1;
+                pins[p].count++;
+            }
+            pins[p].dirty = pins[p].count > 0;
+        }
+
+        globalFirst = ruleCount;
+        globalCount = 0;
+        uint8_t globals = config.globalRuleCount < MAX_IO_RULES ? config.globalRuleCount : MAX_IO_RULES;
+        for (uint8_t j = 0; j < globals; j++) {
+            const IORule& rule = config.globalRules[j];
+            if (!rule.enabled) continue;
+
+            // Resolve the targets first; a rule that drives no configured output is dropped
+            uint8_t targets[IO_RULE_MAX_TARGETS];
+            uint8_t targetCount = 0;
+            for (uint8_t t = 0; t < rule.action.targetCount && t < IO_RULE_MAX_TARGETS; t++) {
+                int16_t p = outputPinIndex(config, pinCount, rule.action.targetPins[t]);
+                if (p >= 0) targets[targetCount++] = (uint8_t)p;
+            }
+            if (targetCount == 0) continue;
+
+            int16_t r = insertRule(rule, globalFirst, RULE_ENGINE_GLOBAL, j);
+            if (r < 0) break;
+            memcpy(table[r].targets, targets, targetCount);
+            table[r].targetCount = targetCount;
+            globalCount++;
+        }
+        beginClaims();
+
+        // Reverse index: count the references, lay out the groups, then fill them
+        for (uint16_t r = 0; r < ruleCount; r++) {
+            for (uint8_t c = 0; c < table[r].clauseCount; c++) {
+                watched[table[r].clauses[c].watch].dependentCount++;
+            }
+        }
+        uint16_t offset = 0;
+        for (uint16_t w = 0; w < watchedCount; w++) {
+            watched[w].firstDependent = offset;
+            offset += watched[w].dependentCount;
+            watched[w].dependentCount = 0;
+        }
+        for (uint16_t r = 0; r < ruleCount; r++) {
+            for (uint8_t c = 0; c < table[r].clauseCount; c++) {
+                WatchedRegister& w = watched[table[r].clauses[c].watch];
+                // A rule reading the same register twice is listed once
+                if (w.dependentCount > 0 && dependents[w.firstDependent + w.dependentCount - 1] == r) continue;
+                dependents[w.firstDependent + w.dependentCount++] = r;
+            }
+        }
+
+        primed = false;
+        stats.lastCompileMs = millis();
+    }
+
+    /**
+     * Read every watched register once and mark the dependents of changed ones
+     */
+    void scan(RuleRegisterReader read, uint32_t nowMs) {
+        for (uint16_t w = 0; w < watchedCount; w++) {
+            int32_t value = read(watched[w].address);
+            stats.registerReads++;
+            if (primed && value == watched[w].value) continue;
+            watched[w].value = value;
+            if (!primed) continue;  // Everything is dirty after compile() anyway
+            stats.changedRegisters++;
+            for (uint16_t d = 0; d < watched[w].dependentCount; d++) {
+                markRuleDirty(dependents[watched[w].firstDependent + d]);
+            }
+        }
+        primed = true;
+        stats.scans++;
+
+        uint32_t elapsed = nowMs - windowStartMs;
+        if (elapsed >= RULE_ENGINE_RATE_WINDOW_MS) {
+            stats.evaluationsPerSecond = (stats.evaluations - windowEvaluations) * 1000UL / elapsed;
+            stats.skippedPerSecond = (stats.skipped - windowSkipped) * 1000UL / elapsed;
+            windowStartMs = nowMs;
+            windowEvaluations = stats.evaluations;
+            windowSkipped = stats.skipped;
+        }
+    }
+
+    /**
+     * Condition result of table[r]; evaluated only if an input changed
+     */
+    bool evaluate(uint16_t r) {
+        CompiledRule& rule = table[r];
+        if (!rule.dirty) return rule.result;
+
+        bool met = false;
+        for (uint8_t c = 0; c < rule.clauseCount; c++) {
+            CompiledClause& clause = rule.clauses[c];
+            clause.met = clauseMet(clause, watched[clause.watch].value);
+            if (c == 0) {
+                met = clause.met;
+            } else if (rule.clauses[c - 1].nextOperator == LogicOperator::AND) {
+                met = met && clause.met;
+            } else {
+                met = met || clause.met;
+            }
+        }
+        rule.result = met;
+        rule.dirty = false;
+        stats.evaluations++;
+        return met;
+    }
+
+    /**
+     * Condition of table[r] as the actions see it: evaluate() delayed by the
+     * rule's on-delay (to TRUE) or off-delay (to FALSE)
+     */
+    bool condition(uint16_t r, uint32_t nowMs) {
+        CompiledRule& rule = table[r];
+        bool raw = evaluate(r);
+        uint16_t timer = timerId(r, RULE_TIMER_DELAY);
+
+        if (raw == rule.state) {
+            if (timers.isArmed(timer)) {
+                timers.cancel(timer);
+                stats.delaysCancelled++;
+            }
+            return rule.state;
+        }
+        uint32_t delayMs = raw ? rule.onDelayMs : rule.offDelayMs;
+        if (delayMs == 0) {
+            rule.state = raw;
+        } else if (!timers.isArmed(timer)) {
+            timers.schedule(timer, nowMs + delayMs, nowMs);
+        }
+        return rule.state;
+    }
+
+    /**
+     * Start (or restart) the pulse of table[r] on the targets in `driven`
+     * `current` holds their states before this pulse (bit t: targets[t]);
+     * a retrigger while pulsing keeps the states saved by the first one.
+     */
+    void startPulse(uint16_t r, uint8_t driven, uint8_t current, uint32_t durationMs, uint32_t nowMs) {
+        CompiledRule& rule = table[r];
+        uint16_t timer = timerId(r, RULE_TIMER_PULSE);
+        if (!timers.isArmed(timer)) {
+            rule.pulseDriven = 0;
+            rule.pulseRestore = 0;
+        }
+        uint8_t added = driven & ~rule.pulseDriven;
+        rule.pulseRestore |= current & added;
+        rule.pulseDriven |= added;
+        timers.schedule(timer, nowMs + durationMs, nowMs);
+    }
+
+    bool isPulsing(uint16_t r) const {
+        return timers.isArmed(timerId(r, RULE_TIMER_PULSE));
+    }
+
+    /**
+     * Fire the timers due by nowMs: expired delays take effect (and mark
+     * their pin dirty), expired pulses go to onPulseEnd
+     */
+    void processTimers(uint32_t nowMs, RulePulseHandler onPulseEnd) {
+        timers.advance(nowMs, [this, onPulseEnd](uint16_t id) {
+            uint16_t r = id / RULE_TIMER_KINDS;
+            if (id % RULE_TIMER_KINDS == RULE_TIMER_DELAY) {
+                table[r].state = table[r].result;
+                if (table[r].pinIndex != RULE_ENGINE_GLOBAL) pins[table[r].pinIndex].dirty = true;
+                stats.delayedChanges++;
+            } else {
+                stats.pulsesCompleted++;
+                if (onPulseEnd) onPulseEnd(table[r]);
+            }
+        });
+    }
+
+    // Milliseconds left on a rule's pending delay / running pulse (0 if none)
+    uint32_t delayRemainingMs(uint16_t r, uint32_t nowMs) const {
+        return timers.remainingMs(timerId(r, RULE_TIMER_DELAY), nowMs);
+    }
+    uint32_t pulseRemainingMs(uint16_t r, uint32_t nowMs) const {
+        return timers.remainingMs(timerId(r, RULE_TIMER_PULSE), nowMs);
+    }
+
+    /**
+     * Start of a global scan: every pin is unclaimed
+     */
+    void beginClaims() {
+        for (uint8_t p = 0; p < MAX_IO_PINS; p++) claimedBy[p] = RULE_ENGINE_NO_CLAIM;
+    }
+
+    /**
+     * Rule r wants to drive pin p this global scan
+     * Rules are walked in priority order, so the first claim wins; the rule
+     * that already owns the pin may claim it again.
+     */
+    bool claim(uint8_t p, uint16_t r) {
+        if (p >= MAX_IO_PINS) return false;
+        if (claimedBy[p] == RULE_ENGINE_NO_CLAIM || claimedBy[p] == r) {
+            claimedBy[p] = r;
+            return true;
+        }
+        stats.conflicts++;
+        return false;
+    }
+
+    // Rule that owns pin p in the current global scan, RULE_ENGINE_NO_CLAIM if none
+    uint16_t getClaim(uint8_t p) const {
+        return p < MAX_IO_PINS ? claimedBy[p] : RULE_ENGINE_NO_CLAIM;
+    }
+
+    /**
+     * Compiled index of ioConfig.globalRules[j], or -1 if it is not compiled
+     */
+    int16_t findGlobalRule(uint8_t j) const {
+        for (uint16_t r = globalFirst; r < globalFirst + globalCount; r++) {
+            if (table[r].ruleIndex == j) return r;
+        }
+        return -1;
+    }
+
+    /**
+     * Compiled index of ioConfig.pins[p].rules[j], or -1 if it is not compiled
+     */
+    int16_t findRule(uint8_t p, uint8_t j) const {
+        if (p >= pinCount) return -1;
+        for (uint16_t r = pins[p].first; r < pins[p].first + pins[p].count; r++) {
+            if (table[r].ruleIndex == j) return r;
+        }
+        return -1;
+    }
+
+    /**
+     * Pin has a rule to apply this pass; clears the pin's flag
+     * Clean pins are counted as skipped evaluations.
+     */
+    bool takePinDirty(uint8_t p) {
+        if (p >= pinCount || pins[p].count == 0) return false;
+        if (!pins[p].dirty) {
+            stats.skipped += pins[p].count;
+            return false;
+        }
+        pins[p].dirty = false;
+        for (uint16_t r = pins[p].first; r < pins[p].first + pins[p].count; r++) {
+            if (!table[r].dirty) stats.skipped++;
+        }
+        return true;
+    }
+
+    // Apply the pin's rules again on the next pass (output changed outside the rules)
+    void markPinDirty(uint8_t p) {
+        if (p < pinCount && pins[p].count > 0) pins[p].dirty = true;
+    }
+
+    // Value of a watched register as read by the last scan()
+    int32_t getValue(uint16_t watch) const {
+        return watch < watchedCount ? watched[watch].value : 0;
+    }
+
+    const CompiledPin& getPin(uint8_t p) const { return pins[p < MAX_IO_PINS ? p : 0]; }
+    const CompiledRule& getRule(uint16_t r) const { return table[r < RULE_ENGINE_CAPACITY ? r : 0]; }
+    uint16_t getRuleCount() const { return ruleCount; }
+    uint16_t getGlobalFirst() const { return globalFirst; }
+    uint16_t getGlobalCount() const { return globalCount; }
+    uint16_t getWatchedCount() const { return watchedCount; }
+    const RuleEngineStats& getStats() const { return stats; }
+    uint16_t getArmedTimers() const { return timers.getArmedCount(); }
+    uint32_t getTimersFired() const { return timers.getFiredCount(); }
+    uint32_t getTimerNodesVisited() const { return timers.getVisitedCount(); }
+};
+
+// Global instance
+extern RuleEngine ruleEngine;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Arduino.h>
+#include "sensor_types.h"
+
+/**
+ * Sensor Driver - per-type measurement interface and registry
+ *
+ * Every supported sensor type is a SensorDriver: a small table of function
+ * pointers for the phases of one measurement plus the metadata the pollers
+ * plan with (conversion time, bus occupancy, Modbus output channels).
+ *
+ *   begin      one-time device setup (optional)
+ *   trigger    start a measurement, never waits for the result
+ *   pollReady  checked once the conversion time has elapsed (optional):
+ *              PENDING extends the wait, OK proceeds to collect
+ *   collect    read the raw result bytes from the bus
+ *   decode     raw bytes -> engineering units -> calibrated channels
+ *
+ * The driver is resolved once per sensor from its type and protocol when the
+ * configuration is applied (SensorConfig::driver), so the polling paths make
+ * one indirect call per phase instead of comparing types. A new sensor type
+ * adds a driver and a registry entry; the pollers do not change.
+ *
+ * Drivers run on core 1 only (see loop1()).
+ */
+
+struct SensorConfig;
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+enum class DriverStatus : uint8_t {
+    OK = 0,
+    PENDING,          // Device still converting, try again later
+    ERROR_BUS,        // No ACK / no presence pulse / transmission failed
+    ERROR_READ,       // Device answered with no or invalid data
+    ERROR_UNSUPPORTED // No driver (or phase) for this sensor
+};
+
+// Largest raw result a driver collects (UART lines; I2C responses are at most 32 bytes)
+static const uint8_t SENSOR_READING_MAX_BYTES = 128;
+
+/**
+ * Raw result handed from collect to decode
+ */
+struct SensorReading {
+    uint8_t data[SENSOR_READING_MAX_BYTES];
+    uint8_t length;
+};
+
+struct SensorDriver {
+    const char* name;
+    SensorProtocol protocol;
+    uint8_t outputChannels;   // Consecutive Modbus input registers (channels A-C, then any feature block)
+    uint16_t conversionMs;    // Declared wait between trigger and collect (0 = collect in the same pass)
+    uint16_t busTimeUs;       // Approximate bus occupancy of one trigger + collect
+    bool streaming;           // Collect drains a window over many passes; kept out of batch rounds
+
+    bool (*begin)(SensorConfig& sensor);
+    DriverStatus (*trigger)(SensorConfig& sensor);
+    DriverStatus (*pollReady)(SensorConfig& sensor);
+    DriverStatus (*collect)(SensorConfig& sensor, SensorReading& reading);
+    void (*decode)(SensorConfig& sensor, const SensorReading& reading);
+
+    // Per-sensor conversion time; nullptr = conversionMs, or delayBeforeRead if set and conversionMs > 0
+    uint32_t (*conversionTime)(const SensorConfig& sensor);
+};
+
+// ============================================================================
+// REGISTRY (defined with the drivers in main.cpp)
+// ============================================================================
+
+/**
+ * Driver for a type/protocol pair (configuration time only)
+ * Types without a dedicated driver on the given bus get that bus's generic
+ * driver; nullptr if the bus has none (analog, digital sensors).
+ */
+const SensorDriver* resolveSensorDriver(SensorType type, SensorProtocol protocol);
+
+/**
+ * Wait between trigger and collect for a configured sensor
+ */
+uint32_t getSensorConversionMs(const SensorConfig& sensor);
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Sensor Scheduler - deadline queue for sensor measurement phases
+ *
+ * Every enabled sensor has at most one pending entry: its next TRIGGER, or the
+ * COLLECT that follows a trigger once the conversion time has elapsed. The
+ * entries live in a binary min-heap keyed on their due time, so the poller
+ * only ever looks at the root:
+ *
+ *   peekDue()            O(1)       nothing due -> loop1() returns immediately
+ *   schedule()/popDue()  O(log n)   insert, move or remove one sensor's entry
+ *
+ * A sensor's position in the heap is tracked in slot[], so rescheduling a
+ * sensor moves its existing entry instead of searching for it.
+ *
+ * Triggers are planned from the previous planned trigger time, not from when
+ * the trigger actually ran, so lateness does not accumulate into the polling
+ * period. Planned time, actual dispatch time and lateness are recorded per
+ * sensor for /api/scheduler.
+ *
+ * Batch rounds: when a trigger falls due, the poller also takes every other
+ * trigger due within the batch window (popEarlyTrigger()), sends them
+ * back-to-back and collects the whole round once the longest conversion has
+ * elapsed. Slow converters (EZO ~900 ms, DS18B20 750 ms) then overlap, and a
+ * round takes about the longest conversion time instead of their sum. Round
+ * membership and durations are tracked here (beginRound() / finishRoundMember()).
+ * Sensors marked solo (setSolo(), streaming drivers that drain a window over
+ * many passes) never join a round and are dispatched on their own.
+ *
+ * Core 1 only (see loop1()); core 0 reads the statistics with core 1 paused.
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+// Spacing of the first triggers after (re)configuration, so sensors sharing a
+// bus do not all fall due in the same pass
+static const uint32_t SENSOR_SCHEDULER_STAGGER_MS = 10;
+
+// Shortest polling interval; a smaller updateInterval would keep a sensor's
+// trigger permanently due
+static const uint32_t SENSOR_SCHEDULER_MIN_INTERVAL_MS = 100;
+
+// Triggers due within this window of a due trigger join its batch round
+// (0 disables batching: every sensor is triggered and collected on its own)
+static const uint32_t SENSOR_BATCH_WINDOW_MS = 100;
+
+// Sized for MAX_SENSORS (sys_init.h)
+static const uint8_t SENSOR_SCHEDULER_CAPACITY = 10;
+
+static const uint8_t SENSOR_ROUND_NONE = 0xFF;
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+enum class SchedulePhase : uint8_t {
+    TRIGGER = 0,
+    COLLECT = 1
+};
+
+struct ScheduleEntry {
+    uint32_t dueMs;
+    uint8_t sensorIndex;
+    SchedulePhase phase;
+};
+
+/**
+ * Timing of the most recent dispatch of one sensor
+ */
+struct SensorScheduleStats {
+    uint32_t plannedMs;        // Due time of the last dispatched entry
+    uint32_t actualMs;         // When it was dispatched
+    uint32_t latenessMs;       // actualMs - plannedMs
+    uint32_t maxLatenessMs;
+    uint32_t totalLatenessMs;  // Sum over all dispatches (average = total / dispatches)
+    uint32_t dispatches;
+    SchedulePhase phase;       // Phase of the last dispatched entry
+};
+
+/**
+ * Duration of batch rounds (first trigger to last completed collect)
+ */
+struct SensorRoundStats {
+    uint32_t rounds;               // Completed rounds
+    uint32_t lastDurationMs;
+    uint32_t maxDurationMs;
+    uint8_t lastSensors;           // Members of the last completed round
+    uint32_t lastConversionSumMs;  // Sum of member conversion times (one-at-a-time cost)
+    uint32_t lastConversionMaxMs;  // Longest member conversion time
+};
+
+// ============================================================================
+// SENSOR SCHEDULER CLASS
+// ============================================================================
+
+class SensorScheduler {
+private:
+    static const uint8_t NO_SLOT = 0xFF;
+
+    ScheduleEntry heap[SENSOR_SCHEDULER_CAPACITY];
+    uint8_t count;
+    uint8_t slot[SENSOR_SCHEDULER_CAPACITY];        // Heap position per sensor, NO_SLOT if idle
+    uint32_t anchorMs[SENSOR_SCHEDULER_CAPACITY];   // Planned time of the last trigger
+    bool deferred[SENSOR_SCHEDULER_CAPACITY];       // Pending trigger is a retry (keeps the anchor)
+    bool solo[SENSOR_SCHEDULER_CAPACITY];           // Never joins a batch round
+    SensorScheduleStats stats[SENSOR_SCHEDULER_CAPACITY];
+
+    // Batch rounds in flight; at most one per sensor
+    struct Round {
+        bool active;
+        uint32_t startMs;
+        uint8_t outstanding;       // Members whose measurement has not finished
+        uint8_t sensors;
+        uint32_t conversionSumMs;
+        uint32_t conversionMaxMs;
+    };
+    Round rounds[SENSOR_SCHEDULER_CAPACITY];
+    uint8_t roundOf[SENSOR_SCHEDULER_CAPACITY];     // Round per sensor, SENSOR_ROUND_NONE if none
+    SensorRoundStats roundStats;
+    uint32_t batchWindowMs;
+
+    // Wrap-safe "a is due before b"
+    static bool earlier(uint32_t a, uint32_t b) {
+        return (int32_t)(a - b) < 0;
+    }
+
+    void place(uint8_t position, const ScheduleEntry& entry) {
+        heap[position] = entry;
+        slot[entry.sensorIndex] = position;
+    }
+
+    void siftUp(uint8_t position) {
+        ScheduleEntry entry = heap[position];
+        while (position > 0) {
+            uint8_t parent = (position - 1) / 2;
+            if (!earlier(entry.dueMs, heap[parent].dueMs)) break;
+            place(position, heap[parent]);
+            position = parent;
+        }
+        place(position, entry);
+    }
+
+    void siftDown(uint8_t position) {
+        ScheduleEntry entry = heap[position];
+        while (true) {
+            uint8_t child = 2 * position + 1;
+            if (child >= count) break;
+            if (child + 1 < count && earlier(heap[child + 1].dueMs, heap[child].dueMs)) {
+                child++;
+            }
+            if (!earlier(heap[child].dueMs, entry.dueMs)) break;
+            place(position, heap[child]);
+            position = child;
+        }
+        place(position, entry);
+    }
+
+    // Remove the root and record its timing (lateness 0 if taken early)
+    void popRoot(uint32_t nowMs, ScheduleEntry& out) {
+        out = heap[0];
+        removeAt(0);
+
+        SensorScheduleStats& s = stats[out.sensorIndex];
+        s.plannedMs = out.dueMs;
+        s.actualMs = nowMs;
+        s.latenessMs = earlier(nowMs, out.dueMs) ? 0 : nowMs - out.dueMs;
+        if (s.latenessMs > s.maxLatenessMs) s.maxLatenessMs = s.latenessMs;
+        s.totalLatenessMs += s.latenessMs;
+        s.dispatches++;
+        s.phase = out.phase;
+
+        if (out.phase == SchedulePhase::TRIGGER && !deferred[out.sensorIndex]) {
+            anchorMs[out.sensorIndex] = out.dueMs;
+        }
+        deferred[out.sensorIndex] = false;
+    }
+
+    void removeAt(uint8_t position) {
+        slot[heap[position].sensorIndex] = NO_SLOT;
+        count--;
+        if (position == count) return;
+        place(position, heap[count]);
+        if (position > 0 && earlier(heap[position].dueMs, heap[(position - 1) / 2].dueMs)) {
+            siftUp(position);
+        } else {
+            siftDown(position);
+        }
+    }
+
+    // Drop one reference; closes the round and records it when none remain
+    void releaseRound(uint8_t round, uint32_t nowMs) {
+        Round& r = rounds[round];
+        if (!r.active) return;
+        if (r.outstanding > 0) r.outstanding--;
+        if (r.outstanding > 0) return;
+
+        r.active = false;
+        if (r.sensors == 0) return;
+        roundStats.rounds++;
+        roundStats.lastDurationMs = nowMs - r.startMs;
+        if (roundStats.lastDurationMs > roundStats.maxDurationMs) {
+            roundStats.maxDurationMs = roundStats.lastDurationMs;
+        }
+        roundStats.lastSensors = r.sensors;
+        roundStats.lastConversionSumMs = r.conversionSumMs;
+        roundStats.lastConversionMaxMs = r.conversionMaxMs;
+    }
+
+public:
+    SensorScheduler() : batchWindowMs(SENSOR_BATCH_WINDOW_MS) {
+        clear();
+        resetStats();
+    }
+
+    /**
+     * Drop all pending entries and rounds in flight (statistics are kept)
+     */
+    void clear() {
+        count = 0;
+        memset(slot, NO_SLOT, sizeof(slot));
+        memset(anchorMs, 0, sizeof(anchorMs));
+        memset(deferred, 0, sizeof(deferred));
+        memset(solo, 0, sizeof(solo));
+        memset(rounds, 0, sizeof(rounds));
+        memset(roundOf, SENSOR_ROUND_NONE, sizeof(roundOf));
+    }
+
+    void resetStats() {
+        memset(stats, 0, sizeof(stats));
+        memset(&roundStats, 0, sizeof(roundStats));
+    }
+
+    void setBatchWindow(uint32_t windowMs) { batchWindowMs = windowMs; }
+    uint32_t getBatchWindow() const { return batchWindowMs; }
+
+    /**
+     * Keep a sensor out of batch rounds: its triggers are never taken early
+     * and are dispatched on their own (cleared by clear())
+     */
+    void setSolo(uint8_t sensorIndex, bool isSolo) {
+        if (sensorIndex < SENSOR_SCHEDULER_CAPACITY) solo[sensorIndex] = isSolo;
+    }
+
+    bool isSolo(uint8_t sensorIndex) const {
+        return sensorIndex < SENSOR_SCHEDULER_CAPACITY && solo[sensorIndex];
+    }
+
+    /**
+     * Set a sensor's pending entry, replacing any existing one
+     * @return false if the sensor index is out of range
+     */
+    bool schedule(uint8_t sensorIndex, SchedulePhase phase, uint32_t dueMs) {
+        if (sensorIndex >= SENSOR_SCHEDULER_CAPACITY) return false;
+
+        ScheduleEntry entry = { dueMs, sensorIndex, phase };
+        deferred[sensorIndex] = false;
+        uint8_t position = slot[sensorIndex];
+        if (position == NO_SLOT) {
+            position = count++;
+            place(position, entry);
+            siftUp(position);
+            return true;
+        }
+
+        bool movedEarlier = earlier(dueMs, heap[position].dueMs);
+        place(position, entry);
+        if (movedEarlier) {
+            siftUp(position);
+        } else {
+            siftDown(position);
+        }
+        return true;
+    }
+
+    /**
+     * Plan a sensor's next trigger one interval after its previous planned
+     * trigger; if that time has already passed, trigger as soon as possible
+     */
+    void scheduleNextTrigger(uint8_t sensorIndex, uint32_t intervalMs, uint32_t nowMs) {
+        if (sensorIndex >= SENSOR_SCHEDULER_CAPACITY) return;
+        uint32_t next = anchorMs[sensorIndex] + intervalMs;
+        if (earlier(next, nowMs)) next = nowMs;
+        schedule(sensorIndex, SchedulePhase::TRIGGER, next);
+    }
+
+    /**
+     * Retry a trigger that could not start yet (e.g. its UART is busy with
+     * another sensor's request); the next interval is still planned from the
+     * trigger's original planned time
+     */
+    void deferTrigger(uint8_t sensorIndex, uint32_t dueMs) {
+        if (schedule(sensorIndex, SchedulePhase::TRIGGER, dueMs)) {
+            deferred[sensorIndex] = true;
+        }
+    }
+
+    void remove(uint8_t sensorIndex) {
+        if (sensorIndex >= SENSOR_SCHEDULER_CAPACITY || slot[sensorIndex] == NO_SLOT) return;
+        removeAt(slot[sensorIndex]);
+    }
+
+    bool isScheduled(uint8_t sensorIndex) const {
+        return sensorIndex < SENSOR_SCHEDULER_CAPACITY && slot[sensorIndex] != NO_SLOT;
+    }
+
+    /**
+     * Earliest due time
+     * @return false if nothing is scheduled
+     */
+    bool peekDue(uint32_t& dueMs) const {
+        if (count == 0) return false;
+        dueMs = heap[0].dueMs;
+        return true;
+    }
+
+    /**
+     * Remove the earliest entry if it is due and record its timing
+     * @return false if nothing is due at nowMs
+     */
+    bool popDue(uint32_t nowMs, ScheduleEntry& out) {
+        if (count == 0 || earlier(nowMs, heap[0].dueMs)) return false;
+        popRoot(nowMs, out);
+        return true;
+    }
+
+    /**
+     * Earliest entry, due or not
+     * @return false if nothing is scheduled
+     */
+    bool peekNext(ScheduleEntry& out) const {
+        if (count == 0) return false;
+        out = heap[0];
+        return true;
+    }
+
+    /**
+     * Take the earliest entry ahead of time if it is a trigger due within the
+     * batch window; its next trigger is still planned from its own due time
+     * @return false if batching is off or the next entry does not qualify
+     *         (not a trigger, a solo sensor's trigger, or not due in the window)
+     */
+    bool popEarlyTrigger(uint32_t nowMs, ScheduleEntry& out) {
+        if (batchWindowMs == 0 || count == 0) return false;
+        if (heap[0].phase != SchedulePhase::TRIGGER || solo[heap[0].sensorIndex]) return false;
+        if (earlier(nowMs + batchWindowMs, heap[0].dueMs)) return false;
+        popRoot(nowMs, out);
+        return true;
+    }
+
+    // ========================================================================
+    // BATCH ROUNDS
+    // ========================================================================
+
+    /**
+     * Open a round starting at nowMs
+     * @return round handle, SENSOR_ROUND_NONE if none is free
+     */
+    uint8_t beginRound(uint32_t nowMs) {
+        for (uint8_t r = 0; r < SENSOR_SCHEDULER_CAPACITY; r++) {
+            if (!rounds[r].active) {
+                memset(&rounds[r], 0, sizeof(Round));
+                rounds[r].active = true;
+                rounds[r].startMs = nowMs;
+                rounds[r].outstanding = 1;  // Held open until endRound()
+                return r;
+            }
+        }
+        return SENSOR_ROUND_NONE;
+    }
+
+    /**
+     * Add a triggered sensor to a round
+     */
+    void addToRound(uint8_t round, uint8_t sensorIndex, uint32_t conversionMs) {
+        if (round >= SENSOR_SCHEDULER_CAPACITY || sensorIndex >= SENSOR_SCHEDULER_CAPACITY) return;
+        finishRoundMember(sensorIndex, rounds[round].startMs);  // Leaves a stale round, if any
+        Round& r = rounds[round];
+        r.outstanding++;
+        r.sensors++;
+        r.conversionSumMs += conversionMs;
+        if (conversionMs > r.conversionMaxMs) r.conversionMaxMs = conversionMs;
+        roundOf[sensorIndex] = round;
+    }
+
+    /**
+     * A member's measurement finished (successfully or not); closes the round
+     * and records its duration once every member has finished
+     */
+    void finishRoundMember(uint8_t sensorIndex, uint32_t nowMs) {
+        if (sensorIndex >= SENSOR_SCHEDULER_CAPACITY) return;
+        uint8_t round = roundOf[sensorIndex];
+        if (round == SENSOR_ROUND_NONE) return;
+        roundOf[sensorIndex] = SENSOR_ROUND_NONE;
+
+        releaseRound(round, nowMs);
+    }
+
+    /**
+     * All triggers of the round have been sent
+     */
+    void endRound(uint8_t round, uint32_t nowMs) {
+        if (round < SENSOR_SCHEDULER_CAPACITY) releaseRound(round, nowMs);
+    }
+
+    const SensorRoundStats& getRoundStats() const { return roundStats; }
+
+    /**
+     * Pending entry of a sensor
+     * @return false if the sensor has nothing scheduled
+     */
+    bool getPending(uint8_t sensorIndex, ScheduleEntry& out) const {
+        if (!isScheduled(sensorIndex)) return false;
+        out = heap[slot[sensorIndex]];
+        return true;
+    }
+
+    const SensorScheduleStats& getStats(uint8_t sensorIndex) const {
+        return stats[sensorIndex < SENSOR_SCHEDULER_CAPACITY ? sensorIndex : 0];
+    }
+
+    uint8_t getPendingCount() const { return count; }
+};
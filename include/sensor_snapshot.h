@@ -0,0 +1,272 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <cstring>
+
+/**
+ * Sensor Snapshot - Core 1 -> Core 0 handoff of sensor runtime values
+ *
+ * The sensor subsystem (I2C bus manager, UART and 1-Wire queues, calibration)
+ * runs in setup1()/loop1() on core 1 and is the only writer of the runtime
+ * fields in configuredSensors[]. Core 0 (Modbus, HTTP, automation rules)
+ * never reads those fields directly; it reads a copy published through
+ * SensorSnapshot:
+ *
+ * - Two slots, written alternately by core 1; each publish bumps a
+ *   generation counter and core 0 always reads the most recent slot
+ * - Each slot carries its own sequence word (seqlock), so a reader that
+ *   races a writer recycling the same slot detects it and retries
+ * - Only plain atomic loads/stores and fences are used, which the
+ *   Cortex-M0+ implements without locks (no LDREX/STREX needed)
+ *
+ * Configuration (name, type, pins, registers) is owned by core 0 and only
+ * changed while core 1 is parked through SensorCoreControl::pause().
+ *
+ * Include after sys_init.h (needs SensorConfig and MAX_SENSORS).
+ */
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * Runtime values of one sensor as seen by core 0
+ * Field names match SensorConfig so consumers read the same way
+ */
+struct SensorRuntimeValues {
+    float rawValue;
+    float rawValueB;
+    float rawValueC;
+    float calibratedValue;
+    float calibratedValueB;
+    float calibratedValueC;
+    int modbusValue;
+    int modbusValueB;
+    int modbusValueC;
+    VibrationFeatures vibration;
+    EzoProbeStats ezoStats;
+    unsigned long lastReadTime;
+    char response[64];
+    char rawDataString[128];
+};
+
+// Minimum period between snapshot publishes from core 1
+static const uint32_t SENSOR_SNAPSHOT_PUBLISH_MS = 10;
+
+// ============================================================================
+// SENSOR SNAPSHOT (DOUBLE BUFFER)
+// ============================================================================
+
+class SensorSnapshot {
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;   // Generation stored in this slot, 0 while being written
+        std::atomic<uint8_t> count;
+        SensorRuntimeValues values[MAX_SENSORS];
+    };
+
+    Slot slots[2];
+    std::atomic<uint32_t> publishedGeneration;  // 0 = nothing published yet
+
+    // Core 1 only
+    uint32_t writerGeneration;
+    uint32_t lastPublishMs;
+    std::atomic<uint32_t> publishCount;  // Read by core 0 for stats
+
+public:
+    SensorSnapshot() : publishedGeneration(0), writerGeneration(0), lastPublishMs(0), publishCount(0) {
+        for (uint8_t i = 0; i < 2; i++) {
+            slots[i].sequence.store(0, std::memory_order_relaxed);
+            slots[i].count.store(0, std::memory_order_relaxed);
+            memset(slots[i].values, 0, sizeof(slots[i].values));
+        }
+    }
+
+    /**
+     * Copy the runtime fields of all sensors into the idle slot and publish it
+     * Core 1 only. Never blocks.
+     */
+    void publish(const SensorConfig* sensors, uint8_t count) {
+        if (count > MAX_SENSORS) count = MAX_SENSORS;
+
+        uint32_t generation = writerGeneration + 1;
+        if (generation == 0) generation = 1;  // 0 is reserved for "slot being written"
+        Slot& slot = slots[generation & 1];
+
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.count.store(count, std::memory_order_relaxed);
+        for (uint8_t i = 0; i < count; i++) {
+            const SensorConfig& sensor = sensors[i];
+            SensorRuntimeValues& v = slot.values[i];
+            v.rawValue = sensor.rawValue;
+            v.rawValueB = sensor.rawValueB;
+            v.rawValueC = sensor.rawValueC;
+            v.calibratedValue = sensor.calibratedValue;
+            v.calibratedValueB = sensor.calibratedValueB;
+            v.calibratedValueC = sensor.calibratedValueC;
+            v.modbusValue = sensor.modbusValue;
+            v.modbusValueB = sensor.modbusValueB;
+            v.modbusValueC = sensor.modbusValueC;
+            v.vibration = sensor.vibration;
+            v.ezoStats = sensor.ezoStats;
+            v.lastReadTime = sensor.lastReadTime;
+            memcpy(v.response, sensor.response, sizeof(v.response));
+            v.response[sizeof(v.response) - 1] = '\0';
+            memcpy(v.rawDataString, sensor.rawDataString, sizeof(v.rawDataString));
+            v.rawDataString[sizeof(v.rawDataString) - 1] = '\0';
+        }
+
+        slot.sequence.store(generation, std::memory_order_release);
+        publishedGeneration.store(generation, std::memory_order_release);
+        writerGeneration = generation;
+        lastPublishMs = millis();
+        publishCount.store(publishCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Publish at most every SENSOR_SNAPSHOT_PUBLISH_MS, or immediately if forced
+     * Core 1 only.
+     */
+    void publishIfDue(const SensorConfig* sensors, uint8_t count, bool force = false) {
+        if (force || millis() - lastPublishMs >= SENSOR_SNAPSHOT_PUBLISH_MS) {
+            publish(sensors, count);
+        }
+    }
+
+    /**
+     * Copy the latest published values into `out` if newer than `lastGeneration`
+     * Core 0 only. Lock-free: retries only if core 1 recycled the slot mid-copy.
+     *
+     * @param out Destination array (MAX_SENSORS entries)
+     * @param lastGeneration In/out: generation of the copy already held by the caller
+     * @return true if `out` was refreshed
+     */
+    bool read(SensorRuntimeValues* out, uint32_t& lastGeneration) const {
+        while (true) {
+            uint32_t generation = publishedGeneration.load(std::memory_order_acquire);
+            if (generation == 0 || generation == lastGeneration) return false;
+
+            const Slot& slot = slots[generation & 1];
+            if (slot.sequence.load(std::memory_order_acquire) != generation) continue;
+
+            uint8_t count = slot.count.load(std::memory_order_relaxed);
+            if (count > MAX_SENSORS) continue;
+            memcpy(out, slot.values, count * sizeof(SensorRuntimeValues));
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == generation) {
+                lastGeneration = generation;
+                return true;
+            }
+        }
+    }
+
+    uint32_t getPublishCount() const { return publishCount.load(std::memory_order_relaxed); }
+};
+
+// ============================================================================
+// SENSOR CORE CONTROL
+// ============================================================================
+
+/**
+ * Start gate, pause handshake and liveness heartbeat for core 1
+ *
+ * - Core 1 waits in waitForStart() until core 0 finished setup()
+ * - Core 0 calls pause()/resume() around anything that touches sensor
+ *   configuration or the sensor buses directly (config upload, terminal,
+ *   manual poll); core 1 parks at the next loop1() boundary, so it is never
+ *   stopped in the middle of a bus transaction
+ * - Core 1 bumps a heartbeat every pass; core 0 only feeds the watchdog
+ *   while the heartbeat moves, so a hung sensor core still resets the board
+ */
+class SensorCoreControl {
+private:
+    std::atomic<bool> started;
+    std::atomic<bool> pauseRequested;
+    std::atomic<bool> parked;
+    std::atomic<uint32_t> heartbeat;
+
+    // Core 0 only
+    uint8_t pauseDepth;
+    uint32_t lastHeartbeatSeen;
+    uint32_t lastHeartbeatChangeMs;
+
+public:
+    SensorCoreControl()
+        : started(false), pauseRequested(false), parked(false), heartbeat(0),
+          pauseDepth(0), lastHeartbeatSeen(0), lastHeartbeatChangeMs(0) {}
+
+    /**
+     * Release core 1 (core 0, end of setup())
+     */
+    void start() {
+        lastHeartbeatChangeMs = millis();
+        started.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Block until core 0 has called start() (core 1, setup1())
+     */
+    void waitForStart() const {
+        while (!started.load(std::memory_order_acquire)) {
+            delay(1);
+        }
+    }
+
+    /**
+     * Park core 1 at its next loop boundary and wait until it is parked (core 0)
+     * Nested calls are counted; only the outermost pause/resume pair acts.
+     */
+    void pause() {
+        if (pauseDepth++ > 0) return;
+        pauseRequested.store(true, std::memory_order_release);
+        if (!started.load(std::memory_order_acquire)) return;
+        while (!parked.load(std::memory_order_acquire)) {
+            yield();
+        }
+    }
+
+    /**
+     * Let core 1 continue after pause() (core 0)
+     */
+    void resume() {
+        if (pauseDepth == 0 || --pauseDepth > 0) return;
+        pauseRequested.store(false, std::memory_order_release);
+        lastHeartbeatChangeMs = millis();  // Time spent parked is not a stall
+    }
+
+    /**
+     * Loop boundary on core 1: park here while a pause is requested
+     * @return true if core 1 was parked (configuration may have changed)
+     */
+    bool checkpoint() {
+        heartbeat.store(heartbeat.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (!pauseRequested.load(std::memory_order_acquire)) return false;
+
+        parked.store(true, std::memory_order_release);
+        while (pauseRequested.load(std::memory_order_acquire)) {
+            delayMicroseconds(50);
+        }
+        parked.store(false, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * True while core 1 keeps passing checkpoint() (core 0, before wdt_reset())
+     */
+    bool isAlive(uint32_t stallTimeoutMs) {
+        uint32_t now = millis();
+        uint32_t beat = heartbeat.load(std::memory_order_relaxed);
+        if (beat != lastHeartbeatSeen || !started.load(std::memory_order_acquire)) {
+            lastHeartbeatSeen = beat;
+            lastHeartbeatChangeMs = now;
+            return true;
+        }
+        return now - lastHeartbeatChangeMs < stallTimeoutMs;
+    }
+
+    uint32_t getHeartbeat() const { return heartbeat.load(std::memory_order_relaxed); }
+};
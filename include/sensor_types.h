@@ -0,0 +1,136 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+/**
+ * Sensor Types - interned sensor type, protocol and parsing method
+ *
+ * sensors.json and the web UI identify these by string ("SHT30", "EZO-PH",
+ * "One-Wire", "csv_column", ...). The strings are resolved once to compact
+ * enums when the configuration is applied (applySensorPresets()), and the
+ * polling paths switch on the enums; the strings remain for JSON I/O only.
+ *
+ * SENSOR_TYPE_TABLE holds the accepted spellings and default protocol of each
+ * type. Output channels and conversion times belong to the type's driver
+ * (sensor_driver.h).
+ */
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+enum class SensorType : uint8_t {
+    UNKNOWN = 0,      // No dedicated handling (simulated, analog variants, UART devices, ...)
+    SHT30,
+    BME280,
+    DS18B20,
+    LIS3DH,
+    LIS3DH_SPI,
+    EZO_PH,
+    EZO_EC,
+    EZO_DO,
+    EZO_RTD,
+    EZO_ORP,
+    GENERIC_I2C,
+    GENERIC_UART,
+    GENERIC_ONEWIRE,
+    COUNT
+};
+
+enum class SensorProtocol : uint8_t {
+    NONE = 0,
+    I2C,
+    UART,
+    ONE_WIRE,
+    ANALOG,
+    SPI,
+    DIGITAL
+};
+
+enum class ParsingMethod : uint8_t {
+    RAW = 0,          // Also used for blank and unknown method names
+    CUSTOM_BITS,
+    BIT_FIELD,
+    STATUS_REGISTER,
+    JSON_PATH,
+    CSV_COLUMN
+};
+
+/**
+ * Per-type metadata
+ */
+struct SensorTypeInfo {
+    SensorType type;
+    const char* name;           // Canonical spelling (as sent by the web UI)
+    const char* aliases[2];     // Other accepted spellings, nullptr if unused
+    SensorProtocol defaultProtocol;
+};
+
+// Indexed by SensorType
+static const SensorTypeInfo SENSOR_TYPE_TABLE[] = {
+    { SensorType::UNKNOWN,         "",                {nullptr, nullptr},                SensorProtocol::NONE },
+    { SensorType::SHT30,           "SHT30",           {nullptr, nullptr},                SensorProtocol::I2C },
+    { SensorType::BME280,          "BME280",          {nullptr, nullptr},                SensorProtocol::I2C },
+    { SensorType::DS18B20,         "DS18B20",         {nullptr, nullptr},                SensorProtocol::ONE_WIRE },
+    { SensorType::LIS3DH,          "LIS3DH",          {nullptr, nullptr},                SensorProtocol::I2C },
+    { SensorType::LIS3DH_SPI,      "LIS3DH_SPI",      {nullptr, nullptr},                SensorProtocol::SPI },
+    { SensorType::EZO_PH,          "EZO_PH",          {"EZO-PH", nullptr},               SensorProtocol::I2C },
+    { SensorType::EZO_EC,          "EZO_EC",          {"EZO-EC", nullptr},               SensorProtocol::I2C },
+    { SensorType::EZO_DO,          "EZO_DO",          {"EZO-DO", nullptr},               SensorProtocol::I2C },
+    { SensorType::EZO_RTD,         "EZO_RTD",         {"EZO-RTD", nullptr},              SensorProtocol::I2C },
+    { SensorType::EZO_ORP,         "EZO_ORP",         {"EZO-ORP", nullptr},              SensorProtocol::I2C },
+    { SensorType::GENERIC_I2C,     "GENERIC_I2C",     {"Generic I2C", "GENERIC"},        SensorProtocol::I2C },
+    { SensorType::GENERIC_UART,    "GENERIC_UART",    {nullptr, nullptr},                SensorProtocol::UART },
+    { SensorType::GENERIC_ONEWIRE, "GENERIC_ONEWIRE", {"Generic One-Wire", nullptr},     SensorProtocol::ONE_WIRE },
+};
+
+static_assert(sizeof(SENSOR_TYPE_TABLE) / sizeof(SENSOR_TYPE_TABLE[0]) == (size_t)SensorType::COUNT,
+              "SENSOR_TYPE_TABLE must have one entry per SensorType");
+
+// ============================================================================
+// LOOKUP (configuration time only)
+// ============================================================================
+
+inline const SensorTypeInfo& getSensorTypeInfo(SensorType type) {
+    uint8_t index = (uint8_t)type;
+    return SENSOR_TYPE_TABLE[index < (uint8_t)SensorType::COUNT ? index : 0];
+}
+
+inline SensorType sensorTypeFromString(const char* name) {
+    if (name == nullptr || name[0] == '\0') return SensorType::UNKNOWN;
+    for (uint8_t i = 1; i < (uint8_t)SensorType::COUNT; i++) {
+        const SensorTypeInfo& info = SENSOR_TYPE_TABLE[i];
+        if (strcmp(name, info.name) == 0) return info.type;
+        for (uint8_t a = 0; a < 2; a++) {
+            if (info.aliases[a] != nullptr && strcmp(name, info.aliases[a]) == 0) return info.type;
+        }
+    }
+    return SensorType::UNKNOWN;
+}
+
+// Prefix match, as the polling code always did ("Analog Voltage" -> ANALOG)
+inline SensorProtocol sensorProtocolFromString(const char* name) {
+    if (name == nullptr) return SensorProtocol::NONE;
+    if (strncmp(name, "I2C", 3) == 0) return SensorProtocol::I2C;
+    if (strncmp(name, "UART", 4) == 0) return SensorProtocol::UART;
+    if (strncmp(name, "One-Wire", 8) == 0 || strcmp(name, "ONEWIRE") == 0) return SensorProtocol::ONE_WIRE;
+    if (strncmp(name, "Analog", 6) == 0) return SensorProtocol::ANALOG;
+    if (strncmp(name, "SPI", 3) == 0) return SensorProtocol::SPI;
+    if (strncmp(name, "Digital", 7) == 0) return SensorProtocol::DIGITAL;
+    return SensorProtocol::NONE;
+}
+
+inline ParsingMethod parsingMethodFromString(const char* name) {
+    if (name == nullptr) return ParsingMethod::RAW;
+    if (strcmp(name, "custom_bits") == 0) return ParsingMethod::CUSTOM_BITS;
+    if (strcmp(name, "bit_field") == 0) return ParsingMethod::BIT_FIELD;
+    if (strcmp(name, "status_register") == 0) return ParsingMethod::STATUS_REGISTER;
+    if (strcmp(name, "json_path") == 0) return ParsingMethod::JSON_PATH;
+    if (strcmp(name, "csv_column") == 0) return ParsingMethod::CSV_COLUMN;
+    return ParsingMethod::RAW;
+}
+
+inline bool isEzoSensorType(SensorType type) {
+    return type >= SensorType::EZO_PH && type <= SensorType::EZO_ORP;
+}
@@ -9,6 +9,11 @@
 #include <ArduinoModbus.h>
 #include <ArduinoJson.h>
 #include <LittleFS.h>
+#include "calibration_program.h"
+#include "fixed_point.h"
+#include "vibration_spectrum.h"
+#include "sensor_types.h"
+#include "sensor_driver.h"
 
 #define MAX_SENSORS 10
 
@@ -82,6 +87,7 @@ struct CommandArray {
 #define CONFIG_VERSION 8  // Increment this when config structure changes
 #define HOSTNAME_MAX_LENGTH 32
 #define MAX_MODBUS_CLIENTS 4  // Maximum number of concurrent Modbus clients
+#define MODBUS_HOLDING_REGISTERS 201  // 0-200, so I/O pins' override registers (100-200) are covered
 #define MAX_SENSORS 10
 
 // Global flags
@@ -90,6 +96,8 @@ bool core0setupComplete = false;
 // I/O Configuration Structures (replacing hardcoded pin arrays)
 #define MAX_IO_PINS 16
 #define MAX_IO_RULES 50
+#define IO_RULE_MAX_TARGETS 4          // Outputs one global rule can drive
+#define IO_GLOBAL_SCAN_PERIOD_MS 10    // Default period of the global rule scan
 #define IO_CONFIG_FILE "/io_config.json"
 
 // Action types for automation rules
@@ -122,6 +130,8 @@ struct IOAction {
     IOActionType type;
     bool value;                    // For SET/TOGGLE
     uint32_t pulseDurationMs;      // For PULSE
+    uint8_t targetPins[IO_RULE_MAX_TARGETS];  // Global rules: GP numbers of the outputs driven
+    uint8_t targetCount;
 };
 
 // Single trigger condition (for multi-condition rules)
@@ -130,6 +140,7 @@ struct ConditionClause {
     TriggerCondition condition;   // Comparison operator
     int32_t triggerValue;         // Value to compare against
     LogicOperator nextOperator;   // AND/OR to next condition
+    int32_t hysteresis;           // </<=/>/>=: once met, stays met until the value is this far back past triggerValue
 };
 
 // I/O Rule Trigger definition (supports multiple conditions)
@@ -137,6 +148,8 @@ struct IOTrigger {
     ConditionClause conditions[3];  // Support up to 3 conditions per rule
     uint8_t conditionCount;         // Number of active conditions (1-3)
     bool lastTriggeredState;        // Track previous state (for edge detection)
+    uint32_t onDelayMs;             // Conditions must hold this long before the rule sees TRUE
+    uint32_t offDelayMs;            // ...and be gone this long before it sees FALSE
 };
 
 // I/O Automation Rule
@@ -168,6 +181,7 @@ struct IOPin {
     bool previousState;           // Previous state (for edge detection)
     uint32_t lastStateChange;     // Timestamp of last change
     bool externallyLocked;        // Set to true when external write = 0 (rules disabled until UI unlock)
+    bool heldByGlobalRule;        // A FOLLOW_CONDITION global rule owns this output; pin rules wait
 };
 
 // Master I/O Configuration
@@ -175,8 +189,9 @@ struct IOConfig {
     uint8_t version;
     IOPin pins[MAX_IO_PINS];
     uint8_t pinCount;
-    IORule globalRules[MAX_IO_RULES];
+    IORule globalRules[MAX_IO_RULES];  // Cross-pin rules, driving action.targetPins
     uint8_t globalRuleCount;
+    uint16_t globalScanPeriodMs;       // Global rules run on this fixed period
 };
 
 // Digital IO pins (LEGACY - kept for backward compatibility during transition)
@@ -189,25 +204,6 @@ const uint8_t RESERVED_PINS[] = {16, 17, 18, 19, 20, 21, 22};
 
 // Network and Modbus Configuration
 
-// Bus operation states
-enum class BusOpState {
-    IDLE,
-    REQUEST_SENT,
-    WAITING_CONVERSION,
-    READY_TO_READ,
-    ERROR
-};
-
-// Bus operation structure
-struct BusOperation {
-    uint8_t sensorIndex;
-    uint32_t startTime;
-    uint32_t conversionTime;
-    BusOpState state;
-    uint8_t retryCount;
-    bool needsCRC;
-};
-
 // SensorCommand is already defined above
 
 struct Config {
@@ -248,15 +244,36 @@ struct IOStatus {
     float conductivity;
 };
 
+/**
+ * Read statistics of one EZO circuit (ezoDriver)
+ */
+struct EzoProbeStats {
+    uint32_t reads;           // Readings received
+    uint32_t errors;          // Bus errors, error status codes and requests never answered
+    uint32_t lastLatencyMs;   // Read command to reading, "still processing" polls included
+    uint32_t maxLatencyMs;
+    float compensationC;      // Temperature sent with the last read
+    bool compensated;         // Last read was "RT,<temp>"
+};
+
 // Sensor configuration structure (KEEP - intentional improvements)
 struct SensorConfig {
     bool enabled;
     char name[32];
     char type[16];
     char protocol[16]; // Added protocol field for sensor assignment
+    // Interned from type/protocol/parsingMethod by resolveSensorKinds(); the strings are for JSON I/O only
+    SensorType typeId;
+    SensorProtocol protocolId;
+    ParsingMethod parsingMethodId;
+    ParsingMethod parsingMethodIdB;
+    const SensorDriver* driver;   // Resolved by applySensorPresets(); nullptr = not polled through a bus queue
+    bool driverStarted;           // driver->begin() has succeeded
     uint8_t i2cAddress;
     char i2cAddressStr[8]; // Hex string for I2C address
+    TwoWire* i2cWire;             // Wire (I2C0 pairs) or Wire1 (I2C1 pairs), resolved by applySensorPresets()
     int modbusRegister;
+    uint8_t modbusRegisterCount;  // Consecutive input registers used (channels A-C, then any feature block), resolved by applySensorPresets()
     float calibrationOffset;
     float calibrationSlope;
     char calibrationExpression[128];  // Mathematical expression for calibration (supports any equation)
@@ -269,6 +286,10 @@ struct SensorConfig {
     int analogPin;
     int oneWirePin;
     int digitalPin;
+    // UART line settings; uartConfig is interned from uartFraming by resolveSensorKinds()
+    uint32_t uartBaud;
+    char uartFraming[4];      // "8N1", "7E1", ...
+    uint16_t uartConfig;      // SERIAL_8N1 etc.
     // Data parsing configuration
     char parsingMethod[16];   // raw, custom_bits, bit_field, status_register, json_path, csv_column
     char command[32];
@@ -282,9 +303,10 @@ struct SensorConfig {
     char parsingConfigB[128]; // JSON config for secondary parsing
     char parsingMethodC[16];  // Parsing method for tertiary value (rawValueC)  
     char parsingConfigC[128]; // JSON config for tertiary parsing
-    // EZO sensor state tracking
-    bool cmdPending;
-    unsigned long lastCmdSent;
+    // Atlas Scientific EZO circuits (ezoDriver)
+    char ezoCompensation[32];  // Name of the sensor whose temperature is sent with each read ("RT,"), empty = plain "R"
+    int8_t ezoCompensationIndex; // Resolved from ezoCompensation by applySensorPresets(), -1 = none
+    EzoProbeStats ezoStats;
     // Response data storage
     char response[64];
     char calibrationData[256];
@@ -300,6 +322,7 @@ struct SensorConfig {
     int modbusValue;          // Primary value written to Modbus register
     int modbusValueB;         // Secondary value for next Modbus register
     int modbusValueC;         // Tertiary value for next Modbus register
+    VibrationFeatures vibration;  // Last completed window of streaming accelerometers (LIS3DH)
     
     // Calibration for multiple outputs
     float calibrationOffsetB; // Calibration offset for rawValueB
@@ -308,6 +331,14 @@ struct SensorConfig {
     float calibrationSlopeC;  // Calibration slope for rawValueC
     char calibrationExpressionB[128];  // Mathematical expression for calibrating rawValueB
     char calibrationExpressionC[128];  // Mathematical expression for calibrating rawValueC
+    // Expressions compiled at config load (empty program = linear slope/offset)
+    CalibrationProgram calibrationProgram;
+    CalibrationProgram calibrationProgramB;
+    CalibrationProgram calibrationProgramC;
+    // Q16.16 sample path (fixed_point.h), resolved with the programs
+    bool fixedPoint;              // Requested per sensor ("fixedPoint" in sensors.json)
+    uint8_t fixedPointChannels;   // Bit n set: channel A/B/C runs in Q16.16
+    LinearQ16 linearQ16[3];       // Quantized slope/offset per channel
     
     char rawDataString[128];  // Raw data string for parsing (I2C/UART responses)
     unsigned long lastReadTime; // When last read was performed
@@ -318,6 +349,14 @@ struct SensorConfig {
     int oneWireConversionTime; // Time in ms to wait after command before reading
     unsigned long lastOneWireCmd; // When last command was sent
     bool oneWireAutoMode;     // Enable automatic periodic commands
+    char oneWireRom[24];      // Device ROM as 16 hex digits ("28FF641E0F0000A1"), empty = by position on the pin
+    uint8_t oneWireRomId[8];  // Parsed from oneWireRom by resolveSensorKinds(), all zero = by position
+    uint8_t oneWireSlot;      // Position among the pin's sensors without a ROM, resolved by applySensorPresets()
+    uint8_t oneWireResolution; // DS18B20 resolution in bits (9-12); sets the conversion wait
+    // Streaming accelerometer spectrum (LIS3DH); vibrationBandSet is parsed by resolveSensorKinds()
+    uint16_t fftPoints;       // 256 or 512 samples per window
+    char vibrationBands[48];  // "low-high,..." in Hz, up to VIBRATION_MAX_BANDS, empty = VIBRATION_DEFAULT_BANDS
+    VibrationBands vibrationBandSet;
     
     // SPI specific configuration
     uint8_t spiChipSelect;    // GPIO pin for chip select
@@ -341,6 +380,8 @@ extern WiFiServer httpServer;    // HTTP server on port 80
 extern WiFiClient client;
 
 // Client management
+// One connection slot: socket plus protocol context. Requests are answered
+// from the shared modbusImage, so a slot holds no register/coil storage.
 struct ModbusClientConnection {
     WiFiClient client;
     ModbusTCPServer server;
@@ -349,6 +390,7 @@ struct ModbusClientConnection {
     unsigned long connectionTime;
 };
 
+extern ModbusTCPServer modbusImage;  // Shared coil/register image served to every connection
 extern ModbusClientConnection modbusClients[MAX_MODBUS_CLIENTS];
 extern int connectedClients;
 
@@ -379,8 +421,6 @@ void applyIOConfigToPins();
 void evaluateIOAutomationRules();
 void updateIOpins();
 void resetLatches();
-void initializeEzoSensors();
-void handleEzoSensors();
 
 // File serving helper for main.cpp
 void serveFileFromFS(WiFiClient& client, const String& filename, const String& contentType) {
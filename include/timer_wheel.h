@@ -0,0 +1,188 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Timer Wheel - millisecond one-shot timers for the rules engine
+ *
+ * A hashed timing wheel: TIMER_WHEEL_SLOTS buckets of one millisecond each.
+ * A timer due at t lives in bucket t % SLOTS as a doubly linked list node,
+ * so arming, re-arming and cancelling are O(1). advance() walks only the
+ * buckets for the milliseconds that elapsed since the previous call (at
+ * most one lap) and fires the timers in them that are due; a timer more
+ * than one lap out stays in its bucket until the lap it is due in.
+ *
+ * Per scan the cost is O(elapsed ms + timers in those buckets), which for a
+ * loop running well above 1 kHz is one bucket and its expiring timers,
+ * independent of how many rules exist.
+ *
+ * Timers are identified by a fixed index (0..capacity-1) chosen by the
+ * owner, so nothing is allocated. Core 0 only.
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+static const uint16_t TIMER_WHEEL_SLOTS = 256;   // Power of two
+static const uint16_t TIMER_WHEEL_NONE = 0xFFFF;
+
+// ============================================================================
+// TIMER WHEEL CLASS
+// ============================================================================
+
+template <uint16_t CAPACITY>
+class TimerWheel {
+private:
+    struct Timer {
+        uint32_t dueMs;
+        uint16_t next;
+        uint16_t prev;
+        uint16_t slot;
+        bool armed;
+        bool expiring;             // Taken off the wheel by advance(), callback pending
+    };
+
+    Timer timers[CAPACITY];
+    uint16_t head[TIMER_WHEEL_SLOTS];
+    uint16_t expired[CAPACITY];    // Due timers of the bucket being processed
+    uint32_t currentMs;            // Last millisecond whose bucket was processed
+    bool started;
+    uint16_t armedCount;
+
+    // Statistics
+    uint32_t fired;
+    uint32_t visited;              // Nodes examined by advance() (fired or not yet due)
+
+    // Wrap-safe "a is at or before b"
+    static bool reached(uint32_t a, uint32_t b) {
+        return (int32_t)(a - b) <= 0;
+    }
+
+    void link(uint16_t id, uint32_t slotMs) {
+        uint16_t slot = slotMs & (TIMER_WHEEL_SLOTS - 1);
+        timers[id].slot = slot;
+        timers[id].prev = TIMER_WHEEL_NONE;
+        timers[id].next = head[slot];
+        if (head[slot] != TIMER_WHEEL_NONE) timers[head[slot]].prev = id;
+        head[slot] = id;
+    }
+
+    void unlink(uint16_t id) {
+        Timer& t = timers[id];
+        if (t.prev != TIMER_WHEEL_NONE) {
+            timers[t.prev].next = t.next;
+        } else {
+            head[t.slot] = t.next;
+        }
+        if (t.next != TIMER_WHEEL_NONE) timers[t.next].prev = t.prev;
+        t.armed = false;
+        armedCount--;
+    }
+
+public:
+    TimerWheel() : currentMs(0), started(false), armedCount(0), fired(0), visited(0) {
+        clear();
+    }
+
+    /**
+     * Disarm every timer
+     */
+    void clear() {
+        for (uint16_t i = 0; i < TIMER_WHEEL_SLOTS; i++) head[i] = TIMER_WHEEL_NONE;
+        for (uint16_t i = 0; i < CAPACITY; i++) {
+            timers[i].armed = false;
+            timers[i].expiring = false;
+        }
+        armedCount = 0;
+    }
+
+    /**
+     * Arm timer `id` to fire at dueMs (re-arms it if already armed)
+     */
+    void schedule(uint16_t id, uint32_t dueMs, uint32_t nowMs) {
+        if (id >= CAPACITY) return;
+        if (!started) {
+            currentMs = nowMs;
+            started = true;
+        }
+        if (timers[id].armed) unlink(id);
+        timers[id].expiring = false;
+        timers[id].dueMs = dueMs;
+        timers[id].armed = true;
+        armedCount++;
+        // Already due: park it in the next bucket to be processed
+        link(id, reached(dueMs, currentMs) ? currentMs + 1 : dueMs);
+    }
+
+    void cancel(uint16_t id) {
+        if (id >= CAPACITY) return;
+        if (timers[id].armed) unlink(id);
+        timers[id].expiring = false;
+    }
+
+    bool isArmed(uint16_t id) const {
+        return id < CAPACITY && timers[id].armed;
+    }
+
+    // Milliseconds until timer `id` fires (0 if due or not armed)
+    uint32_t remainingMs(uint16_t id, uint32_t nowMs) const {
+        if (!isArmed(id) || reached(timers[id].dueMs, nowMs)) return 0;
+        return timers[id].dueMs - nowMs;
+    }
+
+    /**
+     * Process the buckets up to nowMs and call onExpired(id) for each due timer
+     * The callback may re-arm or cancel any timer, including the one firing.
+     */
+    template <typename Callback>
+    void advance(uint32_t nowMs, Callback onExpired) {
+        if (!started) {
+            currentMs = nowMs;
+            started = true;
+            return;
+        }
+        if (armedCount == 0) {
+            currentMs = nowMs;
+            return;
+        }
+
+        uint32_t elapsed = nowMs - currentMs;
+        if (elapsed > TIMER_WHEEL_SLOTS) {
+            // Stalled for more than a lap: every bucket once is enough
+            currentMs = nowMs - TIMER_WHEEL_SLOTS;
+            elapsed = TIMER_WHEEL_SLOTS;
+        }
+        while (elapsed-- > 0 && armedCount > 0) {
+            currentMs++;
+            uint16_t slot = currentMs & (TIMER_WHEEL_SLOTS - 1);
+
+            // Take the due timers off the bucket first, so callbacks can arm
+            // and cancel freely while they run
+            uint16_t count = 0;
+            uint16_t id = head[slot];
+            while (id != TIMER_WHEEL_NONE) {
+                uint16_t next = timers[id].next;
+                visited++;
+                if (reached(timers[id].dueMs, nowMs)) {
+                    unlink(id);
+                    timers[id].expiring = true;
+                    expired[count++] = id;
+                }
+                id = next;
+            }
+            for (uint16_t i = 0; i < count; i++) {
+                uint16_t firing = expired[i];
+                if (!timers[firing].expiring) continue;  // Cancelled or re-armed by an earlier callback
+                timers[firing].expiring = false;
+                fired++;
+                onExpired(firing);
+            }
+        }
+        currentMs = nowMs;
+    }
+
+    uint16_t getArmedCount() const { return armedCount; }
+    uint32_t getFiredCount() const { return fired; }
+    uint32_t getVisitedCount() const { return visited; }
+};
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstring>
+
+/**
+ * UART Sensor Engine - persistent ports and non-blocking line assembly
+ *
+ * The RP2040 has two UARTs: UART0 (Serial1) and UART1 (Serial2). A port is
+ * opened the first time one of its sensors is polled and then stays open.
+ * It is only closed and reopened when a sensor with different pins, baud or
+ * framing on the same UART is polled while the port is idle.
+ *
+ * A measurement is split like the other drivers:
+ *
+ *   startRequest()   claim the port, drop stale input, queue the command
+ *                    in the TX FIFO and return
+ *   pollResponse()   copy whatever has arrived into the port's line buffer;
+ *                    PENDING until CR or LF ends a non-empty line, or the
+ *                    response timeout expires
+ *
+ * The core's UART interrupt moves received bytes into a software FIFO
+ * (UART_RX_FIFO_SIZE) between polls, so neither call waits for the wire.
+ * Each port has at most one request outstanding. A sensor polled while
+ * another sensor's request holds its port gets PENDING from startRequest()
+ * and is triggered again shortly after.
+ *
+ * Sensors without a command stream on their own: after the stale input is
+ * dropped, the first (partial) line is discarded and the next whole line is
+ * the reading.
+ *
+ * Core 1 only. The terminal on core 0 borrows a port with core 1 parked
+ * (detachPort()).
+ *
+ * Include after sys_init.h (needs SensorConfig and DriverStatus).
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+static const uint32_t UART_DEFAULT_BAUD = 9600;
+
+// Software RX FIFO behind the 32-byte hardware FIFO (filled from the UART IRQ)
+static const size_t UART_RX_FIFO_SIZE = 256;
+
+// A request without a complete line after this long fails
+static const uint32_t UART_RESPONSE_TIMEOUT_MS = 1000;
+
+// Longest line kept (longer lines are truncated); matches SensorConfig::rawDataString
+static const uint8_t UART_LINE_MAX = 128;
+
+static const uint8_t UART_PORT_COUNT = 2;
+
+// ============================================================================
+// PIN MAP AND FRAMING
+// ============================================================================
+
+/**
+ * UART for a TX/RX pin pair
+ * UART0: TX GP0/12/16/28, RX GP1/13/17/29
+ * UART1: TX GP4/8/20/24,  RX GP5/9/21/25
+ * @return 0 or 1, -1 if the pins are not a TX/RX pair of the same UART
+ */
+inline int uartIdForPins(int txPin, int rxPin) {
+    static const uint32_t TX_PINS[UART_PORT_COUNT] = {
+        (1u << 0) | (1u << 12) | (1u << 16) | (1u << 28),
+        (1u << 4) | (1u << 8) | (1u << 20) | (1u << 24)
+    };
+    static const uint32_t RX_PINS[UART_PORT_COUNT] = {
+        (1u << 1) | (1u << 13) | (1u << 17) | (1u << 29),
+        (1u << 5) | (1u << 9) | (1u << 21) | (1u << 25)
+    };
+    if (txPin < 0 || rxPin < 0 || txPin > 29 || rxPin > 29) return -1;
+    for (uint8_t uart = 0; uart < UART_PORT_COUNT; uart++) {
+        if ((TX_PINS[uart] & (1u << txPin)) && (RX_PINS[uart] & (1u << rxPin))) {
+            return uart;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Framing string ("8N1", "7E1", "8N2", ...) -> SERIAL_xxx config word
+ * Unknown or empty strings give SERIAL_8N1.
+ */
+inline uint16_t uartFramingFromString(const char* framing) {
+    if (framing == nullptr || strlen(framing) != 3) return SERIAL_8N1;
+
+    uint16_t data;
+    switch (framing[0]) {
+        case '5': data = SERIAL_DATA_5; break;
+        case '6': data = SERIAL_DATA_6; break;
+        case '7': data = SERIAL_DATA_7; break;
+        case '8': data = SERIAL_DATA_8; break;
+        default:  return SERIAL_8N1;
+    }
+
+    uint16_t parity;
+    switch (framing[1]) {
+        case 'N': case 'n': parity = SERIAL_PARITY_NONE; break;
+        case 'E': case 'e': parity = SERIAL_PARITY_EVEN; break;
+        case 'O': case 'o': parity = SERIAL_PARITY_ODD; break;
+        default:            return SERIAL_8N1;
+    }
+
+    uint16_t stop;
+    switch (framing[2]) {
+        case '1': stop = SERIAL_STOP_BIT_1; break;
+        case '2': stop = SERIAL_STOP_BIT_2; break;
+        default:  return SERIAL_8N1;
+    }
+    return data | parity | stop;
+}
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * Counters of one UART port
+ */
+struct UartPortStats {
+    uint32_t opens;        // begin() calls (first use and reconfigurations)
+    uint32_t requests;
+    uint32_t lines;        // Requests answered with a complete line
+    uint32_t timeouts;
+    uint32_t busyDeferrals; // Triggers deferred because another sensor held the port
+};
+
+// ============================================================================
+// UART SENSOR ENGINE CLASS
+// ============================================================================
+
+class UartSensorEngine {
+private:
+    struct Port {
+        SerialUART* serial;
+        bool open;
+        int txPin;
+        int rxPin;
+        uint32_t baud;
+        uint16_t config;
+
+        // Request in flight, owner == nullptr if idle
+        const SensorConfig* owner;
+        uint32_t deadlineMs;
+        bool synced;       // Streaming: first line end seen, collecting a whole line
+        char line[UART_LINE_MAX];
+        uint8_t length;
+
+        UartPortStats stats;
+    };
+
+    Port ports[UART_PORT_COUNT];
+
+    // Wrap-safe "a is at or after b"
+    static bool reached(uint32_t a, uint32_t b) {
+        return (int32_t)(a - b) >= 0;
+    }
+
+    static int portIndexFor(const SensorConfig& sensor) {
+        return uartIdForPins(sensor.uartTxPin, sensor.uartRxPin);
+    }
+
+    // Route the port to the sensor's pins and framing; no-op if already there
+    void openPort(Port& port, const SensorConfig& sensor) {
+        uint32_t baud = sensor.uartBaud > 0 ? sensor.uartBaud : UART_DEFAULT_BAUD;
+        if (port.open && port.txPin == sensor.uartTxPin && port.rxPin == sensor.uartRxPin &&
+            port.baud == baud && port.config == sensor.uartConfig) {
+            return;
+        }
+        if (port.open) {
+            port.serial->end();
+        }
+        port.serial->setTX(sensor.uartTxPin);
+        port.serial->setRX(sensor.uartRxPin);
+        port.serial->setFIFOSize(UART_RX_FIFO_SIZE);
+        port.serial->begin(baud, sensor.uartConfig);
+        port.open = true;
+        port.txPin = sensor.uartTxPin;
+        port.rxPin = sensor.uartRxPin;
+        port.baud = baud;
+        port.config = sensor.uartConfig;
+        port.stats.opens++;
+    }
+
+    void release(Port& port) {
+        port.owner = nullptr;
+    }
+
+public:
+    UartSensorEngine() {
+        memset(ports, 0, sizeof(ports));
+        ports[0].serial = &Serial1;
+        ports[1].serial = &Serial2;
+    }
+
+    /**
+     * Start a measurement: claim the sensor's port and send its command (if any)
+     * @return OK when sent, PENDING if another sensor's request holds the
+     *         port, ERROR_BUS if the pins are not a UART TX/RX pair
+     */
+    DriverStatus startRequest(const SensorConfig& sensor, uint32_t nowMs) {
+        int index = portIndexFor(sensor);
+        if (index < 0) return DriverStatus::ERROR_BUS;
+        Port& port = ports[index];
+
+        if (port.owner != nullptr && port.owner != &sensor && !reached(nowMs, port.deadlineMs)) {
+            port.stats.busyDeferrals++;
+            return DriverStatus::PENDING;
+        }
+
+        openPort(port, sensor);
+
+        // Drop leftovers (late replies, "*OK" acknowledgements, streamed lines)
+        while (port.serial->available() > 0) {
+            port.serial->read();
+        }
+
+        port.owner = &sensor;
+        port.deadlineMs = nowMs + UART_RESPONSE_TIMEOUT_MS;
+        port.length = 0;
+        port.stats.requests++;
+
+        size_t commandLength = strlen(sensor.command);
+        port.synced = commandLength > 0;
+        if (commandLength > 0) {
+            port.serial->write((const uint8_t*)sensor.command, commandLength);
+            port.serial->write((const uint8_t*)"\r\n", 2);
+        }
+        return DriverStatus::OK;
+    }
+
+    /**
+     * Copy received bytes into the line buffer
+     * @return OK once a line is complete (see getLine()), PENDING while
+     *         waiting, ERROR_READ on timeout, ERROR_BUS if the request was
+     *         lost (port taken over or detached)
+     */
+    DriverStatus pollResponse(const SensorConfig& sensor, uint32_t nowMs) {
+        int index = portIndexFor(sensor);
+        if (index < 0) return DriverStatus::ERROR_BUS;
+        Port& port = ports[index];
+        if (port.owner != &sensor || !port.open) return DriverStatus::ERROR_BUS;
+
+        while (port.serial->available() > 0) {
+            char c = (char)port.serial->read();
+            if (c == '\r' || c == '\n') {
+                if (!port.synced) {
+                    port.synced = true;  // Streaming: the partial line before this is dropped
+                    continue;
+                }
+                if (port.length == 0) continue;  // CR LF pair or empty line
+                port.line[port.length] = '\0';
+                port.stats.lines++;
+                release(port);
+                return DriverStatus::OK;
+            }
+            if (port.synced && port.length < UART_LINE_MAX - 1) {
+                port.line[port.length++] = c;
+            }
+        }
+
+        if (reached(nowMs, port.deadlineMs)) {
+            port.stats.timeouts++;
+            release(port);
+            return DriverStatus::ERROR_READ;
+        }
+        return DriverStatus::PENDING;
+    }
+
+    /**
+     * Last complete line of the sensor's port (valid after pollResponse() == OK)
+     */
+    const char* getLine(const SensorConfig& sensor) const {
+        int index = portIndexFor(sensor);
+        return index < 0 ? "" : ports[index].line;
+    }
+
+    /**
+     * Drop requests in flight, e.g. after the sensor configuration changed
+     * (ports stay open)
+     */
+    void cancelRequests() {
+        for (uint8_t i = 0; i < UART_PORT_COUNT; i++) {
+            release(ports[i]);
+        }
+    }
+
+    /**
+     * Hand the UART for these pins to a caller that drives it directly (the
+     * terminal); the engine reopens it on its next request. Core 1 parked.
+     * @return nullptr if the pins are not a TX/RX pair of one UART
+     */
+    SerialUART* detachPort(int txPin, int rxPin) {
+        int index = uartIdForPins(txPin, rxPin);
+        if (index < 0) return nullptr;
+        Port& port = ports[index];
+        if (port.open) {
+            port.serial->end();
+            port.open = false;
+        }
+        release(port);
+        return port.serial;
+    }
+
+    const UartPortStats& getStats(uint8_t uart) const {
+        return ports[uart < UART_PORT_COUNT ? uart : 0].stats;
+    }
+
+    /**
+     * Print port state and counters
+     */
+    void printDiagnostics() const {
+        Serial.println("\n=== UART Sensor Engine ===");
+        for (uint8_t i = 0; i < UART_PORT_COUNT; i++) {
+            const Port& port = ports[i];
+            Serial.printf("UART%d (%s): %s", i, i == 0 ? "Serial1" : "Serial2", port.open ? "open" : "closed");
+            if (port.open) {
+                Serial.printf(", TX=%d RX=%d, %lu baud", port.txPin, port.rxPin, port.baud);
+            }
+            Serial.printf(", %s\n", port.owner != nullptr ? "request in flight" : "idle");
+            Serial.printf("  Opens: %lu, Requests: %lu, Lines: %lu, Timeouts: %lu, Busy: %lu\n",
+                        port.stats.opens, port.stats.requests, port.stats.lines,
+                        port.stats.timeouts, port.stats.busyDeferrals);
+        }
+        Serial.println("==========================\n");
+    }
+};
+
+// Global instance
+extern UartSensorEngine uartSensorEngine;
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+
+/**
+ * Vibration Features - windowed statistics of a 3-axis acceleration stream
+ *
+ * An accelerometer streaming through its FIFO delivers every sample, not
+ * one reading per poll. VibrationWindow accumulates a window of raw counts
+ * with integer sums only (no floating point per sample on the Cortex-M0+);
+ * finish() turns the window into per-axis features once:
+ *
+ *   mean    DC level (gravity, tilt)
+ *   rms     RMS about the mean (vibration energy)
+ *   peak    largest deviation from the mean
+ *   crest   peak / rms (impacts and bearing defects raise it before rms)
+ *
+ * The spectral fields (dominant frequency, band RMS) are filled in later
+ * from the same window by VibrationAnalyzer (vibration_spectrum.h).
+ *
+ * Modbus layout after the sensor's three mean registers, X/Y/Z per item:
+ * RMS, peak (0.1 mg), crest (x100), dominant frequency (0.1 Hz), then the
+ * RMS of each band (0.1 mg), see vibrationFeatureRegister().
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+static const uint8_t VIBRATION_AXES = 3;
+
+// Frequency bands analysed per axis
+static const uint8_t VIBRATION_MAX_BANDS = 4;
+
+// Feature registers following the three mean registers:
+// RMS, peak, crest, dominant frequency, then one triple per band
+static const uint8_t VIBRATION_FEATURE_REGISTERS = (4 + VIBRATION_MAX_BANDS) * VIBRATION_AXES;
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+/**
+ * Features of the last completed window (mg unless noted)
+ */
+struct VibrationFeatures {
+    float mean[VIBRATION_AXES];
+    float rms[VIBRATION_AXES];
+    float peak[VIBRATION_AXES];
+    float crest[VIBRATION_AXES];   // Dimensionless, 0 if rms is 0
+    uint16_t samples;              // Window length
+    uint32_t windowMs;             // Time from first to last drain of the window
+
+    // Spectrum of the window (vibration_spectrum.h)
+    float dominantHz[VIBRATION_AXES];
+    float bandRms[VIBRATION_MAX_BANDS][VIBRATION_AXES];
+    uint8_t bandCount;
+    bool spectrumValid;
+};
+
+/**
+ * Running sums of one window of raw counts
+ * Plain data, so a completed window can be copied into a SensorReading.
+ */
+struct VibrationWindow {
+    int32_t sum[VIBRATION_AXES];
+    int64_t sumSquares[VIBRATION_AXES];
+    int16_t minimum[VIBRATION_AXES];
+    int16_t maximum[VIBRATION_AXES];
+    uint16_t count;
+    uint32_t startMs;
+    uint32_t endMs;
+
+    void reset(uint32_t nowMs) {
+        for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+            sum[axis] = 0;
+            sumSquares[axis] = 0;
+            minimum[axis] = INT16_MAX;
+            maximum[axis] = INT16_MIN;
+        }
+        count = 0;
+        startMs = nowMs;
+        endMs = nowMs;
+    }
+
+    void add(const int16_t counts[VIBRATION_AXES]) {
+        for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+            int32_t v = counts[axis];
+            sum[axis] += v;
+            sumSquares[axis] += v * v;
+            if (counts[axis] < minimum[axis]) minimum[axis] = counts[axis];
+            if (counts[axis] > maximum[axis]) maximum[axis] = counts[axis];
+        }
+        count++;
+    }
+
+    /**
+     * Per-axis features in engineering units
+     * @param unitsPerCount Scale of one raw count (e.g. mg per LSB)
+     */
+    void finish(float unitsPerCount, VibrationFeatures& out) const {
+        out.samples = count;
+        out.windowMs = endMs - startMs;
+        if (count == 0) {
+            memset(out.mean, 0, sizeof(out.mean));
+            memset(out.rms, 0, sizeof(out.rms));
+            memset(out.peak, 0, sizeof(out.peak));
+            memset(out.crest, 0, sizeof(out.crest));
+            return;
+        }
+
+        for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+            // n^2 * variance = n * sum(x^2) - sum(x)^2, exact in integers
+            int64_t spread = (int64_t)count * sumSquares[axis] - (int64_t)sum[axis] * sum[axis];
+            float mean = (float)sum[axis] / count;
+            float rms = spread > 0 ? sqrtf((float)spread) / count : 0.0f;
+            float above = (float)maximum[axis] - mean;
+            float below = mean - (float)minimum[axis];
+            float peak = above > below ? above : below;
+
+            out.mean[axis] = mean * unitsPerCount;
+            out.rms[axis] = rms * unitsPerCount;
+            out.peak[axis] = peak * unitsPerCount;
+            out.crest[axis] = rms > 0.0f ? peak / rms : 0.0f;
+        }
+    }
+};
+
+// ============================================================================
+// MODBUS ENCODING
+// ============================================================================
+
+/**
+ * Input register value of feature `index` (0..VIBRATION_FEATURE_REGISTERS-1),
+ * X/Y/Z per item: 0-2 RMS, 3-5 peak (0.1 mg), 6-8 crest (x100), 9-11
+ * dominant frequency (0.1 Hz), 12.. band RMS (0.1 mg); saturated to 0..65535
+ */
+inline uint16_t vibrationFeatureRegister(const VibrationFeatures& features, uint8_t index) {
+    if (index >= VIBRATION_FEATURE_REGISTERS) return 0;
+    uint8_t axis = index % VIBRATION_AXES;
+    uint8_t item = index / VIBRATION_AXES;
+    float value;
+    switch (item) {
+        case 0:  value = features.rms[axis] * 10.0f; break;
+        case 1:  value = features.peak[axis] * 10.0f; break;
+        case 2:  value = features.crest[axis] * 100.0f; break;
+        case 3:  value = features.dominantHz[axis] * 10.0f; break;
+        default: value = features.bandRms[item - 4][axis] * 10.0f; break;
+    }
+    if (value <= 0.0f) return 0;
+    if (value >= 65535.0f) return 65535;
+    return (uint16_t)(value + 0.5f);
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdlib.h>
+#include "vibration_features.h"
+
+/**
+ * Vibration Spectrum - fixed-point FFT band energies of a sample window
+ *
+ * Works on the same contiguous window as VibrationWindow, kept per axis as
+ * raw counts. For one axis: remove the mean, scale the samples up to use
+ * 14 bits, apply a Hann window, run an in-place radix-2 FFT in Q15 (256 or
+ * 512 points), then from the bin powers P[k] = |X[k]|^2:
+ *
+ *   bandRms     RMS of the content in [low, high) Hz:
+ *               sqrt(2 * sum P[k] / mean(w^2)) over the band's bins
+ *               (a sine of amplitude A in the band gives A / sqrt(2))
+ *   dominantHz  largest bin above DC, refined by parabolic interpolation
+ *               over its neighbours' magnitudes
+ *
+ * Every FFT stage halves its butterflies, so nothing overflows and the
+ * output is X[k] / N. Sine and Hann tables are built once for the largest
+ * size; smaller transforms stride through them.
+ *
+ * analyzeAxis() costs well under a millisecond per axis at 512 points; the
+ * poller runs one axis per loop1() pass, outside any bus transaction.
+ *
+ * Core 1 only (shared scratch buffers).
+ */
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+static const uint16_t VIBRATION_FFT_MIN_POINTS = 256;
+static const uint16_t VIBRATION_FFT_MAX_POINTS = 512;
+
+// Used when a sensor's band list is empty or invalid
+static const char* const VIBRATION_DEFAULT_BANDS = "2-25,25-75,75-125,125-200";
+
+// Mean of the squared periodic Hann window
+static const float VIBRATION_HANN_POWER = 0.375f;
+
+// Windowed input is scaled to stay within +/-2^14 (headroom for the butterflies)
+static const int32_t VIBRATION_FFT_INPUT_LIMIT = 16383;
+
+// ============================================================================
+// TYPE DEFINITIONS
+// ============================================================================
+
+struct VibrationBand {
+    uint16_t lowHz;
+    uint16_t highHz;
+};
+
+/**
+ * Bands of one sensor, parsed from "low-high,low-high,..." (Hz)
+ */
+struct VibrationBands {
+    VibrationBand band[VIBRATION_MAX_BANDS];
+    uint8_t count;
+};
+
+// ============================================================================
+// CONFIGURATION PARSING
+// ============================================================================
+
+/**
+ * Parse a band list such as "2-25,25-75,75-125"
+ * @return false (and count 0) on syntax errors, more than
+ *         VIBRATION_MAX_BANDS bands or a band with low >= high
+ */
+inline bool vibrationBandsFromString(const char* text, VibrationBands& out) {
+    out.count = 0;
+    if (text == nullptr) return false;
+    const char* p = text;
+    while (*p) {
+        while (*p == ' ') p++;
+        if (*p == '\0') break;
+        if (out.count >= VIBRATION_MAX_BANDS) { out.count = 0; return false; }
+
+        char* end;
+        long low = strtol(p, &end, 10);
+        if (end == p || *end != '-') { out.count = 0; return false; }
+        p = end + 1;
+        long high = strtol(p, &end, 10);
+        if (end == p || low < 0 || high <= low || high > 65535) { out.count = 0; return false; }
+        p = end;
+        while (*p == ' ') p++;
+        if (*p == ',') p++;
+        else if (*p != '\0') { out.count = 0; return false; }
+
+        out.band[out.count].lowHz = (uint16_t)low;
+        out.band[out.count].highHz = (uint16_t)high;
+        out.count++;
+    }
+    return out.count > 0;
+}
+
+/**
+ * FFT length for a configured value: 512 if asked for, otherwise 256
+ */
+inline uint16_t vibrationFftPoints(uint16_t configured) {
+    return configured >= VIBRATION_FFT_MAX_POINTS ? VIBRATION_FFT_MAX_POINTS : VIBRATION_FFT_MIN_POINTS;
+}
+
+// ============================================================================
+// VIBRATION ANALYZER CLASS
+// ============================================================================
+
+class VibrationAnalyzer {
+private:
+    int16_t sine[VIBRATION_FFT_MAX_POINTS];   // Q15 sin(2*pi*i/MAX)
+    int16_t hann[VIBRATION_FFT_MAX_POINTS];   // Q15 periodic Hann
+    int16_t re[VIBRATION_FFT_MAX_POINTS];
+    int16_t im[VIBRATION_FFT_MAX_POINTS];
+    bool tablesReady;
+
+    // Statistics
+    uint32_t transforms;
+    uint32_t lastMicros;
+    uint32_t maxMicros;
+
+    void buildTables() {
+        for (uint16_t i = 0; i < VIBRATION_FFT_MAX_POINTS; i++) {
+            float angle = 2.0f * (float)PI * i / VIBRATION_FFT_MAX_POINTS;
+            sine[i] = (int16_t)lroundf(sinf(angle) * 32767.0f);
+            hann[i] = (int16_t)lroundf((0.5f - 0.5f * cosf(angle)) * 32767.0f);
+        }
+        tablesReady = true;
+    }
+
+    static int16_t halve(int32_t value) {
+        return (int16_t)((value + 1) >> 1);  // Rounded, not floored: no drift over the stages
+    }
+
+    // In-place radix-2 decimation-in-time FFT of re/im, output scaled by 1/points
+    void transform(uint16_t points) {
+        for (uint16_t i = 1, j = 0; i < points; i++) {
+            uint16_t bit = points >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) {
+                int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+                t = im[i]; im[i] = im[j]; im[j] = t;
+            }
+        }
+
+        const uint16_t quarter = VIBRATION_FFT_MAX_POINTS / 4;
+        for (uint16_t length = 2; length <= points; length <<= 1) {
+            uint16_t half = length >> 1;
+            uint16_t stride = VIBRATION_FFT_MAX_POINTS / length;
+            for (uint16_t start = 0; start < points; start += length) {
+                for (uint16_t k = 0; k < half; k++) {
+                    uint16_t t = k * stride;
+                    int32_t wr = sine[(t + quarter) & (VIBRATION_FFT_MAX_POINTS - 1)];  // cos
+                    int32_t wi = -sine[t];                                             // e^-j
+                    uint16_t a = start + k;
+                    uint16_t b = a + half;
+                    int32_t xr = ((int32_t)re[b] * wr - (int32_t)im[b] * wi) >> 15;
+                    int32_t xi = ((int32_t)re[b] * wi + (int32_t)im[b] * wr) >> 15;
+                    int32_t ar = re[a];
+                    int32_t ai = im[a];
+                    re[a] = halve(ar + xr);
+                    im[a] = halve(ai + xi);
+                    re[b] = halve(ar - xr);
+                    im[b] = halve(ai - xi);
+                }
+            }
+        }
+    }
+
+    uint32_t binPower(uint16_t k) const {
+        return (uint32_t)((int32_t)re[k] * re[k]) + (uint32_t)((int32_t)im[k] * im[k]);
+    }
+
+    // First bin at or above hz, within [1, nyquistBin]
+    static uint16_t bandEdgeBin(uint16_t hz, float binHz, uint16_t nyquistBin) {
+        float bin = ceilf(hz / binHz);
+        if (bin < 1.0f) return 1;
+        if (bin > nyquistBin) return nyquistBin;
+        return (uint16_t)bin;
+    }
+
+public:
+    VibrationAnalyzer() : tablesReady(false), transforms(0), lastMicros(0), maxMicros(0) {}
+
+    /**
+     * Spectrum of one axis of a window into out.dominantHz/bandRms[..][axis]
+     * @param samples Raw counts of this axis, `points` long (256 or 512)
+     * @param sum Sum of the samples (the window's sum for this axis)
+     * @param sampleRateHz Output data rate of the stream
+     * @param unitsPerCount Scale of one raw count (e.g. mg per LSB)
+     */
+    void analyzeAxis(const int16_t* samples, uint16_t points, int32_t sum, float sampleRateHz,
+                     float unitsPerCount, const VibrationBands& bands, uint8_t axis,
+                     VibrationFeatures& out) {
+        uint32_t startUs = micros();
+        if (!tablesReady) buildTables();
+        points = vibrationFftPoints(points);
+        uint16_t tableStride = VIBRATION_FFT_MAX_POINTS / points;
+
+        // Remove the mean, then shift the largest deviation up to 14 bits
+        int32_t mean = (sum >= 0 ? sum + points / 2 : sum - points / 2) / (int32_t)points;
+        int32_t largest = 1;
+        for (uint16_t i = 0; i < points; i++) {
+            int32_t deviation = abs((int32_t)samples[i] - mean);
+            if (deviation > largest) largest = deviation;
+        }
+        uint8_t shift = 0;
+        while (shift < 14 && (largest << (shift + 1)) <= VIBRATION_FFT_INPUT_LIMIT) shift++;
+
+        for (uint16_t i = 0; i < points; i++) {
+            int32_t x = ((int32_t)samples[i] - mean) << shift;
+            if (x > VIBRATION_FFT_INPUT_LIMIT) x = VIBRATION_FFT_INPUT_LIMIT;
+            if (x < -VIBRATION_FFT_INPUT_LIMIT) x = -VIBRATION_FFT_INPUT_LIMIT;
+            re[i] = (int16_t)((x * hann[i * tableStride]) >> 15);
+            im[i] = 0;
+        }
+
+        transform(points);
+
+        // Bin power -> mean square in counts^2: 2 / mean(w^2), undo the input shift
+        float binHz = sampleRateHz / points;
+        float powerScale = 2.0f / VIBRATION_HANN_POWER / (float)(1UL << (2 * shift));
+        uint16_t nyquistBin = points / 2;
+
+        uint16_t peakBin = 1;
+        uint32_t peakPower = 0;
+        for (uint16_t k = 1; k < nyquistBin; k++) {
+            uint32_t power = binPower(k);
+            if (power > peakPower) {
+                peakPower = power;
+                peakBin = k;
+            }
+        }
+        float delta = 0.0f;
+        if (peakPower > 0 && peakBin + 1 < nyquistBin) {
+            float alpha = sqrtf((float)binPower(peakBin - 1));
+            float beta = sqrtf((float)peakPower);
+            float gamma = sqrtf((float)binPower(peakBin + 1));
+            float denominator = alpha - 2.0f * beta + gamma;
+            if (denominator < 0.0f) delta = 0.5f * (alpha - gamma) / denominator;
+        }
+        out.dominantHz[axis] = peakPower > 0 ? (peakBin + delta) * binHz : 0.0f;
+
+        // Bins k with lowHz <= k * binHz < highHz, worked out once per band
+        // so the bin loop has no float compares (soft-float on the M0+)
+        out.bandCount = bands.count;
+        for (uint8_t b = 0; b < VIBRATION_MAX_BANDS; b++) {
+            out.bandRms[b][axis] = 0.0f;
+            if (b >= bands.count) continue;
+            uint16_t firstBin = bandEdgeBin(bands.band[b].lowHz, binHz, nyquistBin);
+            uint16_t endBin = bandEdgeBin(bands.band[b].highHz, binHz, nyquistBin);
+            uint64_t power = 0;
+            for (uint16_t k = firstBin; k < endBin; k++) {
+                power += binPower(k);
+            }
+            out.bandRms[b][axis] = sqrtf((float)power * powerScale) * unitsPerCount;
+        }
+
+        transforms++;
+        lastMicros = micros() - startUs;
+        if (lastMicros > maxMicros) maxMicros = lastMicros;
+    }
+
+    uint32_t getTransformCount() const { return transforms; }
+    uint32_t getLastMicros() const { return lastMicros; }
+    uint32_t getMaxMicros() const { return maxMicros; }
+};
+
+// Global instance
+extern VibrationAnalyzer vibrationAnalyzer;
@@ -64,7 +64,7 @@ int ModbusRTUServerClass::poll()
   int requestLength = modbus_receive(_mb, request);
 
   if (requestLength > 0) {
-    modbus_reply(_mb, request, requestLength, &_mbMapping);
+    modbus_reply(_mb, request, requestLength, replyMapping());
     return 1;
   }
   return 0;
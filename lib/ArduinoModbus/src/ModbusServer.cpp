@@ -22,7 +22,8 @@
 #include "ModbusServer.h"
 
 ModbusServer::ModbusServer() :
-  _mb(NULL)
+  _mb(NULL),
+  _image(NULL)
 {
   memset(&_mbMapping, 0x00, sizeof(_mbMapping));
 }
@@ -300,6 +301,16 @@ int ModbusServer::begin(modbus_t* mb, int id)
   return 1;
 }
 
+void ModbusServer::serveFrom(ModbusServer* image)
+{
+  _image = (image == this) ? NULL : image;
+}
+
+modbus_mapping_t* ModbusServer::replyMapping()
+{
+  return (_image != NULL) ? &_image->_mbMapping : &_mbMapping;
+}
+
 void ModbusServer::end()
 {
   if (_mbMapping.tab_bits != NULL) {
@@ -124,6 +124,14 @@ public:
    */
   int writeInputRegisters(int address, uint16_t values[], int nb);
 
+  /**
+   * Serve requests from another server's coils, discrete inputs and registers
+   * instead of this server's own. Lets several connections share one image.
+   *
+   * @param image server owning the mapping, or NULL to use this server's own
+   */
+  void serveFrom(ModbusServer* image);
+
   /**
    * Poll for requests
    * 
@@ -142,9 +150,12 @@ protected:
 
   int begin(modbus_t* _mb, int id);
 
+  modbus_mapping_t* replyMapping();
+
 protected:
   modbus_t* _mb;
   modbus_mapping_t _mbMapping;
+  ModbusServer* _image;
 };
 
 #endif
@@ -65,7 +65,7 @@ int ModbusTCPServer::poll()
     int requestLength = modbus_receive(_mb, request);
 
     if (requestLength > 0) {
-      modbus_reply(_mb, request, requestLength, &_mbMapping);
+      modbus_reply(_mb, request, requestLength, replyMapping());
       return 1;
     }
   }
@@ -0,0 +1,358 @@
+#include "Arduino.h"
+#include "NativeSim.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <sched.h>
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+
+RP2040 rp2040;
+
+// ============================================================================
+// VIRTUAL CLOCK
+// ============================================================================
+
+namespace {
+
+const std::chrono::steady_clock::time_point kEpoch = std::chrono::steady_clock::now();
+
+std::atomic<uint8_t> clockMode{(uint8_t)NativeHAL::ClockMode::SKIP};
+std::atomic<uint64_t> skippedMicros{0};  // SKIP: time "spent" in delays
+std::atomic<uint64_t> steppedMicros{0};  // STEP: the whole clock
+
+uint64_t wallMicros() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - kEpoch).count();
+}
+
+int portOffset = 0;
+std::atomic<bool> serialQuiet{false};
+
+}  // namespace
+
+namespace NativeHAL {
+
+void setClockMode(ClockMode mode) {
+    clockMode = (uint8_t)mode;
+}
+
+ClockMode getClockMode() {
+    return (ClockMode)clockMode.load();
+}
+
+uint64_t nowMicros() {
+    switch (getClockMode()) {
+        case ClockMode::REALTIME:
+            return wallMicros();
+        case ClockMode::STEP:
+            return steppedMicros.fetch_add(1) + 1;
+        case ClockMode::SKIP:
+        default:
+            return wallMicros() + skippedMicros.load();
+    }
+}
+
+void advanceMicros(uint64_t us) {
+    if (us == 0) return;
+    switch (getClockMode()) {
+        case ClockMode::REALTIME: {
+            // Short waits spin like the target's busy-loop: a sleeping thread
+            // overshoots by tens of microseconds and breaks bit-banged timing
+            uint64_t until = wallMicros() + us;
+            if (us > 2000) {
+                std::this_thread::sleep_for(std::chrono::microseconds(us - 1000));
+            }
+            while (wallMicros() < until) {
+            }
+            break;
+        }
+        case ClockMode::STEP:
+            steppedMicros += us;
+            break;
+        case ClockMode::SKIP:
+        default:
+            skippedMicros += us;
+            break;
+    }
+}
+
+void setPortOffset(int offset) {
+    portOffset = offset;
+}
+
+int getPortOffset() {
+    return portOffset;
+}
+
+void setSerialQuiet(bool quiet) {
+    serialQuiet = quiet;
+}
+
+bool isSerialQuiet() {
+    return serialQuiet;
+}
+
+}  // namespace NativeHAL
+
+extern "C" {
+
+unsigned long millis(void) {
+    return (unsigned long)(NativeHAL::nowMicros() / 1000);
+}
+
+unsigned long micros(void) {
+    return (unsigned long)NativeHAL::nowMicros();
+}
+
+void delay(unsigned long ms) {
+    NativeHAL::advanceMicros((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    NativeHAL::advanceMicros(us);
+}
+
+void yield(void) {
+    if (NativeHAL::getClockMode() == NativeHAL::ClockMode::STEP) {
+        steppedMicros += 10;
+    } else {
+        sched_yield();
+    }
+}
+
+// ============================================================================
+// GPIO / ADC
+// ============================================================================
+
+namespace {
+
+const int kPins = NUM_DIGITAL_PINS;
+
+// Atomic fields: both "cores" access the table, like the RP2040's SIO registers
+struct PinState {
+    std::atomic<int> mode{INPUT};
+    std::atomic<int> latch{LOW};
+    std::atomic<int> forced{-1};     // level injected by NativeHAL::setDigitalInput()
+    std::atomic<uint16_t> analog{2048};
+};
+
+PinState pins[kPins];
+int analogBits = 10;
+std::recursive_mutex interruptLock;
+
+bool isOutputMode(int mode) {
+    return mode == OUTPUT || (mode >= OUTPUT_2MA && mode <= OUTPUT_12MA);
+}
+
+bool drivesLow(const PinState& p) {
+    return isOutputMode(p.mode) && p.latch == LOW;
+}
+
+void updateDrive(int pin, bool wasLow) {
+    bool isLow = drivesLow(pins[pin]);
+    if (isLow != wasLow) {
+        NativeSim::onMasterDrive(pin, isLow, NativeHAL::nowMicros());
+    }
+}
+
+}  // namespace
+
+void pinMode(pin_size_t pin, int mode) {
+    if (pin >= (pin_size_t)kPins) return;
+    bool wasLow = drivesLow(pins[pin]);
+    pins[pin].mode = mode;
+    updateDrive((int)pin, wasLow);
+}
+
+void digitalWrite(pin_size_t pin, int value) {
+    if (pin >= (pin_size_t)kPins) return;
+    bool wasLow = drivesLow(pins[pin]);
+    pins[pin].latch = value ? HIGH : LOW;
+    updateDrive((int)pin, wasLow);
+}
+
+int digitalRead(pin_size_t pin) {
+    if (pin >= (pin_size_t)kPins) return LOW;
+    const PinState& p = pins[pin];
+    if (isOutputMode(p.mode)) return p.latch;
+    if (NativeSim::isLineHeldLow((int)pin, NativeHAL::nowMicros())) return LOW;
+    if (p.forced >= 0) return p.forced;
+    return p.mode == INPUT_PULLUP ? HIGH : LOW;
+}
+
+int analogRead(pin_size_t pin) {
+    // Accept both GPIO numbers (26-29) and channel numbers (0-3)
+    if (pin < 4) pin += A0;
+    if (pin >= (pin_size_t)kPins) return 0;
+    uint16_t raw12 = pins[pin].analog;
+    return analogBits >= 12 ? (int)raw12 << (analogBits - 12) : (int)raw12 >> (12 - analogBits);
+}
+
+void analogReadResolution(int bits) {
+    if (bits >= 1 && bits <= 16) analogBits = bits;
+}
+
+void analogWrite(pin_size_t pin, int value) {
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, value ? HIGH : LOW);
+}
+
+void analogWriteResolution(int bits) {
+    (void)bits;
+}
+
+void analogWriteFreq(uint32_t freq) {
+    (void)freq;
+}
+
+void attachInterrupt(pin_size_t pin, void (*callback)(void), int mode) {
+    (void)pin;
+    (void)callback;
+    (void)mode;
+}
+
+void detachInterrupt(pin_size_t pin) {
+    (void)pin;
+}
+
+// Maps to a process-wide lock so critical sections still exclude the other "core"
+void noInterrupts(void) {
+    interruptLock.lock();
+}
+
+void interrupts(void) {
+    interruptLock.unlock();
+}
+
+// ============================================================================
+// STRING HELPERS (glibc < 2.38 lacks strlcpy/strlcat)
+// ============================================================================
+
+__attribute__((weak)) size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len >= size ? size - 1 : len;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+
+__attribute__((weak)) size_t strlcat(char* dst, const char* src, size_t size) {
+    size_t dlen = strnlen(dst, size);
+    if (dlen == size) return size + strlen(src);
+    return dlen + strlcpy(dst + dlen, src, size - dlen);
+}
+
+}  // extern "C"
+
+// ============================================================================
+// RANDOM
+// ============================================================================
+
+static std::mt19937& rng() {
+    static std::mt19937 engine(12345);
+    return engine;
+}
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return (long)(rng()() % (unsigned long)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) rng().seed((uint32_t)seed);
+}
+
+// ============================================================================
+// GPIO SIMULATION HOOKS
+// ============================================================================
+
+namespace NativeHAL {
+
+void setDigitalInput(int pin, int level) {
+    if (pin >= 0 && pin < kPins) pins[pin].forced = level ? HIGH : LOW;
+}
+
+void clearDigitalInput(int pin) {
+    if (pin >= 0 && pin < kPins) pins[pin].forced = -1;
+}
+
+void setAnalogInput(int pin, uint16_t raw12) {
+    if (pin < 4) pin += A0;
+    if (pin >= 0 && pin < kPins) pins[pin].analog = raw12 > 4095 ? 4095 : raw12;
+}
+
+int getPinMode(int pin) {
+    return (pin >= 0 && pin < kPins) ? pins[pin].mode.load() : -1;
+}
+
+int getPinLevel(int pin) {
+    return (pin >= 0 && pin < kPins) ? digitalRead((pin_size_t)pin) : -1;
+}
+
+void waitForInterrupts() {
+    std::lock_guard<std::recursive_mutex> guard(interruptLock);
+}
+
+}  // namespace NativeHAL
+
+// ============================================================================
+// RP2040
+// ============================================================================
+
+void RP2040::wdt_begin(uint32_t delay_ms) {
+    _wdtTimeoutMs = delay_ms;
+    _wdtLastResetMs = millis();
+}
+
+void RP2040::wdt_reset() {
+    unsigned long now = millis();
+    if (_wdtTimeoutMs == 0) return;
+    uint32_t gap = (uint32_t)(now - _wdtLastResetMs);
+    if (gap > _wdtLongestGapMs) _wdtLongestGapMs = gap;
+    if (gap > _wdtTimeoutMs) {
+        _wdtTrips++;
+        fprintf(stderr, "[NativeHAL] watchdog: %u ms between resets (timeout %u ms)\n",
+                (unsigned)gap, (unsigned)_wdtTimeoutMs);
+    }
+    _wdtLastResetMs = now;
+}
+
+// Report the RP2040's 264 KB SRAM budget; the host heap is not representative
+static const int kTotalHeap = 264 * 1024;
+
+int RP2040::getFreeHeap() {
+    return kTotalHeap - getUsedHeap();
+}
+
+int RP2040::getUsedHeap() {
+    return 64 * 1024;
+}
+
+int RP2040::getTotalHeap() {
+    return kTotalHeap;
+}
+
+uint32_t RP2040::getCycleCount() {
+    return (uint32_t)getCycleCount64();
+}
+
+uint64_t RP2040::getCycleCount64() {
+    return NativeHAL::nowMicros() * (F_CPU / 1000000);
+}
+
+void RP2040::reboot() {
+    fprintf(stderr, "[NativeHAL] rp2040.reboot() requested, exiting\n");
+    fflush(stdout);
+    exit(0);
+}
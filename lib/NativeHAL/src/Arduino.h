@@ -0,0 +1,284 @@
+#pragma once
+
+/**
+ * NativeHAL - Arduino core replacement for the host-native build
+ *
+ * Provides the subset of the arduino-pico (earlephilhower) core API used by
+ * src/main.cpp, include/sys_init.h, include/i2c_bus_manager.h and the vendored
+ * libraries, implemented on top of Linux:
+ * - Virtual clock for millis()/micros()/delay() (see NativeHAL::ClockMode)
+ * - GPIO/ADC state tables with simulation hooks (see NativeSim.h)
+ * - rp2040 object (watchdog, heap and cycle counter queries)
+ *
+ * This header must stay valid C: libmodbus (modbus.c) includes it.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+
+// ============================================================================
+// CORE CONSTANTS
+// ============================================================================
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT            0x0
+#define OUTPUT           0x1
+#define INPUT_PULLUP     0x2
+#define INPUT_PULLDOWN   0x3
+#define OUTPUT_2MA       0x4
+#define OUTPUT_4MA       0x5
+#define OUTPUT_8MA       0x6
+#define OUTPUT_12MA      0x7
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PI          3.1415926535897932384626433832795
+#define HALF_PI     1.5707963267948966192313216916398
+#define TWO_PI      6.283185307179586476925286766559
+#define DEG_TO_RAD  0.017453292519943295769236907684886
+#define RAD_TO_DEG  57.295779513082320876798154814105
+
+#define F_CPU 133000000L
+
+// W5500-EVB-PoE-Pico / Raspberry Pi Pico pin names
+#define LED_BUILTIN 25
+#define PIN_LED     25
+#define NUM_DIGITAL_PINS 30
+#define A0 26
+#define A1 27
+#define A2 28
+#define A3 29
+#define PIN_WIRE0_SDA 4
+#define PIN_WIRE0_SCL 5
+#define PIN_WIRE1_SDA 26
+#define PIN_WIRE1_SCL 27
+#define PIN_SERIAL1_TX 0
+#define PIN_SERIAL1_RX 1
+#define PIN_SERIAL2_TX 8
+#define PIN_SERIAL2_RX 9
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+#define digitalPinToInterrupt(p) (p)
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+typedef unsigned int pin_size_t;
+typedef int PinMode;
+typedef int PinStatus;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// TIME
+// ============================================================================
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+// ============================================================================
+// GPIO / ADC
+// ============================================================================
+
+void pinMode(pin_size_t pin, int mode);
+void digitalWrite(pin_size_t pin, int value);
+int digitalRead(pin_size_t pin);
+int analogRead(pin_size_t pin);
+void analogReadResolution(int bits);
+void analogWrite(pin_size_t pin, int value);
+void analogWriteResolution(int bits);
+void analogWriteFreq(uint32_t freq);
+void attachInterrupt(pin_size_t pin, void (*callback)(void), int mode);
+void detachInterrupt(pin_size_t pin);
+
+void noInterrupts(void);
+void interrupts(void);
+
+#if defined(__GLIBC__) && ((__GLIBC__ < 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+size_t strlcpy(char* dst, const char* src, size_t size);
+size_t strlcat(char* dst, const char* src, size_t size);
+#endif
+
+#ifdef __cplusplus
+}  // extern "C"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using std::isnan;
+using std::isinf;
+using std::abs;
+
+template <class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+    return (b < a) ? b : a;
+}
+
+template <class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+    return (a < b) ? b : a;
+}
+
+template <class T, class L, class H>
+T constrain(const T& x, const L& low, const H& high) {
+    return (x < low) ? low : ((x > high) ? high : x);
+}
+
+template <class T>
+T sq(const T& x) {
+    return x * x;
+}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isAlphaNumeric(int c) { return isalnum(c) != 0; }
+inline bool isSpace(int c) { return isspace(c) != 0; }
+inline bool isWhitespace(int c) { return c == ' ' || c == '\t'; }
+inline bool isPrintable(int c) { return isprint(c) != 0; }
+inline bool isHexadecimalDigit(int c) { return isxdigit(c) != 0; }
+inline bool isUpperCase(int c) { return isupper(c) != 0; }
+inline bool isLowerCase(int c) { return islower(c) != 0; }
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+#include "WString.h"
+#include "Printable.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+#include "HardwareSerial.h"
+
+// ============================================================================
+// RP2040 CORE OBJECT
+// ============================================================================
+
+/**
+ * Host stand-in for the arduino-pico `rp2040` object.
+ *
+ * The watchdog is not armed on the host; instead wdt_reset() records the
+ * longest gap between resets and reports any gap that would have tripped the
+ * hardware watchdog, which makes blocking loop() paths visible under test.
+ */
+class RP2040 {
+public:
+    void wdt_begin(uint32_t delay_ms);
+    void wdt_reset();
+    uint32_t wdtLongestGapMs() const { return _wdtLongestGapMs; }
+    uint32_t wdtTrips() const { return _wdtTrips; }
+
+    int getFreeHeap();
+    int getUsedHeap();
+    int getTotalHeap();
+
+    uint32_t getCycleCount();
+    uint64_t getCycleCount64();
+    uint32_t f_cpu() { return F_CPU; }
+
+    void reboot();
+    void restart() { reboot(); }
+    void idleOtherCore() {}
+    void resumeOtherCore() {}
+
+private:
+    uint32_t _wdtTimeoutMs = 0;
+    unsigned long _wdtLastResetMs = 0;
+    uint32_t _wdtLongestGapMs = 0;
+    uint32_t _wdtTrips = 0;
+};
+
+extern RP2040 rp2040;
+
+// ============================================================================
+// NATIVE HAL CONTROL
+// ============================================================================
+
+namespace NativeHAL {
+
+/**
+ * Clock behaviour for millis()/micros()/delay()
+ * - SKIP:     wall clock plus all time "spent" in delay(); delays return
+ *             immediately so setup()/loop() run at full host speed (default)
+ * - REALTIME: wall clock; delays really sleep (for interactive use)
+ * - STEP:     fully virtual and deterministic; time only advances through
+ *             delays, advanceMicros() and 1 us per clock read (valgrind runs)
+ */
+enum class ClockMode : uint8_t {
+    SKIP = 0,
+    REALTIME = 1,
+    STEP = 2
+};
+
+void setClockMode(ClockMode mode);
+ClockMode getClockMode();
+uint64_t nowMicros();
+void advanceMicros(uint64_t us);
+
+/** Offset added to every WiFiServer port so the host can bind 80/502 unprivileged */
+void setPortOffset(int offset);
+int getPortOffset();
+
+/** Discard Serial (USB CDC) output, e.g. while profiling */
+void setSerialQuiet(bool quiet);
+bool isSerialQuiet();
+
+/**
+ * Block while either core has interrupts masked (noInterrupts()). On the
+ * device lwIP and the W5500 are serviced from interrupts, so the socket
+ * classes call this before touching the network.
+ */
+void waitForInterrupts();
+
+/** GPIO simulation hooks */
+void setDigitalInput(int pin, int level);
+void clearDigitalInput(int pin);
+void setAnalogInput(int pin, uint16_t raw12);
+int getPinMode(int pin);
+int getPinLevel(int pin);
+
+}  // namespace NativeHAL
+
+#endif  // __cplusplus
@@ -0,0 +1,230 @@
+#include "Arduino.h"
+
+#include <poll.h>
+#include <unistd.h>
+
+SerialUSB Serial;
+SerialUART Serial1(0, PIN_SERIAL1_TX, PIN_SERIAL1_RX);
+SerialUART Serial2(1, PIN_SERIAL2_TX, PIN_SERIAL2_RX);
+
+// ============================================================================
+// SerialUSB
+// ============================================================================
+
+void SerialUSB::begin(unsigned long baud, uint16_t config) {
+    (void)baud;
+    (void)config;
+}
+
+void SerialUSB::pollStdin() {
+    if (_stdinClosed) return;
+    struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    while (poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLIN | POLLHUP))) {
+        uint8_t buf[64];
+        ssize_t n = ::read(STDIN_FILENO, buf, sizeof(buf));
+        if (n <= 0) {
+            _stdinClosed = true;
+            return;
+        }
+        _rx.insert(_rx.end(), buf, buf + n);
+    }
+}
+
+int SerialUSB::available() {
+    pollStdin();
+    return (int)_rx.size();
+}
+
+int SerialUSB::read() {
+    pollStdin();
+    if (_rx.empty()) return -1;
+    int c = _rx.front();
+    _rx.pop_front();
+    return c;
+}
+
+int SerialUSB::peek() {
+    pollStdin();
+    return _rx.empty() ? -1 : _rx.front();
+}
+
+size_t SerialUSB::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t SerialUSB::write(const uint8_t* buffer, size_t size) {
+    if (NativeHAL::isSerialQuiet()) return size;
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void SerialUSB::flush() {
+    fflush(stdout);
+}
+
+// ============================================================================
+// SerialUART
+// ============================================================================
+
+SerialUART::SerialUART(int uart, pin_size_t tx, pin_size_t rx) : _uart(uart), _tx(tx), _rx(rx) {}
+
+bool SerialUART::validTX(pin_size_t pin) const {
+    static const uint32_t uart0 = (1u << 0) | (1u << 12) | (1u << 16) | (1u << 28);
+    static const uint32_t uart1 = (1u << 4) | (1u << 8) | (1u << 20) | (1u << 24);
+    return pin < 30 && ((_uart == 0 ? uart0 : uart1) & (1u << pin));
+}
+
+bool SerialUART::validRX(pin_size_t pin) const {
+    static const uint32_t uart0 = (1u << 1) | (1u << 13) | (1u << 17) | (1u << 29);
+    static const uint32_t uart1 = (1u << 5) | (1u << 9) | (1u << 21) | (1u << 25);
+    return pin < 30 && ((_uart == 0 ? uart0 : uart1) & (1u << pin));
+}
+
+bool SerialUART::setTX(pin_size_t pin) {
+    if (!validTX(pin)) {
+        fprintf(stderr, "[NativeHAL] UART%d: illegal TX pin %u\n", _uart, (unsigned)pin);
+        return false;
+    }
+    if (_running) {
+        fprintf(stderr, "[NativeHAL] UART%d: cannot change TX while running\n", _uart);
+        return false;
+    }
+    _tx = pin;
+    return true;
+}
+
+bool SerialUART::setRX(pin_size_t pin) {
+    if (!validRX(pin)) {
+        fprintf(stderr, "[NativeHAL] UART%d: illegal RX pin %u\n", _uart, (unsigned)pin);
+        return false;
+    }
+    if (_running) {
+        fprintf(stderr, "[NativeHAL] UART%d: cannot change RX while running\n", _uart);
+        return false;
+    }
+    _rx = pin;
+    return true;
+}
+
+bool SerialUART::setFIFOSize(size_t size) {
+    if (size == 0 || _running) return false;
+    _fifoSize = size;
+    return true;
+}
+
+void SerialUART::begin(unsigned long baud, uint16_t config) {
+    if (_running) end();
+    _baud = baud ? baud : 115200;
+    _config = config;
+    _rxRing.assign(_fifoSize + 32, 0);
+    _rxHead = 0;
+    _rxCount = 0;
+    _inFlight.clear();
+    _txBusyUntil = NativeHAL::nowMicros();
+    _lastReplyAt = 0;
+    _device = NativeSim::findUartDevice((int)_tx, (int)_rx);
+    _running = true;
+}
+
+void SerialUART::end() {
+    _running = false;
+    _device = nullptr;
+    _inFlight.clear();
+    _rxCount = 0;
+}
+
+uint32_t SerialUART::byteTimeMicros() const {
+    uint32_t dataBits = ((_config & SERIAL_DATA_MASK) >> 8) + 4;
+    uint32_t parityBits = (_config & SERIAL_PARITY_MASK) == SERIAL_PARITY_NONE ? 0 : 1;
+    uint32_t stopBits = (_config & SERIAL_STOP_BIT_MASK) == SERIAL_STOP_BIT_2 ? 2 : 1;
+    uint32_t bits = 1 + dataBits + parityBits + stopBits;
+    return (uint32_t)((bits * 1000000ULL + _baud - 1) / _baud);
+}
+
+void SerialUART::settle() {
+    uint64_t now = NativeHAL::nowMicros();
+    while (!_inFlight.empty() && _inFlight.front().at <= now) {
+        if (_rxCount < _rxRing.size()) {
+            _rxRing[(_rxHead + _rxCount) % _rxRing.size()] = _inFlight.front().value;
+            _rxCount++;
+        } else {
+            _overruns++;
+        }
+        _inFlight.pop_front();
+    }
+}
+
+void SerialUART::reply(const uint8_t* data, size_t length, uint64_t startMicros) {
+    if (!_running) return;
+    uint32_t byteTime = byteTimeMicros();
+    // Replies are serialized on the wire behind anything still being sent
+    uint64_t at = startMicros > _lastReplyAt ? startMicros : _lastReplyAt;
+    for (size_t i = 0; i < length; i++) {
+        at += byteTime;
+        _inFlight.push_back({data[i], at});
+    }
+    _lastReplyAt = at;
+}
+
+int SerialUART::available() {
+    if (!_running) return 0;
+    settle();
+    return (int)_rxCount;
+}
+
+int SerialUART::read() {
+    if (!_running) return -1;
+    settle();
+    if (_rxCount == 0) return -1;
+    uint8_t c = _rxRing[_rxHead];
+    _rxHead = (_rxHead + 1) % _rxRing.size();
+    _rxCount--;
+    return c;
+}
+
+int SerialUART::peek() {
+    if (!_running) return -1;
+    settle();
+    return _rxCount ? _rxRing[_rxHead] : -1;
+}
+
+int SerialUART::availableForWrite() {
+    if (!_running) return 0;
+    uint64_t now = NativeHAL::nowMicros();
+    uint64_t backlog = _txBusyUntil > now ? (_txBusyUntil - now) / byteTimeMicros() : 0;
+    return backlog >= 32 ? 0 : (int)(32 - backlog);
+}
+
+size_t SerialUART::write(uint8_t c) {
+    if (!_running) return 0;
+    uint32_t byteTime = byteTimeMicros();
+    uint64_t now = NativeHAL::nowMicros();
+
+    // TX FIFO is 32 deep; a full FIFO blocks the writer like the real driver
+    if (_txBusyUntil > now + 32ULL * byteTime) {
+        delayMicroseconds((unsigned int)(_txBusyUntil - now - 32ULL * byteTime));
+        now = NativeHAL::nowMicros();
+    }
+
+    uint64_t start = _txBusyUntil > now ? _txBusyUntil : now;
+    _txBusyUntil = start + byteTime;
+    if (_device) {
+        _device->onByte(*this, c, _txBusyUntil);
+    }
+    return 1;
+}
+
+size_t SerialUART::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (written < size && write(buffer[written])) {
+        written++;
+    }
+    return written;
+}
+
+void SerialUART::flush() {
+    if (!_running) return;
+    uint64_t now = NativeHAL::nowMicros();
+    if (_txBusyUntil > now) {
+        delayMicroseconds((unsigned int)(_txBusyUntil - now));
+    }
+}
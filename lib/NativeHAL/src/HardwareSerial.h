@@ -0,0 +1,159 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <vector>
+
+#include "Stream.h"
+#include "NativeSim.h"
+
+// ============================================================================
+// SERIAL FRAMING (arduino-pico encoding)
+// ============================================================================
+
+#define SERIAL_PARITY_EVEN   (0x1ul)
+#define SERIAL_PARITY_ODD    (0x2ul)
+#define SERIAL_PARITY_NONE   (0x3ul)
+#define SERIAL_PARITY_MARK   (0x4ul)
+#define SERIAL_PARITY_SPACE  (0x5ul)
+#define SERIAL_PARITY_MASK   (0xFul)
+
+#define SERIAL_STOP_BIT_1    (0x10ul)
+#define SERIAL_STOP_BIT_1_5  (0x20ul)
+#define SERIAL_STOP_BIT_2    (0x30ul)
+#define SERIAL_STOP_BIT_MASK (0xF0ul)
+
+#define SERIAL_DATA_5        (0x100ul)
+#define SERIAL_DATA_6        (0x200ul)
+#define SERIAL_DATA_7        (0x300ul)
+#define SERIAL_DATA_8        (0x400ul)
+#define SERIAL_DATA_MASK     (0xF00ul)
+
+#define SERIAL_5N1 (SERIAL_STOP_BIT_1 | SERIAL_PARITY_NONE | SERIAL_DATA_5)
+#define SERIAL_6N1 (SERIAL_STOP_BIT_1 | SERIAL_PARITY_NONE | SERIAL_DATA_6)
+#define SERIAL_7N1 (SERIAL_STOP_BIT_1 | SERIAL_PARITY_NONE | SERIAL_DATA_7)
+#define SERIAL_8N1 (SERIAL_STOP_BIT_1 | SERIAL_PARITY_NONE | SERIAL_DATA_8)
+#define SERIAL_8N2 (SERIAL_STOP_BIT_2 | SERIAL_PARITY_NONE | SERIAL_DATA_8)
+#define SERIAL_7E1 (SERIAL_STOP_BIT_1 | SERIAL_PARITY_EVEN | SERIAL_DATA_7)
+#define SERIAL_8E1 (SERIAL_STOP_BIT_1 | SERIAL_PARITY_EVEN | SERIAL_DATA_8)
+#define SERIAL_7O1 (SERIAL_STOP_BIT_1 | SERIAL_PARITY_ODD  | SERIAL_DATA_7)
+#define SERIAL_8O1 (SERIAL_STOP_BIT_1 | SERIAL_PARITY_ODD  | SERIAL_DATA_8)
+
+/**
+ * Common base for the USB console and the hardware UARTs
+ */
+class HardwareSerial : public Stream {
+public:
+    virtual void begin(unsigned long baud) { begin(baud, SERIAL_8N1); }
+    virtual void begin(unsigned long baud, uint16_t config) = 0;
+    virtual void end() = 0;
+    virtual operator bool() = 0;
+
+    using Print::write;
+};
+
+// ============================================================================
+// USB CDC CONSOLE (Serial) -> host stdout / stdin
+// ============================================================================
+
+class SerialUSB : public HardwareSerial {
+public:
+    using HardwareSerial::begin;
+    void begin(unsigned long baud, uint16_t config) override;
+    void end() override {}
+    operator bool() override { return true; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int availableForWrite() override { return 256; }
+    void flush() override;
+
+    using Print::write;
+
+private:
+    std::deque<uint8_t> _rx;
+    bool _stdinClosed = false;
+
+    void pollStdin();
+};
+
+// ============================================================================
+// HARDWARE UART (Serial1 = UART0, Serial2 = UART1)
+// ============================================================================
+
+/**
+ * RP2040 PL011 UART model
+ *
+ * Bytes written are delivered to the simulated device attached to the
+ * port's pins (NativeSim::attachUartDevice) when their stop bit would have
+ * left the wire at the configured baud. Device replies land in the RX path
+ * with per-byte arrival times; bytes that have not "arrived" yet are not
+ * visible to available()/read(). The receive side holds the 32-byte
+ * hardware FIFO plus the software FIFO (setFIFOSize); bytes arriving while
+ * both are full are dropped and counted as overruns, as on the target.
+ */
+class SerialUART : public HardwareSerial, public NativeSim::UartLink {
+public:
+    SerialUART(int uart, pin_size_t tx, pin_size_t rx);
+
+    bool setTX(pin_size_t pin);
+    bool setRX(pin_size_t pin);
+    bool setFIFOSize(size_t size);
+
+    using HardwareSerial::begin;
+    void begin(unsigned long baud, uint16_t config) override;
+    void end() override;
+    operator bool() override { return _running; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int availableForWrite() override;
+    void flush() override;
+
+    using Print::write;
+
+    // NativeSim::UartLink
+    void reply(const uint8_t* data, size_t length, uint64_t startMicros) override;
+    uint32_t byteTimeMicros() const override;
+
+    /** Bytes lost because the receive FIFOs were full */
+    uint32_t overruns() const { return _overruns; }
+
+private:
+    struct PendingByte {
+        uint8_t value;
+        uint64_t at;
+    };
+
+    int _uart;
+    pin_size_t _tx;
+    pin_size_t _rx;
+    bool _running = false;
+    unsigned long _baud = 115200;
+    uint16_t _config = SERIAL_8N1;
+    size_t _fifoSize = 32;
+    uint32_t _overruns = 0;
+    uint64_t _txBusyUntil = 0;
+    uint64_t _lastReplyAt = 0;
+    NativeSim::UartDevice* _device = nullptr;
+
+    std::deque<PendingByte> _inFlight;
+    std::vector<uint8_t> _rxRing;
+    size_t _rxHead = 0;
+    size_t _rxCount = 0;
+
+    void settle();
+    bool validTX(pin_size_t pin) const;
+    bool validRX(pin_size_t pin) const;
+};
+
+extern SerialUSB Serial;
+extern SerialUART Serial1;
+extern SerialUART Serial2;
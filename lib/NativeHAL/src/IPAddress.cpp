@@ -0,0 +1,27 @@
+#include "IPAddress.h"
+#include "Print.h"
+
+#include <stdio.h>
+
+bool IPAddress::fromString(const char* address) {
+    unsigned int a, b, c, d;
+    char tail;
+    if (!address || sscanf(address, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4) {
+        return false;
+    }
+    if (a > 255 || b > 255 || c > 255 || d > 255) {
+        return false;
+    }
+    *this = IPAddress((uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d);
+    return true;
+}
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address[0], _address[1], _address[2], _address[3]);
+    return String(buf);
+}
+
+size_t IPAddress::printTo(Print& p) const {
+    return p.print(toString());
+}
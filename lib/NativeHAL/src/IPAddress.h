@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Printable.h"
+#include "WString.h"
+
+/**
+ * IPv4 address (lwIP IPAddress subset used by the firmware)
+ */
+class IPAddress : public Printable {
+public:
+    IPAddress() : _address{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address{a, b, c, d} {}
+    IPAddress(uint32_t address) { *this = address; }
+    IPAddress(const uint8_t* address) : _address{address[0], address[1], address[2], address[3]} {}
+
+    IPAddress& operator=(uint32_t address) {
+        _address[0] = (uint8_t)(address & 0xFF);
+        _address[1] = (uint8_t)((address >> 8) & 0xFF);
+        _address[2] = (uint8_t)((address >> 16) & 0xFF);
+        _address[3] = (uint8_t)((address >> 24) & 0xFF);
+        return *this;
+    }
+
+    /** Network-order packed value, same layout as lwIP's ip4_addr_t */
+    operator uint32_t() const {
+        return (uint32_t)_address[0] | ((uint32_t)_address[1] << 8) |
+               ((uint32_t)_address[2] << 16) | ((uint32_t)_address[3] << 24);
+    }
+
+    bool operator==(const IPAddress& rhs) const { return (uint32_t)*this == (uint32_t)rhs; }
+    bool operator!=(const IPAddress& rhs) const { return !(*this == rhs); }
+    uint8_t operator[](int index) const { return _address[index & 3]; }
+    uint8_t& operator[](int index) { return _address[index & 3]; }
+
+    bool isSet() const { return (uint32_t)*this != 0; }
+    bool fromString(const char* address);
+    bool fromString(const String& address) { return fromString(address.c_str()); }
+    String toString() const;
+
+    size_t printTo(Print& p) const override;
+
+private:
+    uint8_t _address[4];
+};
@@ -0,0 +1,150 @@
+#include "LittleFS.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LittleFSFS LittleFS;
+
+// Matches board_build.filesystem_size in platformio.ini
+static const size_t kFilesystemSize = 512 * 1024;
+
+// ============================================================================
+// File
+// ============================================================================
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!*this) return 0;
+    return fwrite(buf, 1, size, _handle->fp);
+}
+
+int File::available() {
+    if (!*this) return 0;
+    long remaining = (long)size() - (long)position();
+    return remaining > 0 ? (int)remaining : 0;
+}
+
+int File::read() {
+    if (!*this) return -1;
+    return fgetc(_handle->fp);
+}
+
+int File::read(uint8_t* buf, size_t size) {
+    if (!*this) return -1;
+    return (int)fread(buf, 1, size, _handle->fp);
+}
+
+int File::peek() {
+    if (!*this) return -1;
+    int c = fgetc(_handle->fp);
+    if (c != EOF) ungetc(c, _handle->fp);
+    return c;
+}
+
+void File::flush() {
+    if (*this) fflush(_handle->fp);
+}
+
+bool File::seek(uint32_t pos) {
+    return *this && fseek(_handle->fp, (long)pos, SEEK_SET) == 0;
+}
+
+size_t File::position() const {
+    if (!*this) return 0;
+    long pos = ftell(_handle->fp);
+    return pos > 0 ? (size_t)pos : 0;
+}
+
+size_t File::size() const {
+    if (!*this) return 0;
+    fflush(_handle->fp);
+    struct stat st;
+    return fstat(fileno(_handle->fp), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close() {
+    _handle.reset();
+}
+
+const char* File::name() const {
+    size_t slash = _path.find_last_of('/');
+    return slash == std::string::npos ? _path.c_str() : _path.c_str() + slash + 1;
+}
+
+// ============================================================================
+// LittleFSFS
+// ============================================================================
+
+std::string LittleFSFS::hostPath(const char* path) const {
+    std::string p = path ? path : "";
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return _root + p;
+}
+
+bool LittleFSFS::begin() {
+    struct stat st;
+    if (stat(_root.c_str(), &st) != 0) {
+        if (::mkdir(_root.c_str(), 0755) != 0) return false;
+    } else if (!S_ISDIR(st.st_mode)) {
+        return false;
+    }
+    _mounted = true;
+    return true;
+}
+
+bool LittleFSFS::format() {
+    DIR* dir = opendir(_root.c_str());
+    if (!dir) return begin();
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+        std::string p = _root + "/" + entry->d_name;
+        ::remove(p.c_str());
+    }
+    closedir(dir);
+    return true;
+}
+
+bool LittleFSFS::info(FSInfo& info) {
+    size_t used = 0;
+    if (DIR* dir = opendir(_root.c_str())) {
+        while (struct dirent* entry = readdir(dir)) {
+            struct stat st;
+            std::string p = _root + "/" + entry->d_name;
+            if (entry->d_name[0] != '.' && stat(p.c_str(), &st) == 0) used += (size_t)st.st_size;
+        }
+        closedir(dir);
+    }
+    info.totalBytes = kFilesystemSize;
+    info.usedBytes = used;
+    info.blockSize = 4096;
+    info.pageSize = 256;
+    info.maxOpenFiles = 16;
+    info.maxPathLength = 32;
+    return true;
+}
+
+File LittleFSFS::open(const char* path, const char* mode) {
+    if (!_mounted) return File();
+    std::string p = hostPath(path);
+    FILE* fp = fopen(p.c_str(), mode);
+    if (!fp) return File();
+    return File(fp, path ? path : "");
+}
+
+bool LittleFSFS::exists(const char* path) {
+    if (!_mounted) return false;
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool LittleFSFS::remove(const char* path) {
+    return _mounted && ::remove(hostPath(path).c_str()) == 0;
+}
+
+bool LittleFSFS::rename(const char* from, const char* to) {
+    return _mounted && ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool LittleFSFS::mkdir(const char* path) {
+    return _mounted && ::mkdir(hostPath(path).c_str(), 0755) == 0;
+}
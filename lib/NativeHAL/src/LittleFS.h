@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+#include <string>
+
+/**
+ * File handle (arduino-pico fs::File subset); copies share the open stream
+ */
+class File : public Stream {
+public:
+    File() {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t size);
+    int peek() override;
+    void flush() override;
+    size_t readBytes(char* buffer, size_t length) override { return (size_t)max(0, read((uint8_t*)buffer, length)); }
+
+    using Print::write;
+
+    bool seek(uint32_t pos);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    const char* name() const;
+    const char* fullName() const { return _path.c_str(); }
+    bool isDirectory() const { return false; }
+
+    operator bool() const { return _handle && _handle->fp; }
+
+private:
+    friend class LittleFSFS;
+
+    struct Handle {
+        explicit Handle(FILE* fp) : fp(fp) {}
+        ~Handle() { if (fp) fclose(fp); }
+        FILE* fp;
+    };
+
+    File(FILE* fp, const std::string& path) : _handle(std::make_shared<Handle>(fp)), _path(path) {}
+
+    std::shared_ptr<Handle> _handle;
+    std::string _path;
+};
+
+struct FSInfo {
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+/**
+ * LittleFS backed by a host directory
+ *
+ * Firmware paths ("/config.json") map to files under the root directory
+ * (default ./native_fs, see setRoot()), so the web UI assets and JSON
+ * configs can be seeded from the repo's data/ folder.
+ */
+class LittleFSFS {
+public:
+    void setRoot(const char* root) { _root = root ? root : "native_fs"; }
+    const char* getRoot() const { return _root.c_str(); }
+
+    bool begin();
+    void end() { _mounted = false; }
+    bool format();
+    bool info(FSInfo& info);
+
+    File open(const char* path, const char* mode = "r");
+    File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to);
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+    bool mkdir(const char* path);
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+
+private:
+    std::string _root = "native_fs";
+    bool _mounted = false;
+
+    std::string hostPath(const char* path) const;
+};
+
+extern LittleFSFS LittleFS;
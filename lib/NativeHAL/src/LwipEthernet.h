@@ -0,0 +1,6 @@
+#pragma once
+
+#include <Arduino.h>
+
+/** lwIP is not used on the host: sockets are serviced by the kernel */
+inline void lwipPollingPeriod(int ms) { (void)ms; }
@@ -0,0 +1,137 @@
+// Unit tests under test/ bring their own main() and drive setup()/loop() themselves
+#ifndef PIO_UNIT_TESTING
+
+#include "Arduino.h"
+#include "LittleFS.h"
+#include "NativeSim.h"
+
+#include <atomic>
+#include <signal.h>
+#include <thread>
+
+/**
+ * Host entry point: runs the firmware's setup()/loop() against NativeHAL
+ *
+ *   --fs DIR            LittleFS root directory (default ./native_fs)
+ *   --loops N           exit after N loop() iterations (default: run forever)
+ *   --clock MODE        skip | realtime | step (see NativeHAL::ClockMode)
+ *   --port-offset N     add N to every listening port (e.g. 8000 -> 8080/8502)
+ *   --quiet             discard Serial output
+ *   --no-sim            do not install the default simulated sensors
+ *
+ * If the firmware defines setup1()/loop1() they run on a second thread, started
+ * before setup() like arduino-pico starts core 1, and stopped when loop() stops.
+ *
+ * On exit (loop budget reached or SIGINT) a timing summary is printed to stderr.
+ */
+
+void setup();
+void loop();
+void setup1() __attribute__((weak));
+void loop1() __attribute__((weak));
+
+static volatile sig_atomic_t stopRequested = 0;
+static std::atomic<bool> core1StopRequested{false};
+static std::atomic<unsigned long long> core1Loops{0};
+
+static void core1Main() {
+    if (setup1) setup1();
+    while (!core1StopRequested.load()) {
+        if (loop1) loop1();
+        core1Loops++;
+    }
+}
+
+static void onSignal(int) {
+    stopRequested = 1;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--fs DIR] [--loops N] [--clock skip|realtime|step]\n"
+            "          [--port-offset N] [--quiet] [--no-sim]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    unsigned long long maxLoops = 0;
+    bool installSim = true;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--fs") == 0 && value) {
+            LittleFS.setRoot(value);
+            i++;
+        } else if (strcmp(arg, "--loops") == 0 && value) {
+            maxLoops = strtoull(value, nullptr, 10);
+            i++;
+        } else if (strcmp(arg, "--clock") == 0 && value) {
+            if (strcmp(value, "realtime") == 0) {
+                NativeHAL::setClockMode(NativeHAL::ClockMode::REALTIME);
+            } else if (strcmp(value, "step") == 0) {
+                NativeHAL::setClockMode(NativeHAL::ClockMode::STEP);
+            } else if (strcmp(value, "skip") == 0) {
+                NativeHAL::setClockMode(NativeHAL::ClockMode::SKIP);
+            } else {
+                usage(argv[0]);
+                return 2;
+            }
+            i++;
+        } else if (strcmp(arg, "--port-offset") == 0 && value) {
+            NativeHAL::setPortOffset(atoi(value));
+            i++;
+        } else if (strcmp(arg, "--quiet") == 0) {
+            NativeHAL::setSerialQuiet(true);
+        } else if (strcmp(arg, "--no-sim") == 0) {
+            installSim = false;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    if (installSim) {
+        NativeSim::installDefaultDevices();
+    }
+
+    std::thread core1;
+    if (setup1 || loop1) {
+        core1 = std::thread(core1Main);
+    }
+
+    uint64_t setupStart = NativeHAL::nowMicros();
+    setup();
+    uint64_t setupMicros = NativeHAL::nowMicros() - setupStart;
+
+    unsigned long long loops = 0;
+    uint64_t totalLoopMicros = 0;
+    uint64_t maxLoopMicros = 0;
+    while (!stopRequested && (maxLoops == 0 || loops < maxLoops)) {
+        uint64_t start = NativeHAL::nowMicros();
+        loop();
+        uint64_t elapsed = NativeHAL::nowMicros() - start;
+        totalLoopMicros += elapsed;
+        if (elapsed > maxLoopMicros) maxLoopMicros = elapsed;
+        loops++;
+    }
+
+    core1StopRequested = true;
+    if (core1.joinable()) core1.join();
+
+    Serial.flush();
+    fprintf(stderr,
+            "[NativeHAL] setup: %llu us, loops: %llu, avg loop: %llu us, max loop: %llu us\n"
+            "[NativeHAL] core1 loops: %llu\n"
+            "[NativeHAL] watchdog: longest gap %u ms, %u trips\n",
+            (unsigned long long)setupMicros, loops,
+            loops ? (unsigned long long)(totalLoopMicros / loops) : 0ULL,
+            (unsigned long long)maxLoopMicros, core1Loops.load(),
+            (unsigned)rp2040.wdtLongestGapMs(), (unsigned)rp2040.wdtTrips());
+    return 0;
+}
+
+#endif  // PIO_UNIT_TESTING
@@ -0,0 +1,806 @@
+#include "NativeSim.h"
+#include "Arduino.h"
+
+#include <math.h>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace NativeSim {
+
+// ============================================================================
+// SIGNAL MODELS
+// ============================================================================
+
+static double secondsAt(uint64_t atMicros) {
+    return (double)atMicros / 1000000.0;
+}
+
+float ambientTemperatureC(uint64_t atMicros) {
+    return (float)(22.0 + 1.5 * sin(2.0 * PI * secondsAt(atMicros) / 600.0));
+}
+
+float ambientHumidityRH(uint64_t atMicros) {
+    return (float)(45.0 + 5.0 * sin(2.0 * PI * secondsAt(atMicros) / 900.0));
+}
+
+/** Sensirion CRC-8 (poly 0x31, init 0xFF) */
+static uint8_t sensirionCrc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/** Dallas/Maxim CRC-8 (poly 0x8C reflected, init 0x00) */
+static uint8_t dallasCrc8(const uint8_t* data, size_t length) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t inbyte = data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix) crc ^= 0x8C;
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+// ============================================================================
+// REGISTRIES
+// ============================================================================
+
+struct I2CEntry {
+    int sda;
+    int scl;
+    uint8_t address;
+    I2CDevice* device;
+};
+
+struct UartEntry {
+    int txPin;
+    int rxPin;
+    UartDevice* device;
+};
+
+struct OneWireBus {
+    std::vector<OneWireDevice*> devices;
+    bool masterLow = false;
+    bool slotPulled = false;
+    uint64_t fallAt = 0;
+    uint64_t pullUntil = 0;
+    uint64_t presenceFrom = 0;
+    uint64_t presenceUntil = 0;
+};
+
+static const int kOneWirePins = 30;
+
+static std::vector<I2CEntry>& i2cRegistry() {
+    static std::vector<I2CEntry> entries;
+    return entries;
+}
+
+static std::vector<UartEntry>& uartRegistry() {
+    static std::vector<UartEntry> entries;
+    return entries;
+}
+
+static OneWireBus* oneWireBuses() {
+    static OneWireBus buses[kOneWirePins];
+    return buses;
+}
+
+static bool defaultOneWirePerPin = false;
+
+static bool pinMatches(int registered, int actual) {
+    return registered < 0 || registered == actual;
+}
+
+void attachI2CDevice(uint8_t address, I2CDevice* device, int sda, int scl) {
+    i2cRegistry().push_back({sda, scl, address, device});
+}
+
+I2CDevice* findI2CDevice(int sda, int scl, uint8_t address) {
+    I2CDevice* wildcard = nullptr;
+    for (const I2CEntry& entry : i2cRegistry()) {
+        if (entry.address != address) continue;
+        if (entry.sda == sda && entry.scl == scl) return entry.device;
+        if (!wildcard && pinMatches(entry.sda, sda) && pinMatches(entry.scl, scl)) {
+            wildcard = entry.device;
+        }
+    }
+    return wildcard;
+}
+
+void attachUartDevice(UartDevice* device, int txPin, int rxPin) {
+    uartRegistry().push_back({txPin, rxPin, device});
+}
+
+UartDevice* findUartDevice(int txPin, int rxPin) {
+    UartDevice* wildcard = nullptr;
+    for (const UartEntry& entry : uartRegistry()) {
+        if (entry.txPin == txPin && entry.rxPin == rxPin) return entry.device;
+        if (!wildcard && pinMatches(entry.txPin, txPin) && pinMatches(entry.rxPin, rxPin)) {
+            wildcard = entry.device;
+        }
+    }
+    return wildcard;
+}
+
+void attachOneWireDevice(OneWireDevice* device, int pin) {
+    if (pin < 0 || pin >= kOneWirePins) return;
+    oneWireBuses()[pin].devices.push_back(device);
+}
+
+// ============================================================================
+// SHT30 (Sensirion humidity/temperature, 0x44/0x45)
+// ============================================================================
+
+class SimSHT30 : public I2CDevice {
+public:
+    bool onWrite(const uint8_t* data, size_t length) override {
+        if (length < 2) return true;  // address probe
+        uint16_t command = (uint16_t)((data[0] << 8) | data[1]);
+        uint32_t measureUs = 0;
+        switch (command) {
+            case 0x2C06: case 0x2400: measureUs = 15000; _stretch = (command == 0x2C06); break;
+            case 0x2C0D: case 0x240B: measureUs = 6000; _stretch = (command == 0x2C0D); break;
+            case 0x2C10: case 0x2416: measureUs = 4000; _stretch = (command == 0x2C10); break;
+            case 0x30A2: _pending = false; return true;  // soft reset
+            default: return true;
+        }
+        _pending = true;
+        _readyAt = NativeHAL::nowMicros() + measureUs;
+        return true;
+    }
+
+    size_t onRead(uint8_t* data, size_t length) override {
+        if (!_pending) return 0;
+        uint64_t now = NativeHAL::nowMicros();
+        if (now < _readyAt) {
+            if (!_stretch) return 0;
+            // Clock stretching: the sensor holds SCL low until the measurement completes
+            NativeHAL::advanceMicros(_readyAt - now);
+            now = _readyAt;
+        }
+        _pending = false;
+
+        float t = ambientTemperatureC(now);
+        float rh = ambientHumidityRH(now);
+        uint16_t rawT = (uint16_t)lroundf((t + 45.0f) / 175.0f * 65535.0f);
+        uint16_t rawRH = (uint16_t)lroundf(rh / 100.0f * 65535.0f);
+        uint8_t frame[6] = {
+            (uint8_t)(rawT >> 8), (uint8_t)rawT, 0,
+            (uint8_t)(rawRH >> 8), (uint8_t)rawRH, 0
+        };
+        frame[2] = sensirionCrc8(frame, 2);
+        frame[5] = sensirionCrc8(frame + 3, 2);
+
+        size_t n = length < sizeof(frame) ? length : sizeof(frame);
+        memcpy(data, frame, n);
+        for (size_t i = n; i < length; i++) data[i] = 0xFF;
+        return length;
+    }
+
+private:
+    bool _pending = false;
+    bool _stretch = true;
+    uint64_t _readyAt = 0;
+};
+
+// ============================================================================
+// ATLAS SCIENTIFIC EZO CIRCUITS (I2C mode)
+// ============================================================================
+
+class SimEzo : public I2CDevice {
+public:
+    enum class Kind : uint8_t { PH, EC, DO, ORP, RTD };
+
+    explicit SimEzo(Kind kind) : _kind(kind) {}
+
+    bool onWrite(const uint8_t* data, size_t length) override {
+        if (length == 0) return true;  // address probe
+
+        std::string cmd((const char*)data, length);
+        while (!cmd.empty() && (cmd.back() == '\0' || cmd.back() == '\r' || cmd.back() == '\n')) {
+            cmd.pop_back();
+        }
+        std::string upper = cmd;
+        for (char& c : upper) c = (char)toupper((unsigned char)c);
+
+        uint64_t now = NativeHAL::nowMicros();
+        _issued = true;
+        _code = 1;
+        _response.clear();
+
+        if (upper == "R") {
+            _readyAt = now + readTimeUs();
+            _pendingReading = true;
+        } else if (upper.rfind("RT,", 0) == 0) {
+            _compensationC = (float)atof(cmd.c_str() + 3);
+            _readyAt = now + readTimeUs();
+            _pendingReading = true;
+        } else if (upper == "T,?") {
+            char buf[24];
+            snprintf(buf, sizeof(buf), "?T,%.2f", _compensationC);
+            _response = buf;
+            _readyAt = now + 300000;
+        } else if (upper.rfind("T,", 0) == 0) {
+            _compensationC = (float)atof(cmd.c_str() + 2);
+            _readyAt = now + 300000;
+        } else if (upper == "I") {
+            _response = std::string("?I,") + kindName() + ",2.16";
+            _readyAt = now + 300000;
+        } else if (upper == "STATUS") {
+            _response = "?STATUS,P,5.038";
+            _readyAt = now + 300000;
+        } else if (upper.rfind("CAL", 0) == 0) {
+            _readyAt = now + 900000;
+        } else if (upper == "SLEEP") {
+            _issued = false;
+        } else if (upper == "FIND" || upper.rfind("L,", 0) == 0 || upper.rfind("NAME", 0) == 0 ||
+                   upper.rfind("PLOCK", 0) == 0 || upper.rfind("O,", 0) == 0) {
+            _readyAt = now + 300000;
+        } else {
+            _code = 2;  // syntax error
+            _readyAt = now + 300000;
+        }
+        return true;
+    }
+
+    size_t onRead(uint8_t* data, size_t length) override {
+        if (length == 0) return 0;
+        memset(data, 0, length);
+        uint64_t now = NativeHAL::nowMicros();
+
+        if (!_issued) {
+            data[0] = 255;  // no data to send
+            return length;
+        }
+        if (now < _readyAt) {
+            data[0] = 254;  // still processing
+            return length;
+        }
+
+        if (_pendingReading) {
+            char buf[24];
+            formatReading(buf, sizeof(buf), now);
+            _response = buf;
+            _pendingReading = false;
+        }
+
+        data[0] = _code;
+        for (size_t i = 0; i < _response.size() && i + 1 < length; i++) {
+            data[i + 1] = (uint8_t)_response[i];
+        }
+        _issued = false;
+        return length;
+    }
+
+private:
+    Kind _kind;
+    bool _issued = false;
+    bool _pendingReading = false;
+    uint8_t _code = 255;
+    uint64_t _readyAt = 0;
+    float _compensationC = 25.0f;
+    std::string _response;
+
+    uint32_t readTimeUs() const {
+        switch (_kind) {
+            case Kind::EC: return 600000;
+            case Kind::DO: return 600000;
+            case Kind::RTD: return 600000;
+            default: return 900000;
+        }
+    }
+
+    const char* kindName() const {
+        switch (_kind) {
+            case Kind::PH: return "pH";
+            case Kind::EC: return "EC";
+            case Kind::DO: return "DO";
+            case Kind::ORP: return "OR";
+            case Kind::RTD: return "RTD";
+        }
+        return "?";
+    }
+
+    void formatReading(char* buf, size_t size, uint64_t now) const {
+        double s = secondsAt(now);
+        float ambient = ambientTemperatureC(now);
+        switch (_kind) {
+            case Kind::PH: {
+                double ph = 7.00 + 0.05 * sin(2.0 * PI * s / 300.0) + (25.0 - _compensationC) * 0.003;
+                snprintf(buf, size, "%.3f", ph);
+                break;
+            }
+            case Kind::EC: {
+                double ec = 1413.0 * (1.0 + 0.02 * (ambient - _compensationC));
+                snprintf(buf, size, "%.2f", ec);
+                break;
+            }
+            case Kind::DO:
+                snprintf(buf, size, "%.2f", 8.20 + 0.1 * sin(2.0 * PI * s / 450.0));
+                break;
+            case Kind::ORP:
+                snprintf(buf, size, "%.1f", 225.0 + 3.0 * sin(2.0 * PI * s / 240.0));
+                break;
+            case Kind::RTD:
+                snprintf(buf, size, "%.3f", ambient);
+                break;
+        }
+    }
+};
+
+// ============================================================================
+// LIS3DH (ST 3-axis accelerometer, 0x18/0x19)
+// ============================================================================
+
+class SimLIS3DH : public I2CDevice {
+public:
+    SimLIS3DH() {
+        memset(_regs, 0, sizeof(_regs));
+        _regs[0x0F] = 0x33;  // WHO_AM_I
+        _regs[0x20] = 0x07;  // CTRL_REG1: axes enabled, power-down
+        _regs[0x2F] = 0x20;  // FIFO_SRC_REG: empty
+    }
+
+    bool onWrite(const uint8_t* data, size_t length) override {
+        if (length == 0) return true;  // address probe
+        _autoIncrement = (data[0] & 0x80) != 0;
+        _pointer = data[0] & 0x7F;
+        for (size_t i = 1; i < length; i++) {
+            writeRegister(_pointer, data[i]);
+            if (_autoIncrement) _pointer = (uint8_t)((_pointer + 1) & 0x7F);
+        }
+        return true;
+    }
+
+    size_t onRead(uint8_t* data, size_t length) override {
+        uint64_t now = NativeHAL::nowMicros();
+        for (size_t i = 0; i < length; i++) {
+            data[i] = readRegister(_pointer, now);
+            if (_autoIncrement) {
+                _pointer = (uint8_t)((_pointer + 1) & 0x7F);
+                // Output registers wrap X_L..Z_H so FIFO frames can be burst-read
+                if (_pointer == 0x2E && fifoEnabled()) _pointer = 0x28;
+            }
+        }
+        return length;
+    }
+
+private:
+    uint8_t _regs[0x40];
+    uint8_t _pointer = 0;
+    bool _autoIncrement = false;
+    int16_t _frame[3] = {0, 0, 0};
+    uint64_t _consumedSample = 0;
+    uint64_t _fifoStartSample = 0;
+    bool _fifoOverrun = false;
+
+    uint32_t odrHz() const {
+        static const uint16_t rates[16] = {0, 1, 10, 25, 50, 100, 200, 400, 1600, 1344, 0, 0, 0, 0, 0, 0};
+        uint8_t odr = _regs[0x20] >> 4;
+        if (odr == 9 && (_regs[0x20] & 0x08)) return 5376;  // low-power 5.376 kHz
+        return rates[odr];
+    }
+
+    bool fifoEnabled() const {
+        return (_regs[0x24] & 0x40) && (_regs[0x2E] >> 6) != 0;
+    }
+
+    uint64_t sampleIndex(uint64_t now) const {
+        uint32_t odr = odrHz();
+        return odr ? (now * odr) / 1000000ULL : 0;
+    }
+
+    void writeRegister(uint8_t reg, uint8_t value) {
+        if (reg >= sizeof(_regs) || reg == 0x0F) return;
+        _regs[reg] = value;
+        if (reg == 0x2E || reg == 0x24 || reg == 0x20) {
+            // Mode change restarts FIFO collection from "now"
+            _fifoStartSample = sampleIndex(NativeHAL::nowMicros());
+            _consumedSample = _fifoStartSample;
+            _fifoOverrun = false;
+        }
+    }
+
+    /** Acceleration in g at a given sample index */
+    static void signalAt(double t, double g[3]) {
+        g[0] = 0.02 + 0.25 * sin(2.0 * PI * 50.0 * t) + 0.05 * sin(2.0 * PI * 120.0 * t);
+        g[1] = -0.01 + 0.10 * sin(2.0 * PI * 23.0 * t);
+        g[2] = 1.00 + 0.02 * sin(2.0 * PI * 7.0 * t);
+    }
+
+    void encodeSample(uint64_t index) {
+        uint32_t odr = odrHz();
+        double t = odr ? (double)index / odr : 0.0;
+        double g[3];
+        signalAt(t, g);
+
+        static const double fullScale[4] = {2.0, 4.0, 8.0, 16.0};
+        double fs = fullScale[(_regs[0x23] >> 4) & 0x03];
+        bool lowPower = (_regs[0x20] & 0x08) != 0;
+        bool highRes = (_regs[0x23] & 0x08) != 0;
+        int dropBits = lowPower ? 8 : (highRes ? 4 : 6);
+
+        for (int axis = 0; axis < 3; axis++) {
+            double counts = g[axis] / fs * 32768.0;
+            if (counts > 32767.0) counts = 32767.0;
+            if (counts < -32768.0) counts = -32768.0;
+            int32_t v = (int32_t)lround(counts);
+            v &= ~((1 << dropBits) - 1);
+            _frame[axis] = (int16_t)v;
+        }
+    }
+
+    uint8_t fifoLevel(uint64_t now) {
+        uint64_t produced = sampleIndex(now);
+        uint64_t stored = produced > _consumedSample ? produced - _consumedSample : 0;
+        uint8_t mode = _regs[0x2E] >> 6;
+        if (stored > 32) {
+            _fifoOverrun = true;
+            if (mode == 2 || mode == 3) {
+                _consumedSample = produced - 32;  // stream: oldest samples discarded
+            }
+            stored = 32;
+        }
+        return (uint8_t)stored;
+    }
+
+    uint8_t readRegister(uint8_t reg, uint64_t now) {
+        if (reg >= 0x28 && reg <= 0x2D) {
+            if (reg == 0x28) {
+                if (fifoEnabled()) {
+                    if (fifoLevel(now) > 0) {
+                        encodeSample(_consumedSample++);
+                        _fifoOverrun = false;  // OVRN clears once a sample set is read
+                    }
+                } else {
+                    encodeSample(sampleIndex(now));
+                }
+            }
+            int axis = (reg - 0x28) / 2;
+            uint16_t v = (uint16_t)_frame[axis];
+            return (reg & 1) ? (uint8_t)(v >> 8) : (uint8_t)(v & 0xFF);
+        }
+        switch (reg) {
+            case 0x27:  // STATUS_REG: new data on all axes whenever powered
+                return odrHz() ? 0x0F : 0x00;
+            case 0x2F: {  // FIFO_SRC_REG
+                uint8_t level = fifoEnabled() ? fifoLevel(now) : 0;
+                uint8_t wtm = _regs[0x2E] & 0x1F;
+                uint8_t src = level & 0x1F;
+                if (level >= 32) src = 0x1F;
+                if (level == 0) src |= 0x20;
+                if (_fifoOverrun) src |= 0x40;
+                if (wtm && level > wtm) src |= 0x80;
+                return src;
+            }
+            case 0x0C:  // OUT_ADC3_L: temperature delta (8-bit left justified)
+                return 0;
+            case 0x0D: {
+                int8_t delta = (int8_t)lroundf(ambientTemperatureC(now) - 25.0f);
+                return (uint8_t)delta;
+            }
+            default:
+                return reg < sizeof(_regs) ? _regs[reg] : 0;
+        }
+    }
+};
+
+// ============================================================================
+// DS18B20 (Maxim 1-Wire digital thermometer)
+// ============================================================================
+
+class SimDS18B20 : public OneWireDevice {
+public:
+    explicit SimDS18B20(uint32_t serial, float offsetC = 0.0f) : _offsetC(offsetC) {
+        _rom[0] = 0x28;
+        for (int i = 0; i < 6; i++) _rom[1 + i] = (uint8_t)(serial >> (8 * i));
+        _rom[7] = dallasCrc8(_rom, 7);
+
+        // Power-on scratchpad: +85 C, TH/TL defaults, 12-bit resolution
+        _scratch[0] = 0x50; _scratch[1] = 0x05;
+        _scratch[2] = 0x4B; _scratch[3] = 0x46;
+        _scratch[4] = 0x7F;
+        _scratch[5] = 0xFF; _scratch[6] = 0x0C; _scratch[7] = 0x10;
+        _scratch[8] = dallasCrc8(_scratch, 8);
+    }
+
+    bool onReset(uint64_t atMicros) override {
+        (void)atMicros;
+        _state = State::ROM_COMMAND;
+        resetShift();
+        return true;
+    }
+
+    bool pullsLowInSlot(uint64_t atMicros) override {
+        switch (_state) {
+            case State::TX:
+                return !currentTxBit();
+            case State::SEARCH:
+                if (_searchPhase == 0) return !romBit(_searchBit);
+                if (_searchPhase == 1) return romBit(_searchBit);
+                return false;
+            case State::CONVERTING:
+                return atMicros < _conversionDone;  // read slots return 0 while busy
+            default:
+                return false;
+        }
+    }
+
+    void onSlot(bool lineBit, uint64_t atMicros) override {
+        switch (_state) {
+            case State::ROM_COMMAND:
+            case State::FUNCTION_COMMAND:
+            case State::RX:
+                shiftIn(lineBit, atMicros);
+                break;
+            case State::TX:
+                if (++_bitIndex >= _txLength * 8) {
+                    _state = State::IDLE;
+                }
+                break;
+            case State::SEARCH:
+                if (_searchPhase < 2) {
+                    _searchPhase++;
+                } else {
+                    if (lineBit != romBit(_searchBit)) {
+                        _state = State::IDLE;  // deselected
+                        return;
+                    }
+                    _searchPhase = 0;
+                    if (++_searchBit >= 64) {
+                        _state = State::FUNCTION_COMMAND;
+                        resetShift();
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+private:
+    enum class State : uint8_t { IDLE, ROM_COMMAND, FUNCTION_COMMAND, RX, TX, SEARCH, CONVERTING };
+    enum class RxTarget : uint8_t { MATCH_ROM, WRITE_SCRATCHPAD };
+
+    uint8_t _rom[8];
+    uint8_t _scratch[9];
+    float _offsetC;
+    State _state = State::IDLE;
+    RxTarget _rxTarget = RxTarget::MATCH_ROM;
+    uint8_t _shift[8];
+    int _bitIndex = 0;
+    int _rxLength = 0;
+    const uint8_t* _tx = nullptr;
+    int _txLength = 0;
+    uint8_t _txBuf[9];
+    int _searchBit = 0;
+    int _searchPhase = 0;
+    uint64_t _conversionDone = 0;
+
+    bool romBit(int bit) const { return (_rom[bit / 8] >> (bit % 8)) & 1; }
+    bool currentTxBit() const { return (_tx[_bitIndex / 8] >> (_bitIndex % 8)) & 1; }
+
+    void resetShift() {
+        memset(_shift, 0, sizeof(_shift));
+        _bitIndex = 0;
+    }
+
+    void startTx(const uint8_t* data, int length) {
+        memcpy(_txBuf, data, (size_t)length);
+        _tx = _txBuf;
+        _txLength = length;
+        _bitIndex = 0;
+        _state = State::TX;
+    }
+
+    void startRx(RxTarget target, int length) {
+        _rxTarget = target;
+        _rxLength = length;
+        resetShift();
+        _state = State::RX;
+    }
+
+    uint32_t conversionTimeUs() const {
+        switch ((_scratch[4] >> 5) & 0x03) {
+            case 0: return 93750;
+            case 1: return 187500;
+            case 2: return 375000;
+            default: return 750000;
+        }
+    }
+
+    void completeConversion() {
+        float t = ambientTemperatureC(_conversionDone) + _offsetC;
+        int resolutionBits = 9 + ((_scratch[4] >> 5) & 0x03);
+        int16_t raw = (int16_t)lroundf(t * 16.0f);
+        raw &= (int16_t)~((1 << (12 - resolutionBits)) - 1);  // undefined LSBs read as 0
+        _scratch[0] = (uint8_t)(raw & 0xFF);
+        _scratch[1] = (uint8_t)((raw >> 8) & 0xFF);
+        _scratch[8] = dallasCrc8(_scratch, 8);
+    }
+
+    void shiftIn(bool bit, uint64_t atMicros) {
+        if (bit) _shift[_bitIndex / 8] |= (uint8_t)(1 << (_bitIndex % 8));
+        _bitIndex++;
+
+        if (_state == State::RX) {
+            if (_bitIndex < _rxLength * 8) return;
+            if (_rxTarget == RxTarget::MATCH_ROM) {
+                _state = memcmp(_shift, _rom, 8) == 0 ? State::FUNCTION_COMMAND : State::IDLE;
+            } else {
+                _scratch[2] = _shift[0];
+                _scratch[3] = _shift[1];
+                _scratch[4] = (uint8_t)((_shift[2] & 0x60) | 0x1F);
+                _scratch[8] = dallasCrc8(_scratch, 8);
+                _state = State::IDLE;
+            }
+            resetShift();
+            return;
+        }
+
+        if (_bitIndex < 8) return;
+        uint8_t command = _shift[0];
+        resetShift();
+
+        if (_state == State::ROM_COMMAND) {
+            switch (command) {
+                case 0xCC: _state = State::FUNCTION_COMMAND; break;               // Skip ROM
+                case 0x33: startTx(_rom, 8); break;                               // Read ROM
+                case 0x55: startRx(RxTarget::MATCH_ROM, 8); break;                // Match ROM
+                case 0xF0: _state = State::SEARCH; _searchBit = 0; _searchPhase = 0; break;  // Search ROM
+                default: _state = State::IDLE; break;
+            }
+            return;
+        }
+
+        // FUNCTION_COMMAND
+        switch (command) {
+            case 0x44:  // Convert T
+                _conversionDone = atMicros + conversionTimeUs();
+                completeConversion();
+                _state = State::CONVERTING;
+                break;
+            case 0xBE:  // Read Scratchpad
+                if (atMicros < _conversionDone) {
+                    // Reading mid-conversion returns the previous result
+                }
+                startTx(_scratch, 9);
+                break;
+            case 0x4E:  // Write Scratchpad (TH, TL, config)
+                startRx(RxTarget::WRITE_SCRATCHPAD, 3);
+                break;
+            case 0xB4: {  // Read Power Supply: externally powered
+                static const uint8_t powered = 0xFF;
+                startTx(&powered, 1);
+                break;
+            }
+            default:
+                _state = State::IDLE;
+                break;
+        }
+    }
+};
+
+// ============================================================================
+// UART ASCII RESPONDER (EZO UART-mode protocol)
+// ============================================================================
+
+class SimUartEzo : public UartDevice {
+public:
+    void onByte(UartLink& link, uint8_t value, uint64_t atMicros) override {
+        if (value != '\r' && value != '\n') {
+            if (_line.size() < 64) _line += (char)value;
+            return;
+        }
+        if (_line.empty()) return;
+
+        std::string upper = _line;
+        for (char& c : upper) c = (char)toupper((unsigned char)c);
+        _line.clear();
+
+        char response[48];
+        uint64_t latency = 300000;
+        if (upper == "R") {
+            snprintf(response, sizeof(response), "%.2f\r*OK\r", 7.0 + 0.05 * sin(2.0 * PI * secondsAt(atMicros) / 300.0));
+            latency = 900000;
+        } else if (upper == "I") {
+            snprintf(response, sizeof(response), "?I,pH,2.16\r*OK\r");
+        } else {
+            snprintf(response, sizeof(response), "*OK\r");
+        }
+        link.reply((const uint8_t*)response, strlen(response), atMicros + latency);
+    }
+
+private:
+    std::string _line;
+};
+
+// ============================================================================
+// 1-WIRE LINE DECODER
+// ============================================================================
+
+// Line state is shared by both "cores" (core 1 bit-bangs, core 0 may sample the pin)
+static std::mutex oneWireLock;
+
+void onMasterDrive(int pin, bool drivenLow, uint64_t atMicros) {
+    if (pin < 0 || pin >= kOneWirePins) return;
+    std::lock_guard<std::mutex> guard(oneWireLock);
+    OneWireBus& bus = oneWireBuses()[pin];
+
+    if (drivenLow && !bus.masterLow) {
+        bus.masterLow = true;
+        bus.fallAt = atMicros;
+        bus.slotPulled = false;
+        bus.pullUntil = 0;
+        for (OneWireDevice* device : bus.devices) {
+            if (device->pullsLowInSlot(atMicros)) bus.slotPulled = true;
+        }
+        if (bus.slotPulled) bus.pullUntil = atMicros + 60;
+        return;
+    }
+
+    if (!drivenLow && bus.masterLow) {
+        bus.masterLow = false;
+        uint64_t lowFor = atMicros - bus.fallAt;
+
+        if (lowFor >= 400) {
+            if (bus.devices.empty() && defaultOneWirePerPin) {
+                bus.devices.push_back(new SimDS18B20(0x00B18B20u + (uint32_t)pin, 0.1f * (float)pin));
+            }
+            bool present = false;
+            for (OneWireDevice* device : bus.devices) {
+                if (device->onReset(atMicros)) present = true;
+            }
+            bus.pullUntil = 0;
+            if (present) {
+                bus.presenceFrom = atMicros + 15;
+                bus.presenceUntil = atMicros + 240;
+            }
+            return;
+        }
+
+        bool lineBit = lowFor < 15 && !bus.slotPulled;
+        for (OneWireDevice* device : bus.devices) {
+            device->onSlot(lineBit, atMicros);
+        }
+    }
+}
+
+bool isLineHeldLow(int pin, uint64_t atMicros) {
+    if (pin < 0 || pin >= kOneWirePins) return false;
+    std::lock_guard<std::mutex> guard(oneWireLock);
+    const OneWireBus& bus = oneWireBuses()[pin];
+    if (atMicros >= bus.presenceFrom && atMicros < bus.presenceUntil) return true;
+    return atMicros < bus.pullUntil;
+}
+
+// ============================================================================
+// DEFAULT DEVICE SET
+// ============================================================================
+
+void installDefaultDevices() {
+    attachI2CDevice(0x44, new SimSHT30());
+    attachI2CDevice(0x18, new SimLIS3DH());
+    attachI2CDevice(0x19, new SimLIS3DH());
+    attachI2CDevice(0x61, new SimEzo(SimEzo::Kind::DO));
+    attachI2CDevice(0x62, new SimEzo(SimEzo::Kind::ORP));
+    attachI2CDevice(0x63, new SimEzo(SimEzo::Kind::PH));
+    attachI2CDevice(0x64, new SimEzo(SimEzo::Kind::EC));
+    attachI2CDevice(0x66, new SimEzo(SimEzo::Kind::RTD));
+    attachUartDevice(new SimUartEzo());
+    defaultOneWirePerPin = true;
+}
+
+}  // namespace NativeSim
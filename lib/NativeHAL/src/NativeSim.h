@@ -0,0 +1,113 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * NativeSim - Simulated bus devices for the host-native build
+ *
+ * The HAL routes bus traffic to the devices registered here:
+ * - I2C:    TwoWire transactions are delivered to the device attached at the
+ *           current (SDA, SCL, address); a missing device NACKs.
+ * - UART:   bytes written by Serial1/Serial2 are delivered to the device
+ *           attached to the port's (TX, RX) pins, paced at the configured baud.
+ * - 1-Wire: GPIO edges on a pin are decoded into reset pulses and time slots
+ *           (Maxim AN126 timing) and presented to the devices on that pin,
+ *           which can pull the line low in response.
+ *
+ * I2C and UART attach functions accept -1 for a pin to match any pin, so a
+ * single default device set covers whatever pins a sensors.json happens to use.
+ * installDefaultDevices() registers one of every supported sensor model.
+ */
+
+namespace NativeSim {
+
+// ============================================================================
+// I2C
+// ============================================================================
+
+class I2CDevice {
+public:
+    virtual ~I2CDevice() {}
+
+    /** Master write transaction (payload after the address byte). Return false to NACK. */
+    virtual bool onWrite(const uint8_t* data, size_t length) = 0;
+
+    /** Master read request. Fill up to `length` bytes; returning 0 NACKs the address. */
+    virtual size_t onRead(uint8_t* data, size_t length) = 0;
+};
+
+void attachI2CDevice(uint8_t address, I2CDevice* device, int sda = -1, int scl = -1);
+I2CDevice* findI2CDevice(int sda, int scl, uint8_t address);
+
+// ============================================================================
+// UART
+// ============================================================================
+
+/**
+ * Reply channel handed to UART devices; implemented by the HAL's SerialUART
+ */
+class UartLink {
+public:
+    virtual ~UartLink() {}
+
+    /** Queue bytes towards the firmware, the first arriving at `startMicros` */
+    virtual void reply(const uint8_t* data, size_t length, uint64_t startMicros) = 0;
+
+    /** Time one character occupies the wire at the current baud/framing */
+    virtual uint32_t byteTimeMicros() const = 0;
+};
+
+class UartDevice {
+public:
+    virtual ~UartDevice() {}
+
+    /** Called for every byte the firmware transmits, when its stop bit completes */
+    virtual void onByte(UartLink& link, uint8_t value, uint64_t atMicros) = 0;
+};
+
+void attachUartDevice(UartDevice* device, int txPin = -1, int rxPin = -1);
+UartDevice* findUartDevice(int txPin, int rxPin);
+
+// ============================================================================
+// 1-WIRE
+// ============================================================================
+
+class OneWireDevice {
+public:
+    virtual ~OneWireDevice() {}
+
+    /** Reset pulse seen; return true to answer with a presence pulse */
+    virtual bool onReset(uint64_t atMicros) = 0;
+
+    /** Queried when the master starts a time slot; true pulls the line low (sends a 0) */
+    virtual bool pullsLowInSlot(uint64_t atMicros) = 0;
+
+    /** Slot complete; `lineBit` is the wired-AND level the bus settled at */
+    virtual void onSlot(bool lineBit, uint64_t atMicros) = 0;
+};
+
+void attachOneWireDevice(OneWireDevice* device, int pin);
+
+/** GPIO hooks used by the HAL's pinMode()/digitalWrite()/digitalRead() */
+void onMasterDrive(int pin, bool drivenLow, uint64_t atMicros);
+bool isLineHeldLow(int pin, uint64_t atMicros);
+
+// ============================================================================
+// DEFAULT DEVICE SET
+// ============================================================================
+
+/**
+ * Register the stock simulated sensors on every pin:
+ * - I2C:    SHT30 @0x44, LIS3DH @0x18/0x19, EZO DO/ORP/pH/EC/RTD @0x61-0x64/0x66
+ * - UART:   EZO-style ASCII responder ("R\r" -> reading)
+ * - 1-Wire: one DS18B20 on any pin that issues a reset pulse and has no
+ *           explicitly attached devices, ROM serial derived from the pin
+ */
+void installDefaultDevices();
+
+/** Ambient signal models shared by the simulated sensors */
+float ambientTemperatureC(uint64_t atMicros);
+float ambientHumidityRH(uint64_t atMicros);
+
+}  // namespace NativeSim
@@ -0,0 +1,124 @@
+#include "Print.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (write(*buffer++)) {
+            n++;
+        } else {
+            break;
+        }
+    }
+    return n;
+}
+
+size_t Print::printNumber(unsigned long long value, int base, bool negative) {
+    if (base < 2) base = 10;
+    char buf[72];
+    char* p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    do {
+        unsigned digit = (unsigned)(value % (unsigned)base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= (unsigned)base;
+    } while (value);
+    if (negative) *--p = '-';
+    return write(p);
+}
+
+// ============================================================================
+// print()
+// ============================================================================
+
+size_t Print::print(const __FlashStringHelper* str) { return write(reinterpret_cast<const char*>(str)); }
+size_t Print::print(const String& str) { return write((const uint8_t*)str.c_str(), str.length()); }
+size_t Print::print(const char* str) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return print((unsigned long)value, base); }
+size_t Print::print(int value, int base) { return print((long)value, base); }
+size_t Print::print(unsigned int value, int base) { return print((unsigned long)value, base); }
+
+size_t Print::print(long value, int base) {
+    if (base == 0) return write((uint8_t)value);
+    if (base == 10 && value < 0) return printNumber((unsigned long long)(-(long long)value), 10, true);
+    return printNumber(base == 10 ? (unsigned long long)value : (unsigned long)value, base, false);
+}
+
+size_t Print::print(unsigned long value, int base) {
+    if (base == 0) return write((uint8_t)value);
+    return printNumber(value, base, false);
+}
+
+size_t Print::print(long long value, int base) {
+    if (base == 0) return write((uint8_t)value);
+    if (base == 10 && value < 0) return printNumber((unsigned long long)(-value), 10, true);
+    return printNumber((unsigned long long)value, base, false);
+}
+
+size_t Print::print(unsigned long long value, int base) {
+    if (base == 0) return write((uint8_t)value);
+    return printNumber(value, base, false);
+}
+
+size_t Print::print(double value, int digits) {
+    if (isnan(value)) return write("nan");
+    if (isinf(value)) return write("inf");
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", digits, value);
+    return write(buf);
+}
+
+size_t Print::print(const Printable& p) { return p.printTo(*this); }
+
+// ============================================================================
+// println()
+// ============================================================================
+
+size_t Print::println() { return write("\r\n"); }
+size_t Print::println(const __FlashStringHelper* str) { size_t n = print(str); return n + println(); }
+size_t Print::println(const String& str) { size_t n = print(str); return n + println(); }
+size_t Print::println(const char* str) { size_t n = print(str); return n + println(); }
+size_t Print::println(char c) { size_t n = print(c); return n + println(); }
+size_t Print::println(unsigned char value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(int value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(unsigned int value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(long value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(unsigned long value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(long long value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(unsigned long long value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(double value, int digits) { size_t n = print(value, digits); return n + println(); }
+size_t Print::println(const Printable& p) { size_t n = print(p); return n + println(); }
+
+// ============================================================================
+// printf()
+// ============================================================================
+
+size_t Print::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    size_t n = vprintf(format, args);
+    va_end(args);
+    return n;
+}
+
+size_t Print::vprintf(const char* format, va_list args) {
+    char stackBuf[256];
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(stackBuf, sizeof(stackBuf), format, copy);
+    va_end(copy);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(stackBuf)) {
+        return write((const uint8_t*)stackBuf, (size_t)len);
+    }
+    char* heapBuf = (char*)malloc((size_t)len + 1);
+    if (!heapBuf) return 0;
+    vsnprintf(heapBuf, (size_t)len + 1, format, args);
+    size_t n = write((const uint8_t*)heapBuf, (size_t)len);
+    free(heapBuf);
+    return n;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "WString.h"
+#include "Printable.h"
+
+/**
+ * Arduino Print base class (arduino-pico flavour, including printf)
+ */
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) {
+        return str ? write((const uint8_t*)str, strlen(str)) : 0;
+    }
+    size_t write(const char* buffer, size_t size) {
+        return write((const uint8_t*)buffer, size);
+    }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    int getWriteError() const { return _writeError; }
+    void clearWriteError() { _writeError = 0; }
+
+    size_t print(const __FlashStringHelper* str);
+    size_t print(const String& str);
+    size_t print(const char* str);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC_BASE);
+    size_t print(int value, int base = DEC_BASE);
+    size_t print(unsigned int value, int base = DEC_BASE);
+    size_t print(long value, int base = DEC_BASE);
+    size_t print(unsigned long value, int base = DEC_BASE);
+    size_t print(long long value, int base = DEC_BASE);
+    size_t print(unsigned long long value, int base = DEC_BASE);
+    size_t print(double value, int digits = 2);
+    size_t print(const Printable& p);
+
+    size_t println(const __FlashStringHelper* str);
+    size_t println(const String& str);
+    size_t println(const char* str);
+    size_t println(char c);
+    size_t println(unsigned char value, int base = DEC_BASE);
+    size_t println(int value, int base = DEC_BASE);
+    size_t println(unsigned int value, int base = DEC_BASE);
+    size_t println(long value, int base = DEC_BASE);
+    size_t println(unsigned long value, int base = DEC_BASE);
+    size_t println(long long value, int base = DEC_BASE);
+    size_t println(unsigned long long value, int base = DEC_BASE);
+    size_t println(double value, int digits = 2);
+    size_t println(const Printable& p);
+    size_t println();
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    size_t vprintf(const char* format, va_list args);
+
+protected:
+    void setWriteError(int err = 1) { _writeError = err; }
+
+private:
+    static const int DEC_BASE = 10;
+    int _writeError = 0;
+
+    size_t printNumber(unsigned long long value, int base, bool negative);
+};
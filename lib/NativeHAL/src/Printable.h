@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stddef.h>
+
+class Print;
+
+/**
+ * Interface for objects that know how to print themselves (e.g. IPAddress)
+ */
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
@@ -0,0 +1,4 @@
+#include "SPI.h"
+
+SPIClassRP2040 SPI(16, 17, 18, 19);
+SPIClassRP2040 SPI1(12, 13, 10, 11);
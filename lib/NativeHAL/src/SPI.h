@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+#ifndef LSBFIRST
+#define LSBFIRST 0
+#endif
+#ifndef MSBFIRST
+#define MSBFIRST 1
+#endif
+
+class SPISettings {
+public:
+    SPISettings() : clock(1000000), bitOrder(MSBFIRST), dataMode(SPI_MODE0) {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+/**
+ * SPI controller stub; the only SPI peripheral on the board is the W5500,
+ * which the host build replaces with the POSIX socket layer, so transfers
+ * return 0xFF (no device driving MISO).
+ */
+class SPIClassRP2040 {
+public:
+    SPIClassRP2040(pin_size_t rx, pin_size_t cs, pin_size_t sck, pin_size_t tx)
+        : _rx(rx), _cs(cs), _sck(sck), _tx(tx) {}
+
+    bool setRX(pin_size_t pin) { _rx = pin; return true; }
+    bool setCS(pin_size_t pin) { _cs = pin; return true; }
+    bool setSCK(pin_size_t pin) { _sck = pin; return true; }
+    bool setTX(pin_size_t pin) { _tx = pin; return true; }
+    bool setMISO(pin_size_t pin) { return setRX(pin); }
+    bool setMOSI(pin_size_t pin) { return setTX(pin); }
+
+    void begin(bool hwCS = false) { (void)hwCS; _running = true; }
+    void end() { _running = false; }
+
+    void beginTransaction(SPISettings settings) { _settings = settings; }
+    void endTransaction() {}
+
+    uint8_t transfer(uint8_t data) { (void)data; return 0xFF; }
+    uint16_t transfer16(uint16_t data) { (void)data; return 0xFFFF; }
+    void transfer(void* buf, size_t count) { memset(buf, 0xFF, count); }
+    void transfer(const void* txbuf, void* rxbuf, size_t count) {
+        (void)txbuf;
+        if (rxbuf) memset(rxbuf, 0xFF, count);
+    }
+
+private:
+    pin_size_t _rx;
+    pin_size_t _cs;
+    pin_size_t _sck;
+    pin_size_t _tx;
+    bool _running = false;
+    SPISettings _settings;
+};
+
+typedef SPIClassRP2040 SPIClass;
+
+extern SPIClassRP2040 SPI;
+extern SPIClassRP2040 SPI1;
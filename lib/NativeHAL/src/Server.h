@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Print.h"
+
+/**
+ * Arduino network server interface
+ */
+class Server : public Print {
+public:
+    virtual void begin() = 0;
+};
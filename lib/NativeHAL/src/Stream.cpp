@@ -0,0 +1,131 @@
+#include "Arduino.h"
+
+// ============================================================================
+// TIMED PRIMITIVES
+// ============================================================================
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) return c;
+        yield();
+    } while (millis() - start < _timeout);
+    return -1;
+}
+
+int Stream::timedPeek() {
+    unsigned long start = millis();
+    do {
+        int c = peek();
+        if (c >= 0) return c;
+        yield();
+    } while (millis() - start < _timeout);
+    return -1;
+}
+
+int Stream::peekNextDigit(bool allowFloat) {
+    while (true) {
+        int c = timedPeek();
+        if (c < 0) return c;
+        if (c == '-' || (c >= '0' && c <= '9') || (allowFloat && c == '.')) return c;
+        read();
+    }
+}
+
+// ============================================================================
+// SEARCH / PARSE
+// ============================================================================
+
+bool Stream::find(const char* target) {
+    return find(target, strlen(target));
+}
+
+bool Stream::find(const char* target, size_t length) {
+    if (length == 0) return true;
+    size_t index = 0;
+    int c;
+    while ((c = timedRead()) > 0) {
+        if (c == target[index]) {
+            if (++index >= length) return true;
+        } else {
+            index = (c == target[0]) ? 1 : 0;
+        }
+    }
+    return false;
+}
+
+long Stream::parseInt() {
+    bool negative = false;
+    long value = 0;
+    int c = peekNextDigit(false);
+    if (c < 0) return 0;
+    do {
+        if (c == '-') {
+            negative = true;
+        } else if (c >= '0' && c <= '9') {
+            value = value * 10 + (c - '0');
+        }
+        read();
+        c = timedPeek();
+    } while (c >= '0' && c <= '9');
+    return negative ? -value : value;
+}
+
+float Stream::parseFloat() {
+    String text;
+    int c = peekNextDigit(true);
+    if (c < 0) return 0;
+    do {
+        text += (char)c;
+        read();
+        c = timedPeek();
+    } while ((c >= '0' && c <= '9') || c == '.');
+    return text.toFloat();
+}
+
+// ============================================================================
+// BULK READS
+// ============================================================================
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) break;
+        *buffer++ = (char)c;
+        count++;
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+    size_t index = 0;
+    while (index < length) {
+        int c = timedRead();
+        if (c < 0 || c == terminator) break;
+        *buffer++ = (char)c;
+        index++;
+    }
+    return index;
+}
+
+String Stream::readString() {
+    String ret;
+    int c = timedRead();
+    while (c >= 0) {
+        ret += (char)c;
+        c = timedRead();
+    }
+    return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String ret;
+    int c = timedRead();
+    while (c >= 0 && c != terminator) {
+        ret += (char)c;
+        c = timedRead();
+    }
+    return ret;
+}
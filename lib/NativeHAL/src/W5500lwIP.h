@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include "WiFi.h"
+
+/**
+ * Host stand-in for the arduino-pico W5500 lwIP driver
+ *
+ * Networking goes through the host's TCP/IP stack; this object only keeps
+ * the interface configuration so the firmware's status output stays
+ * coherent. With a static configuration localIP() reports the configured
+ * address; under DHCP it reports the loopback address the host listens on.
+ */
+class Wiznet5500lwIP {
+public:
+    Wiznet5500lwIP(int8_t cs = 17, SPIClass& spi = SPI, int8_t intr = -1) {
+        (void)cs;
+        (void)spi;
+        (void)intr;
+    }
+
+    bool config(const IPAddress& local, const IPAddress& gateway, const IPAddress& subnet,
+                const IPAddress& dns1 = IPAddress(), const IPAddress& dns2 = IPAddress()) {
+        (void)dns1;
+        (void)dns2;
+        _static = local.isSet();
+        _local = local;
+        _gateway = gateway;
+        _subnet = subnet;
+        return true;
+    }
+
+    bool begin(const uint8_t* macAddress = nullptr, uint16_t mtu = 1500) {
+        (void)macAddress;
+        (void)mtu;
+        if (!_static) {
+            _local = IPAddress(127, 0, 0, 1);
+            _gateway = IPAddress(127, 0, 0, 1);
+            _subnet = IPAddress(255, 0, 0, 0);
+        }
+        _running = true;
+        return true;
+    }
+
+    void end() {
+        _running = false;
+        _static = false;
+        _local = IPAddress();
+    }
+
+    void hostname(const char* name) { strlcpy(_hostname, name ? name : "", sizeof(_hostname)); }
+    const char* getHostname() const { return _hostname; }
+    void setSPISpeed(int hz) { (void)hz; }
+
+    bool connected() const { return _running; }
+    bool isLinked() const { return _running; }
+    IPAddress localIP() const { return _running ? _local : IPAddress(); }
+    IPAddress gatewayIP() const { return _gateway; }
+    IPAddress subnetMask() const { return _subnet; }
+
+private:
+    bool _running = false;
+    bool _static = false;
+    IPAddress _local;
+    IPAddress _gateway;
+    IPAddress _subnet;
+    char _hostname[32] = "modbus-io";
+};
@@ -0,0 +1,309 @@
+#include "WString.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// ============================================================================
+// CONSTRUCTION
+// ============================================================================
+
+String::String(const char* cstr) : _buffer(cstr ? cstr : "") {}
+
+String::String(const char* cstr, unsigned int length) {
+    if (cstr) {
+        _buffer.assign(cstr, strnlen(cstr, length));
+    }
+}
+
+String::String(const __FlashStringHelper* str) : String(reinterpret_cast<const char*>(str)) {}
+
+String::String(char c) : _buffer(1, c) {}
+
+String::String(unsigned char value, unsigned char base) {
+    appendNumber(value, base, false);
+}
+
+String::String(int value, unsigned char base) {
+    if (base == 10 && value < 0) {
+        appendNumber((unsigned long long)(-(long long)value), base, true);
+    } else {
+        appendNumber(base == 10 ? (unsigned long long)value : (unsigned int)value, base, false);
+    }
+}
+
+String::String(unsigned int value, unsigned char base) {
+    appendNumber(value, base, false);
+}
+
+String::String(long value, unsigned char base) {
+    if (base == 10 && value < 0) {
+        appendNumber((unsigned long long)(-(long long)value), base, true);
+    } else {
+        appendNumber(base == 10 ? (unsigned long long)value : (unsigned long)value, base, false);
+    }
+}
+
+String::String(unsigned long value, unsigned char base) {
+    appendNumber(value, base, false);
+}
+
+String::String(long long value, unsigned char base) {
+    if (base == 10 && value < 0) {
+        appendNumber((unsigned long long)(-value), base, true);
+    } else {
+        appendNumber((unsigned long long)value, base, false);
+    }
+}
+
+String::String(unsigned long long value, unsigned char base) {
+    appendNumber(value, base, false);
+}
+
+String::String(float value, unsigned char decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned char decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    _buffer = buf;
+}
+
+void String::appendNumber(unsigned long long value, unsigned char base, bool negative) {
+    if (base < 2) base = 10;
+    char buf[72];
+    char* p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    do {
+        unsigned digit = (unsigned)(value % base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value);
+    if (negative) *--p = '-';
+    _buffer += p;
+}
+
+String& String::operator=(const char* cstr) {
+    _buffer = cstr ? cstr : "";
+    return *this;
+}
+
+String& String::operator=(char c) {
+    _buffer.assign(1, c);
+    return *this;
+}
+
+bool String::reserve(unsigned int size) {
+    _buffer.reserve(size);
+    return true;
+}
+
+// ============================================================================
+// CONCATENATION
+// ============================================================================
+
+bool String::concat(const String& str) { _buffer += str._buffer; return true; }
+bool String::concat(const char* cstr) { if (!cstr) return false; _buffer += cstr; return true; }
+bool String::concat(const char* cstr, unsigned int length) { if (!cstr) return false; _buffer.append(cstr, length); return true; }
+bool String::concat(char c) { _buffer += c; return true; }
+bool String::concat(unsigned char value) { return concat(String(value)); }
+bool String::concat(int value) { return concat(String(value)); }
+bool String::concat(unsigned int value) { return concat(String(value)); }
+bool String::concat(long value) { return concat(String(value)); }
+bool String::concat(unsigned long value) { return concat(String(value)); }
+bool String::concat(long long value) { return concat(String(value)); }
+bool String::concat(unsigned long long value) { return concat(String(value)); }
+bool String::concat(float value) { return concat(String(value)); }
+bool String::concat(double value) { return concat(String(value)); }
+
+String operator+(const String& lhs, const String& rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, const char* rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const char* lhs, const String& rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, char rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, unsigned char rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, int rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, unsigned int rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, long rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, unsigned long rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, long long rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, unsigned long long rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, float rhs) { String s(lhs); s.concat(rhs); return s; }
+String operator+(const String& lhs, double rhs) { String s(lhs); s.concat(rhs); return s; }
+
+// ============================================================================
+// COMPARISON
+// ============================================================================
+
+int String::compareTo(const String& s) const {
+    return strcmp(c_str(), s.c_str());
+}
+
+bool String::equals(const char* cstr) const {
+    return strcmp(c_str(), cstr ? cstr : "") == 0;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+    return length() == s.length() && strcasecmp(c_str(), s.c_str()) == 0;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    if (offset > length() || prefix.length() > length() - offset) return false;
+    return _buffer.compare(offset, prefix.length(), prefix._buffer) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix.length() > length()) return false;
+    return _buffer.compare(length() - suffix.length(), suffix.length(), suffix._buffer) == 0;
+}
+
+// ============================================================================
+// CHARACTER ACCESS
+// ============================================================================
+
+char String::charAt(unsigned int index) const {
+    return index < length() ? _buffer[index] : 0;
+}
+
+void String::setCharAt(unsigned int index, char c) {
+    if (index < length()) _buffer[index] = c;
+}
+
+char String::operator[](unsigned int index) const {
+    return charAt(index);
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy;
+    if (index >= length()) {
+        dummy = 0;
+        return dummy;
+    }
+    return _buffer[index];
+}
+
+void String::getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index) const {
+    if (!bufsize || !buf) return;
+    if (index >= length()) {
+        buf[0] = 0;
+        return;
+    }
+    unsigned int n = bufsize - 1;
+    if (n > length() - index) n = length() - index;
+    memcpy(buf, _buffer.data() + index, n);
+    buf[n] = 0;
+}
+
+// ============================================================================
+// SEARCH
+// ============================================================================
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+    if (fromIndex >= length()) return -1;
+    size_t pos = _buffer.find(ch, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+    if (fromIndex >= length()) return -1;
+    size_t pos = _buffer.find(str._buffer, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char ch) const {
+    return length() ? lastIndexOf(ch, length() - 1) : -1;
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const {
+    if (fromIndex >= length()) return -1;
+    size_t pos = _buffer.rfind(ch, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(const String& str) const {
+    return length() ? lastIndexOf(str, length() - 1) : -1;
+}
+
+int String::lastIndexOf(const String& str, unsigned int fromIndex) const {
+    if (str.length() == 0 || str.length() > length() || fromIndex >= length()) return -1;
+    size_t pos = _buffer.rfind(str._buffer, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int left, unsigned int right) const {
+    if (left > right) {
+        unsigned int temp = right;
+        right = left;
+        left = temp;
+    }
+    if (left >= length()) return String();
+    if (right > length()) right = length();
+    String out;
+    out._buffer = _buffer.substr(left, right - left);
+    return out;
+}
+
+// ============================================================================
+// MODIFICATION
+// ============================================================================
+
+void String::replace(char find, char replace) {
+    for (char& c : _buffer) {
+        if (c == find) c = replace;
+    }
+}
+
+void String::replace(const String& find, const String& replace) {
+    if (find.length() == 0) return;
+    size_t pos = 0;
+    while ((pos = _buffer.find(find._buffer, pos)) != std::string::npos) {
+        _buffer.replace(pos, find.length(), replace._buffer);
+        pos += replace.length();
+    }
+}
+
+void String::remove(unsigned int index) {
+    remove(index, (unsigned int)-1);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index >= length()) return;
+    if (count > length() - index) count = length() - index;
+    _buffer.erase(index, count);
+}
+
+void String::toLowerCase() {
+    for (char& c : _buffer) c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (char& c : _buffer) c = (char)toupper((unsigned char)c);
+}
+
+void String::trim() {
+    size_t begin = 0;
+    while (begin < _buffer.size() && isspace((unsigned char)_buffer[begin])) begin++;
+    size_t end = _buffer.size();
+    while (end > begin && isspace((unsigned char)_buffer[end - 1])) end--;
+    _buffer = _buffer.substr(begin, end - begin);
+}
+
+// ============================================================================
+// PARSING
+// ============================================================================
+
+long String::toInt() const {
+    return atol(c_str());
+}
+
+float String::toFloat() const {
+    return (float)atof(c_str());
+}
+
+double String::toDouble() const {
+    return atof(c_str());
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+class __FlashStringHelper;
+
+/**
+ * Arduino String for the host build, backed by std::string.
+ *
+ * Mirrors the arduino-pico WString API (constructors, concatenation,
+ * search/substring, trim/case helpers and numeric conversion) closely enough
+ * that firmware code and ArduinoJson's String adapters behave identically.
+ */
+class String {
+public:
+    String(const char* cstr = "");
+    String(const char* cstr, unsigned int length);
+    String(const String& str) = default;
+    String(String&& str) noexcept = default;
+    String(const __FlashStringHelper* str);
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned char decimalPlaces = 2);
+    explicit String(double value, unsigned char decimalPlaces = 2);
+
+    String& operator=(const String& rhs) = default;
+    String& operator=(String&& rhs) noexcept = default;
+    String& operator=(const char* cstr);
+    String& operator=(char c);
+
+    bool reserve(unsigned int size);
+    // size_t (== unsigned int on the RP2040) so ArduinoJson's string traits match
+    size_t length() const { return _buffer.size(); }
+    bool isEmpty() const { return _buffer.empty(); }
+    const char* c_str() const { return _buffer.c_str(); }
+    char* begin() { return &_buffer[0]; }
+    char* end() { return begin() + _buffer.size(); }
+    const char* begin() const { return _buffer.c_str(); }
+    const char* end() const { return _buffer.c_str() + _buffer.size(); }
+
+    // Concatenation
+    bool concat(const String& str);
+    bool concat(const char* cstr);
+    bool concat(const char* cstr, unsigned int length);
+    bool concat(char c);
+    bool concat(unsigned char value);
+    bool concat(int value);
+    bool concat(unsigned int value);
+    bool concat(long value);
+    bool concat(unsigned long value);
+    bool concat(long long value);
+    bool concat(unsigned long long value);
+    bool concat(float value);
+    bool concat(double value);
+
+    template <typename T>
+    String& operator+=(const T& rhs) {
+        concat(rhs);
+        return *this;
+    }
+
+    // Comparison
+    int compareTo(const String& s) const;
+    bool equals(const String& s) const { return _buffer == s._buffer; }
+    bool equals(const char* cstr) const;
+    bool equalsIgnoreCase(const String& s) const;
+    bool operator==(const String& rhs) const { return equals(rhs); }
+    bool operator==(const char* cstr) const { return equals(cstr); }
+    bool operator!=(const String& rhs) const { return !equals(rhs); }
+    bool operator!=(const char* cstr) const { return !equals(cstr); }
+    bool operator<(const String& rhs) const { return compareTo(rhs) < 0; }
+    bool operator>(const String& rhs) const { return compareTo(rhs) > 0; }
+    bool operator<=(const String& rhs) const { return compareTo(rhs) <= 0; }
+    bool operator>=(const String& rhs) const { return compareTo(rhs) >= 0; }
+    bool startsWith(const String& prefix) const;
+    bool startsWith(const String& prefix, unsigned int offset) const;
+    bool endsWith(const String& suffix) const;
+
+    // Character access
+    char charAt(unsigned int index) const;
+    void setCharAt(unsigned int index, char c);
+    char operator[](unsigned int index) const;
+    char& operator[](unsigned int index);
+    void getBytes(unsigned char* buf, unsigned int bufsize, unsigned int index = 0) const;
+    void toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const {
+        getBytes((unsigned char*)buf, bufsize, index);
+    }
+
+    // Search
+    int indexOf(char ch) const { return indexOf(ch, 0); }
+    int indexOf(char ch, unsigned int fromIndex) const;
+    int indexOf(const String& str) const { return indexOf(str, 0); }
+    int indexOf(const String& str, unsigned int fromIndex) const;
+    int lastIndexOf(char ch) const;
+    int lastIndexOf(char ch, unsigned int fromIndex) const;
+    int lastIndexOf(const String& str) const;
+    int lastIndexOf(const String& str, unsigned int fromIndex) const;
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, length()); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    // Modification
+    void replace(char find, char replace);
+    void replace(const String& find, const String& replace);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    // Parsing
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+
+private:
+    std::string _buffer;
+
+    void appendNumber(unsigned long long value, unsigned char base, bool negative);
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char* rhs);
+String operator+(const char* lhs, const String& rhs);
+String operator+(const String& lhs, char rhs);
+String operator+(const String& lhs, unsigned char rhs);
+String operator+(const String& lhs, int rhs);
+String operator+(const String& lhs, unsigned int rhs);
+String operator+(const String& lhs, long rhs);
+String operator+(const String& lhs, unsigned long rhs);
+String operator+(const String& lhs, long long rhs);
+String operator+(const String& lhs, unsigned long long rhs);
+String operator+(const String& lhs, float rhs);
+String operator+(const String& lhs, double rhs);
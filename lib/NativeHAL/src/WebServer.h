@@ -0,0 +1,4 @@
+#pragma once
+
+// The firmware serves HTTP from a raw WiFiServer; only the socket classes are needed
+#include "WiFi.h"
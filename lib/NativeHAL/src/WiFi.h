@@ -0,0 +1,30 @@
+#pragma once
+
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+/**
+ * CYW43 WiFi object; the W5500-EVB-PoE-Pico has no radio, so it reports
+ * WL_NO_SHIELD and empty addresses exactly like the target does
+ */
+class WiFiClass {
+public:
+    wl_status_t status() { return WL_NO_SHIELD; }
+    IPAddress localIP() { return IPAddress(); }
+    IPAddress gatewayIP() { return IPAddress(); }
+    IPAddress subnetMask() { return IPAddress(); }
+    String macAddress() { return String("00:00:00:00:00:00"); }
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,160 @@
+#include "WiFiClient.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Give up on a peer that stops draining its receive window
+static const int kWriteTimeoutMs = 5000;
+
+static IPAddress ipFromSockaddr(const sockaddr_in& sa) {
+    return IPAddress((uint32_t)sa.sin_addr.s_addr);
+}
+
+// ============================================================================
+// SOCKET STATE
+// ============================================================================
+
+WiFiClient::Socket::Socket(int fd) : fd(fd) {
+    if (fd < 0) return;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    sockaddr_in sa;
+    socklen_t len = sizeof(sa);
+    if (getpeername(fd, (sockaddr*)&sa, &len) == 0 && sa.sin_family == AF_INET) {
+        remoteIP = ipFromSockaddr(sa);
+        remotePort = ntohs(sa.sin_port);
+    }
+    len = sizeof(sa);
+    if (getsockname(fd, (sockaddr*)&sa, &len) == 0 && sa.sin_family == AF_INET) {
+        localIP = ipFromSockaddr(sa);
+    }
+}
+
+WiFiClient::Socket::~Socket() {
+    close();
+}
+
+void WiFiClient::Socket::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+// ============================================================================
+// CONNECT / STOP
+// ============================================================================
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    stop();
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return 0;
+
+    sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+    sa.sin_addr.s_addr = (uint32_t)ip;
+    if (::connect(fd, (sockaddr*)&sa, sizeof(sa)) != 0) {
+        ::close(fd);
+        return 0;
+    }
+    _socket = std::make_shared<Socket>(fd);
+    return 1;
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &result) != 0 || !result) return 0;
+    IPAddress ip = ipFromSockaddr(*(sockaddr_in*)result->ai_addr);
+    freeaddrinfo(result);
+    return connect(ip, port);
+}
+
+void WiFiClient::stop() {
+    if (_socket) _socket->close();
+    _socket.reset();
+}
+
+uint8_t WiFiClient::connected() {
+    if (!_socket || _socket->fd < 0) return 0;
+    uint8_t probe;
+    ssize_t n = recv(_socket->fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n > 0) return 1;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 1;
+    return 0;  // orderly shutdown or error
+}
+
+// ============================================================================
+// DATA
+// ============================================================================
+
+int WiFiClient::available() {
+    if (!_socket || _socket->fd < 0) return 0;
+    NativeHAL::waitForInterrupts();
+    int count = 0;
+    if (ioctl(_socket->fd, FIONREAD, &count) != 0) return 0;
+    return count;
+}
+
+int WiFiClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+    if (!_socket || _socket->fd < 0 || size == 0) return -1;
+    NativeHAL::waitForInterrupts();
+    ssize_t n = recv(_socket->fd, buf, size, MSG_DONTWAIT);
+    return n > 0 ? (int)n : -1;
+}
+
+int WiFiClient::peek() {
+    if (!_socket || _socket->fd < 0) return -1;
+    uint8_t c;
+    return recv(_socket->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+    if (!_socket || _socket->fd < 0) return 0;
+    NativeHAL::waitForInterrupts();
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t n = send(_socket->fd, buf + sent, size - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += (size_t)n;
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd pfd = {_socket->fd, POLLOUT, 0};
+            if (poll(&pfd, 1, kWriteTimeoutMs) > 0) continue;
+        }
+        setWriteError();
+        break;
+    }
+    return sent;
+}
+
+void WiFiClient::setNoDelay(bool noDelay) {
+    if (!_socket || _socket->fd < 0) return;
+    int flag = noDelay ? 1 : 0;
+    setsockopt(_socket->fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+}
+
+bool WiFiClient::getNoDelay() const {
+    if (!_socket || _socket->fd < 0) return false;
+    int flag = 0;
+    socklen_t len = sizeof(flag);
+    getsockopt(_socket->fd, IPPROTO_TCP, TCP_NODELAY, &flag, &len);
+    return flag != 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+#include <memory>
+
+#include "Client.h"
+
+/**
+ * TCP client over a non-blocking POSIX socket
+ *
+ * Copies share one socket (like lwIP's ClientContext refcount): the
+ * descriptor is closed by stop() or when the last copy is destroyed.
+ */
+class WiFiClient : public Client {
+public:
+    WiFiClient() {}
+    virtual ~WiFiClient() {}
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buf, size_t size) override;
+    int read(char* buf, size_t size) { return read((uint8_t*)buf, size); }
+    int peek() override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+    operator bool() override { return _socket && _socket->fd >= 0; }
+
+    using Print::write;
+
+    IPAddress remoteIP() const { return _socket ? _socket->remoteIP : IPAddress(); }
+    uint16_t remotePort() const { return _socket ? _socket->remotePort : 0; }
+    IPAddress localIP() const { return _socket ? _socket->localIP : IPAddress(); }
+    void setNoDelay(bool noDelay);
+    bool getNoDelay() const;
+
+    bool operator==(const WiFiClient& rhs) const { return _socket == rhs._socket; }
+    bool operator!=(const WiFiClient& rhs) const { return !(*this == rhs); }
+
+private:
+    friend class WiFiServer;
+
+    struct Socket {
+        explicit Socket(int fd);
+        ~Socket();
+        void close();
+
+        int fd;
+        IPAddress remoteIP;
+        uint16_t remotePort = 0;
+        IPAddress localIP;
+    };
+
+    explicit WiFiClient(int fd) : _socket(std::make_shared<Socket>(fd)) {}
+
+    std::shared_ptr<Socket> _socket;
+};
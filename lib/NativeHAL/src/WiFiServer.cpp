@@ -0,0 +1,68 @@
+#include "WiFiServer.h"
+#include "WiFi.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+// lwIP hands the first segment over with the connection; wait this long for it
+static const int kFirstSegmentWaitMs = 20;
+
+void WiFiServer::begin(uint16_t port, int backlog) {
+    close();
+    _port = port;
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    int hostPort = (int)port + NativeHAL::getPortOffset();
+    sockaddr_in sa = {};
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons((uint16_t)hostPort);
+    sa.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(fd, (sockaddr*)&sa, sizeof(sa)) != 0 || listen(fd, backlog) != 0) {
+        fprintf(stderr, "[NativeHAL] WiFiServer: cannot listen on port %d: %s\n", hostPort, strerror(errno));
+        ::close(fd);
+        return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    _fd = fd;
+    fprintf(stderr, "[NativeHAL] WiFiServer: port %u listening on host port %d\n", (unsigned)port, hostPort);
+}
+
+void WiFiServer::close() {
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+}
+
+bool WiFiServer::hasClient() {
+    if (_fd < 0) return false;
+    NativeHAL::waitForInterrupts();
+    struct pollfd pfd = {_fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0;
+}
+
+WiFiClient WiFiServer::accept() {
+    if (_fd < 0) return WiFiClient();
+    NativeHAL::waitForInterrupts();
+    int fd = ::accept(_fd, nullptr, nullptr);
+    if (fd < 0) return WiFiClient();
+
+    if (_noDelay) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    struct pollfd pfd = {fd, POLLIN, 0};
+    poll(&pfd, 1, kFirstSegmentWaitMs);
+    return WiFiClient(fd);
+}
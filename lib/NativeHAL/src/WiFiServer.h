@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "Server.h"
+#include "WiFiClient.h"
+
+/**
+ * TCP listener over a POSIX socket
+ *
+ * Binds INADDR_ANY on `port + NativeHAL::getPortOffset()` so the default
+ * ports (80, 502) can be served by an unprivileged host process.
+ */
+class WiFiServer : public Server {
+public:
+    explicit WiFiServer(uint16_t port = 23) : _port(port) {}
+    WiFiServer(const IPAddress& addr, uint16_t port) : _port(port) { (void)addr; }
+    virtual ~WiFiServer() { close(); }
+
+    void begin() override { begin(_port); }
+    void begin(uint16_t port, int backlog = 4);
+    void end() { close(); }
+    void close();
+    void stop() { close(); }
+
+    WiFiClient accept();
+    WiFiClient available() { return accept(); }
+    bool hasClient();
+    uint8_t status() { return _fd >= 0 ? 1 : 0; }
+    void setNoDelay(bool noDelay) { _noDelay = noDelay; }
+    bool getNoDelay() const { return _noDelay; }
+    uint16_t port() const { return _port; }
+
+    size_t write(uint8_t c) override { (void)c; return 0; }
+    size_t write(const uint8_t* buf, size_t size) override { (void)buf; (void)size; return 0; }
+    using Print::write;
+
+    operator bool() { return _fd >= 0; }
+
+private:
+    uint16_t _port;
+    int _fd = -1;
+    bool _noDelay = false;
+};
@@ -0,0 +1,127 @@
+#include "Wire.h"
+#include "NativeSim.h"
+
+TwoWire Wire(0, PIN_WIRE0_SDA, PIN_WIRE0_SCL);
+TwoWire Wire1(1, PIN_WIRE1_SDA, PIN_WIRE1_SCL);
+
+TwoWire::TwoWire(int controller, pin_size_t sda, pin_size_t scl)
+    : _controller(controller), _sda(sda), _scl(scl) {}
+
+// I2C0 SDA lives on GPIO 0,4,8,...,28 and I2C1 SDA on 2,6,...,26; SCL is SDA+1
+bool TwoWire::validSDA(pin_size_t pin) const {
+    return pin < 30 && (pin % 4) == (pin_size_t)(_controller == 0 ? 0 : 2);
+}
+
+bool TwoWire::validSCL(pin_size_t pin) const {
+    return pin < 30 && (pin % 4) == (pin_size_t)(_controller == 0 ? 1 : 3);
+}
+
+bool TwoWire::setSDA(pin_size_t sda) {
+    if (!validSDA(sda)) {
+        fprintf(stderr, "[NativeHAL] I2C%d: illegal SDA pin %u\n", _controller, (unsigned)sda);
+        return false;
+    }
+    if (_running) {
+        fprintf(stderr, "[NativeHAL] I2C%d: cannot change SDA while running\n", _controller);
+        return false;
+    }
+    _sda = sda;
+    return true;
+}
+
+bool TwoWire::setSCL(pin_size_t scl) {
+    if (!validSCL(scl)) {
+        fprintf(stderr, "[NativeHAL] I2C%d: illegal SCL pin %u\n", _controller, (unsigned)scl);
+        return false;
+    }
+    if (_running) {
+        fprintf(stderr, "[NativeHAL] I2C%d: cannot change SCL while running\n", _controller);
+        return false;
+    }
+    _scl = scl;
+    return true;
+}
+
+void TwoWire::begin() {
+    _running = true;
+    _txBegun = false;
+    _txLength = 0;
+    _rxLength = 0;
+    _rxIndex = 0;
+}
+
+void TwoWire::end() {
+    _running = false;
+    _txBegun = false;
+}
+
+void TwoWire::occupyBus(size_t bytes) {
+    // address byte + payload, 9 clocks each, plus roughly 2 clocks for START/STOP
+    uint64_t bits = (uint64_t)(bytes + 1) * 9 + 2;
+    uint64_t us = (bits * 1000000ULL + _clock - 1) / _clock;
+    delayMicroseconds((unsigned int)us);
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    _txAddress = address;
+    _txLength = 0;
+    _txBegun = true;
+}
+
+uint8_t TwoWire::endTransmission(bool stopBit) {
+    (void)stopBit;
+    if (!_running || !_txBegun) return 4;
+    _txBegun = false;
+
+    NativeSim::I2CDevice* device = NativeSim::findI2CDevice((int)_sda, (int)_scl, _txAddress);
+    if (!device) {
+        occupyBus(0);
+        return 2;  // address NACK
+    }
+    occupyBus(_txLength);
+    return device->onWrite(_txBuffer, _txLength) ? 0 : 3;
+}
+
+size_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit) {
+    (void)stopBit;
+    _rxIndex = 0;
+    _rxLength = 0;
+    if (!_running || quantity == 0) return 0;
+    if (quantity > WIRE_BUFFER_SIZE) quantity = WIRE_BUFFER_SIZE;
+
+    NativeSim::I2CDevice* device = NativeSim::findI2CDevice((int)_sda, (int)_scl, address);
+    if (!device) {
+        occupyBus(0);
+        return 0;
+    }
+    size_t received = device->onRead(_rxBuffer, quantity);
+    occupyBus(received);
+    _rxLength = received;
+    return received;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (!_txBegun || _txLength >= WIRE_BUFFER_SIZE) return 0;
+    _txBuffer[_txLength++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t quantity) {
+    size_t written = 0;
+    while (written < quantity && write(data[written])) {
+        written++;
+    }
+    return written;
+}
+
+int TwoWire::available() {
+    return (int)(_rxLength - _rxIndex);
+}
+
+int TwoWire::read() {
+    return _rxIndex < _rxLength ? _rxBuffer[_rxIndex++] : -1;
+}
+
+int TwoWire::peek() {
+    return _rxIndex < _rxLength ? _rxBuffer[_rxIndex] : -1;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define WIRE_BUFFER_SIZE 256
+
+/**
+ * RP2040 I2C controller model (arduino-pico TwoWire subset)
+ *
+ * Transactions are routed to NativeSim devices at the controller's current
+ * (SDA, SCL) pins. Each transaction advances the virtual clock by the time it
+ * would occupy the bus (9 bit times per byte incl. ACK, plus start/stop), so
+ * firmware timing measurements stay meaningful on the host.
+ */
+class TwoWire : public Stream {
+public:
+    TwoWire(int controller, pin_size_t sda, pin_size_t scl);
+
+    bool setSDA(pin_size_t sda);
+    bool setSCL(pin_size_t scl);
+    void setClock(uint32_t frequency) { _clock = frequency ? frequency : 100000; }
+    uint32_t getClock() const { return _clock; }
+    void setTimeout(uint32_t timeoutMs = 25, bool resetWithTimeout = false) {
+        _timeoutMs = timeoutMs;
+        (void)resetWithTimeout;
+    }
+
+    void begin();
+    void begin(uint8_t address) { (void)address; begin(); }
+    void end();
+
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+    uint8_t endTransmission(bool stopBit);
+    uint8_t endTransmission() { return endTransmission(true); }
+
+    size_t requestFrom(uint8_t address, size_t quantity, bool stopBit);
+    size_t requestFrom(uint8_t address, size_t quantity) { return requestFrom(address, quantity, true); }
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t* data, size_t quantity) override;
+    size_t write(int data) { return write((uint8_t)data); }
+    size_t write(unsigned int data) { return write((uint8_t)data); }
+    size_t write(long data) { return write((uint8_t)data); }
+    size_t write(unsigned long data) { return write((uint8_t)data); }
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override {}
+
+    using Print::write;
+
+    pin_size_t getSDA() const { return _sda; }
+    pin_size_t getSCL() const { return _scl; }
+
+private:
+    int _controller;
+    pin_size_t _sda;
+    pin_size_t _scl;
+    uint32_t _clock = 100000;
+    uint32_t _timeoutMs = 25;
+    bool _running = false;
+    bool _txBegun = false;
+    uint8_t _txAddress = 0;
+
+    uint8_t _txBuffer[WIRE_BUFFER_SIZE];
+    size_t _txLength = 0;
+    uint8_t _rxBuffer[WIRE_BUFFER_SIZE];
+    size_t _rxLength = 0;
+    size_t _rxIndex = 0;
+
+    bool validSDA(pin_size_t pin) const;
+    bool validSCL(pin_size_t pin) const;
+    void occupyBus(size_t bytes);
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
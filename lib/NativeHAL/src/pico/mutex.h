@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+
+/**
+ * pico-sdk mutex subset (pico/mutex.h)
+ *
+ * On the RP2040 a mutex_t excludes the other core; on the host the two
+ * "cores" are threads, so it wraps a std::mutex.
+ */
+typedef struct mutex {
+    std::mutex lock;
+} mutex_t;
+
+#define auto_init_mutex(name) static mutex_t name
+
+static inline void mutex_init(mutex_t* mtx) {
+    (void)mtx;
+}
+
+static inline void mutex_enter_blocking(mutex_t* mtx) {
+    mtx->lock.lock();
+}
+
+static inline bool mutex_try_enter(mutex_t* mtx, uint32_t* owner_out) {
+    if (owner_out) *owner_out = 0;
+    return mtx->lock.try_lock();
+}
+
+static inline void mutex_exit(mutex_t* mtx) {
+    mtx->lock.unlock();
+}
@@ -1,7 +1,15 @@
 #include "sys_init.h"
 #include "i2c_bus_manager.h"
-#include <Adafruit_LIS3DH.h>
-#include <Adafruit_Sensor.h>
+#include "sensor_snapshot.h"
+#include "register_store.h"
+#include "register_directory.h"
+#include "logging.h"
+#include "sensor_scheduler.h"
+#include "uart_sensor_engine.h"
+#include "one_wire_bus_manager.h"
+#include "rule_engine.h"
+#include "periodic_scan.h"
+#include <pico/mutex.h>
 
 // Sensor reading functions
 bool readSHT30(uint8_t sensorIndex, float& temperature, float& humidity);
@@ -9,19 +17,51 @@ bool readDS18B20(uint8_t sensorIndex, float& temperature);
 bool readEZOPH(uint8_t sensorIndex, float& ph);
 bool readEZOEC(uint8_t sensorIndex, float& conductivity);
 float parseSensorData(const char* rawData, const SensorConfig& sensor);
-float evaluateCalibrationExpression(float x, const SensorConfig& sensor);
+void resolveSensorKinds(SensorConfig& sensor);
+#ifdef NATIVE_BUILD
+float evaluateCalibrationExpression(float x, const char* expression);
+#endif
+void compileSensorCalibration(SensorConfig& sensor);
+void resolveFixedPointCalibration(SensorConfig& sensor);
+void storeChannelQ16(SensorConfig& sensor, uint8_t channel, q16_t raw);
+void runFixedPointBenchmark();
+#ifdef NATIVE_BUILD
+void runCalibrationBenchmark();
+#endif
 float applyCalibration(float rawValue, const SensorConfig& sensor);
 float applyCalibrationB(float rawValue, const SensorConfig& sensor);
 float applyCalibrationC(float rawValue, const SensorConfig& sensor);
-void handleLIS3DHSensors();  // Forward declaration for LIS3DH polling handler
+void updateAnalogSensors();  // Core 1: ANALOG_CUSTOM sensor sampling
 // Use ANALOG_INPUTS from sys_init.h instead of ADC_PINS
-#include "Ezo_i2c.h"
-
-// LIS3DH accelerometer instances (one per sensor, max 8 sensors)
-Adafruit_LIS3DH* lis3dhSensors[MAX_SENSORS] = {nullptr};
 
 // I2C Bus Manager instance
 I2CBusManager i2cBusManager;
+UartSensorEngine uartSensorEngine;
+OneWireBusManager oneWireBusManager;
+
+// FFT of LIS3DH windows (core 1)
+VibrationAnalyzer vibrationAnalyzer;
+
+// Dual-core handoff: core 1 polls sensors and publishes, core 0 reads sensorValues
+SensorSnapshot sensorSnapshot;
+SensorCoreControl sensorCore;
+SensorRuntimeValues sensorValues[MAX_SENSORS] = {};  // Core 0 copy of the latest snapshot
+uint32_t sensorValuesGeneration = 0;
+
+// Change-tracked input values; only dirty entries are written to modbusImage
+RegisterStore registerStore;
+
+// Source of every register address, rebuilt by applySensorPresets()
+RegisterDirectory registerDirectory;
+
+// Serial log filter within the compiled-in LOG_LEVEL ("loglevel <n>" command)
+uint8_t logRuntimeLevel = LOG_LEVEL;
+
+// Compiled I/O rules, rebuilt on every I/O configuration load/post (core 0)
+RuleEngine ruleEngine;
+
+// Fixed-period release of the global rules (ioConfig.globalScanPeriodMs)
+PeriodicScan globalRuleScan;
 
 // SensorConfig array definition (from sys_init.h extern)
 SensorConfig configuredSensors[MAX_SENSORS] = {};
@@ -29,8 +69,8 @@ int numConfiguredSensors = 0;
 
 // Preset table for named sensors
 struct SensorPreset {
-    const char* type;
-    const char* protocol;
+    SensorType type;
+    SensorProtocol protocol;
     uint8_t command[2];
     int commandLen;
     int updateInterval;
@@ -39,25 +79,30 @@ struct SensorPreset {
 
 const SensorPreset sensorPresets[] = {
     // SHT30: I2C command 0x2C 0x06, 1s polling, 15ms delay
-    { "SHT30", "I2C", {0x2C, 0x06}, 2, 1000, 15 },
+    { SensorType::SHT30, SensorProtocol::I2C, {0x2C, 0x06}, 2, 1000, 15 },
     // DS18B20: One-Wire, 2s polling, 750ms conversion time
-    { "DS18B20", "One-Wire", {0x44, 0x00}, 1, 2000, 750 },
+    { SensorType::DS18B20, SensorProtocol::ONE_WIRE, {0x44, 0x00}, 1, 2000, 750 },
     // EZO Sensors: I2C read command 'R' = 0x52, 5s polling, 900ms response time
-    { "EZO_PH", "I2C", {0x52, 0x00}, 1, 5000, 900 },
-    { "EZO_EC", "I2C", {0x52, 0x00}, 1, 5000, 900 },
-    { "EZO_DO", "I2C", {0x52, 0x00}, 1, 5000, 900 },
-    { "EZO_RTD", "I2C", {0x52, 0x00}, 1, 5000, 900 },
+    { SensorType::EZO_PH, SensorProtocol::I2C, {0x52, 0x00}, 1, 5000, 900 },
+    { SensorType::EZO_EC, SensorProtocol::I2C, {0x52, 0x00}, 1, 5000, 900 },
+    { SensorType::EZO_DO, SensorProtocol::I2C, {0x52, 0x00}, 1, 5000, 900 },
+    { SensorType::EZO_RTD, SensorProtocol::I2C, {0x52, 0x00}, 1, 5000, 900 },
     // LIS3DH: 3-axis accelerometer, I2C, 1s polling, direct register read (no command)
-    { "LIS3DH", "I2C", {0x00, 0x00}, 0, 1000, 0 },
+    { SensorType::LIS3DH, SensorProtocol::I2C, {0x00, 0x00}, 0, 1000, 0 },
     // Add more named sensors here as needed
 };
 
 void applySensorPresets() {
+    // Intern type/protocol/parsing method before anything dispatches on them
+    for (int i = 0; i < numConfiguredSensors; i++) {
+        resolveSensorKinds(configuredSensors[i]);
+    }
+    
     int ezoPhCount = 0;
     for (int i = 0; i < numConfiguredSensors; i++) {
         if (!configuredSensors[i].enabled) continue;
         // Auto-configure based on sensor type (only if not already configured)
-            if (strcmp(configuredSensors[i].type, "EZO-PH") == 0 || strcmp(configuredSensors[i].type, "EZO_PH") == 0) {
+            if (configuredSensors[i].typeId == SensorType::EZO_PH) {
             ezoPhCount++;
             if (ezoPhCount > 1) {
                 // Disable duplicate EZO-PH sensors
@@ -70,56 +115,56 @@ void applySensorPresets() {
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "I2C");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 5000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 51;
-        } else if (strcmp(configuredSensors[i].type, "EZO-EC") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::EZO_EC) {
             if (configuredSensors[i].i2cAddress == 0) configuredSensors[i].i2cAddress = 0x64;
             if (strlen(configuredSensors[i].command) == 0) strcpy(configuredSensors[i].command, "R");
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "I2C");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 5000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 52;
-        } else if (strcmp(configuredSensors[i].type, "EZO-DO") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::EZO_DO) {
             if (configuredSensors[i].i2cAddress == 0) configuredSensors[i].i2cAddress = 0x61;
             if (strlen(configuredSensors[i].command) == 0) strcpy(configuredSensors[i].command, "R");
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "I2C");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 5000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 53;
-        } else if (strcmp(configuredSensors[i].type, "EZO-RTD") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::EZO_RTD) {
             if (configuredSensors[i].i2cAddress == 0) configuredSensors[i].i2cAddress = 0x66;
             if (strlen(configuredSensors[i].command) == 0) strcpy(configuredSensors[i].command, "R");
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "I2C");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 5000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 1;
-        } else if (strcmp(configuredSensors[i].type, "SHT30") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::SHT30) {
             if (configuredSensors[i].i2cAddress == 0) configuredSensors[i].i2cAddress = 0x44;
             if (strlen(configuredSensors[i].command) == 0) strcpy(configuredSensors[i].command, "0x2C06");  // SHT30 measurement command
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "I2C");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 1000;
             // Don't override manually configured modbus register!
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 2;
-        } else if (strcmp(configuredSensors[i].type, "BME280") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::BME280) {
             if (configuredSensors[i].i2cAddress == 0) configuredSensors[i].i2cAddress = 0x76;
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "I2C");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 1000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 3;
-        } else if (strcmp(configuredSensors[i].type, "DS18B20") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::DS18B20) {
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "One-Wire");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 2000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 4;
-        } else if (strcmp(configuredSensors[i].type, "LIS3DH") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::LIS3DH) {
             if (configuredSensors[i].i2cAddress == 0) configuredSensors[i].i2cAddress = 0x18;
             // LIS3DH uses direct register read, NOT a command - clear any existing command
             memset(configuredSensors[i].command, 0, sizeof(configuredSensors[i].command));
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "I2C");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 1000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 11;
-        } else if (strcmp(configuredSensors[i].type, "Generic One-Wire") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::GENERIC_ONEWIRE) {
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "One-Wire");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 2000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 17; // Next available register
-        } else if (strcmp(configuredSensors[i].type, "Generic I2C") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::GENERIC_I2C) {
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "I2C");
             if (configuredSensors[i].updateInterval == 0) configuredSensors[i].updateInterval = 1000;
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 18; // Next available register
-        } else if (strcmp(configuredSensors[i].type, "GENERIC_UART") == 0) {
+        } else if (configuredSensors[i].typeId == SensorType::GENERIC_UART) {
             if (strlen(configuredSensors[i].protocol) == 0) strcpy(configuredSensors[i].protocol, "UART");
             // Don't override updateInterval - use what was configured in web UI
             if (configuredSensors[i].modbusRegister == 0) configuredSensors[i].modbusRegister = 19; // Next available register
@@ -134,8 +179,8 @@ void applySensorPresets() {
     }
     for (int i = 0; i < numConfiguredSensors; i++) {
         for (unsigned int p = 0; p < sizeof(sensorPresets)/sizeof(sensorPresets[0]); p++) {
-            if (strcmp(configuredSensors[i].type, sensorPresets[p].type) == 0 &&
-                strcmp(configuredSensors[i].protocol, sensorPresets[p].protocol) == 0) {
+            if (configuredSensors[i].typeId == sensorPresets[p].type &&
+                configuredSensors[i].protocolId == sensorPresets[p].protocol) {
                 // Only set fields if not already set
                 if (configuredSensors[i].updateInterval <= 0)
                     configuredSensors[i].updateInterval = sensorPresets[p].updateInterval;
@@ -145,11 +190,11 @@ void applySensorPresets() {
                     snprintf(configuredSensors[i].command, sizeof(configuredSensors[i].command), "0x%02X 0x%02X", sensorPresets[p].command[0], sensorPresets[p].command[1]);
                 }
                 // Protocol-specific delay assignment
-                if (strcmp(configuredSensors[i].protocol, "I2C") == 0) {
+                if (configuredSensors[i].protocolId == SensorProtocol::I2C) {
                     // For I2C, use updateInterval and (optionally) a dedicated delay field if present
                     // If you have a conversionTime or similar, set it here
                     // Example: configuredSensors[i].conversionTime = sensorPresets[p].delayBeforeRead;
-                } else if (strcmp(configuredSensors[i].protocol, "ONEWIRE") == 0) {
+                } else if (configuredSensors[i].protocolId == SensorProtocol::ONE_WIRE) {
                     // For One-Wire, set oneWireConversionTime and oneWireCommand
                     if (configuredSensors[i].oneWireConversionTime <= 0)
                         configuredSensors[i].oneWireConversionTime = sensorPresets[p].delayBeforeRead;
@@ -160,6 +205,70 @@ void applySensorPresets() {
             }
         }
     }
+    // Re-intern protocols filled in above; resolve each sensor's driver, its I2C
+    // controller, its device slot on a shared 1-Wire pin and how many
+    // consecutive input registers it publishes
+    for (int i = 0; i < numConfiguredSensors; i++) {
+        configuredSensors[i].protocolId = sensorProtocolFromString(configuredSensors[i].protocol);
+        configuredSensors[i].driver = resolveSensorDriver(configuredSensors[i].typeId, configuredSensors[i].protocolId);
+        configuredSensors[i].i2cWire = i2cBusManager.getWireForPins(configuredSensors[i].sdaPin, configuredSensors[i].sclPin);
+        configuredSensors[i].modbusRegisterCount = configuredSensors[i].driver ? configuredSensors[i].driver->outputChannels : 1;
+
+        // Temperature source of an EZO circuit, by name (not itself)
+        configuredSensors[i].ezoCompensationIndex = -1;
+        if (configuredSensors[i].ezoCompensation[0] != '\0') {
+            for (int j = 0; j < numConfiguredSensors; j++) {
+                if (j != i && strcmp(configuredSensors[j].name, configuredSensors[i].ezoCompensation) == 0) {
+                    configuredSensors[i].ezoCompensationIndex = j;
+                    break;
+                }
+            }
+            if (configuredSensors[i].ezoCompensationIndex < 0) {
+                Serial.printf("[EZO] %s: compensation sensor '%s' not found, reading uncompensated\n",
+                              configuredSensors[i].name, configuredSensors[i].ezoCompensation);
+            }
+        }
+
+        // Sensors without a ROM take the pin's devices in search order
+        configuredSensors[i].oneWireSlot = 0;
+        if (configuredSensors[i].protocolId == SensorProtocol::ONE_WIRE && !oneWireRomIsSet(configuredSensors[i].oneWireRomId)) {
+            for (int j = 0; j < i; j++) {
+                if (configuredSensors[j].protocolId == SensorProtocol::ONE_WIRE &&
+                    configuredSensors[j].oneWirePin == configuredSensors[i].oneWirePin &&
+                    !oneWireRomIsSet(configuredSensors[j].oneWireRomId)) {
+                    configuredSensors[i].oneWireSlot++;
+                }
+            }
+        }
+    }
+
+    // Register addresses owned by each enabled sensor, for readRegisterValue()
+    registerDirectory.clear();
+    for (int i = 0; i < numConfiguredSensors; i++) {
+        if (!configuredSensors[i].enabled) continue;
+        uint8_t outside = registerDirectory.mapSensor(i, configuredSensors[i].modbusRegister,
+                                                      configuredSensors[i].modbusRegisterCount);
+        if (outside > 0) {
+            LOG_WARN("[Sensors] '%s': %d of %d registers from %d lie past the input image (0-%d) and are not served\n",
+                    configuredSensors[i].name, outside, configuredSensors[i].modbusRegisterCount,
+                    configuredSensors[i].modbusRegister, REGISTER_STORE_INPUT_REGISTERS - 1);
+        }
+    }
+    registerDirectory.finish();
+}
+
+// Resolve the configuration strings of one sensor to enums (configuration time only)
+void resolveSensorKinds(SensorConfig& sensor) {
+    sensor.typeId = sensorTypeFromString(sensor.type);
+    sensor.protocolId = sensorProtocolFromString(sensor.protocol);
+    sensor.parsingMethodId = parsingMethodFromString(sensor.parsingMethod);
+    sensor.parsingMethodIdB = parsingMethodFromString(sensor.parsingMethodB);
+    sensor.uartConfig = uartFramingFromString(sensor.uartFraming);
+    oneWireRomFromString(sensor.oneWireRom, sensor.oneWireRomId);
+    if (!vibrationBandsFromString(sensor.vibrationBands, sensor.vibrationBandSet)) {
+        vibrationBandsFromString(VIBRATION_DEFAULT_BANDS, sensor.vibrationBandSet);
+    }
+    sensor.driverStarted = false;  // (Re)run the driver's begin() on the next trigger
 }
 
 // Constants
@@ -171,10 +280,6 @@ Config config; // Define the actual config object
 IOStatus ioStatus = {};
 IOConfig ioConfig = {};
 
-// Global coil state store (persists across client connections)
-// Coils 100-200 store output pin states
-uint16_t globalCoilState[201] = {0};  // Index 0-200, indices 100-200 used for output pin coils
-
 // Network configuration for W5500
 uint8_t mac[] = {0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED};
 
@@ -182,35 +287,27 @@ Wiznet5500lwIP eth(PIN_ETH_CS, SPI, PIN_ETH_IRQ);
 WiFiServer modbusServer(502); 
 WiFiServer httpServer(80);    // HTTP server on port 80
 WiFiClient client;
+// Single coil/register image shared by all Modbus connections. Never begun:
+// it only owns the mapping that each connection's server replies from, so it
+// persists across connects, disconnects and network restarts.
+ModbusTCPServer modbusImage;
 ModbusClientConnection modbusClients[MAX_MODBUS_CLIENTS];
 int connectedClients = 0;
 
-// Bus operation queues are declared in sys_init.h
-extern BusOperation i2cQueue[MAX_SENSORS];
-extern BusOperation uartQueue[MAX_SENSORS];
-extern BusOperation oneWireQueue[MAX_SENSORS];
-extern int i2cQueueSize;
-extern int uartQueueSize;
-extern int oneWireQueueSize;
-
 // Command arrays for each bus type
 CommandArray i2cCommands;
 CommandArray uartCommands;
 CommandArray oneWireCommands;
 
-// Bus operation queues
-BusOperation i2cQueue[MAX_SENSORS];
-BusOperation uartQueue[MAX_SENSORS];
-BusOperation oneWireQueue[MAX_SENSORS];
-int i2cQueueSize = 0;
-int uartQueueSize = 0;
-int oneWireQueueSize = 0;
+// Deadline queue of sensor trigger/collect phases (core 1)
+SensorScheduler sensorScheduler;
 
 // Command queues are already declared as extern above
 
 // Forward declarations for functions used before definition
 void handleSimpleHTTP();
-void updateIOForClient(int clientIndex);
+void updateModbusImage();
+void storeSensorRegisters();
 void routeRequest(WiFiClient& client, String method, String path, String body);
 void applyExternalModbusOverride();
 void sendFile(WiFiClient& client, String filename, String contentType);
@@ -231,20 +328,10 @@ void handlePOSTSensorConfig(WiFiClient& client, String body);
 void handlePOSTSensorCommand(WiFiClient& client, String body);
 void handlePOSTSensorPoll(WiFiClient& client, String body);
 // TODO: Implement Poll Now functionality
+// Dallas CRC8 over data[0..length-2], compared with the trailing CRC byte
 bool validateCRC(uint8_t* data, size_t length) {
-    uint8_t crc = 0;
-    
-    for (size_t i = 0; i < length - 1; i++) {
-        uint8_t inbyte = data[i];
-        for (uint8_t j = 0; j < 8; j++) {
-            uint8_t mix = (crc ^ inbyte) & 0x01;
-            crc >>= 1;
-            if (mix) crc ^= 0x8C;
-            inbyte >>= 1;
-        }
-    }
-    
-    return crc == data[length - 1];
+    if (length < 2) return false;
+    return oneWireCrc8(data, length - 1) == data[length - 1];
 }
 
 void setPinModes();
@@ -262,1244 +349,1125 @@ void logUARTTransaction(String pin, String direction, String data);
 void logNetworkTransaction(String protocol, String direction, String localAddr, String remoteAddr, String data);
 String executeTerminalCommand(String command, String pin, String protocol);
 
-// Bus operation management functions
-void processI2CBusManagerQueue();  // NEW: I2C Bus Manager aware polling
-void processI2CQueue();
-void processUARTQueue();
-void processOneWireQueue();
-void enqueueBusOperation(uint8_t sensorIndex, const char* protocol);
-void updateBusQueues();
+// Sensor scheduling functions
+void scheduleSensorPolling();
+void runSensorScheduler();
+void processVibrationSpectra();
 // validateCRC is already declared above
 
 // CRC validation for One-Wire sensors is implemented above
 
 // ============================================================================
-// I2C BUS MANAGER POLLING - NEW SEQUENTIAL POLLING SYSTEM
+// SENSOR DRIVERS
 // ============================================================================
-// This function uses the I2C Bus Manager to sequentially poll sensors
-// across different pin pairs and buses without conflicts.
-void processI2CBusManagerQueue() {
-    // Get next sensor that needs polling (round-robin from bus manager)
-    uint8_t nextSensorIdx = i2cBusManager.getNextSensorToPoll(configuredSensors);
-    
-    if (nextSensorIdx == 255) {
-        return;  // No sensor needs polling yet
+// One SensorDriver per sensor type (sensor_driver.h). SensorScheduler
+// (runSensorScheduler() on core 1) only sequences the TRIGGER/COLLECT phases,
+// running I2C phases inside i2cBusManager's pin-pair transactions, with
+// oneWireBusManager and uartSensorEngine owning their buses; everything
+// type-specific lives here. Bus times assume 100 kHz I2C (90 us
+// per byte) and standard-speed One-Wire slots.
+
+// ---------------------------------------------------------------- Generic I2C
+
+// Send the configured command (if any); the device is read back in collect
+static DriverStatus genericI2CTrigger(SensorConfig& sensor) {
+    size_t length = strlen(sensor.command);
+    if (length == 0) {
+        return DriverStatus::OK;  // Read-only device
+    }
+    TwoWire& wire = *sensor.i2cWire;
+    wire.beginTransmission(sensor.i2cAddress);
+    wire.write((const uint8_t*)sensor.command, length);
+    if (wire.endTransmission(true) != 0) {
+        return DriverStatus::ERROR_BUS;
+    }
+    return DriverStatus::OK;
+}
+
+// Longest I2C response read back (EZO / generic devices)
+static const uint8_t I2C_RESPONSE_MAX_BYTES = 32;
+
+// Read up to 31 bytes (NUL-terminated for the text parsers)
+static DriverStatus readI2CResponse(SensorConfig& sensor, SensorReading& reading) {
+    TwoWire& wire = *sensor.i2cWire;
+    wire.requestFrom((int)sensor.i2cAddress, (int)I2C_RESPONSE_MAX_BYTES);
+    if (!wire.available()) {
+        return DriverStatus::ERROR_READ;
+    }
+    memset(reading.data, 0, I2C_RESPONSE_MAX_BYTES);
+    reading.length = 0;
+    while (wire.available() && reading.length < I2C_RESPONSE_MAX_BYTES - 1) {
+        reading.data[reading.length++] = wire.read();
+    }
+    return DriverStatus::OK;
+}
+
+static void genericI2CDecode(SensorConfig& sensor, const SensorReading& reading) {
+    // Store response for UI
+    String cleanResponse = "";
+    for (int j = 0; j < reading.length; j++) {
+        if (reading.data[j] >= 32 && reading.data[j] <= 126) {
+            cleanResponse += (char)reading.data[j];
+        }
     }
+    strncpy(sensor.response, cleanResponse.c_str(), sizeof(sensor.response) - 1);
     
-    SensorConfig& sensor = configuredSensors[nextSensorIdx];
-    int sda = sensor.sdaPin;
-    int scl = sensor.sclPin;
+    // Parse based on parsing method
+    float value = parseSensorData((const char*)reading.data, sensor);
+    sensor.rawValue = value;
+    sensor.calibratedValue = applyCalibration(value, sensor);
+    sensor.modbusValue = (int)(sensor.calibratedValue * 100);
     
-    if (sda < 0 || scl < 0) {
-        Serial.printf("[I2C Bus Manager] ERROR: Sensor %d (%s) has invalid pins\n", nextSensorIdx, sensor.name);
-        return;
+    logI2CTransaction(sensor.i2cAddress, "VAL", "Generic: " + String(value, 2), sensor.name);
+}
+
+// Only devices that were sent a command get a conversion wait
+static uint32_t genericI2CConversionTime(const SensorConfig& sensor) {
+    return strlen(sensor.command) > 0 ? sensor.delayBeforeRead : 0;
+}
+
+// ---------------------------------------------------------------------- SHT30
+
+static DriverStatus sht30Trigger(SensorConfig& sensor) {
+    TwoWire& wire = *sensor.i2cWire;
+    wire.beginTransmission(sensor.i2cAddress);
+    wire.write(0x2C);  // Single shot, high repeatability, clock stretching
+    wire.write(0x06);
+    if (wire.endTransmission(true) != 0) {
+        return DriverStatus::ERROR_BUS;
+    }
+    return DriverStatus::OK;
+}
+
+static DriverStatus sht30Collect(SensorConfig& sensor, SensorReading& reading) {
+    TwoWire& wire = *sensor.i2cWire;
+    wire.requestFrom((int)sensor.i2cAddress, 6);
+    if (!wire.available()) {
+        return DriverStatus::ERROR_READ;
     }
+    memset(reading.data, 0, 6);
+    reading.length = 0;
+    while (wire.available() && reading.length < 6) {
+        reading.data[reading.length++] = wire.read();
+    }
+    return DriverStatus::OK;
+}
+
+// temp MSB, LSB, CRC, humidity MSB, LSB, CRC
+static void sht30Decode(SensorConfig& sensor, const SensorReading& reading) {
+    uint16_t temp_raw = ((uint16_t)reading.data[0] << 8) | reading.data[1];
+    uint16_t hum_raw = ((uint16_t)reading.data[3] << 8) | reading.data[4];
     
-    // Define the I2C transaction callback for this sensor
-    // This will execute after the pin switch is complete
-    auto performRead = [nextSensorIdx, sda, scl]() -> I2CTransactionResult {
-        SensorConfig& sensor = configuredSensors[nextSensorIdx];
+    if (sensor.fixedPoint) {
+        // Q16.16 straight from the raw ticks
+        storeChannelQ16(sensor, 0, q16FromSht30Temperature(temp_raw));
+        storeChannelQ16(sensor, 1, q16FromSht30Humidity(hum_raw));
+    } else {
+        float temperature = -45.0 + 175.0 * ((float)temp_raw / 65535.0);
+        float humidity = 100.0 * ((float)hum_raw / 65535.0);
         
-        // Check if sensor has a command to send
-        bool hasCommand = strlen(sensor.command) > 0;
+        sensor.rawValue = temperature;
+        sensor.rawValueB = humidity;
         
-        // Handle based on sensor type
-        if (strcmp(sensor.type, "LIS3DH") == 0) {
-            // LIS3DH: Read 6 accelerometer bytes
-            Wire.beginTransmission(sensor.i2cAddress);
-            Wire.write(0xA8);  // 0x28 with auto-increment (OUT_X_L)
-            if (Wire.endTransmission(true) != 0) {
-                return I2CTransactionResult::ERROR_TRANSMISSION;
-            }
-            
-            delayMicroseconds(100);
-            Wire.requestFrom((int)sensor.i2cAddress, 6);
-            
-            if (!Wire.available()) {
-                return I2CTransactionResult::ERROR_READ_FAILED;
-            }
-            
-            uint8_t data[6] = {0};
-            for (int i = 0; i < 6 && Wire.available(); i++) {
-                data[i] = Wire.read();
-            }
-            
-            // Parse LIS3DH data (little-endian 16-bit values)
-            int16_t x_raw = ((int16_t)data[1] << 8) | data[0];
-            int16_t y_raw = ((int16_t)data[3] << 8) | data[2];
-            int16_t z_raw = ((int16_t)data[5] << 8) | data[4];
-            
-            // Shift by 6 bits (standard 10-bit mode)
-            x_raw >>= 6;
-            y_raw >>= 6;
-            z_raw >>= 6;
-            
-            // Scale to mg (3.906 mg/LSB for ±2g)
-            float x_mg = (float)x_raw * 3.906f;
-            float y_mg = (float)y_raw * 3.906f;
-            float z_mg = (float)z_raw * 3.906f;
-            
-            sensor.rawValue = x_mg;
-            sensor.rawValueB = y_mg;
-            sensor.rawValueC = z_mg;
-            
-            sensor.calibratedValue = applyCalibration(x_mg, sensor);
-            sensor.calibratedValueB = applyCalibrationB(y_mg, sensor);
-            sensor.calibratedValueC = applyCalibrationC(z_mg, sensor);
-            
-            sensor.modbusValue = (int)(sensor.calibratedValue * 100);
-            sensor.modbusValueB = (int)(sensor.calibratedValueB * 100);
-            sensor.modbusValueC = (int)(sensor.calibratedValueC * 100);
-            
-            logI2CTransaction(sensor.i2cAddress, "VAL", 
-                            "X: " + String(x_mg, 2) + " mg, Y: " + String(y_mg, 2) + " mg, Z: " + String(z_mg, 2) + " mg", 
-                            sensor.name);
-            return I2CTransactionResult::SUCCESS;
-            
-        } else if (strcmp(sensor.type, "SHT30") == 0) {
-            // SHT30: Send command, wait, then read
-            Wire.beginTransmission(sensor.i2cAddress);
-            Wire.write(0x2C);  // Measurement command
-            Wire.write(0x06);
-            if (Wire.endTransmission(true) != 0) {
-                return I2CTransactionResult::ERROR_TRANSMISSION;
-            }
-            
-            delay(sensor.delayBeforeRead > 0 ? sensor.delayBeforeRead : 15);
-            Wire.requestFrom((int)sensor.i2cAddress, 6);
-            
-            if (!Wire.available()) {
-                return I2CTransactionResult::ERROR_READ_FAILED;
-            }
-            
-            uint8_t data[6] = {0};
-            for (int i = 0; i < 6 && Wire.available(); i++) {
-                data[i] = Wire.read();
-            }
-            
-            // Parse SHT30 data
-            uint16_t temp_raw = ((uint16_t)data[0] << 8) | data[1];
-            uint16_t hum_raw = ((uint16_t)data[3] << 8) | data[4];
-            
-            float temperature = -45.0 + 175.0 * ((float)temp_raw / 65535.0);
-            float humidity = 100.0 * ((float)hum_raw / 65535.0);
-            
-            sensor.rawValue = temperature;
-            sensor.rawValueB = humidity;
-            
-            sensor.calibratedValue = applyCalibration(temperature, sensor);
-            sensor.calibratedValueB = applyCalibrationB(humidity, sensor);
-            
-            sensor.modbusValue = (int)(sensor.calibratedValue * 100);
-            sensor.modbusValueB = (int)(sensor.calibratedValueB * 100);
-            
-            logI2CTransaction(sensor.i2cAddress, "VAL", 
-                            "Temp: " + String(temperature) + "°C, Hum: " + String(humidity) + "%", 
-                            sensor.name);
-            return I2CTransactionResult::SUCCESS;
-            
-        } else if (strcmp(sensor.type, "EZO_PH") == 0 || strcmp(sensor.type, "EZO-PH") == 0) {
-            // EZO-PH: Send read command, wait for response
-            Wire.beginTransmission(sensor.i2cAddress);
-            Wire.write('R');  // Read command
-            Wire.write('\r');
-            if (Wire.endTransmission(true) != 0) {
-                return I2CTransactionResult::ERROR_TRANSMISSION;
-            }
-            
-            delay(sensor.delayBeforeRead > 0 ? sensor.delayBeforeRead : 900);
-            Wire.requestFrom((int)sensor.i2cAddress, 32);
-            
-            if (!Wire.available()) {
-                return I2CTransactionResult::ERROR_READ_FAILED;
-            }
-            
-            uint8_t response[32] = {0};
-            int idx = 0;
-            while (Wire.available() && idx < 31) {
-                response[idx++] = Wire.read();
-            }
-            
-            uint8_t statusCode = response[0];
-            if (statusCode == 1 && idx > 1) {
-                // Extract ASCII data after status byte
-                String dataStr = "";
-                for (int j = 1; j < idx; j++) {
-                    if (response[j] >= 32 && response[j] <= 126) {
-                        dataStr += (char)response[j];
-                    }
-                }
-                sensor.rawValue = dataStr.toFloat();
-                sensor.calibratedValue = applyCalibration(sensor.rawValue, sensor);
-                sensor.modbusValue = (int)(sensor.calibratedValue * 100);
-                
-                logI2CTransaction(sensor.i2cAddress, "VAL", "EZO-PH: " + String(sensor.rawValue, 2), sensor.name);
-                return I2CTransactionResult::SUCCESS;
-            } else if (statusCode == 254) {
-                logI2CTransaction(sensor.i2cAddress, "WARN", "EZO-PH: Still processing", sensor.name);
-                return I2CTransactionResult::ERROR_TIMEOUT;
-            } else {
-                logI2CTransaction(sensor.i2cAddress, "ERR", "EZO-PH: Status code " + String(statusCode), sensor.name);
-                return I2CTransactionResult::ERROR_READ_FAILED;
-            }
-            
-        } else {
-            // Generic I2C sensor: send command if present, then read
-            if (hasCommand) {
-                Wire.beginTransmission(sensor.i2cAddress);
-                // Send command bytes
-                String cmd = String(sensor.command);
-                for (int i = 0; i < cmd.length(); i++) {
-                    Wire.write((uint8_t)cmd[i]);
-                }
-                if (Wire.endTransmission(true) != 0) {
-                    return I2CTransactionResult::ERROR_TRANSMISSION;
-                }
-                
-                if (sensor.delayBeforeRead > 0) {
-                    delay(sensor.delayBeforeRead);
-                }
-            }
-            
-            // Read response
-            Wire.requestFrom((int)sensor.i2cAddress, 32);
-            if (!Wire.available()) {
-                return I2CTransactionResult::ERROR_READ_FAILED;
-            }
-            
-            uint8_t response[32] = {0};
-            int idx = 0;
-            while (Wire.available() && idx < 31) {
-                response[idx++] = Wire.read();
-            }
-            
-            // Store response for UI
-            String cleanResponse = "";
-            for (int j = 0; j < idx; j++) {
-                if (response[j] >= 32 && response[j] <= 126) {
-                    cleanResponse += (char)response[j];
-                }
-            }
-            strncpy(sensor.response, cleanResponse.c_str(), sizeof(sensor.response) - 1);
-            
-            // Parse based on parsing method
-            float value = parseSensorData((const char*)response, sensor);
-            sensor.rawValue = value;
-            sensor.calibratedValue = applyCalibration(value, sensor);
-            sensor.modbusValue = (int)(sensor.calibratedValue * 100);
-            
-            logI2CTransaction(sensor.i2cAddress, "VAL", "Generic: " + String(value, 2), sensor.name);
-            return I2CTransactionResult::SUCCESS;
-        }
-    };
-    
-    // Use the bus manager to perform the atomic transaction
-    I2CTransactionResult result = i2cBusManager.performAtomicTransaction(sda, scl, performRead);
-    
-    if (result != I2CTransactionResult::SUCCESS) {
-        Serial.printf("[I2C Bus Manager] Transaction failed for sensor %d (%s): error code %d\n", 
-                    nextSensorIdx, sensor.name, (int)result);
-        sensor.rawValue = -1000.0;  // Mark as error
+        sensor.calibratedValue = applyCalibration(temperature, sensor);
+        sensor.calibratedValueB = applyCalibrationB(humidity, sensor);
+        
+        sensor.modbusValue = (int)(sensor.calibratedValue * 100);
+        sensor.modbusValueB = (int)(sensor.calibratedValueB * 100);
     }
     
-    sensor.lastReadTime = millis();
+    logI2CTransaction(sensor.i2cAddress, "VAL", 
+                    "Temp: " + String(sensor.rawValue) + "°C, Hum: " + String(sensor.rawValueB) + "%", 
+                    sensor.name);
 }
 
-// CRC validation for One-Wire sensors is implemented above (second occurrence removed)
+// --------------------------------------------------------------------- LIS3DH
+//
+// The LIS3DH streams through its 32-sample FIFO at 400 Hz. A measurement is
+// one window of fftPoints (256 or 512) consecutive samples: the trigger
+// starts a window, and the collect (pollReady) drains the FIFO in one burst
+// read per pass and stays PENDING until the window is full. Drains are
+// LIS3DH_FIFO_DRAIN_MS apart, half the FIFO fill time (32 / 400 Hz = 80 ms).
+// A FIFO overrun mid-window means samples were lost, so the window restarts.
+// Channels A/B/C carry the window mean per axis, the feature block
+// (vibration_features.h) RMS, peak and crest.
+//
+// The window's samples are also kept, and processVibrationSpectra() runs the
+// FFT on them after collect, one axis per loop1() pass, between bus
+// transactions rather than inside one (vibration_spectrum.h). A trigger that
+// finds an axis still pending returns PENDING and is retried shortly, so a
+// short updateInterval never pulls the FFT into the trigger's transaction.
+//
+// 400 Hz rather than 1344 Hz: every sample crosses the bus, and at 100 kHz
+// 1344 Hz takes ~75% of it per sensor; 400 Hz takes ~22% while streaming.
+//
+// Like every I2C driver, the phases run inside an i2cBusManager transaction
+// on the sensor's pin pair, with interrupts left enabled: a 192-byte burst
+// takes ~18 ms at 100 kHz, far too long to hold off the W5500 and lwIP timers.
+
+static const uint8_t LIS3DH_FIFO_DEPTH = 32;
+static const uint8_t LIS3DH_FRAME_BYTES = 6;
+static const float LIS3DH_ODR_HZ = 400.0f;               // CTRL_REG1 0x77
+static const uint32_t LIS3DH_FIFO_DRAIN_MS = 40;
+static const uint8_t LIS3DH_MAX_FIFO_DRAINS = 60;        // 512-sample window plus a few overrun restarts
+static const uint32_t LIS3DH_SPECTRUM_WAIT_MS = 5;       // Trigger retry while the last window's FFT is pending
+static const float LIS3DH_MG_PER_COUNT = 3.906f;         // 10-bit normal mode, +/-2g
+
+// FIFO registers
+static const uint8_t LIS3DH_REG_FIFOCTRL = 0x2E;
+static const uint8_t LIS3DH_REG_FIFOSRC = 0x2F;
+
+// FIFO_SRC_REG bits
+static const uint8_t LIS3DH_FIFO_SRC_OVRN = 0x40;
+static const uint8_t LIS3DH_FIFO_SRC_FSS = 0x1F;
+
+// FIFO_CTRL_REG modes
+static const uint8_t LIS3DH_FIFO_BYPASS = 0x00;
+static const uint8_t LIS3DH_FIFO_STREAM = 0x80;
+
+/**
+ * Window in progress of one LIS3DH (indexed like configuredSensors[])
+ */
+struct Lis3dhStream {
+    VibrationWindow window;
+    bool open;             // FIFO flushed, samples belong to the window
+    int16_t* samples;      // Window counts, axis-major: samples[axis * points + i]
+    uint16_t points;       // Window length (vibrationFftPoints(fftPoints))
+    uint8_t spectrumAxis;  // Next axis to analyse, VIBRATION_AXES when idle
+    int32_t spectrumSum[VIBRATION_AXES];  // Sums of the window being analysed
+    uint32_t windows;      // Completed windows
+    uint32_t overruns;     // Windows restarted after a FIFO overrun
+    uint32_t bursts;       // FIFO burst reads
+};
 
-void processI2CQueue() {
-    if (i2cQueueSize == 0) return;
-    
-    unsigned long currentTime = millis();
-    BusOperation& op = i2cQueue[0];
-    
-    switch(op.state) {
-        case BusOpState::IDLE: {
-            // Start I2C operation
-            Wire.beginTransmission(configuredSensors[op.sensorIndex].i2cAddress);
-            
-            // Check if sensor has a command to send
-            bool hasCommand = strlen(configuredSensors[op.sensorIndex].command) > 0;
-            
-            // Special handling for LIS3DH: atomic write+read without losing register pointer
-            if (strcmp(configuredSensors[op.sensorIndex].type, "LIS3DH") == 0) {
-                // LIS3DH: Write register address then read data
-                // Try normal transaction with full STOP and new START (more reliable than repeated START)
-                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "TX", 
-                                "Register address: 0x28 (OUT_X_L, no auto-increment for first byte)", 
-                                String(configuredSensors[op.sensorIndex].name));
-                
-                // Step 1: Write register address WITHOUT auto-increment bit for first read
-                Wire.beginTransmission(configuredSensors[op.sensorIndex].i2cAddress);
-                Wire.write(0x28);  // Just 0x28, NO auto-increment yet - verify we're at the right register
-                int writeResult = Wire.endTransmission(true);  // true = STOP
-                
-                if (writeResult == 0) {
-                    logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ACK", 
-                                    "Register 0x28 selected", 
-                                    String(configuredSensors[op.sensorIndex].name));
-                    
-                    delayMicroseconds(100);
-                    
-                    // Step 2: Read 1 byte from OUT_X_L to verify it's X data
-                    Wire.requestFrom((int)configuredSensors[op.sensorIndex].i2cAddress, 1);
-                    uint8_t x_low = 0;
-                    if (Wire.available()) {
-                        x_low = Wire.read();
-                        Serial.printf("[DEBUG] Single byte read from 0x28: 0x%02X\n", x_low);
-                    }
-                    
-                    // Step 3: Now read X_H from 0x29
-                    Wire.beginTransmission(configuredSensors[op.sensorIndex].i2cAddress);
-                    Wire.write(0x29);
-                    Wire.endTransmission(true);
-                    delayMicroseconds(100);
-                    
-                    Wire.requestFrom((int)configuredSensors[op.sensorIndex].i2cAddress, 1);
-                    uint8_t x_high = 0;
-                    if (Wire.available()) {
-                        x_high = Wire.read();
-                        Serial.printf("[DEBUG] Single byte read from 0x29: 0x%02X\n", x_high);
-                    }
-                    
-                    // Step 4: Now try auto-increment read of all 6 bytes starting from 0x28
-                    Wire.beginTransmission(configuredSensors[op.sensorIndex].i2cAddress);
-                    Wire.write(0xA8);  // 0x28 with auto-increment
-                    Wire.endTransmission(true);
-                    delayMicroseconds(100);
-                    
-                    Wire.requestFrom((int)configuredSensors[op.sensorIndex].i2cAddress, 6);
-                    
-                    if (Wire.available()) {
-                        char response[32] = {0};
-                        String rawHex = "";
-                        int idx = 0;
-                        
-                        while(Wire.available() && idx < 6) {
-                            uint8_t byte = Wire.read();
-                            response[idx++] = byte;
-                            if (rawHex.length() > 0) rawHex += " ";
-                            rawHex += "0x" + String(byte, HEX);
-                        }
-                        response[idx] = '\0';
-                        
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "RX", 
-                                        "Raw: [" + rawHex + "]", 
-                                        String(configuredSensors[op.sensorIndex].name));
-                        
-                        Serial.printf("[DEBUG] Full 6-byte read: [0x%02X 0x%02X 0x%02X 0x%02X 0x%02X 0x%02X]\n",
-                                    (uint8_t)response[0], (uint8_t)response[1],
-                                    (uint8_t)response[2], (uint8_t)response[3],
-                                    (uint8_t)response[4], (uint8_t)response[5]);
-                        
-                        Serial.printf("[DEBUG] Single bytes: X_L=0x%02X, X_H=0x%02X\n", x_low, x_high);
-                        
-                        // Parse LIS3DH data immediately in IDLE state
-                        if (idx >= 6) {
-                            // Extract raw 16-bit signed integers (little-endian)
-                            int16_t x_raw = ((uint8_t)response[1] << 8) | (uint8_t)response[0];
-                            int16_t y_raw = ((uint8_t)response[3] << 8) | (uint8_t)response[2];
-                            int16_t z_raw = ((uint8_t)response[5] << 8) | (uint8_t)response[4];
-                            
-                            // Debug: log raw values before shifting
-                            Serial.printf("[DEBUG] LIS3DH raw (before shift): X=0x%04X (%d), Y=0x%04X (%d), Z=0x%04X (%d)\n", 
-                                         (uint16_t)x_raw, x_raw, (uint16_t)y_raw, y_raw, (uint16_t)z_raw, z_raw);
-                            
-                            // LIS3DH in standard 10-bit mode (±2g range):
-                            // - Data occupies upper 10 bits (bits 15-6)
-                            // - Lower 6 bits are padding
-                            // - Right-shift by 6 to get actual 10-bit value (-512 to +511)
-                            // - Scale: ±2g / 512 LSB = 3.906 mg/LSB
-                            x_raw >>= 6;
-                            y_raw >>= 6;
-                            z_raw >>= 6;
-                            
-                            Serial.printf("[DEBUG] LIS3DH raw (after shift): X=%d, Y=%d, Z=%d\n", x_raw, y_raw, z_raw);
-                            
-                            float x_mg = (float)x_raw * 3.906f;  // ±2g standard mode: 3.906 mg/LSB
-                            float y_mg = (float)y_raw * 3.906f;
-                            float z_mg = (float)z_raw * 3.906f;
-                            
-                            configuredSensors[op.sensorIndex].rawValue = x_mg;
-                            configuredSensors[op.sensorIndex].rawValueB = y_mg;
-                            configuredSensors[op.sensorIndex].rawValueC = z_mg;
-                            
-                            float calibratedX = applyCalibration(x_mg, configuredSensors[op.sensorIndex]);
-                            float calibratedY = applyCalibrationB(y_mg, configuredSensors[op.sensorIndex]);
-                            float calibratedZ = applyCalibrationC(z_mg, configuredSensors[op.sensorIndex]);
-                            
-                            configuredSensors[op.sensorIndex].calibratedValue = calibratedX;
-                            configuredSensors[op.sensorIndex].calibratedValueB = calibratedY;
-                            configuredSensors[op.sensorIndex].calibratedValueC = calibratedZ;
-                            
-                            configuredSensors[op.sensorIndex].modbusValue = (int)(calibratedX * 100);
-                            configuredSensors[op.sensorIndex].modbusValueB = (int)(calibratedY * 100);
-                            configuredSensors[op.sensorIndex].modbusValueC = (int)(calibratedZ * 100);
-                            
-                            logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", 
-                                            "X: " + String(x_mg, 2) + " mg, Y: " + String(y_mg, 2) + " mg, Z: " + String(z_mg, 2) + " mg", 
-                                            String(configuredSensors[op.sensorIndex].name));
-                        } else {
-                            logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", 
-                                            "LIS3DH response too short: " + String(idx) + " bytes", 
-                                            String(configuredSensors[op.sensorIndex].name));
-                        }
-                    } else {
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "TIMEOUT", 
-                                        "No response after register set", 
-                                        String(configuredSensors[op.sensorIndex].name));
-                    }
-                } else {
-                    logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "NACK", 
-                                    "Failed to set register address, error: " + String(writeResult), 
-                                    String(configuredSensors[op.sensorIndex].name));
-                }
-                
-                // Move to next operation - LIS3DH handled completely in IDLE state
-                for(int i = 0; i < i2cQueueSize - 1; i++) {
-                    i2cQueue[i] = i2cQueue[i + 1];
-                }
-                i2cQueueSize--;
-                rp2040.wdt_reset();
-                return;
-            } else if (hasCommand) {
-                // Sanitize command: remove control chars except explicit \r or \n
-                String rawCmd = String(configuredSensors[op.sensorIndex].command);
-                String command = "";
-                for (int i = 0; i < rawCmd.length(); i++) {
-                    char c = rawCmd[i];
-                    // Allow printable ASCII, or explicit \r/\n sequences
-                    if (c >= 32 && c <= 126) {
-                        command += c;
-                    } else if (c == '\\' && i + 1 < rawCmd.length()) {
-                        char next = rawCmd[i + 1];
-                        if (next == 'r' || next == 'n') {
-                            command += c;
-                            command += next;
-                            i++;
-                        }
-                    }
-                    // Ignore all other control chars
-                }
+static Lis3dhStream lis3dhStreams[MAX_SENSORS];
 
-                // Check if command is hex format (starts with 0x or contains only hex digits)
-                bool isHexCommand = command.startsWith("0x") || command.startsWith("0X");
-                if (!isHexCommand) {
-                    // Check if it's all hex digits (allowing spaces)
-                    String testCmd = command;
-                    testCmd.replace(" ", "");
-                    isHexCommand = true;
-                    for (int i = 0; i < testCmd.length(); i++) {
-                        char c = testCmd[i];
-                        if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'))) {
-                            isHexCommand = false;
-                            break;
-                        }
-                    }
-                }
+static Lis3dhStream& lis3dhStreamFor(const SensorConfig& sensor) {
+    return lis3dhStreams[&sensor - configuredSensors];
+}
 
-                if (isHexCommand) {
-                    // Hex command format (e.g., "0x2C06" or "2C 06")
-                    String cleanCmd = command;
-                    cleanCmd.replace("0x", "");
-                    cleanCmd.replace("0X", "");
-                    cleanCmd.replace(" ", "");
+// FFT of the next pending axis of one sensor's last window
+static void lis3dhAnalyzeAxis(SensorConfig& sensor, Lis3dhStream& stream) {
+    uint8_t axis = stream.spectrumAxis;
+    vibrationAnalyzer.analyzeAxis(&stream.samples[axis * stream.points], stream.points,
+                                  stream.spectrumSum[axis], LIS3DH_ODR_HZ, LIS3DH_MG_PER_COUNT,
+                                  sensor.vibrationBandSet, axis, sensor.vibration);
+    stream.spectrumAxis++;
+    if (stream.spectrumAxis >= VIBRATION_AXES) {
+        sensor.vibration.spectrumValid = true;
+    }
+}
 
-                    logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "TX", 
-                                    "CMD: " + command + " (HEX) (" + String(configuredSensors[op.sensorIndex].type) + ")", 
-                                    String(configuredSensors[op.sensorIndex].name));
+static bool lis3dhWriteRegister(TwoWire& wire, uint8_t address, uint8_t reg, uint8_t value) {
+    wire.beginTransmission(address);
+    wire.write(reg);
+    wire.write(value);
+    return wire.endTransmission(true) == 0;
+}
 
-                    // Write hex command bytes
-                    for (int i = 0; i < cleanCmd.length(); i += 2) {
-                        if (i + 1 < cleanCmd.length()) {
-                            String hexByte = cleanCmd.substring(i, i + 2);
-                            uint8_t byte = strtoul(hexByte.c_str(), NULL, 16);
-                            Wire.write(byte);
-                        }
-                    }
-                } else {
-                    // Text command format (e.g., "R\r" for EZO sensors)
-                    logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "TX", 
-                                    "CMD: \"" + command + "\" (TEXT) (" + String(configuredSensors[op.sensorIndex].type) + ")", 
-                                    String(configuredSensors[op.sensorIndex].name));
+static bool lis3dhReadRegister(TwoWire& wire, uint8_t address, uint8_t reg, uint8_t& value) {
+    wire.beginTransmission(address);
+    wire.write(reg);
+    if (wire.endTransmission(true) != 0) {
+        return false;
+    }
+    if (wire.requestFrom((int)address, 1) != 1) {
+        return false;
+    }
+    value = wire.read();
+    return true;
+}
 
-                    // Write text command as ASCII bytes
-                    for (int i = 0; i < command.length(); i++) {
-                        Wire.write((uint8_t)command[i]);
-                    }
-                }
-            } else {
-                // No command - direct read sensor
-                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "PREP", 
-                                "Direct read (no command) for " + String(configuredSensors[op.sensorIndex].name), 
-                                String(configuredSensors[op.sensorIndex].name));
-            }
-            
-            int result = Wire.endTransmission();
-            
-            if (result == 0) {
-                // Check if sensor needs delay before reading
-                bool hasCommand = strlen(configuredSensors[op.sensorIndex].command) > 0;
-                
-                // LIS3DH is handled completely in IDLE state, so skip state transitions for it
-                if (hasCommand && op.conversionTime > 0) {
-                    op.state = BusOpState::REQUEST_SENT;
-                    op.startTime = currentTime;
-                    logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ACK", "Command sent successfully", String(configuredSensors[op.sensorIndex].name));
-                } else {
-                    // No delay needed - go directly to read
-                    op.state = BusOpState::READY_TO_READ;
-                    logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ACK", "Ready for immediate read", String(configuredSensors[op.sensorIndex].name));
-                }
-            } else {
-                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "NACK", "Error code: " + String(result), String(configuredSensors[op.sensorIndex].name));
-                if (++op.retryCount >= 3) {
-                    logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", "Max retries exceeded", String(configuredSensors[op.sensorIndex].name));
-                    // Move to next operation after 3 retries
-                    for(int i = 0; i < i2cQueueSize - 1; i++) {
-                        i2cQueue[i] = i2cQueue[i + 1];
-                    }
-                    i2cQueueSize--;
-                }
-            }
-            break;
+// Check WHO_AM_I, start continuous conversion and put the FIFO in stream mode
+static bool lis3dhBegin(SensorConfig& sensor) {
+    TwoWire& wire = *sensor.i2cWire;
+    uint8_t whoAmI = 0;
+    if (!lis3dhReadRegister(wire, sensor.i2cAddress, 0x0F, whoAmI)) {  // WHO_AM_I
+        return false;
+    }
+    if (whoAmI != 0x33) {
+        Serial.printf("[LIS3DH] %s at 0x%02X: unexpected WHO_AM_I 0x%02X\n", sensor.name, sensor.i2cAddress, whoAmI);
+        return false;
+    }
+    // CTRL_REG1 0x77: 400 Hz, normal mode, X/Y/Z enabled
+    // CTRL_REG4 0x80: block data update, little endian, ±2g, high resolution off (10-bit)
+    // TEMP_CFG_REG 0xC0: auxiliary ADC and temperature sensor on
+    // CTRL_REG5 0x40: FIFO enabled; FIFO_CTRL_REG: stream mode (oldest sample dropped when full)
+    if (!lis3dhWriteRegister(wire, sensor.i2cAddress, 0x20, 0x77) ||
+        !lis3dhWriteRegister(wire, sensor.i2cAddress, 0x23, 0x80) ||
+        !lis3dhWriteRegister(wire, sensor.i2cAddress, 0x1F, 0xC0) ||
+        !lis3dhWriteRegister(wire, sensor.i2cAddress, 0x24, 0x40) ||
+        !lis3dhWriteRegister(wire, sensor.i2cAddress, LIS3DH_REG_FIFOCTRL, LIS3DH_FIFO_STREAM)) {
+        return false;
+    }
+    Lis3dhStream& stream = lis3dhStreamFor(sensor);
+    stream.open = false;
+    stream.spectrumAxis = VIBRATION_AXES;  // Nothing of a previous configuration left to analyse
+    sensor.vibration.spectrumValid = false;
+    Serial.printf("[LIS3DH] %s at 0x%02X started, FIFO stream, %u-sample windows\n",
+                  sensor.name, sensor.i2cAddress, vibrationFftPoints(sensor.fftPoints));
+    return true;
+}
+
+// Start a window; the FIFO is flushed at the first drain so the window holds consecutive samples
+// PENDING while processVibrationSpectra() still needs the previous window's samples: the
+// trigger runs inside a bus transaction, so the FFT is never done from here
+static DriverStatus lis3dhTrigger(SensorConfig& sensor) {
+    Lis3dhStream& stream = lis3dhStreamFor(sensor);
+    if (stream.samples != nullptr && stream.spectrumAxis < VIBRATION_AXES) {
+        return DriverStatus::PENDING;
+    }
+    uint16_t points = vibrationFftPoints(sensor.fftPoints);
+    if (stream.samples == nullptr || stream.points != points) {
+        delete[] stream.samples;  // fftPoints changed
+        stream.samples = new int16_t[VIBRATION_AXES * points];
+        stream.points = points;
+        stream.spectrumAxis = VIBRATION_AXES;
+    }
+    stream.window.reset(millis());
+    stream.open = false;
+    return DriverStatus::OK;
+}
+
+// Drain the FIFO into the window: PENDING until stream.points samples are in
+static DriverStatus lis3dhPollReady(SensorConfig& sensor) {
+    TwoWire& wire = *sensor.i2cWire;
+    Lis3dhStream& stream = lis3dhStreamFor(sensor);
+    uint32_t now = millis();
+
+    if (!stream.open) {
+        // Bypass and back to stream empties the FIFO (cheaper than reading it out)
+        if (!lis3dhWriteRegister(wire, sensor.i2cAddress, LIS3DH_REG_FIFOCTRL, LIS3DH_FIFO_BYPASS) ||
+            !lis3dhWriteRegister(wire, sensor.i2cAddress, LIS3DH_REG_FIFOCTRL, LIS3DH_FIFO_STREAM)) {
+            return DriverStatus::ERROR_BUS;
         }
-            
-        case BusOpState::REQUEST_SENT: {
-            if (currentTime - op.startTime >= op.conversionTime) {
-                op.state = BusOpState::READY_TO_READ;
-            }
-            break;
+        stream.window.reset(now);
+        stream.open = true;
+        return DriverStatus::PENDING;
+    }
+
+    uint8_t source = 0;
+    if (!lis3dhReadRegister(wire, sensor.i2cAddress, LIS3DH_REG_FIFOSRC, source)) {
+        return DriverStatus::ERROR_BUS;
+    }
+    uint8_t level = (source & LIS3DH_FIFO_SRC_OVRN) ? LIS3DH_FIFO_DEPTH : (source & LIS3DH_FIFO_SRC_FSS);
+    if (source & LIS3DH_FIFO_SRC_OVRN) {
+        // Full FIFO: samples were dropped since the last drain, start over
+        stream.overruns++;
+        stream.window.reset(now);
+    }
+    if (level == 0) {
+        return DriverStatus::PENDING;
+    }
+
+    // One burst for everything stored; the address wraps OUT_Z_H -> OUT_X_L in FIFO mode
+    wire.beginTransmission(sensor.i2cAddress);
+    wire.write(0xA8);  // 0x28 with auto-increment (OUT_X_L)
+    if (wire.endTransmission(true) != 0) {
+        return DriverStatus::ERROR_BUS;
+    }
+    size_t length = (size_t)level * LIS3DH_FRAME_BYTES;
+    if (wire.requestFrom((int)sensor.i2cAddress, (int)length) != length) {
+        return DriverStatus::ERROR_READ;
+    }
+    stream.bursts++;
+
+    for (uint8_t i = 0; i < level; i++) {
+        uint8_t frame[LIS3DH_FRAME_BYTES];
+        for (uint8_t b = 0; b < LIS3DH_FRAME_BYTES; b++) {
+            frame[b] = wire.read();
         }
-        
-        case BusOpState::WAITING_CONVERSION: {
-            // Wait for conversion/delay time to elapse (used for LIS3DH register pointer setup)
-            if (currentTime - op.startTime >= op.conversionTime) {
-                op.state = BusOpState::READY_TO_READ;
-            }
-            break;
+        if (stream.window.count >= stream.points) continue;  // Window full, drain the rest
+        // Little-endian 16-bit values, left-justified 10-bit data (normal mode)
+        int16_t counts[VIBRATION_AXES];
+        for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+            counts[axis] = (int16_t)(((uint16_t)frame[2 * axis + 1] << 8) | frame[2 * axis]) >> 6;
+            stream.samples[axis * stream.points + stream.window.count] = counts[axis];
         }
-            
-        case BusOpState::READY_TO_READ: {
-            // Per-op timeout: abort if this operation has been pending too long (3 seconds)
-            if (op.startTime > 0 && currentTime - op.startTime > 3000) {
-                Serial.printf("[I2C] TIMEOUT: Sensor %d stuck in READY_TO_READ for 3s, removing from queue\n", op.sensorIndex);
-                configuredSensors[op.sensorIndex].rawValue = -1000.0;  // Mark as error
-                for(int i = 0; i < i2cQueueSize - 1; i++) {
-                    i2cQueue[i] = i2cQueue[i + 1];
-                }
-                i2cQueueSize--;
-                rp2040.wdt_reset();
-                return;
-            }
-            
-            // Determine how many bytes to request based on sensor type
-            int bytesToRequest = 32;  // Default for most sensors
-            if (strcmp(configuredSensors[op.sensorIndex].type, "LIS3DH") == 0) {
-                bytesToRequest = 6;  // LIS3DH: OUT_X_L, OUT_X_H, OUT_Y_L, OUT_Y_H, OUT_Z_L, OUT_Z_H
-            } else if (strcmp(configuredSensors[op.sensorIndex].type, "SHT30") == 0) {
-                bytesToRequest = 6;  // SHT30: 6 bytes (temp MSB/LSB/CRC + hum MSB/LSB/CRC)
-            }
-            
-            logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "REQ", 
-                            "Requesting " + String(bytesToRequest) + " bytes from " + String(configuredSensors[op.sensorIndex].name), 
-                            String(configuredSensors[op.sensorIndex].name));
-            Wire.requestFrom((int)configuredSensors[op.sensorIndex].i2cAddress, bytesToRequest);
-            
-            if (Wire.available()) {
-                char response[32] = {0};
-                String rawHex = "";
-                int idx = 0;
-                
-                while(Wire.available() && idx < 31) {
-                    uint8_t byte = Wire.read();
-                    response[idx++] = byte;
-                    if (rawHex.length() > 0) rawHex += " ";
-                    rawHex += "0x" + String(byte, HEX);
-                }
-                response[idx] = '\0';
-                
-                // Log raw response
-                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "RX", 
-                                "Raw: [" + rawHex + "] ASCII: \"" + String(response) + "\"", 
-                                String(configuredSensors[op.sensorIndex].name));
-                
-                // Store response for web interface (clean for JSON compatibility)
-                String cleanResponse = "";
-                for (int j = 0; j < idx; j++) {
-                    char c = response[j];
-                    if (c >= 32 && c <= 126) { // Only printable ASCII
-                        cleanResponse += c;
-                    }
-                }
-                strncpy(configuredSensors[op.sensorIndex].response, cleanResponse.c_str(), sizeof(configuredSensors[op.sensorIndex].response)-1);
-                configuredSensors[op.sensorIndex].response[sizeof(configuredSensors[op.sensorIndex].response)-1] = '\0';
-                configuredSensors[op.sensorIndex].lastReadTime = currentTime;
-                
-                // Process response based on sensor type
-                if (strcmp(configuredSensors[op.sensorIndex].type, "SHT30") == 0) {
-                    // SHT30 returns 6 bytes: temp_msb, temp_lsb, temp_crc, hum_msb, hum_lsb, hum_crc
-                    if (idx >= 6) {
-                        uint16_t temp_raw = ((uint8_t)response[0] << 8) | (uint8_t)response[1];
-                        uint16_t hum_raw = ((uint8_t)response[3] << 8) | (uint8_t)response[4];
-                        
-                        float temperature = -45.0 + 175.0 * ((float)temp_raw / 65535.0);
-                        float humidity = 100.0 * ((float)hum_raw / 65535.0);
-                        
-                        // Store both values in multi-output structure
-                        configuredSensors[op.sensorIndex].rawValue = temperature;
-                        configuredSensors[op.sensorIndex].rawValueB = humidity;
-                        
+        stream.window.add(counts);
+    }
+    stream.window.endMs = now;
 
-                        
-                        // Apply calibration to both values using new expression-capable functions
-                        float calibratedTemp = applyCalibration(temperature, configuredSensors[op.sensorIndex]);
-                        float calibratedHum = applyCalibrationB(humidity, configuredSensors[op.sensorIndex]);
-                        
-                        configuredSensors[op.sensorIndex].calibratedValue = calibratedTemp;
-                        configuredSensors[op.sensorIndex].calibratedValueB = calibratedHum;
-                        
-                        // Convert to Modbus values (scaled by 100 for decimal precision)
-                        configuredSensors[op.sensorIndex].modbusValue = (int)(calibratedTemp * 100);
-                        configuredSensors[op.sensorIndex].modbusValueB = (int)(calibratedHum * 100);
-                        
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", 
-                                        "Temp: " + String(temperature) + "°C, Hum: " + String(humidity) + "%", 
-                                        String(configuredSensors[op.sensorIndex].name));
-                    } else {
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", 
-                                        "SHT30 response too short: " + String(idx) + " bytes", 
-                                        String(configuredSensors[op.sensorIndex].name));
-                    }
-                } else if (strcmp(configuredSensors[op.sensorIndex].type, "EZO-PH") == 0 || 
-                          strcmp(configuredSensors[op.sensorIndex].type, "EZO_PH") == 0) {
-                    // Atlas Scientific EZO PH protocol: first byte is status
-                    if (idx > 0) {
-                        uint8_t statusCode = (uint8_t)response[0];
-                        if (statusCode == 1) {
-                            // Success: parse ASCII data after status byte
-                            String dataStr = "";
-                            for (int j = 1; j < idx; j++) {
-                                char c = response[j];
-                                if (c >= 32 && c <= 126) dataStr += c;
-                            }
-                            dataStr.trim();
-                            if (dataStr.length() > 0) {
-                                configuredSensors[op.sensorIndex].rawValue = dataStr.toFloat();
-                                // Apply calibration and update calibratedValue/modbusValue
-                                float calibratedValue = applyCalibration(configuredSensors[op.sensorIndex].rawValue, configuredSensors[op.sensorIndex]);
-                                configuredSensors[op.sensorIndex].calibratedValue = calibratedValue;
-                                configuredSensors[op.sensorIndex].modbusValue = (int)(calibratedValue * 100);
-                                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", "EZO Success: '" + dataStr + "', Calibrated: " + String(calibratedValue), String(configuredSensors[op.sensorIndex].name));
-                            } else {
-                                configuredSensors[op.sensorIndex].rawValue = -998.0;
-                                configuredSensors[op.sensorIndex].calibratedValue = 0.0;
-                                configuredSensors[op.sensorIndex].modbusValue = 0;
-                                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", "EZO-PH: Empty data after success code", String(configuredSensors[op.sensorIndex].name));
-                            }
-                        } else if (statusCode == 254) {
-                            // Processing: use non-blocking retry (don't use delay!)
-                            if (op.retryCount < 3) {
-                                op.retryCount++;
-                                // Reschedule as REQUEST_SENT with short conversion time to retry after 100ms
-                                op.state = BusOpState::REQUEST_SENT;
-                                op.conversionTime = 100;
-                                op.startTime = currentTime;
-                                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "WARN", "EZO-PH: Processing, will retry " + String(op.retryCount), String(configuredSensors[op.sensorIndex].name));
-                                return; // Do not dequeue yet, will process again next loop
-                            } else {
-                                configuredSensors[op.sensorIndex].rawValue = -996.0;
-                                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", "EZO-PH: Processing timeout after 3 retries", String(configuredSensors[op.sensorIndex].name));
-                            }
-                        } else if (statusCode == 2) {
-                            configuredSensors[op.sensorIndex].rawValue = -997.0;
-                            logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", "EZO-PH: Syntax error", String(configuredSensors[op.sensorIndex].name));
-                        } else if (statusCode == 255) {
-                            configuredSensors[op.sensorIndex].rawValue = -995.0;
-                            logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "WARN", "EZO-PH: No data available", String(configuredSensors[op.sensorIndex].name));
-                        } else {
-                            configuredSensors[op.sensorIndex].rawValue = -994.0;
-                            logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", "EZO-PH: Unknown status " + String(statusCode), String(configuredSensors[op.sensorIndex].name));
-                        }
-                    } else {
-                        configuredSensors[op.sensorIndex].rawValue = -993.0;
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", "EZO-PH: No response data", String(configuredSensors[op.sensorIndex].name));
-                    }
-                } else if (strcmp(configuredSensors[op.sensorIndex].type, "EZO-EC") == 0 || 
-                          strcmp(configuredSensors[op.sensorIndex].type, "EZO_EC") == 0) {
-                    // Handle both hyphen and underscore variants for compatibility
-                    uint8_t responseCode = (uint8_t)response[0];
-                    if (responseCode == 1 && idx > 1) {
-                        String dataStr = "";
-                        for (int j = 1; j < idx; j++) {
-                            if (response[j] >= 32 && response[j] <= 126) {
-                                dataStr += (char)response[j];
-                            }
-                        }
-                        configuredSensors[op.sensorIndex].rawValue = dataStr.toFloat();
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", "EC: " + String(configuredSensors[op.sensorIndex].rawValue), String(configuredSensors[op.sensorIndex].name));
-                    } else {
-                        configuredSensors[op.sensorIndex].rawValue = atof(response);
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", "EC: " + String(configuredSensors[op.sensorIndex].rawValue), String(configuredSensors[op.sensorIndex].name));
-                    }
-                } else if (strcmp(configuredSensors[op.sensorIndex].type, "GENERIC_I2C") == 0 || 
-                          strcmp(configuredSensors[op.sensorIndex].type, "GENERIC") == 0 ||
-                          strcmp(configuredSensors[op.sensorIndex].type, "Generic I2C") == 0) {
-                    // Use existing parsing infrastructure for generic sensors
-                    float primaryValue = parseSensorData(response, configuredSensors[op.sensorIndex]);
-                    configuredSensors[op.sensorIndex].rawValue = primaryValue;
-                    
-                    // Apply primary calibration using expression-capable function
-                    float calibratedPrimary = applyCalibration(primaryValue, configuredSensors[op.sensorIndex]);
-                    configuredSensors[op.sensorIndex].calibratedValue = calibratedPrimary;
-                    configuredSensors[op.sensorIndex].modbusValue = (int)(calibratedPrimary * 100);
-                    
-                    // Check if secondary parsing is configured (for multi-output)
-                    if (strlen(configuredSensors[op.sensorIndex].parsingMethodB) > 0 && 
-                        strcmp(configuredSensors[op.sensorIndex].parsingMethodB, "raw") != 0) {
-                        
-                        // Create temporary sensor config for secondary parsing
-                        SensorConfig tempConfig = configuredSensors[op.sensorIndex];
-                        strcpy(tempConfig.parsingMethod, configuredSensors[op.sensorIndex].parsingMethodB);
-                        strcpy(tempConfig.parsingConfig, configuredSensors[op.sensorIndex].parsingConfigB);
-                        
-                        float secondaryValue = parseSensorData(response, tempConfig);
-                        configuredSensors[op.sensorIndex].rawValueB = secondaryValue;
-                        
-                        // Apply secondary calibration using expression-capable function
-                        float calibratedSecondary = applyCalibrationB(secondaryValue, configuredSensors[op.sensorIndex]);
-                        configuredSensors[op.sensorIndex].calibratedValueB = calibratedSecondary;
-                        configuredSensors[op.sensorIndex].modbusValueB = (int)(calibratedSecondary * 100);
-                        
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", 
-                                        "Primary: " + String(primaryValue) + ", Secondary: " + String(secondaryValue), 
-                                        String(configuredSensors[op.sensorIndex].name));
-                    } else {
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", 
-                                        "Parsed: " + String(primaryValue), 
-                                        String(configuredSensors[op.sensorIndex].name));
-                    }
-                } else if (strcmp(configuredSensors[op.sensorIndex].type, "LIS3DH") == 0) {
-                    // LIS3DH returns 6 bytes: X_LSB, X_MSB, Y_LSB, Y_MSB, Z_LSB, Z_MSB (signed 16-bit little-endian)
-                    if (idx >= 6) {
-                        // Extract 16-bit signed integers from raw response bytes (little-endian format)
-                        // LIS3DH auto-increments through: 0x28(X_L), 0x29(X_H), 0x2A(Y_L), 0x2B(Y_H), 0x2C(Z_L), 0x2D(Z_H)
-                        int16_t x_raw = ((uint8_t)response[1] << 8) | (uint8_t)response[0];
-                        int16_t y_raw = ((uint8_t)response[3] << 8) | (uint8_t)response[2];
-                        int16_t z_raw = ((uint8_t)response[5] << 8) | (uint8_t)response[4];
-                        
-                        // LIS3DH in standard 10-bit mode (±2g range):
-                        // - Data occupies upper 10 bits (bits 15-6)
-                        // - Lower 6 bits are padding
-                        // - Right-shift by 6 to get actual 10-bit value (-512 to +511)
-                        // - Scale: ±2g / 512 LSB = 3.906 mg/LSB
-                        x_raw >>= 6;
-                        y_raw >>= 6;
-                        z_raw >>= 6;
-                        
-                        float x_mg = (float)x_raw * 3.906f;  // ±2g standard mode: 3.906 mg/LSB
-                        float y_mg = (float)y_raw * 3.906f;
-                        float z_mg = (float)z_raw * 3.906f;
-                        
-                        // Store raw values in multi-axis structure
-                        configuredSensors[op.sensorIndex].rawValue = x_mg;
-                        configuredSensors[op.sensorIndex].rawValueB = y_mg;
-                        configuredSensors[op.sensorIndex].rawValueC = z_mg;
-                        
-                        // Apply calibration to all three axes using new expression-capable functions
-                        float calibratedX = applyCalibration(x_mg, configuredSensors[op.sensorIndex]);
-                        float calibratedY = applyCalibrationB(y_mg, configuredSensors[op.sensorIndex]);
-                        float calibratedZ = applyCalibrationC(z_mg, configuredSensors[op.sensorIndex]);
-                        
-                        configuredSensors[op.sensorIndex].calibratedValue = calibratedX;
-                        configuredSensors[op.sensorIndex].calibratedValueB = calibratedY;
-                        configuredSensors[op.sensorIndex].calibratedValueC = calibratedZ;
-                        
-                        // Convert to Modbus values (scaled by 100 for decimal precision)
-                        configuredSensors[op.sensorIndex].modbusValue = (int)(calibratedX * 100);
-                        configuredSensors[op.sensorIndex].modbusValueB = (int)(calibratedY * 100);
-                        configuredSensors[op.sensorIndex].modbusValueC = (int)(calibratedZ * 100);
-                        
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", 
-                                        "X: " + String(x_mg, 2) + " mg, Y: " + String(y_mg, 2) + " mg, Z: " + String(z_mg, 2) + " mg", 
-                                        String(configuredSensors[op.sensorIndex].name));
-                    } else {
-                        logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "ERR", 
-                                        "LIS3DH response too short: " + String(idx) + " bytes", 
-                                        String(configuredSensors[op.sensorIndex].name));
-                    }
-                } else {
-                    // Fallback: log raw value for all other I2C sensors
-                    logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "VAL", "Raw: " + String(response), String(configuredSensors[op.sensorIndex].name));
-                }
-                
-                // Move queue forward
-                for(int i = 0; i < i2cQueueSize - 1; i++) {
-                    i2cQueue[i] = i2cQueue[i + 1];
-                }
-                i2cQueueSize--;
-            } else {
-                logI2CTransaction(configuredSensors[op.sensorIndex].i2cAddress, "TIMEOUT", "No response received", String(configuredSensors[op.sensorIndex].name));
-                // Move to next operation on timeout
-                for(int i = 0; i < i2cQueueSize - 1; i++) {
-                    i2cQueue[i] = i2cQueue[i + 1];
-                }
-                i2cQueueSize--;
-            }
-            break;
-        }
-            
-        case BusOpState::ERROR: {
-            // Move to next operation
-            for(int i = 0; i < i2cQueueSize - 1; i++) {
-                i2cQueue[i] = i2cQueue[i + 1];
-            }
-            i2cQueueSize--;
-            break;
+    return stream.window.count >= stream.points ? DriverStatus::OK : DriverStatus::PENDING;
+}
+
+// Hand the completed window to decode
+static DriverStatus lis3dhCollect(SensorConfig& sensor, SensorReading& reading) {
+    static_assert(sizeof(VibrationWindow) <= SENSOR_READING_MAX_BYTES, "window must fit a SensorReading");
+    Lis3dhStream& stream = lis3dhStreamFor(sensor);
+    memcpy(reading.data, &stream.window, sizeof(VibrationWindow));
+    reading.length = sizeof(VibrationWindow);
+    stream.windows++;
+    stream.open = false;
+    // Samples stay in the buffer for processVibrationSpectra()
+    for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+        stream.spectrumSum[axis] = stream.window.sum[axis];
+    }
+    stream.spectrumAxis = 0;
+    return DriverStatus::OK;
+}
+
+static void lis3dhDecode(SensorConfig& sensor, const SensorReading& reading) {
+    VibrationWindow window;
+    memcpy(&window, reading.data, sizeof(window));
+    window.finish(LIS3DH_MG_PER_COUNT, sensor.vibration);
+
+    if (sensor.fixedPoint) {
+        // Q16.16 window mean from the integer sums (3.906 mg/LSB for ±2g)
+        for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+            storeChannelQ16(sensor, axis, q16FromLis3dhCountSum(window.sum[axis], window.count));
         }
+    } else {
+        float x_mg = sensor.vibration.mean[0];
+        float y_mg = sensor.vibration.mean[1];
+        float z_mg = sensor.vibration.mean[2];
+        
+        sensor.rawValue = x_mg;
+        sensor.rawValueB = y_mg;
+        sensor.rawValueC = z_mg;
+        
+        sensor.calibratedValue = applyCalibration(x_mg, sensor);
+        sensor.calibratedValueB = applyCalibrationB(y_mg, sensor);
+        sensor.calibratedValueC = applyCalibrationC(z_mg, sensor);
+        
+        sensor.modbusValue = (int)(sensor.calibratedValue * 100);
+        sensor.modbusValueB = (int)(sensor.calibratedValueB * 100);
+        sensor.modbusValueC = (int)(sensor.calibratedValueC * 100);
+    }
+    
+    const VibrationFeatures& v = sensor.vibration;
+    snprintf(sensor.rawDataString, sizeof(sensor.rawDataString),
+             "n=%u RMS %.1f/%.1f/%.1f mg, peak %.1f/%.1f/%.1f mg",
+             v.samples, v.rms[0], v.rms[1], v.rms[2], v.peak[0], v.peak[1], v.peak[2]);
+    logI2CTransaction(sensor.i2cAddress, "VAL", 
+                    "X: " + String(sensor.rawValue, 2) + " mg, Y: " + String(sensor.rawValueB, 2) + " mg, Z: " + String(sensor.rawValueC, 2) + " mg, " +
+                    String(sensor.rawDataString), 
+                    sensor.name);
+}
+
+// ---------------------------------------------------------- Atlas Scientific EZO
+//
+// One request per cycle, sent at trigger and read back at collect (the
+// scheduler re-polls "still processing" answers), so the bus is never held
+// while a circuit converts. pH, EC and DO circuits with an ezoCompensation
+// source get "RT,<temp>" instead of "R": the compensation temperature and
+// the read go out in the same command, taken from the source's latest value.
+
+// Temperatures accepted for compensation (EZO-RTD range is -126..1254 degC,
+// the pH/EC/DO compensation range is narrower)
+static const float EZO_COMPENSATION_MIN_C = -5.0f;
+static const float EZO_COMPENSATION_MAX_C = 105.0f;
+
+/**
+ * Request in flight of one EZO circuit (indexed like configuredSensors[])
+ */
+struct EzoRequest {
+    uint32_t sentAt;
+    bool awaiting;         // Sent, no reading or error yet
+};
+
+static EzoRequest ezoRequests[MAX_SENSORS];
+
+static EzoRequest& ezoRequestFor(const SensorConfig& sensor) {
+    return ezoRequests[&sensor - configuredSensors];
+}
+
+// Only these circuits take a temperature with the read command
+static bool ezoAcceptsCompensation(SensorType type) {
+    return type == SensorType::EZO_PH || type == SensorType::EZO_EC || type == SensorType::EZO_DO;
+}
+
+// Latest temperature of the compensation source, false if there is none usable
+static bool ezoCompensationTemperature(const SensorConfig& sensor, float& temperature) {
+    if (sensor.ezoCompensationIndex < 0 || !ezoAcceptsCompensation(sensor.typeId)) {
+        return false;
+    }
+    const SensorConfig& source = configuredSensors[sensor.ezoCompensationIndex];
+    if (!source.enabled || source.lastReadTime == 0 || source.rawValue == -1000.0) {
+        return false;  // Not read yet, or its last measurement failed
     }
+    temperature = source.calibratedValue;
+    return temperature >= EZO_COMPENSATION_MIN_C && temperature <= EZO_COMPENSATION_MAX_C;
 }
 
-void processUARTQueue() {
-    if (uartQueueSize == 0) return;
-    
-    unsigned long currentTime = millis();
-    BusOperation& op = uartQueue[0];
+static DriverStatus ezoTrigger(SensorConfig& sensor) {
+    EzoRequest& request = ezoRequestFor(sensor);
+    EzoProbeStats& stats = sensor.ezoStats;
+    if (request.awaiting) {
+        stats.errors++;  // Previous read was never answered
+    }
     
-    // Declare variables outside switch to avoid 'crosses initialization' error
-    int txPin, rxPin;
+    char command[16];
+    float temperature;
+    stats.compensated = ezoCompensationTemperature(sensor, temperature);
+    if (stats.compensated) {
+        stats.compensationC = temperature;
+        snprintf(command, sizeof(command), "RT,%.2f\r", temperature);
+    } else {
+        strcpy(command, "R\r");  // Single reading
+    }
     
+    TwoWire& wire = *sensor.i2cWire;
+    wire.beginTransmission(sensor.i2cAddress);
+    wire.write((const uint8_t*)command, strlen(command));
+    if (wire.endTransmission(true) != 0) {
+        stats.errors++;
+        request.awaiting = false;
+        return DriverStatus::ERROR_BUS;
+    }
+    request.sentAt = millis();
+    request.awaiting = true;
+    return DriverStatus::OK;
+}
 
+// Response: status byte (1 = data, 254 = still processing, 2/255 = error) + ASCII value
+static DriverStatus ezoCollect(SensorConfig& sensor, SensorReading& reading) {
+    EzoRequest& request = ezoRequestFor(sensor);
+    EzoProbeStats& stats = sensor.ezoStats;
+    DriverStatus status = readI2CResponse(sensor, reading);
+    if (status != DriverStatus::OK) {
+        stats.errors++;
+        request.awaiting = false;
+        return status;
+    }
+    
+    uint8_t statusCode = reading.data[0];
+    if (statusCode == 1 && reading.length > 1) {
+        stats.reads++;
+        stats.lastLatencyMs = millis() - request.sentAt;
+        if (stats.lastLatencyMs > stats.maxLatencyMs) stats.maxLatencyMs = stats.lastLatencyMs;
+        request.awaiting = false;
+        return DriverStatus::OK;
+    } else if (statusCode == 254) {
+        return DriverStatus::PENDING;  // Still processing, polled again by the scheduler
+    }
+    stats.errors++;
+    request.awaiting = false;
+    logI2CTransaction(sensor.i2cAddress, "ERR", String(sensor.type) + ": Status code " + String(statusCode), sensor.name);
+    return DriverStatus::ERROR_READ;
+}
+
+static void ezoDecode(SensorConfig& sensor, const SensorReading& reading) {
+    // Extract ASCII data after status byte
+    String dataStr = "";
+    for (int j = 1; j < reading.length; j++) {
+        if (reading.data[j] >= 32 && reading.data[j] <= 126) {
+            dataStr += (char)reading.data[j];
+        }
+    }
+    strncpy(sensor.response, dataStr.c_str(), sizeof(sensor.response) - 1);
+    sensor.rawValue = dataStr.toFloat();
+    sensor.calibratedValue = applyCalibration(sensor.rawValue, sensor);
+    sensor.modbusValue = (int)(sensor.calibratedValue * 100);
     
-    switch(op.state) {
-        case BusOpState::IDLE:
-            txPin = configuredSensors[op.sensorIndex].uartTxPin;
-            rxPin = configuredSensors[op.sensorIndex].uartRxPin;
-            
-            // Initialize UART if pins are valid
-            if (txPin >= 0 && rxPin >= 0 && txPin <= 28 && rxPin <= 28) {
-                // Configure hardware UART (RP2040 has UART0 and UART1)
-                if ((txPin == 0 && rxPin == 1) || (txPin == 12 && rxPin == 13) || 
-                    (txPin == 16 && rxPin == 17) || (txPin == 4 && rxPin == 5)) {
-                    
-                    // Use Serial1 for UART communication
-                    Serial1.setTX(txPin);
-                    Serial1.setRX(rxPin);
-                    Serial1.begin(9600); // Default baud rate
-                    
-                    // Send command if configured
-                    const char* command = configuredSensors[op.sensorIndex].command;
-                    if (strlen(command) > 0) {
-                        Serial1.print(command);
-                        Serial1.print("\r\n");
+    const EzoProbeStats& stats = sensor.ezoStats;
+    if (stats.compensated) {
+        snprintf(sensor.rawDataString, sizeof(sensor.rawDataString), "%s @ %.2f C, %lu ms",
+                 dataStr.c_str(), stats.compensationC, (unsigned long)stats.lastLatencyMs);
+    } else {
+        snprintf(sensor.rawDataString, sizeof(sensor.rawDataString), "%s, %lu ms",
+                 dataStr.c_str(), (unsigned long)stats.lastLatencyMs);
+    }
+    logI2CTransaction(sensor.i2cAddress, "VAL", String(sensor.type) + ": " + String(sensor.rawDataString), sensor.name);
+}
 
-                        
-                        // Log the UART transaction for terminal watch
-                        String pinStr = String(txPin) + "," + String(rxPin);
-                        logUARTTransaction(pinStr, "TX", String(command));
-                        
-                        // Wait for response
-                        delay(100);
-                        
-                        String response = "";
-                        unsigned long timeout = millis() + 1000; // 1 second timeout
-                        while (millis() < timeout && response.length() < 120) {
-                            if (Serial1.available()) {
-                                char c = Serial1.read();
-                                response += c;
-                                if (c == '\n' || c == '\r') break; // End of line
-                            }
-                        }
-                        
-                        if (response.length() > 0) {
-                            response.trim();
-                            
-                            // Log the UART response for terminal watch
-                            logUARTTransaction(pinStr, "RX", response);
-                            
-                            strncpy(configuredSensors[op.sensorIndex].rawDataString, response.c_str(), 
-                                   sizeof(configuredSensors[op.sensorIndex].rawDataString)-1);
-
-                            
-                            // Parse the response to extract numeric value
-                            float value = 0.0;
-                            // Try to extract first number from response
-                            for (int i = 0; i < response.length(); i++) {
-                                if (isdigit(response[i]) || response[i] == '.' || response[i] == '-') {
-                                    value = response.substring(i).toFloat();
-                                    break;
-                                }
-                            }
-                            
-                            configuredSensors[op.sensorIndex].rawValue = value;
-                            // Apply calibration using expression-capable function
-                            float calibratedValue = applyCalibration(value, configuredSensors[op.sensorIndex]);
-                            configuredSensors[op.sensorIndex].calibratedValue = calibratedValue;
-                            configuredSensors[op.sensorIndex].modbusValue = (int)(calibratedValue * 100);
-                            
-                        } else {
+// ---------------------------------------------------------- One-Wire (DS18B20)
+// Multi-drop strings per pin: one broadcast conversion, Match ROM reads (oneWireBusManager)
 
-                            configuredSensors[op.sensorIndex].rawValue = 0.0;
-                            strcpy(configuredSensors[op.sensorIndex].rawDataString, "NO_RESPONSE");
-                        }
-                    } else {
+static uint8_t ds18b20Resolution(const SensorConfig& sensor) {
+    if (sensor.oneWireResolution < DS18B20_MIN_RESOLUTION || sensor.oneWireResolution > DS18B20_MAX_RESOLUTION) {
+        return DS18B20_MAX_RESOLUTION;
+    }
+    return sensor.oneWireResolution;
+}
 
-                        // Just read any available data
-                        String response = "";
-                        while (Serial1.available() && response.length() < 120) {
-                            char c = Serial1.read();
-                            response += c;
-                        }
-                        if (response.length() > 0) {
-                            response.trim();
-                            strncpy(configuredSensors[op.sensorIndex].rawDataString, response.c_str(), 
-                                   sizeof(configuredSensors[op.sensorIndex].rawDataString)-1);
-                        }
-                    }
-                    
-                    Serial1.end(); // Close UART to free pins for other sensors
-                } else {
+// Write the configured resolution (DS18B20 type only; generic devices are left as they are)
+static bool ds18b20Begin(SensorConfig& sensor) {
+    if (sensor.typeId != SensorType::DS18B20) {
+        return true;
+    }
+    const uint8_t* rom = oneWireBusManager.deviceRom(sensor.oneWirePin, sensor.oneWireRomId, sensor.oneWireSlot);
+    if (rom == nullptr) {
+        return false;
+    }
+    uint8_t resolution = ds18b20Resolution(sensor);
+    if (oneWireBusManager.writeResolution(sensor.oneWirePin, rom, resolution) != DriverStatus::OK) {
+        Serial.printf("[DS18B20] %s: could not set %d-bit resolution\n", sensor.name, resolution);
+        return false;
+    }
+    return true;
+}
 
-                    configuredSensors[op.sensorIndex].rawValue = 0.0;
-                    strcpy(configuredSensors[op.sensorIndex].rawDataString, "INVALID_PINS");
-                }
-            } else {
+static DriverStatus ds18b20Trigger(SensorConfig& sensor) {
+    int owPin = sensor.oneWirePin;
+    uint32_t now = millis();
+    bool joined = oneWireBusManager.isConverting(owPin, now);
+    DriverStatus status = oneWireBusManager.startConversion(owPin, now, getSensorConversionMs(sensor));
+    if (status != DriverStatus::OK) {
+        return status;
+    }
+    
+    // Log the One-Wire transaction for terminal watch
+    if (!joined) {
+        logOneWireTransaction(String(owPin), "TX", "0xCC 0x44 (Skip ROM + Convert T, all devices)");
+    }
+    sensor.lastOneWireCmd = now;
+    return DriverStatus::OK;
+}
 
-                configuredSensors[op.sensorIndex].rawValue = 0.0;
-                strcpy(configuredSensors[op.sensorIndex].rawDataString, "INVALID_PINS");
-            }
-            
-            configuredSensors[op.sensorIndex].lastReadTime = currentTime;
-            
-            // Move to next operation
-            for(int i = 0; i < uartQueueSize - 1; i++) {
-                uartQueue[i] = uartQueue[i + 1];
-            }
-            uartQueueSize--;
-            break;
-            
-        case BusOpState::REQUEST_SENT:
-        case BusOpState::READY_TO_READ:
-        case BusOpState::ERROR:
-            // Move to next operation
-            for(int i = 0; i < uartQueueSize - 1; i++) {
-                uartQueue[i] = uartQueue[i + 1];
-            }
-            uartQueueSize--;
-            break;
+// Powered DS18B20s answer read slots with 0 until the conversion is done
+static DriverStatus ds18b20PollReady(SensorConfig& sensor) {
+    return oneWireBusManager.pollConversion(sensor.oneWirePin, millis(), getSensorConversionMs(sensor));
+}
+
+static DriverStatus ds18b20Collect(SensorConfig& sensor, SensorReading& reading) {
+    int owPin = sensor.oneWirePin;
+    const uint8_t* rom = oneWireBusManager.deviceRom(owPin, sensor.oneWireRomId, sensor.oneWireSlot);
+    if (rom == nullptr) {
+        strcpy(sensor.rawDataString, "NO_DEVICE");
+        return DriverStatus::ERROR_BUS;
     }
+    
+    DriverStatus status = oneWireBusManager.readScratchpad(owPin, rom, reading.data);
+    if (status == DriverStatus::ERROR_READ) {
+        strcpy(sensor.rawDataString, "CRC_ERROR");
+    }
+    if (status != DriverStatus::OK) {
+        return status;
+    }
+    reading.length = DS18B20_SCRATCHPAD_BYTES;
+    return DriverStatus::OK;
 }
 
-void processOneWireQueue() {
-    if (oneWireQueueSize == 0) return;
+static void ds18b20Decode(SensorConfig& sensor, const SensorReading& reading) {
+    const uint8_t* scratchpad = reading.data;
+    
+    // Convert raw data to temperature (DS18B20 format, 1/16 degC); below 12 bit
+    // the low bits are undefined
+    int16_t raw = (scratchpad[1] << 8) | scratchpad[0];
+    uint8_t resolution = ds18b20ResolutionFromConfig(scratchpad[4]);
+    raw &= ~((1 << (DS18B20_MAX_RESOLUTION - resolution)) - 1);
+    float temp = raw / 16.0;
     
-    unsigned long currentTime = millis();
-    BusOperation& op = oneWireQueue[0];
+    // Power-cycled devices come back at 12 bit: reconfigure on the next trigger
+    if (sensor.typeId == SensorType::DS18B20 && resolution != ds18b20Resolution(sensor)) {
+        sensor.driverStarted = false;
+    }
+    
+    // Log the One-Wire read for terminal watch
+    char readData[64];
+    snprintf(readData, sizeof(readData), "Scratchpad: %02X %02X %02X %02X %02X %02X %02X %02X %02X (%.2f°C)", 
+             scratchpad[0], scratchpad[1], scratchpad[2], scratchpad[3], scratchpad[4], 
+             scratchpad[5], scratchpad[6], scratchpad[7], scratchpad[8], temp);
+    logOneWireTransaction(String(sensor.oneWirePin), "RX", String(readData));
     
-    int owPin = configuredSensors[op.sensorIndex].oneWirePin;
-    uint8_t scratchpad[9] = {0};
-    bool presence;
-    bool readOk;
+    sensor.rawValue = temp;
+    sensor.calibratedValue = applyCalibration(temp, sensor);
+    sensor.modbusValue = (int)(sensor.calibratedValue * 100);
     
-    switch(op.state) {
-        case BusOpState::IDLE:
+    // Format raw data string
+    char dataStr[32];
+    snprintf(dataStr, sizeof(dataStr), "%.2f°C", temp);
+    strncpy(sensor.rawDataString, dataStr, sizeof(sensor.rawDataString) - 1);
+}
 
-            // Initialize One-Wire transaction
-            pinMode(owPin, OUTPUT);
-            digitalWrite(owPin, LOW);
-            delayMicroseconds(480);
-            pinMode(owPin, INPUT_PULLUP);
-            delayMicroseconds(70);
-            presence = !digitalRead(owPin);
-            delayMicroseconds(410);
+// DS18B20: set by the resolution; other 1-Wire devices: oneWireConversionTime
+static uint32_t ds18b20ConversionTime(const SensorConfig& sensor) {
+    if (sensor.typeId == SensorType::DS18B20) {
+        return ds18b20ConversionMs(ds18b20Resolution(sensor));
+    }
+    return sensor.oneWireConversionTime > 0 ? sensor.oneWireConversionTime : 750;
+}
 
-            if (presence) {
+// ----------------------------------------------------------------------- UART
+// Request/response or streaming line devices on UART0/UART1 (uartSensorEngine)
 
-                
-                // Log the One-Wire transaction for terminal watch
-                logOneWireTransaction(String(owPin), "TX", "0xCC 0x44 (Skip ROM + Convert T)");
-                
-                // Send Skip ROM (0xCC) + Convert T (0x44) command
-                // Skip ROM command
-                for (int bit = 0; bit < 8; bit++) {
-                    pinMode(owPin, OUTPUT);
-                    digitalWrite(owPin, LOW);
-                    if ((0xCC >> bit) & 1) {
-                        delayMicroseconds(6);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(64);
-                    } else {
-                        delayMicroseconds(60);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(10);
-                    }
-                }
-                
-                // Convert T command
-                for (int bit = 0; bit < 8; bit++) {
-                    pinMode(owPin, OUTPUT);
-                    digitalWrite(owPin, LOW);
-                    if ((0x44 >> bit) & 1) {
-                        delayMicroseconds(6);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(64);
-                    } else {
-                        delayMicroseconds(60);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(10);
-                    }
-                }
-                
-                op.state = BusOpState::REQUEST_SENT;
-                op.startTime = currentTime;
-                configuredSensors[op.sensorIndex].lastOneWireCmd = currentTime;
-            } else {
+static String uartPinString(const SensorConfig& sensor) {
+    return String(sensor.uartTxPin) + "," + String(sensor.uartRxPin);
+}
 
-                if (++op.retryCount >= 3) {
+// Send the command (if any); PENDING while another sensor's request holds the port
+static DriverStatus uartTrigger(SensorConfig& sensor) {
+    DriverStatus status = uartSensorEngine.startRequest(sensor, millis());
+    if (status == DriverStatus::ERROR_BUS) {
+        strcpy(sensor.rawDataString, "INVALID_PINS");
+    } else if (status == DriverStatus::OK && strlen(sensor.command) > 0) {
+        logUARTTransaction(uartPinString(sensor), "TX", String(sensor.command));
+    }
+    return status;
+}
 
-                    for(int i = 0; i < oneWireQueueSize - 1; i++) {
-                        oneWireQueue[i] = oneWireQueue[i + 1];
-                    }
-                    oneWireQueueSize--;
-                }
-            }
+// Copy what has arrived; OK once a whole line is in
+static DriverStatus uartCollect(SensorConfig& sensor, SensorReading& reading) {
+    DriverStatus status = uartSensorEngine.pollResponse(sensor, millis());
+    if (status == DriverStatus::ERROR_READ) {
+        strcpy(sensor.rawDataString, "NO_RESPONSE");
+    }
+    if (status != DriverStatus::OK) {
+        return status;
+    }
+    const char* line = uartSensorEngine.getLine(sensor);
+    reading.length = (uint8_t)min(strlen(line), (size_t)SENSOR_READING_MAX_BYTES - 1);
+    memcpy(reading.data, line, reading.length);
+    reading.data[reading.length] = '\0';
+    return DriverStatus::OK;
+}
+
+static void uartDecode(SensorConfig& sensor, const SensorReading& reading) {
+    String response = String((const char*)reading.data);
+    response.trim();
+    logUARTTransaction(uartPinString(sensor), "RX", response);
+    strncpy(sensor.rawDataString, response.c_str(), sizeof(sensor.rawDataString) - 1);
+    
+    // First number in the line
+    float value = 0.0;
+    for (int i = 0; i < response.length(); i++) {
+        if (isdigit(response[i]) || response[i] == '.' || response[i] == '-') {
+            value = response.substring(i).toFloat();
             break;
+        }
+    }
+    
+    sensor.rawValue = value;
+    sensor.calibratedValue = applyCalibration(value, sensor);
+    sensor.modbusValue = (int)(sensor.calibratedValue * 100);
+}
+
+// ------------------------------------------------------------------- Registry
+
+// name, protocol, output channels, conversion ms, bus us, streaming, begin, trigger, pollReady, collect, decode, conversionTime
+static const SensorDriver genericI2CDriver = { "GENERIC_I2C", SensorProtocol::I2C,      1,  0,   3300,  false, nullptr,      genericI2CTrigger, nullptr,          readI2CResponse, genericI2CDecode, genericI2CConversionTime };
+static const SensorDriver sht30Driver      = { "SHT30",       SensorProtocol::I2C,      2,  15,  900,   false, nullptr,      sht30Trigger,      nullptr,          sht30Collect,    sht30Decode,      nullptr };
+static const SensorDriver lis3dhDriver     = { "LIS3DH",      SensorProtocol::I2C,      27, 40,  9000,  true,  lis3dhBegin,  lis3dhTrigger,     lis3dhPollReady,  lis3dhCollect,   lis3dhDecode,     nullptr };
+static const SensorDriver ezoDriver        = { "EZO",         SensorProtocol::I2C,      1,  900, 3250,  false, nullptr,      ezoTrigger,        nullptr,          ezoCollect,      ezoDecode,        nullptr };
+static const SensorDriver ds18b20Driver    = { "DS18B20",     SensorProtocol::ONE_WIRE, 1,  750, 13400, false, ds18b20Begin, ds18b20Trigger,    ds18b20PollReady, ds18b20Collect,  ds18b20Decode,    ds18b20ConversionTime };
+static const SensorDriver uartDriver       = { "UART",        SensorProtocol::UART,     1,  10,  0,     false, nullptr,      uartTrigger,       nullptr,          uartCollect,     uartDecode,       nullptr };
+
+// Indexed by SensorType; nullptr = the bus's generic driver (if any)
+static const SensorDriver* const SENSOR_DRIVERS[] = {
+    nullptr,            // UNKNOWN
+    &sht30Driver,       // SHT30
+    nullptr,            // BME280 (no driver yet: generic I2C read)
+    &ds18b20Driver,     // DS18B20
+    &lis3dhDriver,      // LIS3DH
+    nullptr,            // LIS3DH_SPI
+    &ezoDriver,         // EZO_PH
+    &ezoDriver,         // EZO_EC
+    &ezoDriver,         // EZO_DO
+    &ezoDriver,         // EZO_RTD
+    &ezoDriver,         // EZO_ORP
+    &genericI2CDriver,  // GENERIC_I2C
+    &uartDriver,        // GENERIC_UART
+    &ds18b20Driver,     // GENERIC_ONEWIRE (scratchpad temperature, as DS18B20)
+};
+
+static_assert(sizeof(SENSOR_DRIVERS) / sizeof(SENSOR_DRIVERS[0]) == (size_t)SensorType::COUNT,
+              "SENSOR_DRIVERS must have one entry per SensorType");
+
+const SensorDriver* resolveSensorDriver(SensorType type, SensorProtocol protocol) {
+    uint8_t index = (uint8_t)type;
+    const SensorDriver* driver = index < (uint8_t)SensorType::COUNT ? SENSOR_DRIVERS[index] : nullptr;
+    if (driver != nullptr && driver->protocol == protocol) {
+        return driver;
+    }
+    switch (protocol) {
+        case SensorProtocol::I2C:      return &genericI2CDriver;
+        case SensorProtocol::ONE_WIRE: return &ds18b20Driver;
+        case SensorProtocol::UART:     return &uartDriver;
+        default:                       return nullptr;
+    }
+}
+
+uint32_t getSensorConversionMs(const SensorConfig& sensor) {
+    const SensorDriver* driver = sensor.driver;
+    if (driver == nullptr) return 0;
+    if (driver->conversionTime != nullptr) return driver->conversionTime(sensor);
+    // delayBeforeRead tunes the wait of drivers that have one (continuous devices stay at 0)
+    if (driver->conversionMs > 0 && sensor.delayBeforeRead > 0) return sensor.delayBeforeRead;
+    return driver->conversionMs;
+}
+
+// TRIGGER phase: start the device on first use, then start a measurement
+static DriverStatus triggerSensorMeasurement(SensorConfig& sensor) {
+    const SensorDriver* driver = sensor.driver;
+    if (driver == nullptr || driver->trigger == nullptr) {
+        return DriverStatus::ERROR_UNSUPPORTED;
+    }
+    if (!sensor.driverStarted && driver->begin != nullptr) {
+        if (!driver->begin(sensor)) {
+            return DriverStatus::ERROR_BUS;  // Retried on the next poll
+        }
+    }
+    sensor.driverStarted = true;
+    return driver->trigger(sensor);
+}
+
+// COLLECT phase: conversion time has elapsed, read and decode the result
+static DriverStatus collectSensorMeasurement(SensorConfig& sensor) {
+    const SensorDriver* driver = sensor.driver;
+    if (driver == nullptr || driver->collect == nullptr) {
+        return DriverStatus::ERROR_UNSUPPORTED;
+    }
+    if (driver->pollReady != nullptr) {
+        DriverStatus ready = driver->pollReady(sensor);
+        if (ready != DriverStatus::OK) {
+            return ready;
+        }
+    }
+    SensorReading reading;
+    reading.length = 0;
+    DriverStatus status = driver->collect(sensor, reading);
+    if (status == DriverStatus::OK) {
+        driver->decode(sensor, reading);
+    }
+    return status;
+}
+
+static I2CTransactionResult toI2CTransactionResult(DriverStatus status) {
+    switch (status) {
+        case DriverStatus::OK:          return I2CTransactionResult::SUCCESS;
+        case DriverStatus::PENDING:     return I2CTransactionResult::PENDING;
+        case DriverStatus::ERROR_BUS:   return I2CTransactionResult::ERROR_TRANSMISSION;
+        case DriverStatus::ERROR_READ:  return I2CTransactionResult::ERROR_READ_FAILED;
+        default:                        return I2CTransactionResult::ERROR_SENSOR_NOT_CONFIGURED;
+    }
+}
+
+// ============================================================================
+// SENSOR SCHEDULER DISPATCH
+// ============================================================================
+// Sensor measurements are driven by sensorScheduler (sensor_scheduler.h): a
+// min-heap holding each sensor's next TRIGGER or COLLECT deadline. loop1()
+// dispatches whatever is due and returns immediately when nothing is, so a
+// sensor is triggered within one core 1 loop pass of its planned time
+// instead of on the next tick of a fixed scan.
+//
+// A trigger with a conversion time schedules the matching COLLECT for when
+// the conversion completes; a device that is still converting at collect
+// time is collected again after a short retry delay. Once the measurement
+// completes (or fails) the next trigger is planned one interval after the
+// previous planned trigger.
+//
+// With batching on (SENSOR_BATCH_WINDOW_MS) a due trigger starts a round: all
+// triggers due within the window are sent back-to-back and the round is
+// collected together once its longest conversion has elapsed. Each pass is
+// grouped by I2C pin pair, so the bus manager re-pins a controller once per
+// pair rather than once per sensor. I2C0 pairs run on Wire and I2C1 pairs on
+// Wire1, so pairs on different controllers never displace each other.
+//
+// UART sensors follow the same phases: the trigger queues the command and
+// the collect is re-polled until the reply line is complete. A trigger whose
+// UART is still busy with another sensor's request is deferred briefly.
+//
+// LIS3DH accelerometers stream: the collect is re-polled every
+// LIS3DH_FIFO_DRAIN_MS, each poll draining the FIFO, until the window is full.
+
+// Not-ready retries at collect time (I2C limits are in i2c_bus_manager.h)
+static const uint32_t ONE_WIRE_NOT_READY_RETRY_MS = 10;
+static const uint8_t ONE_WIRE_MAX_NOT_READY_RETRIES = 25;
+// UART replies are re-polled until the engine's response timeout ends the request
+static const uint32_t UART_NOT_READY_RETRY_MS = 10;
+static const uint8_t UART_MAX_NOT_READY_RETRIES = 255;
+
+// Trigger retry while another sensor's request holds a shared UART
+static const uint32_t UART_PORT_BUSY_RETRY_MS = 20;
+
+// Collect attempts answered with "still converting", per sensor
+static uint8_t sensorNotReadyRetries[MAX_SENSORS] = {0};
+
+// Run one phase of an I2C sensor on its pin pair
+static DriverStatus runI2CSensorPhase(SensorConfig& sensor, SchedulePhase phase) {
+    DriverStatus status = DriverStatus::ERROR_BUS;  // Kept if the pin switch fails
+    i2cBusManager.performAtomicTransaction(sensor.sdaPin, sensor.sclPin,
+        [&sensor, phase, &status]() -> I2CTransactionResult {
+            status = (phase == SchedulePhase::TRIGGER) ? triggerSensorMeasurement(sensor)
+                                                       : collectSensorMeasurement(sensor);
+            return toI2CTransactionResult(status);
+        });
+    return status;
+}
+
+static DriverStatus runSensorPhase(SensorConfig& sensor, SchedulePhase phase) {
+    if (sensor.protocolId == SensorProtocol::I2C) {
+        return runI2CSensorPhase(sensor, phase);
+    }
+    return (phase == SchedulePhase::TRIGGER) ? triggerSensorMeasurement(sensor)
+                                             : collectSensorMeasurement(sensor);
+}
+
+static uint32_t getSchedulerIntervalMs(const SensorConfig& sensor) {
+    return sensor.updateInterval > SENSOR_SCHEDULER_MIN_INTERVAL_MS ? sensor.updateInterval
+                                                                    : SENSOR_SCHEDULER_MIN_INTERVAL_MS;
+}
+
+/**
+ * Plan the first trigger of every polled sensor
+ * Called with core 1 parked (or not yet started) after the configuration is applied.
+ */
+void scheduleSensorPolling() {
+    sensorScheduler.clear();
+    sensorScheduler.resetStats();  // Sensor indices may have changed
+    memset(sensorNotReadyRetries, 0, sizeof(sensorNotReadyRetries));
+    uartSensorEngine.cancelRequests();
+    oneWireBusManager.reset();  // Pins may have changed: search again
+
+    uint32_t now = millis();
+    uint8_t scheduled = 0;
+    for (int i = 0; i < numConfiguredSensors && i < SENSOR_SCHEDULER_CAPACITY; i++) {
+        const SensorConfig& sensor = configuredSensors[i];
+        if (!sensor.enabled) continue;
+
+        bool polled = sensor.driver != nullptr &&
+                      (sensor.protocolId == SensorProtocol::I2C || sensor.protocolId == SensorProtocol::ONE_WIRE ||
+                       sensor.protocolId == SensorProtocol::UART);
+        if (!polled) continue;
+
+        if (sensor.protocolId == SensorProtocol::I2C && (sensor.sdaPin < 0 || sensor.sclPin < 0)) {
+            Serial.printf("[Scheduler] Sensor %d (%s) has invalid I2C pins, not polled\n", i, sensor.name);
+            continue;
+        }
 
-        case BusOpState::REQUEST_SENT:
-            if (currentTime - op.startTime >= op.conversionTime) {
+        // A streaming window would wait for the round's slowest conversion before it opens
+        sensorScheduler.setSolo(i, sensor.driver->streaming);
+        sensorScheduler.schedule(i, SchedulePhase::TRIGGER, now + scheduled * SENSOR_SCHEDULER_STAGGER_MS);
+        scheduled++;
+    }
+    Serial.printf("[Scheduler] %d sensors scheduled\n", scheduled);
+}
 
-                op.state = BusOpState::READY_TO_READ;
-            }
-            break;
+// Measurement finished (successfully or not): plan the next one
+static void finishSensorMeasurement(uint8_t sensorIdx, uint32_t now) {
+    SensorConfig& sensor = configuredSensors[sensorIdx];
+    sensorNotReadyRetries[sensorIdx] = 0;
+    sensor.lastReadTime = now;
+    sensorScheduler.finishRoundMember(sensorIdx, now);
+    sensorScheduler.scheduleNextTrigger(sensorIdx, getSchedulerIntervalMs(sensor), now);
+}
 
-        case BusOpState::READY_TO_READ:
-            readOk = true;
+// Completes a measurement whose phase did not succeed
+static void failSensorMeasurement(uint8_t sensorIdx, SchedulePhase phase, DriverStatus status, uint32_t now) {
+    SensorConfig& sensor = configuredSensors[sensorIdx];
+    LOG_WARN_EVERY(5000, "[Scheduler] %s failed for sensor %d (%s): status %d\n",
+                         phase == SchedulePhase::TRIGGER ? "Trigger" : "Collect",
+                         sensorIdx, sensor.name, (int)status);
+    sensor.rawValue = -1000.0;  // Mark as error
+    finishSensorMeasurement(sensorIdx, now);
+}
 
-            // Send read scratchpad command
-            pinMode(owPin, OUTPUT);
-            digitalWrite(owPin, LOW);
-            delayMicroseconds(480);
-            pinMode(owPin, INPUT_PULLUP);
-            delayMicroseconds(70);
-            presence = !digitalRead(owPin);
-            delayMicroseconds(410);
+// Sensors of a batch round still waiting for their conversion
+struct TriggerRound {
+    uint8_t handle;
+    uint8_t waiting[SENSOR_SCHEDULER_CAPACITY];
+    uint8_t waitingCount;
+    uint32_t collectAt;  // End of the longest conversion
+};
 
-            if (presence) {
+/**
+ * Trigger one member of a batch round; members without a conversion time are
+ * collected straight away, the others wait for the round's collect
+ */
+static void triggerRoundMember(TriggerRound& round, uint8_t sensorIdx) {
+    SensorConfig& sensor = configuredSensors[sensorIdx];
+    uint32_t triggeredAt = millis();
+    DriverStatus status = runSensorPhase(sensor, SchedulePhase::TRIGGER);
+    if (status == DriverStatus::PENDING) {
+        sensorScheduler.deferTrigger(sensorIdx, millis() + UART_PORT_BUSY_RETRY_MS);
+        return;  // Shared UART busy: joins a later pass
+    }
+    if (status != DriverStatus::OK) {
+        failSensorMeasurement(sensorIdx, SchedulePhase::TRIGGER, status, millis());
+        return;
+    }
 
-                
-                // Send Skip ROM (0xCC) + Read Scratchpad (0xBE) command
-                // Skip ROM command
-                for (int bit = 0; bit < 8; bit++) {
-                    pinMode(owPin, OUTPUT);
-                    digitalWrite(owPin, LOW);
-                    if ((0xCC >> bit) & 1) {
-                        delayMicroseconds(6);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(64);
-                    } else {
-                        delayMicroseconds(60);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(10);
-                    }
-                }
-                
-                // Read Scratchpad command
-                for (int bit = 0; bit < 8; bit++) {
-                    pinMode(owPin, OUTPUT);
-                    digitalWrite(owPin, LOW);
-                    if ((0xBE >> bit) & 1) {
-                        delayMicroseconds(6);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(64);
-                    } else {
-                        delayMicroseconds(60);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(10);
-                    }
-                }
-                
-                // Read scratchpad data
-                for (int i = 0; i < 9 && readOk; i++) {
-                    uint8_t value = 0;
-                    for (int bit = 0; bit < 8; bit++) {
-                        pinMode(owPin, OUTPUT);
-                        digitalWrite(owPin, LOW);
-                        delayMicroseconds(3);
-                        pinMode(owPin, INPUT_PULLUP);
-                        delayMicroseconds(10);
-                        if (digitalRead(owPin)) {
-                            value |= (1 << bit);
-                        }
-                        delayMicroseconds(53);
-                    }
-                    scratchpad[i] = value;
-                }
-                
-                // Print scratchpad for debugging
-                // (Disabled for cleaner serial output)
-                /*
-                // Skip CRC validation for now - DS18B20 often has CRC issues with bit-banged implementation
-                // if (op.needsCRC && !validateCRC(scratchpad, 9)) {
-                //     Serial.printf("[DEBUG] One-Wire: CRC failed for sensor %d\n", op.sensorIndex);
-                //     readOk = false;
-                // }
-                */
-
-                if (readOk) {
-                    // Convert raw data to temperature (DS18B20 format)
-                    int16_t raw = (scratchpad[1] << 8) | scratchpad[0];
-                    float temp = raw / 16.0;
-                    
-                    // Log the One-Wire read for terminal watch
-                    char readData[64];
-                    snprintf(readData, sizeof(readData), "Scratchpad: %02X %02X %02X %02X %02X %02X %02X %02X %02X (%.2f°C)", 
-                             scratchpad[0], scratchpad[1], scratchpad[2], scratchpad[3], scratchpad[4], 
-                             scratchpad[5], scratchpad[6], scratchpad[7], scratchpad[8], temp);
-                    logOneWireTransaction(String(owPin), "RX", String(readData));
-                    
-                    // Apply calibration using expression-capable function
-                    float calibratedTemp = applyCalibration(temp, configuredSensors[op.sensorIndex]);
-                    
-                    configuredSensors[op.sensorIndex].rawValue = temp;
-                    configuredSensors[op.sensorIndex].calibratedValue = calibratedTemp;
-                    configuredSensors[op.sensorIndex].modbusValue = (int)(calibratedTemp * 100);
-                    configuredSensors[op.sensorIndex].lastReadTime = currentTime;
+    uint32_t conversionMs = getSensorConversionMs(sensor);
+    sensorScheduler.addToRound(round.handle, sensorIdx, conversionMs);
+    if (conversionMs == 0) {
+        // Nothing to wait for: read in the same pass
+        status = runSensorPhase(sensor, SchedulePhase::COLLECT);
+        if (status == DriverStatus::OK) {
+            finishSensorMeasurement(sensorIdx, millis());
+        } else {
+            failSensorMeasurement(sensorIdx, SchedulePhase::COLLECT, status, millis());
+        }
+        return;
+    }
+
+    round.waiting[round.waitingCount++] = sensorIdx;
+    if ((int32_t)(triggeredAt + conversionMs - round.collectAt) > 0) {
+        round.collectAt = triggeredAt + conversionMs;
+    }
+}
 
+// Both entries are I2C sensors on the same pin pair
+static bool onSamePinPair(const ScheduleEntry& a, const ScheduleEntry& b) {
+    const SensorConfig& sa = configuredSensors[a.sensorIndex];
+    const SensorConfig& sb = configuredSensors[b.sensorIndex];
+    return sa.protocolId == SensorProtocol::I2C && sb.protocolId == SensorProtocol::I2C &&
+           sa.sdaPin == sb.sdaPin && sa.sclPin == sb.sclPin;
+}
 
+/**
+ * Reorder the entries of one pass so each I2C pin pair is drained before the
+ * bus manager switches to the next: the pair that is already active first,
+ * then the other pairs in order of their earliest entry. Within a group the
+ * due order is kept, and every entry of the pass is still dispatched in the
+ * same pass, so grouping never delays a sensor past the current pass.
+ */
+static void groupByPinPair(ScheduleEntry* entries, uint8_t count) {
+    ScheduleEntry grouped[SENSOR_SCHEDULER_CAPACITY];
+    bool taken[SENSOR_SCHEDULER_CAPACITY] = {false};
+    uint8_t out = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        const SensorConfig& sensor = configuredSensors[entries[i].sensorIndex];
+        if (sensor.protocolId == SensorProtocol::I2C &&
+            i2cBusManager.isCurrentPinPair(sensor.sdaPin, sensor.sclPin)) {
+            grouped[out++] = entries[i];
+            taken[i] = true;
+        }
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (taken[i]) continue;
+        grouped[out++] = entries[i];
+        taken[i] = true;
+        for (uint8_t j = i + 1; j < count; j++) {
+            if (!taken[j] && onSamePinPair(entries[i], entries[j])) {
+                grouped[out++] = entries[j];
+                taken[j] = true;
+            }
+        }
+    }
+    memcpy(entries, grouped, count * sizeof(ScheduleEntry));
+}
 
-                    // Format raw data string
-                    char dataStr[32];
-                    snprintf(dataStr, sizeof(dataStr), "%.2f°C", temp);
-                    strncpy(configuredSensors[op.sensorIndex].rawDataString, dataStr, 
-                            sizeof(configuredSensors[op.sensorIndex].rawDataString)-1);
-                } else {
+static void dispatchScheduledPhase(const ScheduleEntry& entry, uint32_t now) {
+    uint8_t sensorIdx = entry.sensorIndex;
+    SensorConfig& sensor = configuredSensors[sensorIdx];
 
-                }
-            } else {
+    SchedulePhase phase = entry.phase;
+    DriverStatus status = runSensorPhase(sensor, phase);
 
-            }
+    if (phase == SchedulePhase::TRIGGER && status == DriverStatus::PENDING) {
+        // Shared UART busy with another sensor's request, or an LIS3DH spectrum still pending
+        uint32_t retryMs = sensor.driver == &lis3dhDriver ? LIS3DH_SPECTRUM_WAIT_MS : UART_PORT_BUSY_RETRY_MS;
+        sensorScheduler.deferTrigger(sensorIdx, now + retryMs);
+        return;
+    }
 
-            // Move to next operation
-            for(int i = 0; i < oneWireQueueSize - 1; i++) {
-                oneWireQueue[i] = oneWireQueue[i + 1];
-            }
-            oneWireQueueSize--;
-            break;
+    if (phase == SchedulePhase::TRIGGER && status == DriverStatus::OK) {
+        uint32_t conversionMs = getSensorConversionMs(sensor);
+        if (conversionMs > 0) {
+            sensorScheduler.schedule(sensorIdx, SchedulePhase::COLLECT, now + conversionMs);
+            return;
+        }
+        phase = SchedulePhase::COLLECT;  // No conversion time: read in the same pass
+        status = runSensorPhase(sensor, phase);
+    }
 
-        case BusOpState::ERROR:
+    if (phase == SchedulePhase::COLLECT && status == DriverStatus::PENDING) {
+        uint8_t maxRetries = I2C_MAX_NOT_READY_RETRIES;
+        uint32_t retryMs = I2C_NOT_READY_RETRY_MS;
+        if (sensor.protocolId == SensorProtocol::ONE_WIRE) {
+            maxRetries = ONE_WIRE_MAX_NOT_READY_RETRIES;
+            retryMs = ONE_WIRE_NOT_READY_RETRY_MS;
+        } else if (sensor.protocolId == SensorProtocol::UART) {
+            maxRetries = UART_MAX_NOT_READY_RETRIES;
+            retryMs = UART_NOT_READY_RETRY_MS;
+        } else if (sensor.driver == &lis3dhDriver) {
+            maxRetries = LIS3DH_MAX_FIFO_DRAINS;
+            retryMs = LIS3DH_FIFO_DRAIN_MS;  // Must beat the FIFO fill time
+        }
+        if (sensorNotReadyRetries[sensorIdx] < maxRetries) {
+            sensorNotReadyRetries[sensorIdx]++;
+            sensorScheduler.schedule(sensorIdx, SchedulePhase::COLLECT, now + retryMs);
+            return;  // Device still converting, collect again shortly
+        }
+    }
 
-            // Move to next operation
-            for(int i = 0; i < oneWireQueueSize - 1; i++) {
-                oneWireQueue[i] = oneWireQueue[i + 1];
-            }
-            oneWireQueueSize--;
-            break;
+    if (status != DriverStatus::OK) {
+        failSensorMeasurement(sensorIdx, phase, status, now);
+        return;
     }
+    finishSensorMeasurement(sensorIdx, now);
 }
 
-void enqueueBusOperation(uint8_t sensorIndex, const char* protocol) {
-    if (!configuredSensors[sensorIndex].enabled) return;
-    
-    // Prevent duplicate operations in queue for the same sensor
-    // This avoids queuing up multiple pending reads while one is still processing
-    if (strcmp(protocol, "One-Wire") == 0) {
-        for (int i = 0; i < oneWireQueueSize; i++) {
-            if (oneWireQueue[i].sensorIndex == sensorIndex) {
-                // Operation for this sensor already pending, skip
-                return;
-            }
+/**
+ * Dispatch every scheduler entry that is due (core 1)
+ * With batching on, triggers due within the batch window join this pass as
+ * one round; solo (streaming) sensors are dispatched on their own. The pass is grouped by I2C pin pair before dispatching.
+ */
+void runSensorScheduler() {
+    ScheduleEntry due[SENSOR_SCHEDULER_CAPACITY];
+    uint8_t dueCount = 0;
+    bool batching = false;
+    uint32_t now = millis();
+
+    // At most one entry per sensor, so a pass never exceeds the capacity
+    while (dueCount < SENSOR_SCHEDULER_CAPACITY && sensorScheduler.popDue(now, due[dueCount])) {
+        const ScheduleEntry& entry = due[dueCount++];
+        if (entry.phase == SchedulePhase::TRIGGER && sensorScheduler.getBatchWindow() > 0 &&
+            !sensorScheduler.isSolo(entry.sensorIndex)) {
+            batching = true;
         }
-    } else if (strcmp(protocol, "I2C") == 0) {
-        for (int i = 0; i < i2cQueueSize; i++) {
-            if (i2cQueue[i].sensorIndex == sensorIndex) {
-                // Operation for this sensor already pending, skip
-                return;
-            }
+    }
+    if (dueCount == 0) return;
+
+    if (batching) {
+        // Pull triggers due within the batch window into this round
+        while (dueCount < SENSOR_SCHEDULER_CAPACITY && sensorScheduler.popEarlyTrigger(now, due[dueCount])) {
+            dueCount++;
         }
-    } else if (strcmp(protocol, "UART") == 0) {
-        for (int i = 0; i < uartQueueSize; i++) {
-            if (uartQueue[i].sensorIndex == sensorIndex) {
-                // Operation for this sensor already pending, skip
-                return;
+    }
+
+    groupByPinPair(due, dueCount);
+
+    TriggerRound round;
+    round.handle = SENSOR_ROUND_NONE;
+    round.waitingCount = 0;
+    round.collectAt = now;
+    for (uint8_t i = 0; i < dueCount; i++) {
+        const ScheduleEntry& entry = due[i];
+        if (batching && entry.phase == SchedulePhase::TRIGGER && !sensorScheduler.isSolo(entry.sensorIndex)) {
+            if (round.handle == SENSOR_ROUND_NONE) {
+                round.handle = sensorScheduler.beginRound(now);
             }
+            triggerRoundMember(round, entry.sensorIndex);
+        } else {
+            dispatchScheduledPhase(entry, millis());
         }
     }
-    
-    BusOperation op = {
-        .sensorIndex = sensorIndex,
-            .startTime = millis(),
-        .conversionTime = 750, // Default 750ms, adjust per sensor type
-        .state = BusOpState::IDLE,
-        .retryCount = 0,
-        .needsCRC = true
-    };
-    
-    // Adjust conversion time based on sensor type
-    if (strcmp(configuredSensors[sensorIndex].type, "EZO-PH") == 0) {
-        op.conversionTime = 900; // Atlas Scientific pH spec: 900ms
-    } else if (strcmp(configuredSensors[sensorIndex].type, "EZO-EC") == 0) {
-        op.conversionTime = 900;
-    } else if (strcmp(configuredSensors[sensorIndex].type, "LIS3DH") == 0) {
-        op.conversionTime = 0; // Direct register read, no conversion time needed (just 1ms in WAITING_CONVERSION state)
-    } else if (strcmp(configuredSensors[sensorIndex].type, "DS18B20") == 0) {
-        op.conversionTime = configuredSensors[sensorIndex].oneWireConversionTime;
-        if (op.conversionTime <= 0) op.conversionTime = 750;
+
+    // Collect the whole round once its longest conversion has elapsed
+    for (uint8_t i = 0; i < round.waitingCount; i++) {
+        sensorScheduler.schedule(round.waiting[i], SchedulePhase::COLLECT, round.collectAt);
     }
-    
-    // Add to appropriate queue
-    if (strcmp(protocol, "I2C") == 0 && i2cQueueSize < MAX_SENSORS) {
-        i2cQueue[i2cQueueSize++] = op;
-    } else if (strcmp(protocol, "UART") == 0 && uartQueueSize < MAX_SENSORS) {
-        uartQueue[uartQueueSize++] = op;
-    } else if (strcmp(protocol, "One-Wire") == 0 && oneWireQueueSize < MAX_SENSORS) {
-        oneWireQueue[oneWireQueueSize++] = op;
+    if (round.handle != SENSOR_ROUND_NONE) {
+        sensorScheduler.endRound(round.handle, millis());
     }
 }
 
-void updateBusQueues() {
-    static unsigned long lastQueueUpdate = 0;
-    unsigned long currentTime = millis();
-    
-    // Update every 100ms
-    if (currentTime - lastQueueUpdate < 100) return;
-    lastQueueUpdate = currentTime;
-    
-    // Check each enabled sensor
+/**
+ * Run the FFT of one pending LIS3DH axis (core 1)
+ * One axis per call keeps each loop1() pass short; the three axes of a
+ * window are done long before the next window fills.
+ */
+void processVibrationSpectra() {
     for (int i = 0; i < numConfiguredSensors; i++) {
-        if (!configuredSensors[i].enabled) continue;
-        
-        // Add to queue if it's time for next reading
-        if (currentTime - configuredSensors[i].lastReadTime >= configuredSensors[i].updateInterval) {
-            if (strncmp(configuredSensors[i].protocol, "I2C", 3) == 0) {
-                enqueueBusOperation(i, "I2C");
-            } else if (strncmp(configuredSensors[i].protocol, "UART", 4) == 0) {
-                enqueueBusOperation(i, "UART");
-            } else if (strncmp(configuredSensors[i].protocol, "One-Wire", 8) == 0) {
-                enqueueBusOperation(i, "One-Wire");
-            }
-        }
+        SensorConfig& sensor = configuredSensors[i];
+        if (sensor.driver != &lis3dhDriver) continue;
+        Lis3dhStream& stream = lis3dhStreams[i];
+        if (stream.samples == nullptr || stream.spectrumAxis >= VIBRATION_AXES) continue;
+        lis3dhAnalyzeAxis(sensor, stream);
+        return;
     }
-    
-    // Process queues
-    // NEW: Use I2C Bus Manager for advanced multi-bus polling (recommended)
-    processI2CBusManagerQueue();
-    
-    // LEGACY: Keep old queue processor as fallback (can be removed once bus manager is fully tested)
-    // processI2CQueue();
-    
-    processUARTQueue();
-    processOneWireQueue();
 }
 
-// EZO sensor functionality 
-Ezo_board* ezoSensors[MAX_SENSORS] = {nullptr};
-bool ezoSensorsInitialized = false;
-
 // Terminal monitoring variables
 bool terminalWatchActive = false;
 String watchedPin = "";
 String watchedProtocol = "";
 std::vector<String> terminalBuffer;
+auto_init_mutex(terminalLogMutex);  // terminalBuffer is appended from both cores
 
 // Bus traffic logging functions
 void addTerminalLog(String message) {
@@ -1508,13 +1476,15 @@ void addTerminalLog(String message) {
     String timestamp = String(millis());
     String logEntry = "[" + timestamp + "] " + message;
     
+    mutex_enter_blocking(&terminalLogMutex);
     terminalBuffer.push_back(logEntry);
     if (terminalBuffer.size() > MAX_TERMINAL_BUFFER) {
         terminalBuffer.erase(terminalBuffer.begin());
     }
+    mutex_exit(&terminalLogMutex);
     
     // Also print to Serial for debugging
-    Serial.println(logEntry);
+    LOG_DEBUG("%s\n", logEntry.c_str());
 }
 
 void logI2CTransaction(int address, String direction, String data, String pin) {
@@ -1523,14 +1493,14 @@ void logI2CTransaction(int address, String direction, String data, String pin) {
     
     if (terminalWatchActive) {
         // Debug what we're checking
-        Serial.printf("DEBUG logI2C: addr=0x%02X, dir=%s, pin=%s, watchedPin=%s, watchedProtocol=%s\n", 
+        LOG_TRACE("DEBUG logI2C: addr=0x%02X, dir=%s, pin=%s, watchedPin=%s, watchedProtocol=%s\n", 
                      address, direction.c_str(), pin.c_str(), watchedPin.c_str(), watchedProtocol.c_str());
         
         // Support both pin numbers and sensor names
         if (watchedPin == "all" || watchedPin == pin) {
             // Direct match (legacy support)
             shouldLog = true;
-            Serial.printf("DEBUG logI2C: Direct match - shouldLog=true\n");
+            LOG_TRACE("DEBUG logI2C: Direct match - shouldLog=true\n");
         } else if (watchedPin.length() <= 2 && watchedPin.toInt() > 0) {
             // Pin number selected (e.g., "4" for GP4/GP5) - show ALL traffic on that pin pair
             int pinNum = watchedPin.toInt();
@@ -1540,14 +1510,14 @@ void logI2CTransaction(int address, String direction, String data, String pin) {
                     (configuredSensors[i].sdaPin == pinNum || configuredSensors[i].sclPin == pinNum ||
                      configuredSensors[i].sdaPin == pinNum + 1 || configuredSensors[i].sclPin == pinNum + 1)) {
                     shouldLog = true;
-                    Serial.printf("DEBUG logI2C: Pin pair match for pins %d/%d - shouldLog=true\n", pinNum, pinNum + 1);
+                    LOG_TRACE("DEBUG logI2C: Pin pair match for pins %d/%d - shouldLog=true\n", pinNum, pinNum + 1);
                     break;
                 }
             }
             // Also check default I2C pins if no sensors match
             if (!shouldLog && (pinNum == 4 || pinNum == 5)) {
                 shouldLog = true; // Default I2C bus
-                Serial.printf("DEBUG logI2C: Default I2C bus match - shouldLog=true\n");
+                LOG_TRACE("DEBUG logI2C: Default I2C bus match - shouldLog=true\n");
             }
         } else {
             // Sensor name selected - show only that sensor's traffic
@@ -1556,7 +1526,7 @@ void logI2CTransaction(int address, String direction, String data, String pin) {
                     strcmp(configuredSensors[i].name, watchedPin.c_str()) == 0 &&
                     configuredSensors[i].i2cAddress == address) {
                     shouldLog = true;
-                    Serial.printf("DEBUG logI2C: Sensor name match for %s - shouldLog=true\n", configuredSensors[i].name);
+                    LOG_TRACE("DEBUG logI2C: Sensor name match for %s - shouldLog=true\n", configuredSensors[i].name);
                     break;
                 }
             }
@@ -1568,7 +1538,7 @@ void logI2CTransaction(int address, String direction, String data, String pin) {
         if (watchedProtocolUpper == "I2C" && shouldLog) {
             String logMsg = "I2C [0x" + String(address, HEX) + "] " + direction + ": " + data;
             addTerminalLog(logMsg);
-            Serial.println("TERMINAL_LOG: " + logMsg);
+            LOG_DEBUG("TERMINAL_LOG: %s\n", logMsg.c_str());
         }
     }
 }
@@ -1777,7 +1747,7 @@ String executeTerminalCommand(String command, String pin, String protocol) {
         } else if (command == "i2c-diag-poll") {
             response = "I2C polling sequence:\n";
             for (int i = 0; i < numConfiguredSensors; i++) {
-                if (configuredSensors[i].enabled && strcmp(configuredSensors[i].protocol, "I2C") == 0) {
+                if (configuredSensors[i].enabled && configuredSensors[i].protocolId == SensorProtocol::I2C) {
                     response += String(i) + ": " + configuredSensors[i].name + 
                               " (SDA=" + String(configuredSensors[i].sdaPin) + 
                               " SCL=" + String(configuredSensors[i].sclPin) + 
@@ -1793,9 +1763,9 @@ String executeTerminalCommand(String command, String pin, String protocol) {
             bool hasConflicts = false;
             
             for (int i = 0; i < numConfiguredSensors - 1; i++) {
-                if (configuredSensors[i].enabled && strcmp(configuredSensors[i].protocol, "I2C") == 0) {
+                if (configuredSensors[i].enabled && configuredSensors[i].protocolId == SensorProtocol::I2C) {
                     for (int j = i + 1; j < numConfiguredSensors; j++) {
-                        if (configuredSensors[j].enabled && strcmp(configuredSensors[j].protocol, "I2C") == 0) {
+                        if (configuredSensors[j].enabled && configuredSensors[j].protocolId == SensorProtocol::I2C) {
                             // Check same pin pair but different address
                             if (configuredSensors[i].sdaPin == configuredSensors[j].sdaPin &&
                                 configuredSensors[i].sclPin == configuredSensors[j].sclPin &&
@@ -1926,10 +1896,7 @@ void setup() {
     // Initialize command queues
     Serial.printf("Sensors: %d configured\n", numConfiguredSensors);
     
-    // Initialize bus queues and command arrays
-    i2cQueueSize = 0;
-    uartQueueSize = 0;
-    oneWireQueueSize = 0;
+    // Initialize command arrays
     i2cCommands.init();
     uartCommands.init();
     oneWireCommands.init();
@@ -1943,21 +1910,17 @@ void setup() {
                 .sensorIndex = (uint8_t)i,
                 .nextExecutionMs = millis(),
                 .intervalMs = configuredSensors[i].updateInterval,
-                .command = (strcmp(configuredSensors[i].type, "GENERIC") == 0) ? configuredSensors[i].command : nullptr,
-                .isGeneric = (strcmp(configuredSensors[i].type, "GENERIC") == 0)
+                .command = (configuredSensors[i].typeId == SensorType::GENERIC_I2C) ? configuredSensors[i].command : nullptr,
+                .isGeneric = (configuredSensors[i].typeId == SensorType::GENERIC_I2C)
             };
             
             // Add to appropriate command array (including SHT30 sensors)
-            if (strncmp(configuredSensors[i].protocol, "I2C", 3) == 0) {
+            if (configuredSensors[i].protocolId == SensorProtocol::I2C) {
                 i2cCommands.add(cmd);
-                // Queue initial bus operation
-                enqueueBusOperation(i, "I2C");
-            } else if (strncmp(configuredSensors[i].protocol, "UART", 4) == 0) {
+            } else if (configuredSensors[i].protocolId == SensorProtocol::UART) {
                 uartCommands.add(cmd);
-                enqueueBusOperation(i, "UART");
-            } else if (strncmp(configuredSensors[i].protocol, "One-Wire", 8) == 0) {
+            } else if (configuredSensors[i].protocolId == SensorProtocol::ONE_WIRE) {
                 oneWireCommands.add(cmd);
-                enqueueBusOperation(i, "One-Wire");
             }
         }
     }
@@ -1991,82 +1954,17 @@ void setup() {
     
     Serial.println("I2C Bus Manager initialized successfully\n");
     
-    // Initialize any LIS3DH sensors that are configured and enabled
-    for (int i = 0; i < numConfiguredSensors; i++) {
-        if (configuredSensors[i].enabled && strcmp(configuredSensors[i].type, "LIS3DH") == 0) {
-            uint8_t addr = configuredSensors[i].i2cAddress;
-            Serial.printf("[Setup] Initializing LIS3DH at 0x%02X\n", addr);
-            
-            // First verify WHO_AM_I register (0x0F should return 0x33)
-            Wire.beginTransmission(addr);
-            Wire.write(0x0F);  // WHO_AM_I register
-            Wire.endTransmission();
-            delay(5);
-            Wire.requestFrom(addr, 1);
-            if (Wire.available()) {
-                uint8_t whoami = Wire.read();
-                Serial.printf("[Setup] LIS3DH WHO_AM_I = 0x%02X (expect 0x33)\n", whoami);
-                if (whoami != 0x33) {
-                    Serial.printf("[Setup] WARNING: Unexpected WHO_AM_I value! Device may not be LIS3DH\n");
-                }
-            } else {
-                Serial.printf("[Setup] WARNING: Could not read WHO_AM_I from LIS3DH\n");
-            }
-            delay(10);
-            
-            // Configure LIS3DH: CTRL_REG1 (0x20) = 0x96
-            // Bit 7-4: ODR[3:0] = 1001 (1344 Hz, fastest normal mode)
-            // Bit 3: Zen = 1 - Enable Z-axis
-            // Bit 2: Yen = 1 - Enable Y-axis
-            // Bit 1: Xen = 1 - Enable X-axis
-            // Bit 0: LP = 0 - Normal mode (not low power)
-            // 0x96 = 10010110 = 1344 Hz, all axes enabled, normal mode
-            Wire.beginTransmission(addr);
-            Wire.write(0x20);  // CTRL_REG1
-            Wire.write(0x96);  // 1344 Hz, all axes enabled, normal mode
-            if (Wire.endTransmission() == 0) {
-                Serial.printf("[Setup] LIS3DH CTRL_REG1 (0x20) set to 0x96 OK (1344 Hz, all axes, normal mode)\n");
-            } else {
-                Serial.printf("[Setup] LIS3DH CTRL_REG1 config failed\n");
-            }
-            
-            // Configure LIS3DH: CTRL_REG4 (0x23) = 0x80
-            // Bit 7: BDU (1) - Block Data Update (wait for both MSB/LSB before reading)
-            // Bit 6: BLE (0) - Big Endian (0 = Little Endian)
-            // Bits 5-4: FS1, FS0 (00) - Full Scale ±2g (Raspberry Pi reference uses this)
-            // Bit 3: HR (0) - High Resolution disabled (standard 10-bit mode)
-            // 0x80 = 1000 0000 = ±2g range, BDU enabled
-            // Per RP reference: sensitivity = 0.004g per LSB in this standard mode
-            delay(10);
-            Wire.beginTransmission(addr);
-            Wire.write(0x23);  // CTRL_REG4
-            Wire.write(0x80);  // ±2g range with BDU enabled (standard mode, per RP reference)
-            if (Wire.endTransmission() == 0) {
-                Serial.printf("[Setup] LIS3DH CTRL_REG4 (0x23) set to 0x80 OK (±2g, standard mode)\n");
-            } else {
-                Serial.printf("[Setup] LIS3DH CTRL_REG4 config failed\n");
-            }
-            
-            // Turn auxiliary ADC on (for temperature sensing, optional but included per RP reference)
-            delay(10);
-            Wire.beginTransmission(addr);
-            Wire.write(0x1F);  // TEMP_CFG_REG
-            Wire.write(0xC0);  // Temperature sensor enabled
-            if (Wire.endTransmission() == 0) {
-                Serial.printf("[Setup] LIS3DH TEMP_CFG_REG (0x1F) set to 0xC0 OK\n");
-            } else {
-                Serial.printf("[Setup] LIS3DH TEMP_CFG_REG config failed\n");
-            }
-            
-            Serial.printf("[Setup] LIS3DH at 0x%02X initialized successfully\n", addr);
-            
-            // Give sensor time to start outputting data after initialization
-            delay(500);  // Wait 500ms for first data to be available
-        }
-    }
+    // LIS3DH and other devices needing setup are started by their driver's begin()
+    // on the first poll, after the bus manager has switched to their pins
+
+    // Plan the first measurement of every polled sensor
+    scheduleSensorPolling();
 
     // Start watchdog
     rp2040.wdt_begin(WDT_TIMEOUT);
+    
+    // Hand the sensor buses over to core 1
+    sensorCore.start();
     Serial.println("Setup complete.");
 }
 
@@ -2099,6 +1997,48 @@ void handlePOSTSensorCalibration(WiFiClient& client, String body) {
         client.println("{\"success\":false,\"message\":\"Sensor not found\"}");
         return;
     }
+    // Calibration expressions are compiled here, once; reject ones that do not compile
+    const char* expressionKeys[3] = { "expression", "expressionB", "expressionC" };
+    char* expressionFields[3] = { configuredSensors[found].calibrationExpression,
+                                  configuredSensors[found].calibrationExpressionB,
+                                  configuredSensors[found].calibrationExpressionC };
+    CalibrationProgram* programs[3] = { &configuredSensors[found].calibrationProgram,
+                                        &configuredSensors[found].calibrationProgramB,
+                                        &configuredSensors[found].calibrationProgramC };
+    CalibrationProgram compiled[3];
+    const size_t expressionCapacity = sizeof(configuredSensors[found].calibrationExpression);
+    for (int ch = 0; ch < 3; ch++) {
+        if (!doc.containsKey(expressionKeys[ch])) continue;
+        const char* expr = doc[expressionKeys[ch]] | "";
+        // The stored text is recompiled on boot (compileSensorCalibration()); it must not be cut short
+        if (strlen(expr) >= expressionCapacity) {
+            client.println("HTTP/1.1 400 Bad Request");
+            client.println("Content-Type: application/json");
+            client.println("Connection: close");
+            client.println();
+            client.printf("{\"success\":false,\"error\":\"Expression too long (max %u characters)\",\"channel\":\"%c\"}\n",
+                          (unsigned)(expressionCapacity - 1), 'A' + ch);
+            return;
+        }
+        uint16_t errorOffset = 0;
+        CalCompileResult result = compiled[ch].compile(expr, &errorOffset);
+        if (result != CalCompileResult::OK && result != CalCompileResult::EMPTY) {
+            client.println("HTTP/1.1 400 Bad Request");
+            client.println("Content-Type: application/json");
+            client.println("Connection: close");
+            client.println();
+            client.printf("{\"success\":false,\"error\":\"%s\",\"channel\":\"%c\",\"offset\":%u}\n",
+                          CalibrationProgram::resultString(result), 'A' + ch, errorOffset);
+            return;
+        }
+    }
+    for (int ch = 0; ch < 3; ch++) {
+        if (!doc.containsKey(expressionKeys[ch])) continue;
+        strlcpy(expressionFields[ch], doc[expressionKeys[ch]] | "", expressionCapacity);
+        *programs[ch] = compiled[ch];
+    }
+    resolveFixedPointCalibration(configuredSensors[found]);
+    
     // Store all calibration info as a JSON string in calibrationData
     String calibJson;
     serializeJson(doc, calibJson);
@@ -2175,12 +2115,8 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
                     ioStatus.dOut[pinNum] = state;
                     digitalWrite(DIGITAL_OUTPUTS[pinNum], config.doInvert[pinNum] ? !state : state);
                     
-                    // Update all connected Modbus clients
-                    for (int i = 0; i < MAX_MODBUS_CLIENTS; i++) {
-                        if (modbusClients[i].connected) {
-                            modbusClients[i].server.coilWrite(pinNum, state);
-                        }
-                    }
+                    // Update the shared Modbus image
+                    modbusImage.coilWrite(pinNum, state);
                     
                     response = pin + " set to " + (state ? "HIGH" : "LOW");
                 } else {
@@ -2527,7 +2463,23 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
         if (owPin < 0 || owPin > 28) {
             success = false;
             response = "Error: Invalid One-Wire pin. Use GP0-GP28 format";
-        } else if (command == "scan" || command == "search") {
+        } else if (command == "search") {
+            // ROM search on this pin; refreshes the device list the sensors use (core 1 is parked)
+            int found = oneWireBusManager.rescan(owPin);
+            if (found < 0) {
+                success = false;
+                response = "Error: All " + String(ONE_WIRE_MAX_BUSES) + " One-Wire bus slots are in use";
+            } else if (found == 0) {
+                response = "No One-Wire devices found on GP" + String(owPin);
+            } else {
+                response = String(found) + " device(s) on GP" + String(owPin) + ":\\n";
+                for (int i = 0; i < found; i++) {
+                    char rom[2 * ONE_WIRE_ROM_BYTES + 1];
+                    oneWireRomToString(oneWireBusManager.getDevice(owPin, i), rom);
+                    response += "[" + String(i) + "] " + String(rom) + "\\n";
+                }
+            }
+        } else if (command == "scan") {
             // Scan all supported One-Wire pins
             int oneWirePins[] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,22,26,27,28};
             bool foundDevice = false;
@@ -2800,7 +2752,8 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
             response += "Voltage: 3.3V or 5V\\n";
             response += "Speed: 15.4 kbps (standard), 125 kbps (overdrive)\\n\\n";
             response += "Available Commands:\\n";
-            response += "• scan/search - Detect device presence\\n";
+            response += "• scan - Detect device presence on all pins\\n";
+            response += "• search - List device ROMs on this pin\\n";
             response += "• convert - Start temperature conversion\\n";
             response += "• read - Read scratchpad data (raw bytes)\\n";
             response += "• rom - Read device ROM ID\\n";
@@ -2808,17 +2761,19 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
             response += "• reset - Send reset pulse\\n";
             response += "• power - Check power mode";
         } else if (command == "crc") {
-            response = "CRC check functionality requires OneWire library\\n";
-            response += "Install: OneWire by Jim Studt, Tom Pollard\\n";
-            response += "Also: DallasTemperature by Miles Burton";
+            response = "CRC8 is checked on every ROM search and scratchpad read\\n";
+            response += "CRC errors per pin: 'onewire' on the serial console";
         } else {
             success = false;
-            response = "Error: Unknown One-Wire command. Use 'scan', 'read', 'convert', 'rom', 'cmd', 'reset', 'power', 'info', or 'crc'";
+            response = "Error: Unknown One-Wire command. Use 'scan', 'search', 'read', 'convert', 'rom', 'cmd', 'reset', 'power', 'info', or 'crc'";
         }
     } else if (protocol == "uart") {
         // Extract pin numbers from pin string (e.g., "GP8,GP9" for TX,RX)
         int txPin = -1;
         int rxPin = -1;
+        uint32_t baud = UART_DEFAULT_BAUD;
+        uint16_t framing = SERIAL_8N1;
+        const char* framingName = "8N1";
         
         if (pin.indexOf(',') > 0) {
             // Parse "GP8,GP9" format
@@ -2832,9 +2787,12 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
             for (int i = 0; i < numConfiguredSensors; i++) {
                 Serial.printf("[DEBUG] Checking sensor %d: name='%s', protocol='%s', pin query='%s'\n", 
                              i, configuredSensors[i].name, configuredSensors[i].protocol, pin.c_str());
-                if (String(configuredSensors[i].name) == pin && strcmp(configuredSensors[i].protocol, "UART") == 0) {
+                if (String(configuredSensors[i].name) == pin && configuredSensors[i].protocolId == SensorProtocol::UART) {
                     txPin = configuredSensors[i].uartTxPin;
                     rxPin = configuredSensors[i].uartRxPin;
+                    if (configuredSensors[i].uartBaud > 0) baud = configuredSensors[i].uartBaud;
+                    framing = configuredSensors[i].uartConfig;
+                    framingName = configuredSensors[i].uartFraming;
                     Serial.printf("[DEBUG] Found UART sensor: TX=%d, RX=%d\n", txPin, rxPin);
                     break;
                 }
@@ -2861,11 +2819,11 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
             response = "UART Configuration:\\n";
             response += "TX Pin: GP" + String(txPin) + "\\n";
             response += "RX Pin: GP" + String(rxPin) + "\\n";
-            response += "Baud Rate: 9600 (default)\\n";
-            response += "Data Bits: 8\\n";
-            response += "Parity: None\\n";
-            response += "Stop Bits: 1\\n";
-            response += "Note: Use PlatformIO Serial2 for hardware UART on these pins";
+            response += "Baud Rate: " + String(baud) + "\\n";
+            response += "Framing: " + String(framingName) + "\\n";
+            int uart = uartIdForPins(txPin, rxPin);
+            response += uart < 0 ? String("Controller: none (not a UART TX/RX pair)")
+                                 : "Controller: UART" + String(uart) + (uart == 0 ? " (Serial1)" : " (Serial2)");
         } else if (command.startsWith("send ")) {
             String data = command.substring(5);
             
@@ -2884,16 +2842,16 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
                 logUARTTransaction("GP" + String(txPin) + ",GP" + String(rxPin), "TX", data);
                 
                 // Real UART implementation
-                if ((txPin == 0 && rxPin == 1) || (txPin == 12 && rxPin == 13) || 
-                    (txPin == 16 && rxPin == 17) || (txPin == 4 && rxPin == 5)) {
+                SerialUART* uart = uartSensorEngine.detachPort(txPin, rxPin);  // Core 1 is parked
+                if (uart != nullptr) {
                     
                     // Configure and send via hardware UART
-                    Serial1.setTX(txPin);
-                    Serial1.setRX(rxPin);
-                    Serial1.begin(9600);
+                    uart->setTX(txPin);
+                    uart->setRX(rxPin);
+                    uart->begin(baud, framing);
                     
                     // Send data as-is (don't add extra CR/LF if already present)
-                    Serial1.print(data);
+                    uart->print(data);
                     
                     response = "UART TX (GP" + String(txPin) + "): " + data;
                     
@@ -2902,8 +2860,8 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
                     String uartResponse = "";
                     unsigned long timeout = millis() + 1000;
                     while (millis() < timeout && uartResponse.length() < 100) {
-                        if (Serial1.available()) {
-                            char c = Serial1.read();
+                        if (uart->available()) {
+                            char c = uart->read();
                             uartResponse += c;
                             if (c == '\n' || c == '\r') break;
                         }
@@ -2917,7 +2875,7 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
                         response += "\nRX: (no response)";
                     }
                     
-                    Serial1.end();
+                    uart->end();
                 } else {
                     success = false;
                     response = "Error: Invalid UART pin combination for hardware UART";
@@ -2928,16 +2886,16 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
             }
         } else if (command == "read") {
             // Real UART read
-            if ((txPin == 0 && rxPin == 1) || (txPin == 12 && rxPin == 13) || 
-                (txPin == 16 && rxPin == 17) || (txPin == 4 && rxPin == 5)) {
+            SerialUART* uart = uartSensorEngine.detachPort(txPin, rxPin);  // Core 1 is parked
+            if (uart != nullptr) {
                 
-                Serial1.setTX(txPin);
-                Serial1.setRX(rxPin);
-                Serial1.begin(9600);
+                uart->setTX(txPin);
+                uart->setRX(rxPin);
+                uart->begin(baud, framing);
                 
                 String readData = "";
-                while (Serial1.available() && readData.length() < 100) {
-                    char c = Serial1.read();
+                while (uart->available() && readData.length() < 100) {
+                    char c = uart->read();
                     readData += c;
                 }
                 
@@ -2948,7 +2906,7 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
                     response = "UART RX (GP" + String(rxPin) + "): (no data available)";
                 }
                 
-                Serial1.end();
+                uart->end();
             } else {
                 success = false;
                 response = "Error: Invalid UART pin combination for hardware UART";
@@ -2958,15 +2916,15 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
             String testCmd = "R";
             logUARTTransaction("GP" + String(txPin) + ",GP" + String(rxPin), "TX", testCmd);
             
-            if ((txPin == 0 && rxPin == 1) || (txPin == 12 && rxPin == 13) || 
-                (txPin == 16 && rxPin == 17) || (txPin == 4 && rxPin == 5)) {
+            SerialUART* uart = uartSensorEngine.detachPort(txPin, rxPin);  // Core 1 is parked
+            if (uart != nullptr) {
                 
-                Serial1.setTX(txPin);
-                Serial1.setRX(rxPin);
-                Serial1.begin(9600);
+                uart->setTX(txPin);
+                uart->setRX(rxPin);
+                uart->begin(baud, framing);
                 
-                Serial1.print(testCmd);
-                Serial1.print("\r\n");
+                uart->print(testCmd);
+                uart->print("\r\n");
                 
                 response = "UART Test Command Sent: " + testCmd;
                 
@@ -2975,8 +2933,8 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
                 String testResp = "";
                 unsigned long timeout = millis() + 2000;
                 while (millis() < timeout && testResp.length() < 100) {
-                    if (Serial1.available()) {
-                        char c = Serial1.read();
+                    if (uart->available()) {
+                        char c = uart->read();
                         testResp += c;
                         if (c == '\n' || c == '\r') break;
                     }
@@ -2990,7 +2948,7 @@ void handlePOSTTerminalCommand(WiFiClient& client, String body) {
                     response += "\nResponse: (timeout - no response)";
                 }
                 
-                Serial1.end();
+                uart->end();
             } else {
                 success = false;
                 response = "Error: Invalid UART pin combination for hardware UART";
@@ -3026,8 +2984,14 @@ void loop() {
     static unsigned long lastStats = 0;
     static unsigned long webRequests = 0;
     static unsigned long loopCount = 0;
+    static uint32_t lastCore1Heartbeat = 0;
     unsigned long now = millis();
     
+    // Pick up the latest sensor values published by core 1
+    if (sensorSnapshot.read(sensorValues, sensorValuesGeneration)) {
+        storeSensorRegisters();
+    }
+    
     // Process web requests more frequently
     if (now - lastWebCheck >= 1) {  // Check every 1ms
         handleSimpleHTTP();
@@ -3036,23 +3000,23 @@ void loop() {
     
     // Print stats every 5 seconds
     if (now - lastStats >= 5000) {
-        Serial.println("\n========================================");
-        Serial.print("Device IP: ");
-        Serial.println(eth.localIP());
-        Serial.print("Hostname: ");
-        Serial.println(config.hostname);
-        Serial.println("----------------------------------------");
-        Serial.print("Loop: ");
-        Serial.print(loopCount / 5);
-        Serial.print(" Hz | RAM: ");
-        Serial.print(rp2040.getFreeHeap());
-        Serial.print(" | Web: ");
-        Serial.print(webRequests);
-        Serial.print("/5s | Modbus clients: ");
-        Serial.println(connectedClients);
-        
+        uint32_t core1Heartbeat = sensorCore.getHeartbeat();
+        LOG_INFO("\n========================================\n"
+                 "Device IP: %s\nHostname: %s\n"
+                 "----------------------------------------\n",
+                 eth.localIP().toString().c_str(), config.hostname);
+        LOG_INFO("Loop: %lu Hz | RAM: %d | Web: %lu/5s | Modbus clients: %d\n",
+                 loopCount / 5, rp2040.getFreeHeap(), webRequests, connectedClients);
+        LOG_INFO("Core1 (sensors): %lu Hz | Snapshots: %lu\n",
+                 (unsigned long)((core1Heartbeat - lastCore1Heartbeat) / 5),
+                 (unsigned long)sensorSnapshot.getPublishCount());
+        LOG_INFO("Modbus image: %lu writes/s | Version: %lu\n",
+                 (unsigned long)registerStore.getPublishRate(), (unsigned long)registerStore.getVersion());
+        lastCore1Heartbeat = core1Heartbeat;
+        
+#if LOG_LEVEL >= LOG_LEVEL_INFO
         // Print sensor readings
-        if (numConfiguredSensors > 0) {
+        if (numConfiguredSensors > 0 && logRuntimeLevel >= LOG_LEVEL_INFO) {
             Serial.println("----------------------------------------");
             Serial.println("SENSOR READINGS:");
             for (int i = 0; i < numConfiguredSensors; i++) {
@@ -3060,37 +3024,38 @@ void loop() {
                     Serial.printf("  [%d] %s: ", i, configuredSensors[i].name);
                     
                     // Check sensor type for multi-value display
-                    if (strcmp(configuredSensors[i].type, "LIS3DH") == 0) {
-                        Serial.printf("X=%.1f Y=%.1f Z=%.1f mg (Reg %d-%d)\n",
-                            configuredSensors[i].calibratedValue,
-                            configuredSensors[i].calibratedValueB,
-                            configuredSensors[i].calibratedValueC,
+                    if (configuredSensors[i].typeId == SensorType::LIS3DH) {
+                        Serial.printf("X=%.1f Y=%.1f Z=%.1f mg, RMS %.1f/%.1f/%.1f mg (Reg %d-%d)\n",
+                            sensorValues[i].calibratedValue,
+                            sensorValues[i].calibratedValueB,
+                            sensorValues[i].calibratedValueC,
+                            sensorValues[i].vibration.rms[0],
+                            sensorValues[i].vibration.rms[1],
+                            sensorValues[i].vibration.rms[2],
                             configuredSensors[i].modbusRegister,
-                            configuredSensors[i].modbusRegister + 2);
-                    } else if (strcmp(configuredSensors[i].type, "SHT30") == 0) {
+                            configuredSensors[i].modbusRegister + configuredSensors[i].modbusRegisterCount - 1);
+                    } else if (configuredSensors[i].typeId == SensorType::SHT30) {
                         Serial.printf("T=%.1f°C H=%.1f%% (Reg %d-%d)\n",
-                            configuredSensors[i].calibratedValue,
-                            configuredSensors[i].calibratedValueB,
+                            sensorValues[i].calibratedValue,
+                            sensorValues[i].calibratedValueB,
                             configuredSensors[i].modbusRegister,
                             configuredSensors[i].modbusRegister + 1);
                     } else {
                         Serial.printf("%.2f (Reg %d)\n",
-                            configuredSensors[i].calibratedValue,
+                            sensorValues[i].calibratedValue,
                             configuredSensors[i].modbusRegister);
                     }
                 }
             }
         }
-        Serial.println("========================================\n");
+#endif
+        LOG_INFO("========================================\n\n");
         
         loopCount = 0;
         webRequests = 0;
         lastStats = now;
     }
     
-    // Update bus operation queues
-    updateBusQueues();
-
     // Check for new client connections on the WiFi server (actually Ethernet via W5500lwIP)
     WiFiClient newClient = modbusServer.accept();
     loopCount++;
@@ -3100,8 +3065,7 @@ void loop() {
         bool clientAdded = false;
         for (int i = 0; i < MAX_MODBUS_CLIENTS; i++) {
             if (!modbusClients[i].connected) {
-                Serial.print("New client connected to slot ");
-                Serial.println(i);
+                LOG_INFO("New client connected to slot %d\n", i);
                 
                 // Store the client and mark as connected
                 modbusClients[i].client = newClient;
@@ -3111,26 +3075,13 @@ void loop() {
                 
                 // Accept the connection on this server instance
                 modbusClients[i].server.accept(modbusClients[i].client);
-                Serial.println("Modbus server accepted client connection");
+                LOG_DEBUG("Modbus server accepted client connection\n");
                 
                 // Log Modbus connection for network monitoring
                 String remoteIP = modbusClients[i].clientIP.toString();
                 String localIP = eth.localIP().toString() + ":" + String(config.modbusPort);
                 logNetworkTransaction("MODBUS", "CONNECT", localIP, remoteIP, "New Modbus TCP connection established");
                 
-                // Initialize coil states for this client to match current output states
-                for (int j = 0; j < 8; j++) {
-                    modbusClients[i].server.coilWrite(j, ioStatus.dOut[j]);
-                }
-                
-                // Restore global coil states (100-200) for all output pins
-                for (int reg = 100; reg <= 200; reg++) {
-                    if (globalCoilState[reg] != 0) {
-                        modbusClients[i].server.coilWrite(reg, globalCoilState[reg]);
-                        Serial.printf("Restored coil %d = %d to new client\n", reg, globalCoilState[reg]);
-                    }
-                }
-                
                 connectedClients++;
                 clientAdded = true;
                 digitalWrite(LED_BUILTIN, HIGH);  // Turn on LED when at least one client is connected
@@ -3139,7 +3090,7 @@ void loop() {
         }
         
         if (!clientAdded) {
-            Serial.println("No available slots for new client");
+            LOG_WARN("No available slots for new client\n");
             newClient.stop();
         }
     }
@@ -3150,19 +3101,18 @@ void loop() {
             if (modbusClients[i].client.connected()) {
                 // Poll this client's Modbus server
                 if (modbusClients[i].server.poll()) {
-                    Serial.println("Modbus server recieved new request");
+                    LOG_TRACE("Modbus server recieved new request\n");
                     
-                    // Log Modbus request for network monitoring
-                    String remoteIP = modbusClients[i].clientIP.toString();
-                    String localIP = eth.localIP().toString() + ":" + String(config.modbusPort);
-                    logNetworkTransaction("MODBUS", "RX", localIP, remoteIP, "Modbus Request (Function Code Processing)");
+                    // Log Modbus request for network monitoring (only builds the strings while watched)
+                    if (terminalWatchActive) {
+                        String remoteIP = modbusClients[i].clientIP.toString();
+                        String localIP = eth.localIP().toString() + ":" + String(config.modbusPort);
+                        logNetworkTransaction("MODBUS", "RX", localIP, remoteIP, "Modbus Request (Function Code Processing)");
+                    }
                 }
-                // Update IO for this specific client
-                updateIOForClient(i);
             } else {
                 // Client disconnected
-                Serial.print("Client disconnected from slot ");
-                Serial.println(i);
+                LOG_INFO("Client disconnected from slot %d\n", i);
                 
                 // Log Modbus disconnection for network monitoring
                 String remoteIP = modbusClients[i].clientIP.toString();
@@ -3180,18 +3130,19 @@ void loop() {
         }
     }
     
+    // Publish IO and sensor state to the shared register image (once, not per client)
+    updateModbusImage();
+    
     updateIOpins();
     // Evaluate I/O automation rules (NEW)
     evaluateIOAutomationRules();
     
-    // updateSensorReadings();  // DISABLED - SHT30 sensors now handled in queue system
-    handleEzoSensors(); // Handle EZO sensor communications with logging
-    handleLIS3DHSensors(); // Handle LIS3DH accelerometer polling using Adafruit library (low-freq, non-blocking)
+    // Sensor polling (bus queues, EZO, LIS3DH, analog) runs on core 1, see loop1()
     
     // Debug: Web server check (every 30 seconds)
     static unsigned long lastWebDebug = 0;
     if (millis() - lastWebDebug > 30000) {
-        Serial.println("Web server status: Listening on " + eth.localIP().toString() + ":80");
+        LOG_DEBUG("Web server status: Listening on %s:80\n", eth.localIP().toString().c_str());
         lastWebDebug = millis();
     }
 
@@ -3222,22 +3173,75 @@ void loop() {
         } else if (cmd.equalsIgnoreCase("sensors")) {
             Serial.println("=== SENSOR STATUS ===");
             Serial.printf("Configured sensors: %d\n", numConfiguredSensors);
-            Serial.printf("Queue sizes - I2C: %d, UART: %d, One-Wire: %d\n", i2cQueueSize, uartQueueSize, oneWireQueueSize);
+            Serial.printf("Scheduled phases pending: %d\n", sensorScheduler.getPendingCount());
+            uint32_t busLoadUsPerSec = 0;
             for (int i = 0; i < numConfiguredSensors; i++) {
                 Serial.printf("[%d] %s (%s): enabled=%s, lastRead=%lu, interval=%d\n", 
                              i, configuredSensors[i].name, configuredSensors[i].type,
                              configuredSensors[i].enabled ? "YES" : "NO",
-                             configuredSensors[i].lastReadTime, configuredSensors[i].updateInterval);
+                             sensorValues[i].lastReadTime, configuredSensors[i].updateInterval);
                 Serial.printf("    Protocol: %s, I2C: 0x%02X, ModbusReg: %d\n",
                              configuredSensors[i].protocol, configuredSensors[i].i2cAddress, configuredSensors[i].modbusRegister);
                 Serial.printf("    Raw: %.2f, Calibrated: %.2f, Modbus: %d\n",
-                             configuredSensors[i].rawValue, configuredSensors[i].calibratedValue, configuredSensors[i].modbusValue);
-                if (strcmp(configuredSensors[i].type, "SHT30") == 0) {
+                             sensorValues[i].rawValue, sensorValues[i].calibratedValue, sensorValues[i].modbusValue);
+                if (configuredSensors[i].typeId == SensorType::SHT30) {
                     Serial.printf("    Secondary - Raw: %.2f, Calibrated: %.2f, Modbus: %d\n",
-                                 configuredSensors[i].rawValueB, configuredSensors[i].calibratedValueB, configuredSensors[i].modbusValueB);
+                                 sensorValues[i].rawValueB, sensorValues[i].calibratedValueB, sensorValues[i].modbusValueB);
+                }
+                const SensorDriver* driver = configuredSensors[i].driver;
+                if (driver != nullptr) {
+                    Serial.printf("    Driver: %s, channels=%d, conversion=%lu ms, bus=%u us/read\n",
+                                 driver->name, driver->outputChannels,
+                                 (unsigned long)getSensorConversionMs(configuredSensors[i]), driver->busTimeUs);
+                    if (driver == &ezoDriver) {
+                        const EzoProbeStats& stats = sensorValues[i].ezoStats;
+                        Serial.printf("    EZO: reads=%lu, errors=%lu, latency=%lu ms (max %lu ms)",
+                                     (unsigned long)stats.reads, (unsigned long)stats.errors,
+                                     (unsigned long)stats.lastLatencyMs, (unsigned long)stats.maxLatencyMs);
+                        if (stats.compensated) {
+                            Serial.printf(", RT %.2f C from %s", stats.compensationC, configuredSensors[i].ezoCompensation);
+                        }
+                        Serial.println();
+                    }
+                    if (configuredSensors[i].enabled && configuredSensors[i].updateInterval > 0) {
+                        busLoadUsPerSec += (uint32_t)driver->busTimeUs * 1000 / configuredSensors[i].updateInterval;
+                    }
                 }
             }
+            Serial.printf("Planned bus time: %lu us/s\n", (unsigned long)busLoadUsPerSec);
+            const SensorRoundStats& rounds = sensorScheduler.getRoundStats();
+            Serial.printf("Batch window: %lu ms, rounds: %lu, last round: %lu ms (%d sensors, conversions sum %lu ms / max %lu ms)\n",
+                         (unsigned long)sensorScheduler.getBatchWindow(), (unsigned long)rounds.rounds,
+                         (unsigned long)rounds.lastDurationMs, rounds.lastSensors,
+                         (unsigned long)rounds.lastConversionSumMs, (unsigned long)rounds.lastConversionMaxMs);
             Serial.println("====================");
+        } else if (cmd.equalsIgnoreCase("onewire")) {
+            sensorCore.pause();
+            oneWireBusManager.printDiagnostics();
+            sensorCore.resume();
+        } else if (cmd.equalsIgnoreCase("uart")) {
+            sensorCore.pause();
+            uartSensorEngine.printDiagnostics();
+            sensorCore.resume();
+        } else if (cmd.equalsIgnoreCase("batch on") || cmd.equalsIgnoreCase("batch off")) {
+            sensorCore.pause();
+            sensorScheduler.setBatchWindow(cmd.equalsIgnoreCase("batch on") ? SENSOR_BATCH_WINDOW_MS : 0);
+            sensorCore.resume();
+            Serial.printf("[Scheduler] Batch rounds %s\n", sensorScheduler.getBatchWindow() > 0 ? "enabled" : "disabled");
+        } else if (cmd.startsWith("loglevel")) {
+            String level = cmd.substring(8);
+            level.trim();
+            if (level.length() > 0) {
+                int requested = level.toInt();
+                logRuntimeLevel = (uint8_t)constrain(requested, LOG_LEVEL_NONE, LOG_LEVEL);
+            }
+            Serial.printf("[Log] Level %s (compiled in: %s)\n", logLevelName(logRuntimeLevel), logLevelName(LOG_LEVEL));
+#ifdef NATIVE_BUILD
+        } else if (cmd.equalsIgnoreCase("calbench")) {
+            runCalibrationBenchmark();
+#endif
+        } else if (cmd.equalsIgnoreCase("fixbench")) {
+            runFixedPointBenchmark();
         } else if (cmd.equalsIgnoreCase("webtest")) {
             Serial.println("=== WEB SERVER TEST ===");
             Serial.println("Try accessing these URLs:");
@@ -3250,163 +3254,64 @@ void loop() {
         }
     }
 
-    // Watchdog timer reset
-    rp2040.wdt_reset();
+    // Watchdog timer reset - withheld if the sensor core stops making progress,
+    // so a hung bus on core 1 still resets the board
+    if (sensorCore.isAlive(WDT_TIMEOUT / 2)) {
+        rp2040.wdt_reset();
+    }
 }
 
-void initializeEzoSensors() {
-    if (ezoSensorsInitialized) return;
-    
-    for (int i = 0; i < numConfiguredSensors; i++) {
-        if (configuredSensors[i].enabled && strncmp(configuredSensors[i].type, "EZO-", 4) == 0) {
-            ezoSensors[i] = new Ezo_board(configuredSensors[i].i2cAddress, configuredSensors[i].name);
-            configuredSensors[i].cmdPending = false;
-            configuredSensors[i].lastCmdSent = 0;
-            memset(configuredSensors[i].response, 0, sizeof(configuredSensors[i].response));
-            Serial.printf("Initialized EZO sensor %s at I2C address 0x%02X\n", 
-                configuredSensors[i].name, configuredSensors[i].i2cAddress);
-        }
-    }
-    ezoSensorsInitialized = true;
+// ============================================================================
+// CORE 1 - SENSOR SUBSYSTEM
+// ============================================================================
+// All sensor bus traffic (scheduled I2C, UART and One-Wire sensors, EZO,
+// LIS3DH, analog sensors) and calibration run here, so Modbus and HTTP on
+// core 0 never wait for a bus. Results reach core 0 through sensorSnapshot.
+
+void setup1() {
+    // Sensor config, Wire and the bus manager are set up by core 0's setup()
+    sensorCore.waitForStart();
+    Serial.println("[Core1] Sensor subsystem running");
+    sensorSnapshot.publish(configuredSensors, numConfiguredSensors);
 }
 
-// Handle LIS3DH sensor polling (separate from I2C queue to use Adafruit library)
-// Non-blocking, low-frequency polling to avoid interfering with web server
-void handleLIS3DHSensors() {
-    static unsigned long lastLIS3DHCheck = 0;
-    unsigned long currentTime = millis();
+void loop1() {
+    // Park here while core 0 changes sensor config or uses a bus directly
+    if (sensorCore.checkpoint()) {
+        sensorSnapshot.publish(configuredSensors, numConfiguredSensors);
+    }
     
-    // Poll at very low frequency - only every 5 seconds max to avoid I2C contention
-    if (currentTime - lastLIS3DHCheck < 5000) return;
-    lastLIS3DHCheck = currentTime;
+    runSensorScheduler();
+    processVibrationSpectra();
+    updateAnalogSensors();
     
-    // Poll each enabled LIS3DH sensor
-    for (int i = 0; i < numConfiguredSensors; i++) {
-        if (!configuredSensors[i].enabled) continue;
-        if (strcmp(configuredSensors[i].type, "LIS3DH") != 0) continue;
-        
-        // Check if it's time for next reading based on updateInterval
-        if (currentTime - configuredSensors[i].lastReadTime < configuredSensors[i].updateInterval) {
-            continue;
-        }
-        
-        // Initialize Adafruit_LIS3DH if not already done for this sensor
-        if (lis3dhSensors[i] == nullptr) {
-            lis3dhSensors[i] = new Adafruit_LIS3DH();
-            
-            // Non-blocking initialization check
-            noInterrupts();  // Briefly disable interrupts for I2C
-            bool initOk = lis3dhSensors[i]->begin(configuredSensors[i].i2cAddress);
-            interrupts();
-            
-            if (!initOk) {
-                Serial.printf("[LIS3DH] Failed to init sensor %d (%s) at 0x%02X\n", 
-                             i, configuredSensors[i].name, configuredSensors[i].i2cAddress);
-                delete lis3dhSensors[i];
-                lis3dhSensors[i] = nullptr;
-                continue;
-            }
-            Serial.printf("[LIS3DH] Initialized sensor %d (%s) at 0x%02X\n", 
-                         i, configuredSensors[i].name, configuredSensors[i].i2cAddress);
-        }
-        
-        if (lis3dhSensors[i] == nullptr) continue;
-        
-        // Read accelerometer data - brief I2C transaction
-        noInterrupts();  // Disable interrupts during I2C read to prevent contention
-        lis3dhSensors[i]->read();
-        float x_mg = lis3dhSensors[i]->x;
-        float y_mg = lis3dhSensors[i]->y;
-        float z_mg = lis3dhSensors[i]->z;
-        interrupts();  // Re-enable interrupts
-        
-        // Store raw values (in milligravity)
-        configuredSensors[i].rawValue = x_mg;
-        configuredSensors[i].rawValueB = y_mg;
-        configuredSensors[i].rawValueC = z_mg;
-        
-        // Apply calibration to all three axes
-        float calibratedX = applyCalibration(x_mg, configuredSensors[i]);
-        float calibratedY = applyCalibrationB(y_mg, configuredSensors[i]);
-        float calibratedZ = applyCalibrationC(z_mg, configuredSensors[i]);
-        
-        configuredSensors[i].calibratedValue = calibratedX;
-        configuredSensors[i].calibratedValueB = calibratedY;
-        configuredSensors[i].calibratedValueC = calibratedZ;
-        
-        // Convert to Modbus values (scaled by 100 for decimal precision)
-        configuredSensors[i].modbusValue = (int)(calibratedX * 100);
-        configuredSensors[i].modbusValueB = (int)(calibratedY * 100);
-        configuredSensors[i].modbusValueC = (int)(calibratedZ * 100);
-        
-        // Update timestamp
-        configuredSensors[i].lastReadTime = currentTime;
-    }
+    sensorSnapshot.publishIfDue(configuredSensors, numConfiguredSensors);
 }
 
-
-void handleEzoSensors() {
-    static bool initialized = false;
-    
-    if (!initialized) {
-        initializeEzoSensors();
-        initialized = true;
-    }
-    
+// Read ANALOG_CUSTOM sensors - analog voltage sensors sampled directly on the ADC
+void updateAnalogSensors() {
     for (int i = 0; i < numConfiguredSensors; i++) {
-        if (!configuredSensors[i].enabled || strncmp(configuredSensors[i].type, "EZO-", 4) != 0) {
-            continue;
-        }
-        
-        if (ezoSensors[i] == nullptr) {
-            continue;
-        }
+        if (!configuredSensors[i].enabled) continue;
+        if (configuredSensors[i].protocolId != SensorProtocol::ANALOG) continue;
         
+        // Check if sensor should be read based on updateInterval
         unsigned long currentTime = millis();
+        if (currentTime - configuredSensors[i].lastReadTime < configuredSensors[i].updateInterval) continue;
         
-        // Check if we should log for terminal watch
-        bool shouldLog = terminalWatchActive && 
-                        (watchedProtocol.equalsIgnoreCase("I2C") || watchedProtocol.equalsIgnoreCase("EZO")) &&
-                        (watchedPin == "all" || watchedPin == String(configuredSensors[i].i2cAddress, HEX) || 
-                         watchedPin == String(configuredSensors[i].name));
-        
-        if (configuredSensors[i].cmdPending && (currentTime - configuredSensors[i].lastCmdSent > 1000)) {
-            ezoSensors[i]->receive_read_cmd();
-            
-            if (ezoSensors[i]->get_error() == Ezo_board::SUCCESS) {
-                float reading = ezoSensors[i]->get_last_received_reading();
-                snprintf(configuredSensors[i].response, sizeof(configuredSensors[i].response), "%.2f", reading);
-                Serial.printf("EZO sensor %s reading: %s\n", configuredSensors[i].name, configuredSensors[i].response);
-                
-                // Log for terminal watch
-                if (shouldLog) {
-                    logI2CTransaction(configuredSensors[i].i2cAddress, "RX", 
-                                    String(reading), String(configuredSensors[i].i2cAddress, HEX));
-                }
+        int pin = configuredSensors[i].analogPin;
+        if (pin >= 0 && pin < 32) {
+            uint32_t rawADC = analogRead(pin);
+            if (configuredSensors[i].fixedPoint) {
+                storeChannelQ16(configuredSensors[i], 0, q16FromAdc12Volts((uint16_t)rawADC));
             } else {
-                Serial.printf("EZO sensor %s error: %d\n", configuredSensors[i].name, ezoSensors[i]->get_error());
+                float voltage = (rawADC * 3.3) / 4095.0;
                 
-                // Log error for terminal watch
-                if (shouldLog) {
-                    logI2CTransaction(configuredSensors[i].i2cAddress, "ERR", 
-                                    "Error: " + String(ezoSensors[i]->get_error()), 
-                                    String(configuredSensors[i].i2cAddress, HEX));
-                }
-            }
-            
-            configuredSensors[i].cmdPending = false;
-        } 
-        else if (!configuredSensors[i].cmdPending && (currentTime - configuredSensors[i].lastCmdSent > 5000)) {
-            // Log command being sent for terminal watch
-            if (shouldLog) {
-                logI2CTransaction(configuredSensors[i].i2cAddress, "TX", 
-                                "READ", String(configuredSensors[i].i2cAddress, HEX));
+                configuredSensors[i].rawValue = voltage;
+                float calibrated = applyCalibration(voltage, configuredSensors[i]);
+                configuredSensors[i].calibratedValue = calibrated;
+                configuredSensors[i].modbusValue = (int)(calibrated * 100);
             }
-            
-            ezoSensors[i]->send_read_cmd();
-            configuredSensors[i].lastCmdSent = currentTime;
-            configuredSensors[i].cmdPending = true;
-            Serial.printf("Sent read command to EZO sensor %s\n", configuredSensors[i].name);
+            configuredSensors[i].lastReadTime = currentTime;
         }
     }
 }
@@ -3684,7 +3589,10 @@ void saveConfig() {
 void loadSensorConfig() {
     // Initialize sensors array
     numConfiguredSensors = 0;
-    memset(configuredSensors, 0, sizeof(configuredSensors));
+    // Value-initialize: SensorConfig holds CalibrationPrograms and is not memset-safe
+    for (int i = 0; i < MAX_SENSORS; i++) {
+        configuredSensors[i] = SensorConfig();
+    }
 
     if (!LittleFS.exists(SENSORS_FILE)) {
         return;
@@ -3759,6 +3667,10 @@ void loadSensorConfig() {
         cfg.dataPin = sensor["dataPin"] | -1;
         cfg.uartTxPin = sensor["uartTxPin"] | -1;
         cfg.uartRxPin = sensor["uartRxPin"] | -1;
+        cfg.uartBaud = sensor["uartBaud"] | sensor["baudRate"] | (int)UART_DEFAULT_BAUD;
+        const char* uartFraming = sensor["uartFraming"] | "8N1";
+        strncpy(cfg.uartFraming, uartFraming, sizeof(cfg.uartFraming)-1);
+        cfg.uartFraming[sizeof(cfg.uartFraming)-1] = '\0';
         cfg.analogPin = sensor["analogPin"] | -1;
         cfg.oneWirePin = sensor["oneWirePin"] | -1;
         cfg.digitalPin = sensor["digitalPin"] | -1;
@@ -3769,6 +3681,17 @@ void loadSensorConfig() {
         cfg.oneWireInterval = sensor["oneWireInterval"] | 5;
         cfg.oneWireConversionTime = sensor["oneWireConversionTime"] | 750;
         cfg.oneWireAutoMode = sensor["oneWireAutoMode"] | true;
+        const char* owRom = sensor["oneWireRom"] | "";
+        strncpy(cfg.oneWireRom, owRom, sizeof(cfg.oneWireRom)-1);
+        cfg.oneWireRom[sizeof(cfg.oneWireRom)-1] = '\0';
+        cfg.oneWireResolution = sensor["oneWireResolution"] | DS18B20_MAX_RESOLUTION;
+        cfg.fftPoints = sensor["fftPoints"] | VIBRATION_FFT_MIN_POINTS;
+        const char* bands = sensor["vibrationBands"] | "";
+        strncpy(cfg.vibrationBands, bands, sizeof(cfg.vibrationBands)-1);
+        cfg.vibrationBands[sizeof(cfg.vibrationBands)-1] = '\0';
+        const char* ezoComp = sensor["ezoCompensation"] | "";
+        strncpy(cfg.ezoCompensation, ezoComp, sizeof(cfg.ezoCompensation)-1);
+        cfg.ezoCompensation[sizeof(cfg.ezoCompensation)-1] = '\0';
 
         // Calibration nested or flat
         if (sensor.containsKey("calibration") && sensor["calibration"].is<JsonObject>()) {
@@ -3797,6 +3720,8 @@ void loadSensorConfig() {
         const char* exprC = sensor["calibrationExpressionC"] | "";
         strncpy(cfg.calibrationExpressionC, exprC, sizeof(cfg.calibrationExpressionC)-1);
         cfg.calibrationExpressionC[sizeof(cfg.calibrationExpressionC)-1] = '\0';
+        cfg.fixedPoint = sensor["fixedPoint"] | false;
+        compileSensorCalibration(cfg);
 
         // Data parsing
         if (sensor.containsKey("dataParsing") && sensor["dataParsing"].is<JsonObject>()) {
@@ -3832,8 +3757,7 @@ void loadSensorConfig() {
         }
 
         // Runtime init
-        cfg.cmdPending = false;
-        cfg.lastCmdSent = 0;
+        cfg.ezoStats = {};
         cfg.response[0] = '\0';
         cfg.calibrationData[0] = '\0';
 
@@ -3869,6 +3793,8 @@ void saveSensorConfig() {
         sensor["dataPin"] = configuredSensors[i].dataPin;
         sensor["uartTxPin"] = configuredSensors[i].uartTxPin;
         sensor["uartRxPin"] = configuredSensors[i].uartRxPin;
+        sensor["uartBaud"] = configuredSensors[i].uartBaud;
+        sensor["uartFraming"] = configuredSensors[i].uartFraming;
         sensor["analogPin"] = configuredSensors[i].analogPin;
         sensor["oneWirePin"] = configuredSensors[i].oneWirePin;
         sensor["digitalPin"] = configuredSensors[i].digitalPin;
@@ -3878,6 +3804,15 @@ void saveSensorConfig() {
         sensor["oneWireInterval"] = configuredSensors[i].oneWireInterval;
         sensor["oneWireConversionTime"] = configuredSensors[i].oneWireConversionTime;
         sensor["oneWireAutoMode"] = configuredSensors[i].oneWireAutoMode;
+        sensor["oneWireRom"] = configuredSensors[i].oneWireRom;
+        sensor["oneWireResolution"] = configuredSensors[i].oneWireResolution;
+        
+        // LIS3DH spectrum
+        sensor["fftPoints"] = configuredSensors[i].fftPoints;
+        sensor["vibrationBands"] = configuredSensors[i].vibrationBands;
+        
+        // EZO temperature compensation source
+        sensor["ezoCompensation"] = configuredSensors[i].ezoCompensation;
         
         // Calibration data
         sensor["calibrationOffset"] = configuredSensors[i].calibrationOffset;
@@ -3886,6 +3821,9 @@ void saveSensorConfig() {
         sensor["calibrationSlopeB"] = configuredSensors[i].calibrationSlopeB;
         sensor["calibrationOffsetC"] = configuredSensors[i].calibrationOffsetC;
         sensor["calibrationSlopeC"] = configuredSensors[i].calibrationSlopeC;
+        if (configuredSensors[i].fixedPoint) {
+            sensor["fixedPoint"] = true;
+        }
         
         // Include expression fields for all output channels
         if (strlen(configuredSensors[i].calibrationExpression) > 0) {
@@ -3928,6 +3866,125 @@ void saveSensorConfig() {
 
 // ==================== I/O Configuration Functions ====================
 
+// Comparison operator of a condition clause, "==" when unknown
+static TriggerCondition parseTriggerCondition(const char* condStr) {
+    if (strcmp(condStr, "!=") == 0) return TriggerCondition::NOT_EQUAL;
+    if (strcmp(condStr, "<") == 0) return TriggerCondition::LESS_THAN;
+    if (strcmp(condStr, ">") == 0) return TriggerCondition::GREATER_THAN;
+    if (strcmp(condStr, "<=") == 0) return TriggerCondition::LESS_EQUAL;
+    if (strcmp(condStr, ">=") == 0) return TriggerCondition::GREATER_EQUAL;
+    return TriggerCondition::EQUAL;
+}
+
+static const char* triggerConditionName(TriggerCondition condition) {
+    switch(condition) {
+        case TriggerCondition::NOT_EQUAL: return "!=";
+        case TriggerCondition::LESS_THAN: return "<";
+        case TriggerCondition::GREATER_THAN: return ">";
+        case TriggerCondition::LESS_EQUAL: return "<=";
+        case TriggerCondition::GREATER_EQUAL: return ">=";
+        default: return "==";
+    }
+}
+
+// Read one rule from io_config.json or a POST body. Pin rules and global rules
+// share the layout; only global rules carry action.targets.
+void parseRuleJSON(JsonObject rule, IORule& ioRule, uint8_t index) {
+    ioRule.id = rule["id"] | index;
+    ioRule.enabled = rule["enabled"] | true;
+    strlcpy(ioRule.description, rule["description"] | "", sizeof(ioRule.description));
+    ioRule.priority = rule["priority"] | index;
+    ioRule.lastExecutionTime = 0;
+    ioRule.trigger.lastTriggeredState = false;
+    ioRule.trigger.conditionCount = 0;
+
+    JsonObject trigger = rule["trigger"];
+    ioRule.trigger.onDelayMs = trigger["onDelayMs"] | 0;
+    ioRule.trigger.offDelayMs = trigger["offDelayMs"] | 0;
+    if (trigger["conditions"].is<JsonArray>()) {
+        for (JsonObject cond : trigger["conditions"].as<JsonArray>()) {
+            if (ioRule.trigger.conditionCount >= 3) break;
+
+            ConditionClause& clause = ioRule.trigger.conditions[ioRule.trigger.conditionCount];
+            clause.modbusRegister = cond["register"] | 0;
+            clause.triggerValue = cond["value"] | 0;
+            clause.hysteresis = cond["hysteresis"] | 0;
+            clause.condition = parseTriggerCondition(cond["condition"] | "==");
+
+            const char* opStr = cond["nextOperator"] | "AND";
+            clause.nextOperator = (strcmp(opStr, "OR") == 0) ? LogicOperator::OR : LogicOperator::AND;
+
+            ioRule.trigger.conditionCount++;
+        }
+    } else if (trigger.containsKey("modbusRegister")) {
+        // LEGACY: Support old single-condition format for backward compatibility
+        ConditionClause& clause = ioRule.trigger.conditions[0];
+        clause.modbusRegister = trigger["modbusRegister"] | 0;
+        clause.triggerValue = trigger["value"] | 0;
+        clause.hysteresis = 0;
+        clause.condition = parseTriggerCondition(trigger["condition"] | "==");
+        clause.nextOperator = LogicOperator::AND;
+        ioRule.trigger.conditionCount = 1;
+    }
+
+    JsonObject action = rule["action"];
+    const char* actionTypeStr = action["type"] | "set_output";
+    if (strcmp(actionTypeStr, "toggle_output") == 0) ioRule.action.type = IOActionType::TOGGLE_OUTPUT;
+    else if (strcmp(actionTypeStr, "pulse_output") == 0) ioRule.action.type = IOActionType::PULSE_OUTPUT;
+    else if (strcmp(actionTypeStr, "set_and_latch") == 0) ioRule.action.type = IOActionType::SET_AND_LATCH;
+    else if (strcmp(actionTypeStr, "follow_condition") == 0) ioRule.action.type = IOActionType::FOLLOW_CONDITION;
+    else ioRule.action.type = IOActionType::SET_OUTPUT;
+    ioRule.action.value = action["value"] | false;
+    ioRule.action.pulseDurationMs = action["pulseDuration"] | 100;
+
+    ioRule.action.targetCount = 0;
+    for (JsonVariant target : action["targets"].as<JsonArray>()) {
+        if (ioRule.action.targetCount >= IO_RULE_MAX_TARGETS) break;
+        ioRule.action.targetPins[ioRule.action.targetCount++] = target.as<uint8_t>();
+    }
+}
+
+// Write one rule in the layout parseRuleJSON() reads; targets only when the rule has any
+void writeRuleJSON(JsonObject ruleObj, const IORule& rule) {
+    ruleObj["id"] = rule.id;
+    ruleObj["enabled"] = rule.enabled;
+    ruleObj["description"] = rule.description;
+    ruleObj["priority"] = rule.priority;
+
+    JsonObject triggerObj = ruleObj.createNestedObject("trigger");
+    triggerObj["onDelayMs"] = rule.trigger.onDelayMs;
+    triggerObj["offDelayMs"] = rule.trigger.offDelayMs;
+    JsonArray conditionsArray = triggerObj.createNestedArray("conditions");
+    for (int c = 0; c < rule.trigger.conditionCount && c < 3; c++) {
+        const ConditionClause& clause = rule.trigger.conditions[c];
+        JsonObject condObj = conditionsArray.createNestedObject();
+        condObj["register"] = clause.modbusRegister;
+        condObj["value"] = clause.triggerValue;
+        condObj["hysteresis"] = clause.hysteresis;
+        condObj["condition"] = triggerConditionName(clause.condition);
+        condObj["nextOperator"] = (clause.nextOperator == LogicOperator::OR) ? "OR" : "AND";
+    }
+
+    JsonObject actionObj = ruleObj.createNestedObject("action");
+    const char* actionTypeStr;
+    switch(rule.action.type) {
+        case IOActionType::TOGGLE_OUTPUT: actionTypeStr = "toggle_output"; break;
+        case IOActionType::PULSE_OUTPUT: actionTypeStr = "pulse_output"; break;
+        case IOActionType::SET_AND_LATCH: actionTypeStr = "set_and_latch"; break;
+        case IOActionType::FOLLOW_CONDITION: actionTypeStr = "follow_condition"; break;
+        default: actionTypeStr = "set_output";
+    }
+    actionObj["type"] = actionTypeStr;
+    actionObj["value"] = rule.action.value;
+    actionObj["pulseDuration"] = rule.action.pulseDurationMs;
+    if (rule.action.targetCount > 0) {
+        JsonArray targets = actionObj.createNestedArray("targets");
+        for (uint8_t t = 0; t < rule.action.targetCount && t < IO_RULE_MAX_TARGETS; t++) {
+            targets.add(rule.action.targetPins[t]);
+        }
+    }
+}
+
 // Load I/O configuration from JSON file
 void loadIOConfig() {
     Serial.println("[IO Config] Loading I/O configuration...");
@@ -3936,6 +3993,8 @@ void loadIOConfig() {
     ioConfig.version = 1;
     ioConfig.pinCount = 0;
     ioConfig.globalRuleCount = 0;
+    ioConfig.globalScanPeriodMs = IO_GLOBAL_SCAN_PERIOD_MS;
+    globalRuleScan.setPeriod(ioConfig.globalScanPeriodMs * 1000UL);
     
     if (!LittleFS.exists(IO_CONFIG_FILE)) {
         Serial.println("[IO Config] No io_config.json found, using defaults");
@@ -3955,7 +4014,7 @@ void loadIOConfig() {
         return;
     }
     
-    StaticJsonDocument<4096> doc;
+    StaticJsonDocument<8192> doc;  // Pin rules plus up to MAX_IO_RULES global rules
     DeserializationError err = deserializeJson(doc, file);
     file.close();
     
@@ -3990,6 +4049,7 @@ void loadIOConfig() {
             ioPin.currentState = false;
             ioPin.previousState = false;
             ioPin.lastStateChange = 0;
+            ioPin.heldByGlobalRule = false;
             ioPin.ruleCount = 0;
             
             // Load rules for this pin (max 5 per pin)
@@ -3998,76 +4058,7 @@ void loadIOConfig() {
                 for (JsonObject rule : rulesArray) {
                     if (ioPin.ruleCount >= 5) break;
                     
-                    IORule& ioRule = ioPin.rules[ioPin.ruleCount];
-                    ioRule.id = rule["id"] | (uint8_t)ioPin.ruleCount;
-                    ioRule.enabled = rule["enabled"] | true;
-                    strlcpy(ioRule.description, rule["description"] | "", sizeof(ioRule.description));
-                    ioRule.priority = rule["priority"] | (uint8_t)ioPin.ruleCount;
-                    ioRule.lastExecutionTime = 0;
-                    
-                    // Load trigger (multi-condition support)
-                    if (rule.containsKey("trigger")) {
-                        JsonObject trigger = rule["trigger"];
-                        ioRule.trigger.lastTriggeredState = false;
-                        ioRule.trigger.conditionCount = 0;
-                        
-                        // Load conditions array (new format supports multiple conditions)
-                        if (trigger.containsKey("conditions") && trigger["conditions"].is<JsonArray>()) {
-                            JsonArray conditionsArray = trigger["conditions"];
-                            for (JsonObject cond : conditionsArray) {
-                                if (ioRule.trigger.conditionCount >= 3) break;
-                                
-                                ConditionClause& clause = ioRule.trigger.conditions[ioRule.trigger.conditionCount];
-                                clause.modbusRegister = cond["register"] | 0;
-                                clause.triggerValue = cond["value"] | 0;
-                                
-                                String condStr = cond["condition"] | "";
-                                if (condStr == "==") clause.condition = TriggerCondition::EQUAL;
-                                else if (condStr == "!=") clause.condition = TriggerCondition::NOT_EQUAL;
-                                else if (condStr == "<") clause.condition = TriggerCondition::LESS_THAN;
-                                else if (condStr == ">") clause.condition = TriggerCondition::GREATER_THAN;
-                                else if (condStr == "<=") clause.condition = TriggerCondition::LESS_EQUAL;
-                                else if (condStr == ">=") clause.condition = TriggerCondition::GREATER_EQUAL;
-                                else clause.condition = TriggerCondition::EQUAL;
-                                
-                                String opStr = cond["nextOperator"] | "AND";
-                                clause.nextOperator = (opStr == "OR") ? LogicOperator::OR : LogicOperator::AND;
-                                
-                                ioRule.trigger.conditionCount++;
-                            }
-                        } else if (trigger.containsKey("modbusRegister")) {
-                            // LEGACY: Support old single-condition format for backward compatibility
-                            ioRule.trigger.conditionCount = 1;
-                            ConditionClause& clause = ioRule.trigger.conditions[0];
-                            clause.modbusRegister = trigger["modbusRegister"] | 0;
-                            clause.triggerValue = trigger["value"] | 0;
-                            clause.nextOperator = LogicOperator::AND;
-                            
-                            String condStr = trigger["condition"] | "";
-                            if (condStr == "==") clause.condition = TriggerCondition::EQUAL;
-                            else if (condStr == "!=") clause.condition = TriggerCondition::NOT_EQUAL;
-                            else if (condStr == "<") clause.condition = TriggerCondition::LESS_THAN;
-                            else if (condStr == ">") clause.condition = TriggerCondition::GREATER_THAN;
-                            else if (condStr == "<=") clause.condition = TriggerCondition::LESS_EQUAL;
-                            else if (condStr == ">=") clause.condition = TriggerCondition::GREATER_EQUAL;
-                            else clause.condition = TriggerCondition::EQUAL;
-                        }
-                    }
-                    
-                    // Load action
-                    if (rule.containsKey("action")) {
-                        JsonObject action = rule["action"];
-                        String actionType = action["type"] | "";
-                        if (actionType == "set_output") ioRule.action.type = IOActionType::SET_OUTPUT;
-                        else if (actionType == "toggle_output") ioRule.action.type = IOActionType::TOGGLE_OUTPUT;
-                        else if (actionType == "pulse_output") ioRule.action.type = IOActionType::PULSE_OUTPUT;
-                        else if (actionType == "set_and_latch") ioRule.action.type = IOActionType::SET_AND_LATCH;
-                        else ioRule.action.type = IOActionType::SET_OUTPUT;
-                        
-                        ioRule.action.value = action["value"] | false;
-                        ioRule.action.pulseDurationMs = action["pulseDuration"] | 100;
-                    }
-                    
+                    parseRuleJSON(rule, ioPin.rules[ioPin.ruleCount], ioPin.ruleCount);
                     ioPin.ruleCount++;
                 }
             }
@@ -4076,14 +4067,27 @@ void loadIOConfig() {
         }
     }
     
-    Serial.printf("[IO Config] Loaded %d pins\n", ioConfig.pinCount);
+    // Cross-pin rules, run on a fixed period
+    ioConfig.globalScanPeriodMs = doc["globalScanPeriodMs"] | IO_GLOBAL_SCAN_PERIOD_MS;
+    if (ioConfig.globalScanPeriodMs == 0) ioConfig.globalScanPeriodMs = IO_GLOBAL_SCAN_PERIOD_MS;
+    for (JsonObject rule : doc["globalRules"].as<JsonArray>()) {
+        if (ioConfig.globalRuleCount >= MAX_IO_RULES) break;
+        parseRuleJSON(rule, ioConfig.globalRules[ioConfig.globalRuleCount], ioConfig.globalRuleCount);
+        ioConfig.globalRuleCount++;
+    }
+    
+    ruleEngine.compile(ioConfig);
+    globalRuleScan.setPeriod(ioConfig.globalScanPeriodMs * 1000UL);
+    Serial.printf("[IO Config] Loaded %d pins, %d active rules (%d global, every %d ms) on %d registers\n",
+                 ioConfig.pinCount, ruleEngine.getRuleCount(), ruleEngine.getGlobalCount(),
+                 ioConfig.globalScanPeriodMs, ruleEngine.getWatchedCount());
 }
 
 // Save I/O configuration to JSON file
 void saveIOConfig() {
     Serial.println("[IO Config] Saving I/O configuration...");
     
-    StaticJsonDocument<4096> doc;
+    StaticJsonDocument<8192> doc;
     doc["version"] = ioConfig.version;
     
     JsonArray pinsArray = doc.createNestedArray("pins");
@@ -4105,55 +4109,17 @@ void saveIOConfig() {
         if (ioPin.ruleCount > 0) {
             JsonArray rulesArray = pinObj.createNestedArray("rules");
             for (int j = 0; j < ioPin.ruleCount; j++) {
-                IORule& ioRule = ioPin.rules[j];
-                JsonObject ruleObj = rulesArray.createNestedObject();
-                
-                ruleObj["id"] = ioRule.id;
-                ruleObj["enabled"] = ioRule.enabled;
-                ruleObj["description"] = ioRule.description;
-                ruleObj["priority"] = ioRule.priority;
-                
-                // Save multi-condition trigger
-                JsonObject triggerObj = ruleObj.createNestedObject("trigger");
-                JsonArray conditionsArray = triggerObj.createNestedArray("conditions");
-                
-                for (int c = 0; c < ioRule.trigger.conditionCount && c < 3; c++) {
-                    ConditionClause& clause = ioRule.trigger.conditions[c];
-                    JsonObject condObj = conditionsArray.createNestedObject();
-                    
-                    condObj["register"] = clause.modbusRegister;
-                    condObj["value"] = clause.triggerValue;
-                    
-                    const char* condStr;
-                    switch(clause.condition) {
-                        case TriggerCondition::EQUAL: condStr = "=="; break;
-                        case TriggerCondition::NOT_EQUAL: condStr = "!="; break;
-                        case TriggerCondition::LESS_THAN: condStr = "<"; break;
-                        case TriggerCondition::GREATER_THAN: condStr = ">"; break;
-                        case TriggerCondition::LESS_EQUAL: condStr = "<="; break;
-                        case TriggerCondition::GREATER_EQUAL: condStr = ">="; break;
-                        default: condStr = "==";
-                    }
-                    condObj["condition"] = condStr;
-                    condObj["nextOperator"] = (clause.nextOperator == LogicOperator::OR) ? "OR" : "AND";
-                }
-                
-                JsonObject actionObj = ruleObj.createNestedObject("action");
-                const char* actionTypeStr;
-                switch(ioRule.action.type) {
-                    case IOActionType::SET_OUTPUT: actionTypeStr = "set_output"; break;
-                    case IOActionType::TOGGLE_OUTPUT: actionTypeStr = "toggle_output"; break;
-                    case IOActionType::PULSE_OUTPUT: actionTypeStr = "pulse_output"; break;
-                    case IOActionType::SET_AND_LATCH: actionTypeStr = "set_and_latch"; break;
-                    default: actionTypeStr = "set_output";
-                }
-                actionObj["type"] = actionTypeStr;
-                actionObj["value"] = ioRule.action.value;
-                actionObj["pulseDuration"] = ioRule.action.pulseDurationMs;
+                writeRuleJSON(rulesArray.createNestedObject(), ioPin.rules[j]);
             }
         }
     }
     
+    doc["globalScanPeriodMs"] = ioConfig.globalScanPeriodMs;
+    JsonArray globalArray = doc.createNestedArray("globalRules");
+    for (int j = 0; j < ioConfig.globalRuleCount; j++) {
+        writeRuleJSON(globalArray.createNestedObject(), ioConfig.globalRules[j]);
+    }
+    
     File file = LittleFS.open(IO_CONFIG_FILE, "w");
     if (!file) {
         Serial.println("[IO Config] Failed to open io_config.json for writing");
@@ -4169,6 +4135,28 @@ void saveIOConfig() {
 }
 
 // Apply I/O configuration to GPIO pins
+// Holding register values last seen by applyExternalModbusOverride() or written by the firmware.
+// The image persists across clients, so only a value that differs is a new client write.
+static uint16_t holdingRegisterSeen[MODBUS_HOLDING_REGISTERS];
+
+// Holding register write by the firmware itself, not taken as a client override
+static void writeOwnHoldingRegister(uint16_t address, uint16_t value) {
+    if (address >= MODBUS_HOLDING_REGISTERS) return;
+    if (modbusImage.holdingRegisterWrite(address, value)) {
+        holdingRegisterSeen[address] = value;
+    }
+}
+
+// Override register of every output pin: 1 while released, 0 while locked,
+// so a client writing 0 to a released pin is seen as a lock
+void resetPinOverrideRegisters() {
+    for (int i = 0; i < ioConfig.pinCount; i++) {
+        const IOPin& ioPin = ioConfig.pins[i];
+        if (ioPin.isInput || ioPin.modbusRegister == 0) continue;
+        writeOwnHoldingRegister(ioPin.modbusRegister, ioPin.externallyLocked ? 0 : 1);
+    }
+}
+
 void applyIOConfigToPins() {
     Serial.println("[IO Config] Applying pin configuration...");
     
@@ -4221,6 +4209,7 @@ void applyIOConfigToPins() {
         }
     }
     
+    resetPinOverrideRegisters();
     Serial.println("[IO Config] Pin configuration complete");
 }
 
@@ -4233,160 +4222,246 @@ void applyExternalModbusOverride() {
         if (ioPin.isInput) continue;
         
         // Check if pin has a configured Modbus register
-        if (ioPin.modbusRegister == 0) continue;
+        if (ioPin.modbusRegister == 0 || ioPin.modbusRegister >= MODBUS_HOLDING_REGISTERS) continue;
         
-        // Read the holding register value from any connected client
-        int32_t holdingRegValue = 0;
-        bool regFound = false;
-        
-        for (int c = 0; c < MAX_MODBUS_CLIENTS; c++) {
-            if (modbusClients[c].connected) {
-                holdingRegValue = modbusClients[c].server.holdingRegisterRead(ioPin.modbusRegister);
-                regFound = true;
-                break;
-            }
-        }
+        // Read the holding register value from the shared image (any client may have written it)
+        long holdingRegValue = modbusImage.holdingRegisterRead(ioPin.modbusRegister);
+        bool regWritten = holdingRegValue >= 0 && holdingRegValue != holdingRegisterSeen[ioPin.modbusRegister];
         
         // If external value was written, handle locking/unlocking logic
-        if (regFound) {
+        if (regWritten) {
+            holdingRegisterSeen[ioPin.modbusRegister] = (uint16_t)holdingRegValue;
             // LOCK: External write of 0 → disable rules, lock the pin OFF
             if (holdingRegValue == 0) {
                 if (!ioPin.externallyLocked) {
                     ioPin.externallyLocked = true;
                     ioPin.currentState = false;
                     digitalWrite(ioPin.gpPin, ioPin.invert ? HIGH : LOW);
-                    Serial.printf("[External Override] GP%d LOCKED OFF via register %d (write 0)\n",
-                                 ioPin.gpPin, ioPin.modbusRegister);
+                    LOG_INFO("[External Override] GP%d LOCKED OFF via register %d (write 0)\n",
+                            ioPin.gpPin, ioPin.modbusRegister);
                 }
             }
             // UNLOCK: Any non-zero write → unlock and restore rule control
             else if (ioPin.externallyLocked) {
                 ioPin.externallyLocked = false;
-                Serial.printf("[External Override] GP%d UNLOCKED via register %d (write %ld)\n",
-                             ioPin.gpPin, ioPin.modbusRegister, holdingRegValue);
+                LOG_INFO("[External Override] GP%d UNLOCKED via register %d (write %ld)\n",
+                        ioPin.gpPin, ioPin.modbusRegister, holdingRegValue);
                 // Don't apply the non-zero value; just unlock and let rules take over next cycle
+                ruleEngine.markPinDirty(i);
             }
         }
     }
 }
 
-// Helper function to read a register value from internal sources
-// Used by both rule evaluation and status reporting for consistency
+// Value of a register address from its source (see register_directory.h)
+// Used by rule evaluation, status reporting and sensor register publishing
 int32_t readRegisterValue(uint16_t registerNum) {
-    int32_t registerValue = 0;
-    
-    // Analog inputs (registers 0-2) from ADC
-    if (registerNum < 3) {
-        return ioStatus.aIn[registerNum];
+    const RegisterSource& source = registerDirectory.lookup(registerNum);
+    switch (source.kind) {
+        case RegisterSourceKind::ANALOG_INPUT:
+            return ioStatus.aIn[source.index];
+        case RegisterSourceKind::SENSOR: {
+            const SensorRuntimeValues& values = sensorValues[source.index];
+            if (source.channel == 0) return values.modbusValue;
+            if (source.channel == 1) return values.modbusValueB;
+            if (source.channel == 2) return values.modbusValueC;
+            // Feature block (LIS3DH RMS/peak/crest/spectrum), so rules can alarm on vibration
+            return vibrationFeatureRegister(values.vibration, source.channel - 3);
+        }
+        case RegisterSourceKind::COIL:
+            return modbusImage.coilRead(registerNum) == 1 ? 1 : 0;
+        case RegisterSourceKind::INPUT_REGISTER:
+            return registerStore.getInputRegister(registerNum);
+        default:
+            return 0;
     }
-    
-    // Check if this register belongs to a configured sensor
-    for (int s = 0; s < numConfiguredSensors; s++) {
-        if (!configuredSensors[s].enabled) continue;
-        
-        // Check primary register
-        if (configuredSensors[s].modbusRegister == registerNum) {
-            return configuredSensors[s].modbusValue;
-        }
-        
-        // Check secondary register (B)
-        if (configuredSensors[s].modbusRegister + 1 == registerNum) {
-            return configuredSensors[s].modbusValueB;
+}
+
+// Drive a rule output: GPIO (with inversion) on a change, and its state coil
+// The coil is written even when the state is unchanged, so it stays in step with the pin.
+// Returns false if the pin has no state coil (100-200).
+bool setRuleOutput(IOPin& ioPin, bool state) {
+    if (ioPin.currentState != state) {
+        ioPin.currentState = state;
+        digitalWrite(ioPin.gpPin, ioPin.invert ? !ioPin.currentState : ioPin.currentState);
+    }
+    if (ioPin.modbusRegister > 0 && ioPin.modbusRegister <= 200) {
+        modbusImage.coilWrite(ioPin.modbusRegister, ioPin.currentState ? 1 : 0);
+        return true;
+    }
+    return false;
+}
+
+// End of a PULSE_OUTPUT (called from ruleEngine.processTimers())
+void finishRulePulse(const CompiledRule& compiled) {
+    const char* description = compiled.pinIndex == RULE_ENGINE_GLOBAL
+                            ? ioConfig.globalRules[compiled.ruleIndex].description
+                            : ioConfig.pins[compiled.pinIndex].rules[compiled.ruleIndex].description;
+
+    for (uint8_t t = 0; t < compiled.targetCount; t++) {
+        if (!(compiled.pulseDriven & (1 << t))) continue;
+        uint8_t p = compiled.targets[t];
+        IOPin& ioPin = ioConfig.pins[p];
+        // SCADA owns a locked pin and an interlock owns a held one; neither is ours to restore
+        if (ioPin.externallyLocked || ioPin.heldByGlobalRule) continue;
+
+        setRuleOutput(ioPin, compiled.pulseRestore & (1 << t));
+        LOG_INFO("[IO Rule] PULSE_OUTPUT: Rule '%s' GP%d pulse ended, back to %s\n",
+                description, ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
+
+        // Level rules on the same pin get to re-assert themselves
+        ruleEngine.markPinDirty(p);
+    }
+}
+
+/**
+ * One fixed-period scan of the global rules
+ * Rules run highest priority first and the first one to act on a pin owns
+ * it for the scan (ruleEngine.claim()), so the outcome does not depend on
+ * configuration order or loop timing. A FOLLOW_CONDITION rule acts on
+ * every scan and holds its pins against the pin rules; edge actions act on
+ * the scan their conditions become TRUE, so a lower-priority FOLLOW rule
+ * takes the pin back on the next scan. Externally locked pins are left alone.
+ */
+void runGlobalRules(uint32_t now) {
+    uint32_t heldMask = 0;
+    ruleEngine.beginClaims();
+
+    uint16_t first = ruleEngine.getGlobalFirst();
+    for (uint16_t r = first; r < first + ruleEngine.getGlobalCount(); r++) {
+        const CompiledRule& compiled = ruleEngine.getRule(r);
+        IORule& rule = ioConfig.globalRules[compiled.ruleIndex];
+        bool triggered = ruleEngine.condition(r, now);
+
+        if (rule.action.type == IOActionType::FOLLOW_CONDITION) {
+            for (uint8_t t = 0; t < compiled.targetCount; t++) {
+                uint8_t p = compiled.targets[t];
+                IOPin& ioPin = ioConfig.pins[p];
+                if (ioPin.externallyLocked || !ruleEngine.claim(p, r)) continue;
+                heldMask |= 1UL << p;
+                if (ioPin.currentState != triggered) {
+                    setRuleOutput(ioPin, triggered);
+                    LOG_INFO("[IO Rule] GLOBAL FOLLOW: Rule %d '%s' GP%d = %s\n",
+                            rule.id, rule.description, ioPin.gpPin, triggered ? "HIGH" : "LOW");
+                }
+            }
+            continue;
         }
-        
-        // Check tertiary register (C)
-        if (configuredSensors[s].modbusRegister + 2 == registerNum) {
-            return configuredSensors[s].modbusValueC;
+
+        // Edge-triggered actions, as for pin rules
+        if (!triggered) {
+            rule.trigger.lastTriggeredState = false;
+            continue;
         }
-    }
-    
-    // If not a sensor register, try coil/output range
-    if (registerNum >= 100 && registerNum <= 200) {
-        for (int client = 0; client < MAX_MODBUS_CLIENTS; client++) {
-            if (modbusClients[client].connected) {
-                return modbusClients[client].server.coilRead(registerNum) ? 1 : 0;
+        if (rule.trigger.lastTriggeredState) continue;
+        rule.trigger.lastTriggeredState = true;
+        rule.lastExecutionTime = now;
+        LOG_INFO("\n[IO Rule] ✓✓✓ GLOBAL RULE FIRED (RISING EDGE): Rule %d '%s'\n", rule.id, rule.description);
+
+        uint8_t driven = 0;
+        uint8_t before = 0;
+        for (uint8_t t = 0; t < compiled.targetCount; t++) {
+            uint8_t p = compiled.targets[t];
+            IOPin& ioPin = ioConfig.pins[p];
+            if (ioPin.externallyLocked || !ruleEngine.claim(p, r)) {
+                LOG_DEBUG("[IO Rule]   - GP%d not driven (locked or claimed by a higher-priority rule)\n", ioPin.gpPin);
+                continue;
+            }
+            driven |= 1 << t;
+            if (ioPin.currentState) before |= 1 << t;
+
+            switch (rule.action.type) {
+                case IOActionType::SET_AND_LATCH:
+                    ioPin.latched = true;
+                    setRuleOutput(ioPin, rule.action.value);
+                    break;
+                case IOActionType::TOGGLE_OUTPUT:
+                    setRuleOutput(ioPin, !ioPin.currentState);
+                    break;
+                case IOActionType::PULSE_OUTPUT:
+                    setRuleOutput(ioPin, true);
+                    break;
+                default:
+                    setRuleOutput(ioPin, rule.action.value);
+                    break;
             }
+            LOG_INFO("[IO Rule]   GP%d = %s\n", ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
         }
-    }
-    
-    // Fall back to Modbus client if still not found
-    for (int client = 0; client < MAX_MODBUS_CLIENTS; client++) {
-        if (modbusClients[client].connected) {
-            return modbusClients[client].server.inputRegisterRead(registerNum);
+        if (rule.action.type == IOActionType::PULSE_OUTPUT && driven) {
+            ruleEngine.startPulse(r, driven, before, rule.action.pulseDurationMs, now);
         }
     }
-    
-    return 0;  // Default if not found
+
+    // Pins no longer held go back to their own rules
+    for (uint8_t p = 0; p < ioConfig.pinCount; p++) {
+        bool held = heldMask & (1UL << p);
+        if (ioConfig.pins[p].heldByGlobalRule && !held) ruleEngine.markPinDirty(p);
+        ioConfig.pins[p].heldByGlobalRule = held;
+    }
 }
 
 // Evaluate and execute I/O automation rules
 void evaluateIOAutomationRules() {
     uint32_t now = millis();
     
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
     static bool firstRuleEval = true;
     if (firstRuleEval) {
-        Serial.printf("\n\n[IO Rule] ⚠️  FIRST RULE EVALUATION CYCLE\n");
-        Serial.printf("[IO Rule] Configured sensors:\n");
+        LOG_DEBUG("\n\n[IO Rule] ⚠️  FIRST RULE EVALUATION CYCLE\n");
+        LOG_DEBUG("[IO Rule] Configured sensors:\n");
         for (int s = 0; s < numConfiguredSensors; s++) {
             if (configuredSensors[s].enabled) {
-                Serial.printf("[IO Rule]   - '%s' (type=%s) reg %d = %ld\n",
-                             configuredSensors[s].name, configuredSensors[s].type,
-                             configuredSensors[s].modbusRegister, configuredSensors[s].modbusValue);
+                LOG_DEBUG("[IO Rule]   - '%s' (type=%s) reg %d = %ld\n",
+                         configuredSensors[s].name, configuredSensors[s].type,
+                         configuredSensors[s].modbusRegister, sensorValues[s].modbusValue);
             }
         }
-        Serial.printf("[IO Rule] IO pins with rules:\n");
+        LOG_DEBUG("[IO Rule] IO pins with rules:\n");
         for (int i = 0; i < ioConfig.pinCount; i++) {
             if (ioConfig.pins[i].ruleCount > 0) {
-                Serial.printf("[IO Rule]   - GP%d (currentState=%s, initialState=%s) - %d rules\n",
-                             ioConfig.pins[i].gpPin,
-                             ioConfig.pins[i].currentState ? "HIGH" : "LOW",
-                             ioConfig.pins[i].initialState ? "HIGH" : "LOW",
-                             ioConfig.pins[i].ruleCount);
+                LOG_DEBUG("[IO Rule]   - GP%d (currentState=%s, initialState=%s) - %d rules\n",
+                         ioConfig.pins[i].gpPin,
+                         ioConfig.pins[i].currentState ? "HIGH" : "LOW",
+                         ioConfig.pins[i].initialState ? "HIGH" : "LOW",
+                         ioConfig.pins[i].ruleCount);
             }
         }
         firstRuleEval = false;
-        Serial.printf("[IO Rule] ========================================\n\n");
+        LOG_DEBUG("[IO Rule] ========================================\n\n");
     }
+#endif
     
     // First check for external Modbus overrides (coexistence model)
     // If SCADA writes to holding register, that takes priority over rules
     applyExternalModbusOverride();
+
+    // Expired on/off delays mark their pins dirty; expired pulses restore their outputs
+    ruleEngine.processTimers(now, finishRulePulse);
+
+    // One read per watched register; only rules whose inputs changed are re-evaluated
+    ruleEngine.scan(readRegisterValue, now);
     
     for (int i = 0; i < ioConfig.pinCount; i++) {
         IOPin& ioPin = ioConfig.pins[i];
         
-        // Skip input pins, pins without rules, or externally locked pins
-        if (ioPin.isInput || ioPin.ruleCount == 0 || ioPin.externallyLocked) continue;
-        
-        // Sort rules by priority (lower = higher priority)
-        for (int j = 0; j < ioPin.ruleCount - 1; j++) {
-            for (int k = j + 1; k < ioPin.ruleCount; k++) {
-                if (ioPin.rules[k].priority < ioPin.rules[j].priority) {
-                    IORule temp = ioPin.rules[j];
-                    ioPin.rules[j] = ioPin.rules[k];
-                    ioPin.rules[k] = temp;
-                }
-            }
-        }
+        // Externally locked pins, and pins held by a global rule, keep their dirty flag
+        if (ioPin.externallyLocked || ioPin.heldByGlobalRule) continue;
+        if (!ruleEngine.takePinDirty(i)) continue;
         
-        // Evaluate each rule in priority order
-        for (int j = 0; j < ioPin.ruleCount; j++) {
+        // Apply the pin's rules in priority order (sorted by ruleEngine.compile())
+        const CompiledPin& compiledPin = ruleEngine.getPin(i);
+        for (uint16_t r = compiledPin.first; r < compiledPin.first + compiledPin.count; r++) {
+            const CompiledRule& compiled = ruleEngine.getRule(r);
+            int j = compiled.ruleIndex;
             IORule& rule = ioPin.rules[j];
-            if (!rule.enabled) continue;
-            
-            Serial.printf("\n[IO Rule] ========== EVALUATING RULE %d for GP%d ==========\n", j, ioPin.gpPin);
             
-            // ===== MULTI-CONDITION EVALUATION =====
-            // Evaluate all conditions and combine with AND/OR logic
-            bool conditionsMet = true;  // Start with true for AND logic
-            bool firstCondition = true;
-            int32_t lastRegisterValue = 0;  // For logging FOLLOW_CONDITION
-            
-            for (int c = 0; c < rule.trigger.conditionCount && c < 3; c++) {
-                ConditionClause& clause = rule.trigger.conditions[c];
-                
-                Serial.printf("[IO Rule] Condition %d: Register %d %s %ld ?\n", c,
-                             clause.modbusRegister,
+#if LOG_LEVEL >= LOG_LEVEL_TRACE
+            if (compiled.dirty) {
+                LOG_TRACE("\n[IO Rule] ========== EVALUATING RULE %d for GP%d ==========\n", j, ioPin.gpPin);
+                for (int c = 0; c < compiled.clauseCount; c++) {
+                    const ConditionClause& clause = rule.trigger.conditions[c];
+                    LOG_TRACE("[IO Rule] Condition %d: Register %d = %ld %s %ld\n", c,
+                             clause.modbusRegister, ruleEngine.getValue(compiled.clauses[c].watch),
                              clause.condition == TriggerCondition::EQUAL ? "==" :
                              clause.condition == TriggerCondition::GREATER_THAN ? ">" :
                              clause.condition == TriggerCondition::LESS_THAN ? "<" :
@@ -4394,118 +4469,34 @@ void evaluateIOAutomationRules() {
                              clause.condition == TriggerCondition::GREATER_EQUAL ? ">=" :
                              clause.condition == TriggerCondition::LESS_EQUAL ? "<=" : "?",
                              clause.triggerValue);
-                
-                // Read register value using helper function
-                int32_t registerValue = readRegisterValue(clause.modbusRegister);
-                Serial.printf("[IO Rule]   → Read register %d = %ld\n", clause.modbusRegister, registerValue);
-                
-                // Save first register value for logging
-                if (c == 0) {
-                    lastRegisterValue = registerValue;
                 }
-                
-                
-                // Evaluate this condition
-                bool clauseTriggered = false;
-                switch(clause.condition) {
-                    case TriggerCondition::EQUAL:
-                        clauseTriggered = (registerValue == clause.triggerValue);
-                        break;
-                    case TriggerCondition::NOT_EQUAL:
-                        clauseTriggered = (registerValue != clause.triggerValue);
-                        break;
-                    case TriggerCondition::LESS_THAN:
-                        clauseTriggered = (registerValue < clause.triggerValue);
-                        break;
-                    case TriggerCondition::GREATER_THAN:
-                        clauseTriggered = (registerValue > clause.triggerValue);
-                        break;
-                    case TriggerCondition::LESS_EQUAL:
-                        clauseTriggered = (registerValue <= clause.triggerValue);
-                        break;
-                    case TriggerCondition::GREATER_EQUAL:
-                        clauseTriggered = (registerValue >= clause.triggerValue);
-                        break;
-                }
-                
-                Serial.printf("[IO Rule]   → Result: %ld %s %ld = %s\n",
-                             registerValue,
-                             clause.condition == TriggerCondition::EQUAL ? "==" :
-                             clause.condition == TriggerCondition::GREATER_THAN ? ">" :
-                             clause.condition == TriggerCondition::LESS_THAN ? "<" :
-                             clause.condition == TriggerCondition::NOT_EQUAL ? "!=" :
-                             clause.condition == TriggerCondition::GREATER_EQUAL ? ">=" :
-                             clause.condition == TriggerCondition::LESS_EQUAL ? "<=" : "?",
-                             clause.triggerValue,
-                             clauseTriggered ? "TRUE" : "FALSE");
-                
-                // Combine with previous conditions using AND/OR logic
-                if (firstCondition) {
-                    conditionsMet = clauseTriggered;
-                    firstCondition = false;
-                } else {
-                    // Use the operator from the PREVIOUS clause
-                    LogicOperator op = rule.trigger.conditions[c-1].nextOperator;
-                    if (op == LogicOperator::AND) {
-                        conditionsMet = conditionsMet && clauseTriggered;
-                    } else {  // OR
-                        conditionsMet = conditionsMet || clauseTriggered;
-                    }
-                }
-                
-                Serial.printf("[IO Rule DEBUG] GP%d Rule '%s' Condition %d: Reg%d %s %ld = %s\n",
-                             ioPin.gpPin, rule.description, c, clause.modbusRegister,
-                             clause.condition == TriggerCondition::EQUAL ? "==" :
-                             clause.condition == TriggerCondition::GREATER_THAN ? ">" : "?",
-                             clause.triggerValue, clauseTriggered ? "TRUE" : "FALSE");
             }
+#endif
             
-            bool triggered = conditionsMet;
+            // Conditions after the rule's on/off delay
+            bool triggered = ruleEngine.condition(r, now);
             
             // ===== ACTION EXECUTION =====
             // For FOLLOW_CONDITION, always update the pin state (don't wait for edge)
             if (rule.action.type == IOActionType::FOLLOW_CONDITION) {
                 // FOLLOW_CONDITION: Set pin = condition result
                 bool newState = triggered;
-                Serial.printf("[IO Rule] FOLLOW_CONDITION ACTION: Condition is %s → Pin should be %s\n",
-                             triggered ? "MET" : "NOT MET", newState ? "HIGH" : "LOW");
+                LOG_DEBUG("[IO Rule] FOLLOW_CONDITION ACTION: Condition is %s → Pin should be %s\n",
+                         triggered ? "MET" : "NOT MET", newState ? "HIGH" : "LOW");
                 
-                if (ioPin.currentState != newState) {
-                    ioPin.currentState = newState;
-                    digitalWrite(ioPin.gpPin, ioPin.invert ? !ioPin.currentState : ioPin.currentState);
-                    Serial.printf("[IO Rule]   ✓ GPIO STATE CHANGED: GP%d = %s (physical: %s)\n",
-                                 ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW",
-                                 (ioPin.invert ? !ioPin.currentState : ioPin.currentState) ? "HIGH" : "LOW");
-                } else {
-                    Serial.printf("[IO Rule]   - No GPIO change needed for GP%d (already %s)\n",
-                                 ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
-                }
+                bool changed = ioPin.currentState != newState;
                 
-                // ALWAYS write state to Modbus coil for continuous monitoring
-                if (ioPin.modbusRegister > 0 && ioPin.modbusRegister <= 200) {
-                    // Write to global coil store (persists across connections)
-                    uint16_t coilValue = ioPin.currentState ? 1 : 0;
-                    globalCoilState[ioPin.modbusRegister] = coilValue;
-                    Serial.printf("[IO Rule]   ✓ COIL STORED: Register %d = %d (global store)\n",
-                                 ioPin.modbusRegister, coilValue);
-                    
-                    // Also write to all connected clients
-                    bool coilWritten = false;
-                    for (int c = 0; c < MAX_MODBUS_CLIENTS; c++) {
-                        if (modbusClients[c].connected) {
-                            modbusClients[c].server.coilWrite(ioPin.modbusRegister, coilValue);
-                            Serial.printf("[IO Rule]   ✓ COIL WRITE: Register %d = %d (client %d)\n",
-                                         ioPin.modbusRegister, coilValue, c);
-                            coilWritten = true;
-                            break;
-                        }
-                    }
-                    if (!coilWritten) {
-                        Serial.printf("[IO Rule]   ⚠ NO COIL WRITE: No Modbus client connected for GP%d reg %d\n",
-                                     ioPin.gpPin, ioPin.modbusRegister);
-                    }
+                // ALWAYS writes state to the Modbus coil for continuous monitoring
+                if (!setRuleOutput(ioPin, newState)) {
+                    LOG_WARN_EVERY(10000, "[IO Rule]   ⚠ NO COIL: GP%d has no Modbus register configured\n", ioPin.gpPin);
+                }
+                if (changed) {
+                    LOG_INFO("[IO Rule]   ✓ GPIO STATE CHANGED: GP%d = %s (physical: %s)\n",
+                            ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW",
+                            (ioPin.invert ? !ioPin.currentState : ioPin.currentState) ? "HIGH" : "LOW");
                 } else {
-                    Serial.printf("[IO Rule]   ⚠ NO COIL: GP%d has no Modbus register configured\n", ioPin.gpPin);
+                    LOG_TRACE("[IO Rule]   - No GPIO change needed for GP%d (already %s)\n",
+                             ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
                 }
             }
             // For other action types, only trigger on rising edge
@@ -4513,96 +4504,40 @@ void evaluateIOAutomationRules() {
                 rule.trigger.lastTriggeredState = true;
                 rule.lastExecutionTime = now;
                 
-                Serial.printf("\n[IO Rule] ✓✓✓ RULE FIRED (RISING EDGE): GP%d Rule %d '%s' - Condition went from FALSE→TRUE\n",
-                             ioPin.gpPin, j, rule.description);
+                LOG_INFO("\n[IO Rule] ✓✓✓ RULE FIRED (RISING EDGE): GP%d Rule %d '%s' - Condition went from FALSE→TRUE\n",
+                        ioPin.gpPin, j, rule.description);
                 
                 switch(rule.action.type) {
                     case IOActionType::SET_OUTPUT:
-                        ioPin.currentState = rule.action.value;
-                        digitalWrite(ioPin.gpPin, ioPin.invert ? !ioPin.currentState : ioPin.currentState);
-                        Serial.printf("[IO Rule] SET_OUTPUT: Rule '%s' GP%d = %s\n", 
-                                     rule.description, ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
-                        
-                        // Write to Modbus coil
-                        if (ioPin.modbusRegister > 0 && ioPin.modbusRegister <= 200) {
-                            // Write to global coil store (persists across connections)
-                            globalCoilState[ioPin.modbusRegister] = ioPin.currentState ? 1 : 0;
-                            Serial.printf("[IO Rule]   ✓ SET_OUTPUT: Stored coil %d = %d in global store\n",
-                                         ioPin.modbusRegister, ioPin.currentState ? 1 : 0);
-                            
-                            // Also write to all connected clients
-                            bool coilWritten = false;
-                            for (int c = 0; c < MAX_MODBUS_CLIENTS; c++) {
-                                if (modbusClients[c].connected) {
-                                    modbusClients[c].server.coilWrite(ioPin.modbusRegister, ioPin.currentState ? 1 : 0);
-                                    Serial.printf("[IO Rule]   ✓ SET_OUTPUT: Wrote coil %d = %d for GP%d (client %d)\n",
-                                                 ioPin.modbusRegister, ioPin.currentState ? 1 : 0, ioPin.gpPin, c);
-                                    coilWritten = true;
-                                    break;
-                                }
-                            }
-                            if (!coilWritten) {
-                                Serial.printf("[IO Rule]   ⚠ SET_OUTPUT: WARNING - No Modbus client connected, but coil stored globally\n");
-                            }
-                        } else {
-                            Serial.printf("[IO Rule]   ⚠ SET_OUTPUT: WARNING - Invalid or no Modbus register for GP%d\n", ioPin.gpPin);
+                        if (!setRuleOutput(ioPin, rule.action.value)) {
+                            LOG_WARN_EVERY(10000, "[IO Rule]   ⚠ SET_OUTPUT: WARNING - Invalid or no Modbus register for GP%d\n", ioPin.gpPin);
                         }
+                        LOG_INFO("[IO Rule] SET_OUTPUT: Rule '%s' GP%d = %s\n", 
+                                rule.description, ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
                         break;
                     
                     case IOActionType::TOGGLE_OUTPUT:
-                        ioPin.currentState = !ioPin.currentState;
-                        digitalWrite(ioPin.gpPin, ioPin.invert ? !ioPin.currentState : ioPin.currentState);
-                        Serial.printf("[IO Rule] TOGGLE_OUTPUT: Rule '%s' GP%d toggled to %s\n",
-                                     rule.description, ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
-                        if (ioPin.modbusRegister > 0) {
-                            for (int c = 0; c < MAX_MODBUS_CLIENTS; c++) {
-                                if (modbusClients[c].connected) {
-                                    modbusClients[c].server.coilWrite(ioPin.modbusRegister, ioPin.currentState ? 1 : 0);
-                                    Serial.printf("[IO Rule] TOGGLE_OUTPUT: Wrote coil %d = %d for GP%d\n",
-                                                 ioPin.modbusRegister, ioPin.currentState ? 1 : 0, ioPin.gpPin);
-                                    break;
-                                }
-                            }
-                        }
+                        setRuleOutput(ioPin, !ioPin.currentState);
+                        LOG_INFO("[IO Rule] TOGGLE_OUTPUT: Rule '%s' GP%d toggled to %s\n",
+                                rule.description, ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
                         break;
                     
                     case IOActionType::PULSE_OUTPUT:
-                        digitalWrite(ioPin.gpPin, ioPin.invert ? LOW : HIGH);
-                        Serial.printf("[IO Rule] PULSE_OUTPUT: Rule '%s' GP%d pulsed for %ldms\n",
-                                     rule.description, ioPin.gpPin, rule.action.pulseDurationMs);
+                        // finishRulePulse() restores the previous state when the timer expires;
+                        // a retrigger while pulsing extends the pulse
+                        ruleEngine.startPulse(r, 1, ioPin.currentState ? 1 : 0, rule.action.pulseDurationMs, now);
+                        setRuleOutput(ioPin, true);
+                        LOG_INFO("[IO Rule] PULSE_OUTPUT: Rule '%s' GP%d pulsed for %lums\n",
+                                rule.description, ioPin.gpPin, (unsigned long)rule.action.pulseDurationMs);
                         break;
                     
                     case IOActionType::SET_AND_LATCH:
-                        ioPin.currentState = rule.action.value;
                         ioPin.latched = true;
-                        digitalWrite(ioPin.gpPin, ioPin.invert ? !ioPin.currentState : ioPin.currentState);
-                        Serial.printf("[IO Rule] SET_AND_LATCH: Rule '%s' GP%d latched to %s\n",
-                                     rule.description, ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
-                        
-                        // Write to Modbus coil
-                        if (ioPin.modbusRegister > 0 && ioPin.modbusRegister <= 200) {
-                            // Write to global coil store (persists across connections)
-                            globalCoilState[ioPin.modbusRegister] = ioPin.currentState ? 1 : 0;
-                            Serial.printf("[IO Rule]   ✓ SET_AND_LATCH: Stored coil %d = %d in global store\n",
-                                         ioPin.modbusRegister, ioPin.currentState ? 1 : 0);
-                            
-                            // Also write to all connected clients
-                            bool coilWritten = false;
-                            for (int c = 0; c < MAX_MODBUS_CLIENTS; c++) {
-                                if (modbusClients[c].connected) {
-                                    modbusClients[c].server.coilWrite(ioPin.modbusRegister, ioPin.currentState ? 1 : 0);
-                                    Serial.printf("[IO Rule]   ✓ SET_AND_LATCH: Wrote coil %d = %d for GP%d (client %d)\n",
-                                                 ioPin.modbusRegister, ioPin.currentState ? 1 : 0, ioPin.gpPin, c);
-                                    coilWritten = true;
-                                    break;
-                                }
-                            }
-                            if (!coilWritten) {
-                                Serial.printf("[IO Rule]   ⚠ SET_AND_LATCH: WARNING - No Modbus client connected, but coil stored globally\n");
-                            }
-                        } else {
-                            Serial.printf("[IO Rule]   ⚠ SET_AND_LATCH: WARNING - Invalid or no Modbus register for GP%d\n", ioPin.gpPin);
+                        if (!setRuleOutput(ioPin, rule.action.value)) {
+                            LOG_WARN_EVERY(10000, "[IO Rule]   ⚠ SET_AND_LATCH: WARNING - Invalid or no Modbus register for GP%d\n", ioPin.gpPin);
                         }
+                        LOG_INFO("[IO Rule] SET_AND_LATCH: Rule '%s' GP%d latched to %s\n",
+                                rule.description, ioPin.gpPin, ioPin.currentState ? "HIGH" : "LOW");
                         break;
                     
                     default:
@@ -4613,12 +4548,18 @@ void evaluateIOAutomationRules() {
             // Reset trigger state when condition is no longer met (for edge-triggered actions)
             if (!triggered && rule.trigger.lastTriggeredState && rule.action.type != IOActionType::FOLLOW_CONDITION) {
                 rule.trigger.lastTriggeredState = false;
-                Serial.printf("[IO Rule] ✗✗✗ CONDITION RESET (FALLING EDGE): GP%d Rule %d - Condition went from TRUE→FALSE\n",
-                             ioPin.gpPin, j);
+                LOG_DEBUG("[IO Rule] ✗✗✗ CONDITION RESET (FALLING EDGE): GP%d Rule %d - Condition went from TRUE→FALSE\n",
+                         ioPin.gpPin, j);
                 rule.trigger.lastTriggeredState = false;
             }
         }
     }
+    
+    // Global rules run on their own fixed period, after the pin rules so they have the last word
+    if (ruleEngine.getGlobalCount() > 0 && globalRuleScan.due(micros())) {
+        runGlobalRules(now);
+        globalRuleScan.finish(micros());
+    }
 }
 
 // Reset all latched inputs
@@ -4648,7 +4589,7 @@ void setPinModes() {
     // --- I2C pull-up logic for all configured sensors ---
     bool i2cPinsSet[32] = {false}; // Avoid duplicate pinMode calls
     for (int i = 0; i < numConfiguredSensors; i++) {
-        if (strncmp(configuredSensors[i].protocol, "I2C", 3) == 0) {
+        if (configuredSensors[i].protocolId == SensorProtocol::I2C) {
             int sda = configuredSensors[i].sdaPin >= 0 ? configuredSensors[i].sdaPin : 4;
             int scl = configuredSensors[i].sclPin >= 0 ? configuredSensors[i].sclPin : 5;
             if (sda >= 0 && sda < 32 && !i2cPinsSet[sda]) {
@@ -4794,20 +4735,9 @@ void setupUSBNetwork() {
 void reapplySensorConfig() {
     Serial.println("\n=== Reapplying Sensor Configuration ===");
     
-    // Stop EZO sensors and clear polling state
-    Serial.println("Stopping EZO sensor polling...");
-    for (int i = 0; i < numConfiguredSensors; i++) {
-        if (ezoSensors[i] != nullptr) {
-            delete ezoSensors[i];
-            ezoSensors[i] = nullptr;
-        }
-    }
-    
-    // Clear all queues
-    Serial.println("Clearing polling queues...");
-    i2cQueueSize = 0;
-    uartQueueSize = 0;
-    oneWireQueueSize = 0;
+    // Clear polling state
+    Serial.println("Clearing polling schedule...");
+    sensorScheduler.clear();
     i2cCommands.clear();
     uartCommands.clear();
     oneWireCommands.clear();
@@ -4824,26 +4754,22 @@ void reapplySensorConfig() {
                 .sensorIndex = (uint8_t)i,
                 .nextExecutionMs = millis(),
                 .intervalMs = configuredSensors[i].updateInterval,
-                .command = (strcmp(configuredSensors[i].type, "GENERIC") == 0) ? configuredSensors[i].command : nullptr,
-                .isGeneric = (strcmp(configuredSensors[i].type, "GENERIC") == 0)
+                .command = (configuredSensors[i].typeId == SensorType::GENERIC_I2C) ? configuredSensors[i].command : nullptr,
+                .isGeneric = (configuredSensors[i].typeId == SensorType::GENERIC_I2C)
             };
             
             // Add to appropriate command array
-            if (strncmp(configuredSensors[i].protocol, "I2C", 3) == 0) {
+            if (configuredSensors[i].protocolId == SensorProtocol::I2C) {
                 i2cCommands.add(cmd);
-                enqueueBusOperation(i, "I2C");
-            } else if (strncmp(configuredSensors[i].protocol, "UART", 4) == 0) {
+            } else if (configuredSensors[i].protocolId == SensorProtocol::UART) {
                 uartCommands.add(cmd);
-                enqueueBusOperation(i, "UART");
-            } else if (strncmp(configuredSensors[i].protocol, "One-Wire", 8) == 0) {
+            } else if (configuredSensors[i].protocolId == SensorProtocol::ONE_WIRE) {
                 oneWireCommands.add(cmd);
-                enqueueBusOperation(i, "One-Wire");
             }
         }
     }
     
-    // Reinitialize EZO sensors if needed
-    initializeEzoSensors();
+    scheduleSensorPolling();
     
     Serial.printf("Sensor configuration reapplied. %d sensors configured.\n", numConfiguredSensors);
     Serial.println("=== Sensor Configuration Reapplied Successfully ===\n");
@@ -4885,7 +4811,23 @@ void setupModbus() {
     Serial.print("Starting Modbus server on port: ");
     Serial.println(config.modbusPort);
     
-    // Initialize all ModbusTCPServer instances
+    // Configure the shared register image once; it keeps its contents when the
+    // connection contexts below are restarted (e.g. by reapplyNetworkConfig)
+    static bool imageConfigured = false;
+    if (!imageConfigured) {
+        modbusImage.configureHoldingRegisters(0x00, MODBUS_HOLDING_REGISTERS);  // 0-200, pin overrides at the pins' addresses
+        modbusImage.configureInputRegisters(0x00, REGISTER_STORE_INPUT_REGISTERS);  // 128 input registers
+        modbusImage.configureCoils(0x00, 201);            // 201 coils (0-200, 100-200 for output pins)
+        modbusImage.configureDiscreteInputs(0x00, 16);    // 16 discrete inputs
+        for (int i = 0; i < 8; i++) {
+            modbusImage.coilWrite(i, ioStatus.dOut[i]);
+        }
+        resetPinOverrideRegisters();  // Pins were configured before the image existed
+        registerStore.invalidate();  // Fresh image: republish every stored input
+        imageConfigured = true;
+    }
+    
+    // Initialize the per-connection protocol contexts
     for (int i = 0; i < MAX_MODBUS_CLIENTS; i++) {
         modbusClients[i].connected = false;
         
@@ -4896,11 +4838,8 @@ void setupModbus() {
             continue;
         }
         
-        // Configure Modbus registers for each client server
-        modbusClients[i].server.configureHoldingRegisters(0x00, 16);  // 16 holding registers
-        modbusClients[i].server.configureInputRegisters(0x00, 32);    // 32 input registers
-        modbusClients[i].server.configureCoils(0x00, 128);           // 128 coils (0-127)
-        modbusClients[i].server.configureDiscreteInputs(0x00, 16);   // 16 discrete inputs
+        // Answer from the shared image instead of a per-connection copy
+        modbusClients[i].server.serveFrom(&modbusImage);
     }
     
     Serial.println("Modbus TCP Servers started");
@@ -4997,6 +4936,8 @@ void handleSimpleHTTP() {
 void sendJSONPinMap(WiFiClient& client);
 void sendJSONSensorPinStatus(WiFiClient& client);
 void sendJSONRulesStatus(WiFiClient& client);
+void sendJSONSchedulerStatus(WiFiClient& client);
+void sendJSONI2CBusStatus(WiFiClient& client);
 void sendJSON(WiFiClient& client, String json); // Ensure sendJSON is declared
 
 // Implementation: Return available pins for each protocol
@@ -5128,10 +5069,22 @@ void sendJSONRulesStatus(WiFiClient& client) {
                 condObj["triggerValue"] = clause.triggerValue;
                 condObj["actualValue"] = registerValue;
                 condObj["clauseMet"] = clauseMet;
+                condObj["hysteresis"] = clause.hysteresis;
                 condObj["nextOperator"] = (clause.nextOperator == LogicOperator::OR) ? "OR" : "AND";
             }
             
             ruleObj["allConditionsMet"] = allConditionsMet;
+            ruleObj["onDelayMs"] = rule.trigger.onDelayMs;
+            ruleObj["offDelayMs"] = rule.trigger.offDelayMs;
+            
+            // What the actions see: conditions after hysteresis and the on/off delay
+            int16_t compiledIndex = ruleEngine.findRule(i, j);
+            if (compiledIndex >= 0) {
+                uint32_t now = millis();
+                ruleObj["conditionState"] = ruleEngine.getRule(compiledIndex).state;
+                ruleObj["delayRemainingMs"] = ruleEngine.delayRemainingMs(compiledIndex, now);
+                ruleObj["pulseRemainingMs"] = ruleEngine.pulseRemainingMs(compiledIndex, now);
+            }
             
             const char* actionTypeStr;
             switch(rule.action.type) {
@@ -5148,12 +5101,173 @@ void sendJSONRulesStatus(WiFiClient& client) {
             actionObj["value"] = rule.action.value;
         }
     }
+
+    // Compiled engine: only rules whose input registers changed are evaluated
+    const RuleEngineStats& stats = ruleEngine.getStats();
+    JsonObject engine = doc.createNestedObject("engine");
+    engine["compiled_rules"] = ruleEngine.getRuleCount();
+    engine["watched_registers"] = ruleEngine.getWatchedCount();
+    engine["scans"] = stats.scans;
+    engine["evaluations"] = stats.evaluations;
+    engine["skipped_evaluations"] = stats.skipped;
+    engine["evaluations_per_sec"] = stats.evaluationsPerSecond;
+    engine["skipped_per_sec"] = stats.skippedPerSecond;
+    engine["register_reads"] = stats.registerReads;
+    engine["changed_registers"] = stats.changedRegisters;
+    engine["compiled_at_ms"] = stats.lastCompileMs;
+    engine["timers_armed"] = ruleEngine.getArmedTimers();
+    engine["timers_fired"] = ruleEngine.getTimersFired();
+    engine["timer_nodes_visited"] = ruleEngine.getTimerNodesVisited();
+    engine["delayed_changes"] = stats.delayedChanges;
+    engine["delays_cancelled"] = stats.delaysCancelled;
+    engine["pulses_completed"] = stats.pulsesCompleted;
+    engine["global_rules"] = ruleEngine.getGlobalCount();
+    engine["global_conflicts"] = stats.conflicts;
+    
+    // Global rules, in the order they run (priority), with the pins each one owns
+    JsonArray globalArray = doc.createNestedArray("global");
+    uint32_t statusNow = millis();
+    uint16_t globalFirst = ruleEngine.getGlobalFirst();
+    for (uint16_t r = globalFirst; r < globalFirst + ruleEngine.getGlobalCount(); r++) {
+        const CompiledRule& compiled = ruleEngine.getRule(r);
+        const IORule& rule = ioConfig.globalRules[compiled.ruleIndex];
+        JsonObject ruleObj = globalArray.createNestedObject();
+        ruleObj["id"] = rule.id;
+        ruleObj["description"] = rule.description;
+        ruleObj["priority"] = rule.priority;
+        ruleObj["conditionState"] = compiled.state;
+        ruleObj["delayRemainingMs"] = ruleEngine.delayRemainingMs(r, statusNow);
+        ruleObj["pulseRemainingMs"] = ruleEngine.pulseRemainingMs(r, statusNow);
+        JsonArray targets = ruleObj.createNestedArray("targets");
+        JsonArray owned = ruleObj.createNestedArray("owns");
+        for (uint8_t t = 0; t < compiled.targetCount; t++) {
+            uint8_t p = compiled.targets[t];
+            targets.add(ioConfig.pins[p].gpPin);
+            if (ruleEngine.getClaim(p) == r) owned.add(ioConfig.pins[p].gpPin);
+        }
+    }
+    
+    // Fixed-period scan of the global rules: lateness against the period grid
+    const PeriodicScanStats& scan = globalRuleScan.getStats();
+    JsonObject scanObj = doc.createNestedObject("global_scan");
+    scanObj["period_ms"] = ioConfig.globalScanPeriodMs;
+    scanObj["scans"] = scan.scans;
+    scanObj["overruns"] = scan.overruns;
+    scanObj["jitter_last_us"] = scan.lastJitterUs;
+    scanObj["jitter_avg_us"] = scan.avgJitterUs;
+    scanObj["jitter_max_us"] = scan.maxJitterUs;
+    scanObj["duration_last_us"] = scan.lastDurationUs;
+    scanObj["duration_max_us"] = scan.maxDurationUs;
     
     String response;
     serializeJson(doc, response);
     sendJSON(client, response);
 }
 
+// Implementation: Return planned vs. actual dispatch times of the sensor scheduler
+void sendJSONSchedulerStatus(WiFiClient& client) {
+    // The scheduler belongs to core 1: copy it with core 1 parked
+    SensorScheduleStats stats[SENSOR_SCHEDULER_CAPACITY];
+    SensorRoundStats rounds;
+    ScheduleEntry pending[SENSOR_SCHEDULER_CAPACITY];
+    bool hasPending[SENSOR_SCHEDULER_CAPACITY];
+    uint8_t pendingCount;
+    int sensorCount = min(numConfiguredSensors, (int)SENSOR_SCHEDULER_CAPACITY);
+
+    sensorCore.pause();
+    for (int i = 0; i < sensorCount; i++) {
+        stats[i] = sensorScheduler.getStats(i);
+        hasPending[i] = sensorScheduler.getPending(i, pending[i]);
+    }
+    pendingCount = sensorScheduler.getPendingCount();
+    rounds = sensorScheduler.getRoundStats();
+    uint32_t batchWindowMs = sensorScheduler.getBatchWindow();
+    sensorCore.resume();
+
+    uint32_t now = millis();
+    uint32_t maxLateness = 0;
+    uint64_t totalLateness = 0;
+    uint32_t totalDispatches = 0;
+
+    StaticJsonDocument<3072> doc;
+    doc["system_time"] = now;
+    doc["pending"] = pendingCount;
+    JsonArray sensors = doc.createNestedArray("sensors");
+    for (int i = 0; i < sensorCount; i++) {
+        const SensorScheduleStats& s = stats[i];
+        JsonObject sensor = sensors.createNestedObject();
+        sensor["name"] = configuredSensors[i].name;
+        sensor["scheduled"] = hasPending[i];
+        if (hasPending[i]) {
+            sensor["next_phase"] = pending[i].phase == SchedulePhase::TRIGGER ? "trigger" : "collect";
+            sensor["next_due_ms"] = pending[i].dueMs;
+        }
+        sensor["last_phase"] = s.phase == SchedulePhase::TRIGGER ? "trigger" : "collect";
+        sensor["planned_ms"] = s.plannedMs;
+        sensor["actual_ms"] = s.actualMs;
+        sensor["lateness_ms"] = s.latenessMs;
+        sensor["max_lateness_ms"] = s.maxLatenessMs;
+        sensor["avg_lateness_ms"] = s.dispatches > 0 ? (float)s.totalLatenessMs / s.dispatches : 0.0f;
+        sensor["dispatches"] = s.dispatches;
+
+        if (s.maxLatenessMs > maxLateness) maxLateness = s.maxLatenessMs;
+        totalLateness += s.totalLatenessMs;
+        totalDispatches += s.dispatches;
+    }
+    doc["dispatches"] = totalDispatches;
+    doc["max_lateness_ms"] = maxLateness;
+    doc["avg_lateness_ms"] = totalDispatches > 0 ? (float)totalLateness / totalDispatches : 0.0f;
+
+    JsonObject batch = doc.createNestedObject("rounds");
+    batch["batch_window_ms"] = batchWindowMs;
+    batch["count"] = rounds.rounds;
+    batch["last_duration_ms"] = rounds.lastDurationMs;
+    batch["max_duration_ms"] = rounds.maxDurationMs;
+    batch["last_sensors"] = rounds.lastSensors;
+    batch["last_conversion_sum_ms"] = rounds.lastConversionSumMs;
+    batch["last_conversion_max_ms"] = rounds.lastConversionMaxMs;
+
+    String response;
+    serializeJson(doc, response);
+    sendJSON(client, response);
+}
+
+// Implementation: Return I2C bus manager counters (pin-pair switches and transactions)
+void sendJSONI2CBusStatus(WiFiClient& client) {
+    // Single-word counters written by core 1; read without pausing it
+    uint32_t switches = i2cBusManager.getPinSwitchCount();
+    uint32_t switchTimeUs = i2cBusManager.getPinSwitchTimeUs();
+
+    StaticJsonDocument<1024> doc;
+    doc["active_pin_pairs"] = i2cBusManager.getActivePinPairCount();
+    doc["transactions"] = i2cBusManager.getTransactionCount();
+    doc["transaction_errors"] = i2cBusManager.getTransactionErrors();
+    doc["invalid_pin_errors"] = i2cBusManager.getInvalidPinErrors();
+    doc["pin_switches"] = switches;
+    doc["pin_switch_time_us"] = switchTimeUs;
+    doc["pin_switch_avg_us"] = switches > 0 ? switchTimeUs / switches : 0;
+    doc["pin_switch_max_us"] = i2cBusManager.getMaxPinSwitchUs();
+
+    // Per controller: Wire (I2C0) and Wire1 (I2C1)
+    JsonArray controllers = doc.createNestedArray("controllers");
+    for (uint8_t c = 0; c < RP2040_I2C_CONTROLLER_COUNT; c++) {
+        const I2CController& controller = i2cBusManager.getController((I2CBusId)c);
+        JsonObject obj = controllers.createNestedObject();
+        obj["bus"] = i2cBusName((I2CBusId)c);
+        obj["current_sda"] = controller.sdaPin;
+        obj["current_scl"] = controller.sclPin;
+        obj["transactions"] = controller.transactionCount;
+        obj["transaction_errors"] = controller.transactionErrors;
+        obj["pin_switches"] = controller.pinSwitchCount;
+        obj["pin_switch_time_us"] = controller.pinSwitchTimeUs;
+        obj["pin_switch_max_us"] = controller.maxPinSwitchUs;
+    }
+
+    String response;
+    serializeJson(doc, response);
+    sendJSON(client, response);
+}
+
 void sendJSON(WiFiClient& client, String json); // Ensure sendJSON is declared
 
 void sendJSONConfig(WiFiClient& client) {
@@ -5249,11 +5363,16 @@ void routeRequest(WiFiClient& client, String method, String path, String body) {
             sendJSONSensorPinStatus(client);
         } else if (path == "/api/rules/status") {
             sendJSONRulesStatus(client);
+        } else if (path == "/api/scheduler") {
+            sendJSONSchedulerStatus(client);
+        } else if (path == "/api/i2c/status") {
+            sendJSONI2CBusStatus(client);
         } else if (path == "/terminal/logs") {
             // Send terminal buffer for bus traffic monitoring
             StaticJsonDocument<2048> terminalDoc;
             JsonArray terminalArray = terminalDoc.to<JsonArray>();
             
+            mutex_enter_blocking(&terminalLogMutex);
             for (size_t i = 0; i < terminalBuffer.size(); i++) {
                 // Clean each log entry to prevent JSON corruption
                 String cleanEntry = "";
@@ -5271,6 +5390,7 @@ void routeRequest(WiFiClient& client, String method, String path, String body) {
                 }
                 terminalArray.add(cleanEntry);
             }
+            mutex_exit(&terminalLogMutex);
             
             String response;
             serializeJson(terminalDoc, response);
@@ -5280,7 +5400,13 @@ void routeRequest(WiFiClient& client, String method, String path, String body) {
             send404(client);
         }
     } else if (method == "POST") {
-
+        // Requests that change sensor config, use a sensor bus directly or change
+        // the terminal watch run with core 1 parked at its loop boundary
+        bool pauseSensorCore = path.startsWith("/sensors/") || path.startsWith("/api/sensor/") ||
+                               path.startsWith("/terminal/");
+        if (pauseSensorCore) {
+            sensorCore.pause();
+        }
 
         if (path == "/config") {
             handlePOSTConfig(client, body);
@@ -5336,6 +5462,10 @@ void routeRequest(WiFiClient& client, String method, String path, String body) {
         } else {
             send404(client);
         }
+        
+        if (pauseSensorCore) {
+            sensorCore.resume();
+        }
     } else {
         send404(client);
     }
@@ -5346,6 +5476,42 @@ void sendFile(WiFiClient& client, String filename, String contentType) {
     serveFileFromFS(client, filename, contentType);
 }
 
+// Window features of a streaming accelerometer; registers follow its three mean registers
+// withSpectrum adds dominant frequencies and band RMS (sensor data, not the compact IO status)
+static void addVibrationJson(JsonObject sensor, const SensorConfig& config, const VibrationFeatures& features,
+                             bool withSpectrum) {
+    if (config.modbusRegisterCount <= 3 || features.samples == 0) return;
+    JsonObject vibration = sensor.createNestedObject("vibration");
+    vibration["samples"] = features.samples;
+    vibration["window_ms"] = features.windowMs;
+    vibration["modbus_register"] = config.modbusRegister + 3;
+    JsonArray rms = vibration.createNestedArray("rms_mg");
+    JsonArray peak = vibration.createNestedArray("peak_mg");
+    JsonArray crest = vibration.createNestedArray("crest");
+    for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+        rms.add(features.rms[axis]);
+        peak.add(features.peak[axis]);
+        crest.add(features.crest[axis]);
+    }
+    if (!withSpectrum || !features.spectrumValid) return;
+
+    vibration["fft_points"] = features.samples;
+    JsonArray dominant = vibration.createNestedArray("dominant_hz");
+    for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+        dominant.add(features.dominantHz[axis]);
+    }
+    JsonArray bands = vibration.createNestedArray("bands");
+    for (uint8_t b = 0; b < features.bandCount && b < config.vibrationBandSet.count; b++) {
+        JsonObject band = bands.createNestedObject();
+        band["low_hz"] = config.vibrationBandSet.band[b].lowHz;
+        band["high_hz"] = config.vibrationBandSet.band[b].highHz;
+        JsonArray bandRms = band.createNestedArray("rms_mg");
+        for (uint8_t axis = 0; axis < VIBRATION_AXES; axis++) {
+            bandRms.add(features.bandRms[b][axis]);
+        }
+    }
+}
+
 void sendJSONIOStatus(WiFiClient& client) {
     if (!client.connected()) {
         Serial.println("ERROR: Client not connected in sendJSONIOStatus");
@@ -5386,50 +5552,51 @@ void sendJSONIOStatus(WiFiClient& client) {
             sensor["modbus_register"] = configuredSensors[i].modbusRegister;
             
             // Actual sensor readings
-            sensor["raw_value"] = configuredSensors[i].rawValue;
-            sensor["raw_i2c_data"] = configuredSensors[i].rawDataString;
+            sensor["raw_value"] = sensorValues[i].rawValue;
+            sensor["raw_i2c_data"] = sensorValues[i].rawDataString;
             
             // Calibrated output (applying calibration equation)
-            sensor["calibrated_value"] = configuredSensors[i].calibratedValue;
+            sensor["calibrated_value"] = sensorValues[i].calibratedValue;
             
             // Modbus register value (what gets sent to Modbus)
-            sensor["modbus_value"] = configuredSensors[i].modbusValue;
+            sensor["modbus_value"] = sensorValues[i].modbusValue;
             
             // Multi-output sensor support (for SHT30 humidity, BME280 pressure, LIS3DH Y/Z, etc.)
-            if (strcmp(configuredSensors[i].type, "SHT30") == 0 && configuredSensors[i].rawValueB != 0) {
-                sensor["raw_value_b"] = configuredSensors[i].rawValueB;        // Humidity raw
-                sensor["calibrated_value_b"] = configuredSensors[i].calibratedValueB;  // Humidity calibrated
-                sensor["modbus_value_b"] = configuredSensors[i].modbusValueB;  // Humidity modbus (register+1)
+            if (configuredSensors[i].typeId == SensorType::SHT30 && sensorValues[i].rawValueB != 0) {
+                sensor["raw_value_b"] = sensorValues[i].rawValueB;        // Humidity raw
+                sensor["calibrated_value_b"] = sensorValues[i].calibratedValueB;  // Humidity calibrated
+                sensor["modbus_value_b"] = sensorValues[i].modbusValueB;  // Humidity modbus (register+1)
                 sensor["modbus_register_b"] = configuredSensors[i].modbusRegister + 1;
             }
-            else if (strcmp(configuredSensors[i].type, "LIS3DH") == 0 || strcmp(configuredSensors[i].type, "LIS3DH_SPI") == 0) {
+            else if (configuredSensors[i].typeId == SensorType::LIS3DH || configuredSensors[i].typeId == SensorType::LIS3DH_SPI) {
                 // LIS3DH: Y-axis (register+1)
-                if (configuredSensors[i].rawValueB != 0) {
-                    sensor["raw_value_b"] = configuredSensors[i].rawValueB;        // Y-axis raw
-                    sensor["calibrated_value_b"] = configuredSensors[i].calibratedValueB;  // Y-axis calibrated
-                    sensor["modbus_value_b"] = configuredSensors[i].modbusValueB;  // Y-axis modbus (register+1)
+                if (sensorValues[i].rawValueB != 0) {
+                    sensor["raw_value_b"] = sensorValues[i].rawValueB;        // Y-axis raw
+                    sensor["calibrated_value_b"] = sensorValues[i].calibratedValueB;  // Y-axis calibrated
+                    sensor["modbus_value_b"] = sensorValues[i].modbusValueB;  // Y-axis modbus (register+1)
                     sensor["modbus_register_b"] = configuredSensors[i].modbusRegister + 1;
                 }
                 // LIS3DH: Z-axis (register+2)
-                if (configuredSensors[i].rawValueC != 0) {
-                    sensor["raw_value_c"] = configuredSensors[i].rawValueC;        // Z-axis raw
-                    sensor["calibrated_value_c"] = configuredSensors[i].calibratedValueC;  // Z-axis calibrated
-                    sensor["modbus_value_c"] = configuredSensors[i].modbusValueC;  // Z-axis modbus (register+2)
+                if (sensorValues[i].rawValueC != 0) {
+                    sensor["raw_value_c"] = sensorValues[i].rawValueC;        // Z-axis raw
+                    sensor["calibrated_value_c"] = sensorValues[i].calibratedValueC;  // Z-axis calibrated
+                    sensor["modbus_value_c"] = sensorValues[i].modbusValueC;  // Z-axis modbus (register+2)
                     sensor["modbus_register_c"] = configuredSensors[i].modbusRegister + 2;
                 }
+                addVibrationJson(sensor, configuredSensors[i], sensorValues[i].vibration, false);
             }
-            else if (strcmp(configuredSensors[i].type, "BME280") == 0) {
+            else if (configuredSensors[i].typeId == SensorType::BME280) {
                 // BME280: Humidity (register+1), Pressure (register+2)
-                if (configuredSensors[i].rawValueB != 0) {
-                    sensor["raw_value_b"] = configuredSensors[i].rawValueB;        // Humidity raw
-                    sensor["calibrated_value_b"] = configuredSensors[i].calibratedValueB;  // Humidity calibrated
-                    sensor["modbus_value_b"] = configuredSensors[i].modbusValueB;  // Humidity modbus (register+1)
+                if (sensorValues[i].rawValueB != 0) {
+                    sensor["raw_value_b"] = sensorValues[i].rawValueB;        // Humidity raw
+                    sensor["calibrated_value_b"] = sensorValues[i].calibratedValueB;  // Humidity calibrated
+                    sensor["modbus_value_b"] = sensorValues[i].modbusValueB;  // Humidity modbus (register+1)
                     sensor["modbus_register_b"] = configuredSensors[i].modbusRegister + 1;
                 }
-                if (configuredSensors[i].rawValueC != 0) {
-                    sensor["raw_value_c"] = configuredSensors[i].rawValueC;        // Pressure raw
-                    sensor["calibrated_value_c"] = configuredSensors[i].calibratedValueC;  // Pressure calibrated
-                    sensor["modbus_value_c"] = configuredSensors[i].modbusValueC;  // Pressure modbus (register+2)
+                if (sensorValues[i].rawValueC != 0) {
+                    sensor["raw_value_c"] = sensorValues[i].rawValueC;        // Pressure raw
+                    sensor["calibrated_value_c"] = sensorValues[i].calibratedValueC;  // Pressure calibrated
+                    sensor["modbus_value_c"] = sensorValues[i].modbusValueC;  // Pressure modbus (register+2)
                     sensor["modbus_register_c"] = configuredSensors[i].modbusRegister + 2;
                 }
             }
@@ -5454,7 +5621,7 @@ void sendJSONIOStatus(WiFiClient& client) {
             }
             
             // Include last read time for status
-            sensor["last_read_time"] = configuredSensors[i].lastReadTime;
+            sensor["last_read_time"] = sensorValues[i].lastReadTime;
             
             // Include pin assignments for reference
             if (String(configuredSensors[i].protocol).equalsIgnoreCase("I2C")) {
@@ -5480,7 +5647,7 @@ void sendJSONIOStatus(WiFiClient& client) {
 
 void sendJSONIOConfig(WiFiClient& client) {
     // Send the dynamic IO configuration from ioConfig struct
-    StaticJsonDocument<4096> doc;
+    StaticJsonDocument<8192> doc;
     
     doc["version"] = ioConfig.version;
     
@@ -5503,69 +5670,27 @@ void sendJSONIOConfig(WiFiClient& client) {
         if (pin.ruleCount > 0) {
             JsonArray rulesArray = pinObj.createNestedArray("rules");
             for (int j = 0; j < pin.ruleCount; j++) {
-                IORule& rule = pin.rules[j];
-                JsonObject ruleObj = rulesArray.createNestedObject();
-                
-                ruleObj["id"] = rule.id;
-                ruleObj["enabled"] = rule.enabled;
-                ruleObj["description"] = rule.description;
-                ruleObj["priority"] = rule.priority;
-                
-                // Serialize multi-condition trigger
-                JsonObject triggerObj = ruleObj.createNestedObject("trigger");
-                JsonArray conditionsArray = triggerObj.createNestedArray("conditions");
-                
-                for (int c = 0; c < rule.trigger.conditionCount && c < 3; c++) {
-                    ConditionClause& clause = rule.trigger.conditions[c];
-                    JsonObject condObj = conditionsArray.createNestedObject();
-                    
-                    condObj["register"] = clause.modbusRegister;
-                    condObj["value"] = clause.triggerValue;
-                    
-                    const char* condStr;
-                    switch(clause.condition) {
-                        case TriggerCondition::EQUAL: condStr = "=="; break;
-                        case TriggerCondition::NOT_EQUAL: condStr = "!="; break;
-                        case TriggerCondition::LESS_THAN: condStr = "<"; break;
-                        case TriggerCondition::GREATER_THAN: condStr = ">"; break;
-                        case TriggerCondition::LESS_EQUAL: condStr = "<="; break;
-                        case TriggerCondition::GREATER_EQUAL: condStr = ">="; break;
-                        default: condStr = "==";
-                    }
-                    condObj["condition"] = condStr;
-                    condObj["nextOperator"] = (clause.nextOperator == LogicOperator::OR) ? "OR" : "AND";
-                }
-                
-                JsonObject actionObj = ruleObj.createNestedObject("action");
-                const char* actionTypeStr;
-                switch(rule.action.type) {
-                    case IOActionType::SET_OUTPUT: actionTypeStr = "set_output"; break;
-                    case IOActionType::TOGGLE_OUTPUT: actionTypeStr = "toggle_output"; break;
-                    case IOActionType::PULSE_OUTPUT: actionTypeStr = "pulse_output"; break;
-                    case IOActionType::SET_AND_LATCH: actionTypeStr = "set_and_latch"; break;
-                    case IOActionType::FOLLOW_CONDITION: actionTypeStr = "follow_condition"; break;
-                    default: actionTypeStr = "set_output";
-                }
-                actionObj["type"] = actionTypeStr;
-                actionObj["value"] = rule.action.value;
-                actionObj["pulseDuration"] = rule.action.pulseDurationMs;
+                writeRuleJSON(rulesArray.createNestedObject(), pin.rules[j]);
             }
         }
     }
     
+    doc["globalScanPeriodMs"] = ioConfig.globalScanPeriodMs;
+    JsonArray globalArray = doc.createNestedArray("globalRules");
+    for (int j = 0; j < ioConfig.globalRuleCount; j++) {
+        writeRuleJSON(globalArray.createNestedObject(), ioConfig.globalRules[j]);
+    }
+    
     String response;
     serializeJson(doc, response);
     sendJSON(client, response);
 }
 
-// Mathematical expression evaluator for sensor calibration
-float evaluateCalibrationExpression(float x, const SensorConfig& sensor) {
-    String expr = String(sensor.calibrationExpression);
-    
-    if (expr.length() == 0) {
-        // No expression, use linear calibration: y = slope*x + offset
-        return (sensor.calibrationSlope * x) + sensor.calibrationOffset;
-    }
+#ifdef NATIVE_BUILD
+// String-rewriting expression evaluator (the pre-bytecode implementation)
+// No longer on the sample path; kept for the native build as the reference for "calbench"
+float evaluateCalibrationExpression(float x, const char* expression) {
+    String expr = String(expression);
     
     // Replace 'x' with actual value in the expression
     expr.replace("x", String(x, 6));
@@ -5773,12 +5898,80 @@ float evaluateCalibrationExpression(float x, const SensorConfig& sensor) {
     
     return workingExpr.toFloat();
 }
+#endif // NATIVE_BUILD
+
+// Compile the calibration expressions of all channels (config load, calibration POST)
+// A channel whose expression does not compile falls back to linear slope/offset
+void compileSensorCalibration(SensorConfig& sensor) {
+    const char* expressions[3] = { sensor.calibrationExpression, sensor.calibrationExpressionB, sensor.calibrationExpressionC };
+    CalibrationProgram* programs[3] = { &sensor.calibrationProgram, &sensor.calibrationProgramB, &sensor.calibrationProgramC };
+    
+    for (int ch = 0; ch < 3; ch++) {
+        uint16_t errorOffset = 0;
+        CalCompileResult result = programs[ch]->compile(expressions[ch], &errorOffset);
+        if (result != CalCompileResult::OK && result != CalCompileResult::EMPTY) {
+            Serial.printf("[Calibration] %s channel %c: %s at offset %u in \"%s\", using linear calibration\n",
+                         sensor.name, 'A' + ch, CalibrationProgram::resultString(result), errorOffset, expressions[ch]);
+        }
+    }
+    resolveFixedPointCalibration(sensor);
+}
+
+// Pick the channels of a "fixedPoint" sensor that can run in Q16.16
+// A channel stays on float if it has an expression or its slope/offset do not quantize
+void resolveFixedPointCalibration(SensorConfig& sensor) {
+    const CalibrationProgram* programs[3] = { &sensor.calibrationProgram, &sensor.calibrationProgramB, &sensor.calibrationProgramC };
+    float slopes[3] = { sensor.calibrationSlope, sensor.calibrationSlopeB, sensor.calibrationSlopeC };
+    float offsets[3] = { sensor.calibrationOffset, sensor.calibrationOffsetB, sensor.calibrationOffsetC };
+    
+    sensor.fixedPointChannels = 0;
+    if (!sensor.fixedPoint) return;
+    
+    for (int ch = 0; ch < 3; ch++) {
+        if (!programs[ch]->isEmpty()) continue;
+        if (q16PrepareLinear(slopes[ch], offsets[ch], sensor.linearQ16[ch])) {
+            sensor.fixedPointChannels |= (1 << ch);
+        } else {
+            Serial.printf("[Calibration] %s channel %c: slope %g / offset %g not representable in Q16.16, using float\n",
+                         sensor.name, 'A' + ch, slopes[ch], offsets[ch]);
+        }
+    }
+}
+
+// Store one channel from a reading already in engineering units (Q16.16)
+// Fixed-point channels calibrate and encode in integer math; the float fields are
+// filled once for the UI. Other channels go through applyCalibration*().
+void storeChannelQ16(SensorConfig& sensor, uint8_t channel, q16_t raw) {
+    float* rawFields[3] = { &sensor.rawValue, &sensor.rawValueB, &sensor.rawValueC };
+    float* calibratedFields[3] = { &sensor.calibratedValue, &sensor.calibratedValueB, &sensor.calibratedValueC };
+    int* modbusFields[3] = { &sensor.modbusValue, &sensor.modbusValueB, &sensor.modbusValueC };
+    if (channel > 2) return;
+    
+    *rawFields[channel] = q16ToFloat(raw);
+    if (sensor.fixedPointChannels & (1 << channel)) {
+        q16_t calibrated = q16ApplyLinear(sensor.linearQ16[channel], raw);
+        *calibratedFields[channel] = q16ToFloat(calibrated);
+        *modbusFields[channel] = q16ToHundredths(calibrated);
+        return;
+    }
+    
+    float calibrated;
+    if (channel == 0) {
+        calibrated = applyCalibration(*rawFields[channel], sensor);
+    } else if (channel == 1) {
+        calibrated = applyCalibrationB(*rawFields[channel], sensor);
+    } else {
+        calibrated = applyCalibrationC(*rawFields[channel], sensor);
+    }
+    *calibratedFields[channel] = calibrated;
+    *modbusFields[channel] = (int)(calibrated * 100);
+}
 
 // Apply calibration to raw sensor value
 float applyCalibration(float rawValue, const SensorConfig& sensor) {
-    // Check if mathematical expression calibration is configured
-    if (strlen(sensor.calibrationExpression) > 0) {
-        return evaluateCalibrationExpression(rawValue, sensor);
+    // Compiled expression if configured
+    if (!sensor.calibrationProgram.isEmpty()) {
+        return sensor.calibrationProgram.evaluate(rawValue);
     }
     
     // Default linear calibration: y = slope*x + offset
@@ -5787,12 +5980,9 @@ float applyCalibration(float rawValue, const SensorConfig& sensor) {
 
 // Apply calibration to secondary sensor value (rawValueB)
 float applyCalibrationB(float rawValue, const SensorConfig& sensor) {
-    // Check if mathematical expression calibration is configured for channel B
-    if (strlen(sensor.calibrationExpressionB) > 0) {
-        // Create a temporary sensor config for expression evaluation
-        SensorConfig tempSensor = sensor;
-        strncpy(tempSensor.calibrationExpression, sensor.calibrationExpressionB, sizeof(tempSensor.calibrationExpression));
-        return evaluateCalibrationExpression(rawValue, tempSensor);
+    // Compiled expression if configured for channel B
+    if (!sensor.calibrationProgramB.isEmpty()) {
+        return sensor.calibrationProgramB.evaluate(rawValue);
     }
     
     // Default linear calibration for channel B: y = slope*x + offset
@@ -5801,22 +5991,168 @@ float applyCalibrationB(float rawValue, const SensorConfig& sensor) {
 
 // Apply calibration to tertiary sensor value (rawValueC)
 float applyCalibrationC(float rawValue, const SensorConfig& sensor) {
-    // Check if mathematical expression calibration is configured for channel C
-    if (strlen(sensor.calibrationExpressionC) > 0) {
-        // Create a temporary sensor config for expression evaluation
-        SensorConfig tempSensor = sensor;
-        strncpy(tempSensor.calibrationExpression, sensor.calibrationExpressionC, sizeof(tempSensor.calibrationExpression));
-        return evaluateCalibrationExpression(rawValue, tempSensor);
+    // Compiled expression if configured for channel C
+    if (!sensor.calibrationProgramC.isEmpty()) {
+        return sensor.calibrationProgramC.evaluate(rawValue);
     }
     
     // Default linear calibration for channel C: y = slope*x + offset
     return (sensor.calibrationSlopeC * rawValue) + sensor.calibrationOffsetC;
 }
 
+#ifdef NATIVE_BUILD
+// Serial "calbench" (native build only): evaluations per second of the compiled programs vs the string evaluator
+// Blocks core 0 for ~2 s; sensor polling on core 1 continues
+void runCalibrationBenchmark() {
+    // Expressions the string evaluator also handles (it has no parentheses support)
+    static const char* expressions[] = { "x*1.8+32", "0.5*x^2+2*x-3", "sqrt(x)*10+1", "x*x*0.001+x/3+7" };
+    const uint32_t runMicros = 250000;
+    
+    Serial.println("=== CALIBRATION BENCHMARK ===");
+    for (unsigned int e = 0; e < sizeof(expressions) / sizeof(expressions[0]); e++) {
+        CalibrationProgram program;
+        program.compile(expressions[e]);
+        volatile float sink = 0;
+        
+        // Same inputs for both evaluators; track the largest disagreement
+        float maxDiff = 0;
+        for (int i = 1; i <= 100; i++) {
+            float x = i * 1.37f;
+            float diff = fabsf(program.evaluate(x) - evaluateCalibrationExpression(x, expressions[e]));
+            if (diff > maxDiff) maxDiff = diff;
+        }
+        
+        uint32_t stringEvals = 0;
+        uint32_t start = micros();
+        while (micros() - start < runMicros) {
+            for (int i = 0; i < 8; i++) {
+                sink = sink + evaluateCalibrationExpression(1.0f + (stringEvals & 63), expressions[e]);
+                stringEvals++;
+            }
+        }
+        uint32_t stringMicros = micros() - start;
+        rp2040.wdt_reset();
+        
+        uint32_t compiledEvals = 0;
+        start = micros();
+        while (micros() - start < runMicros) {
+            for (int i = 0; i < 64; i++) {
+                sink = sink + program.evaluate(1.0f + (compiledEvals & 63));
+                compiledEvals++;
+            }
+        }
+        uint32_t compiledMicros = micros() - start;
+        rp2040.wdt_reset();
+        
+        float stringRate = stringEvals * 1e6f / stringMicros;
+        float compiledRate = compiledEvals * 1e6f / compiledMicros;
+        Serial.printf("  %-18s string: %9.0f eval/s | compiled: %10.0f eval/s (%d bytes) | x%.0f | max diff %.5f\n",
+                     expressions[e], stringRate, compiledRate, program.getCodeLength(),
+                     compiledRate / stringRate, maxDiff);
+    }
+    Serial.println("=============================");
+}
+#endif // NATIVE_BUILD
+
+// Sample sources measured by "fixbench" (same scaling as the collect/ADC paths)
+enum class FixedBenchSource : uint8_t { SHT30_TEMPERATURE, SHT30_HUMIDITY, LIS3DH_MG, ADC_VOLTS };
+
+// Float path: scaling, linear calibration and Modbus encoding as done without "fixedPoint"
+static int benchFloatSample(FixedBenchSource source, int32_t raw, float slope, float offset, float& calibrated) {
+    float value;
+    switch (source) {
+        case FixedBenchSource::SHT30_TEMPERATURE: value = -45.0 + 175.0 * ((float)raw / 65535.0); break;
+        case FixedBenchSource::SHT30_HUMIDITY:    value = 100.0 * ((float)raw / 65535.0); break;
+        case FixedBenchSource::LIS3DH_MG:         value = (float)raw * 3.906f; break;
+        default:                                  value = (raw * 3.3) / 4095.0; break;
+    }
+    calibrated = (slope * value) + offset;
+    return (int)(calibrated * 100);
+}
+
+// Q16.16 path: the same steps as storeChannelQ16() on a fixed-point channel
+static int32_t benchFixedSample(FixedBenchSource source, int32_t raw, const LinearQ16& cal, q16_t& calibrated) {
+    q16_t value;
+    switch (source) {
+        case FixedBenchSource::SHT30_TEMPERATURE: value = q16FromSht30Temperature((uint16_t)raw); break;
+        case FixedBenchSource::SHT30_HUMIDITY:    value = q16FromSht30Humidity((uint16_t)raw); break;
+        case FixedBenchSource::LIS3DH_MG:         value = q16FromLis3dhCounts((int16_t)raw); break;
+        default:                                  value = q16FromAdc12Volts((uint16_t)raw); break;
+    }
+    calibrated = q16ApplyLinear(cal, value);
+    return q16ToHundredths(calibrated);
+}
+
+// Serial "fixbench": cycles per sample of the float and Q16.16 sample paths over the
+// full raw range of each source, and the largest difference between the two
+// Blocks core 0 for well under a second on the target; sensor polling on core 1 continues
+void runFixedPointBenchmark() {
+    struct BenchCase {
+        const char* name;
+        FixedBenchSource source;
+        int32_t rawMin;
+        uint32_t rawCount;
+        float slope;
+        float offset;
+    };
+    static const BenchCase cases[] = {
+        { "SHT30 temperature", FixedBenchSource::SHT30_TEMPERATURE, 0, 65536, 1.02f, -0.5f },
+        { "SHT30 humidity", FixedBenchSource::SHT30_HUMIDITY, 0, 65536, 0.98f, 1.5f },
+        { "LIS3DH mg", FixedBenchSource::LIS3DH_MG, -512, 1024, 1.0f, 12.0f },
+        { "ADC volts", FixedBenchSource::ADC_VOLTS, 0, 4096, 10.0f, -1.25f },
+    };
+    
+    Serial.println("=== FIXED-POINT BENCHMARK ===");
+    for (unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const BenchCase& bench = cases[c];
+        LinearQ16 cal;
+        q16PrepareLinear(bench.slope, bench.offset, cal);
+        volatile int32_t sink = 0;
+        float floatCalibrated;
+        q16_t fixedCalibrated;
+        
+        // Accuracy: every raw value, fixed vs float
+        int32_t maxCountError = 0;
+        float maxValueError = 0;
+        for (uint32_t i = 0; i < bench.rawCount; i++) {
+            int32_t raw = bench.rawMin + (int32_t)i;
+            int floatModbus = benchFloatSample(bench.source, raw, bench.slope, bench.offset, floatCalibrated);
+            int32_t fixedModbus = benchFixedSample(bench.source, raw, cal, fixedCalibrated);
+            int32_t countError = abs(fixedModbus - floatModbus);
+            float valueError = fabsf(q16ToFloat(fixedCalibrated) - floatCalibrated);
+            if (countError > maxCountError) maxCountError = countError;
+            if (valueError > maxValueError) maxValueError = valueError;
+        }
+        rp2040.wdt_reset();
+        
+        uint64_t start = rp2040.getCycleCount64();
+        for (uint32_t i = 0; i < bench.rawCount; i++) {
+            sink = sink + benchFloatSample(bench.source, bench.rawMin + (int32_t)i, bench.slope, bench.offset, floatCalibrated);
+        }
+        uint64_t floatCycles = rp2040.getCycleCount64() - start;
+        rp2040.wdt_reset();
+        
+        start = rp2040.getCycleCount64();
+        for (uint32_t i = 0; i < bench.rawCount; i++) {
+            sink = sink + benchFixedSample(bench.source, bench.rawMin + (int32_t)i, cal, fixedCalibrated);
+        }
+        uint64_t fixedCycles = rp2040.getCycleCount64() - start;
+        rp2040.wdt_reset();
+        
+        float floatPerSample = (float)floatCycles / bench.rawCount;
+        float fixedPerSample = (float)fixedCycles / bench.rawCount;
+        Serial.printf("  %-18s float: %7.1f cyc/sample | Q16.16: %7.1f cyc/sample | x%.1f | max error %ld count(s), %.6f units\n",
+                     bench.name, floatPerSample, fixedPerSample,
+                     fixedPerSample > 0 ? floatPerSample / fixedPerSample : 0.0f,
+                     (long)maxCountError, maxValueError);
+    }
+    Serial.println("=============================");
+}
+
 // Data parsing function - converts raw sensor data based on parsing configuration
 float parseSensorData(const char* rawData, const SensorConfig& sensor) {
-    if (strlen(sensor.parsingMethod) == 0 || strcmp(sensor.parsingMethod, "raw") == 0) {
-        // Raw parsing - convert string to float
+    if (sensor.parsingMethodId == ParsingMethod::RAW) {
+        // Raw parsing (also blank/unknown method) - convert string to float
         return atof(rawData);
     }
     
@@ -5828,9 +6164,8 @@ float parseSensorData(const char* rawData, const SensorConfig& sensor) {
     }
     
     JsonObject config = parsingDoc.as<JsonObject>();
-    String method = sensor.parsingMethod;
     
-    if (method == "custom_bits") {
+    if (sensor.parsingMethodId == ParsingMethod::CUSTOM_BITS) {
         // Extract specific bits from integer data
         uint32_t rawValue = (uint32_t)atol(rawData);
         String bitPositions = config["bitPositions"] | "";
@@ -5871,7 +6206,7 @@ float parseSensorData(const char* rawData, const SensorConfig& sensor) {
         }
         return (float)result;
         
-    } else if (method == "bit_field") {
+    } else if (sensor.parsingMethodId == ParsingMethod::BIT_FIELD) {
         // Extract a range of bits
         uint32_t rawValue = (uint32_t)atol(rawData);
         int startBit = config["bitStart"] | 0;
@@ -5881,12 +6216,12 @@ float parseSensorData(const char* rawData, const SensorConfig& sensor) {
         uint32_t result = (rawValue >> startBit) & mask;
         return (float)result;
         
-    } else if (method == "status_register") {
+    } else if (sensor.parsingMethodId == ParsingMethod::STATUS_REGISTER) {
         // Return status as bit pattern
         uint32_t rawValue = (uint32_t)atol(rawData);
         return (float)rawValue;
         
-    } else if (method == "json_path") {
+    } else if (sensor.parsingMethodId == ParsingMethod::JSON_PATH) {
         // Extract value from JSON data
         StaticJsonDocument<512> jsonDoc;
         DeserializationError jsonError = deserializeJson(jsonDoc, rawData);
@@ -5936,7 +6271,7 @@ float parseSensorData(const char* rawData, const SensorConfig& sensor) {
         
         return value.as<float>();
         
-    } else if (method == "csv_column") {
+    } else if (sensor.parsingMethodId == ParsingMethod::CSV_COLUMN) {
         // Extract specific column from CSV data
         int columnIndex = config["csvColumn"] | 0;
         String delimiter = config["csvDelimiter"] | ",";
@@ -5991,8 +6326,8 @@ void sendJSONSensorConfig(WiFiClient& client) {
         
         // Clean response field to prevent JSON corruption from binary data
         String cleanResponse = "";
-        for (int j = 0; j < strlen(configuredSensors[i].response); j++) {
-            char c = configuredSensors[i].response[j];
+        for (int j = 0; j < strlen(sensorValues[i].response); j++) {
+            char c = sensorValues[i].response[j];
             if (c >= 32 && c <= 126) { // Only printable ASCII
                 cleanResponse += c;
             }
@@ -6005,6 +6340,8 @@ void sendJSONSensorConfig(WiFiClient& client) {
         sensor["dataPin"] = configuredSensors[i].dataPin;
         sensor["uartTxPin"] = configuredSensors[i].uartTxPin;
         sensor["uartRxPin"] = configuredSensors[i].uartRxPin;
+        sensor["uartBaud"] = configuredSensors[i].uartBaud;
+        sensor["uartFraming"] = configuredSensors[i].uartFraming;
         sensor["analogPin"] = configuredSensors[i].analogPin;
         sensor["oneWirePin"] = configuredSensors[i].oneWirePin;
         sensor["digitalPin"] = configuredSensors[i].digitalPin;
@@ -6020,6 +6357,13 @@ void sendJSONSensorConfig(WiFiClient& client) {
             sensor["oneWireConversionTime"] = configuredSensors[i].oneWireConversionTime;
         }
         sensor["oneWireAutoMode"] = configuredSensors[i].oneWireAutoMode;
+        sensor["oneWireRom"] = configuredSensors[i].oneWireRom;
+        sensor["oneWireResolution"] = configuredSensors[i].oneWireResolution;
+        sensor["fftPoints"] = configuredSensors[i].fftPoints;
+        sensor["vibrationBands"] = configuredSensors[i].vibrationBands;
+        sensor["ezoCompensation"] = configuredSensors[i].ezoCompensation;
+        
+        sensor["fixedPoint"] = configuredSensors[i].fixedPoint;
         
         // Always include calibration data
         JsonObject calibration = sensor.createNestedObject("calibration");
@@ -6078,7 +6422,7 @@ void sendJSONSensorConfig(WiFiClient& client) {
 }
 
 void sendJSONSensorData(WiFiClient& client) {
-    StaticJsonDocument<4096> doc;
+    StaticJsonDocument<8192> doc;  // Room for per-sensor vibration spectra
     JsonArray sensorsArray = doc.createNestedArray("sensors");
     
     for (int i = 0; i < numConfiguredSensors; i++) {
@@ -6091,13 +6435,13 @@ void sendJSONSensorData(WiFiClient& client) {
             sensor["modbus_register"] = configuredSensors[i].modbusRegister;
             
             // Raw sensor data
-            sensor["raw_value"] = configuredSensors[i].rawValue;
-            sensor["raw_data_string"] = configuredSensors[i].rawDataString;
+            sensor["raw_value"] = sensorValues[i].rawValue;
+            sensor["raw_data_string"] = sensorValues[i].rawDataString;
             
             // Clean response field to prevent JSON corruption from binary data
             String cleanResponse = "";
-            for (int j = 0; j < strlen(configuredSensors[i].response); j++) {
-                char c = configuredSensors[i].response[j];
+            for (int j = 0; j < strlen(sensorValues[i].response); j++) {
+                char c = sensorValues[i].response[j];
                 if (c >= 32 && c <= 126) { // Only printable ASCII
                     cleanResponse += c;
                 }
@@ -6105,26 +6449,41 @@ void sendJSONSensorData(WiFiClient& client) {
             sensor["response"] = cleanResponse;
             
             // Calibrated values
-            sensor["calibrated_value"] = configuredSensors[i].calibratedValue;
-            sensor["modbus_value"] = configuredSensors[i].modbusValue;
+            sensor["calibrated_value"] = sensorValues[i].calibratedValue;
+            sensor["modbus_value"] = sensorValues[i].modbusValue;
             
             // Multi-output sensor support (SHT30, BME280, etc.)
-            if (configuredSensors[i].rawValueB != 0) {
-                sensor["raw_value_b"] = configuredSensors[i].rawValueB;
-                sensor["calibrated_value_b"] = configuredSensors[i].calibratedValueB;
-                sensor["modbus_value_b"] = configuredSensors[i].modbusValueB;
+            if (sensorValues[i].rawValueB != 0) {
+                sensor["raw_value_b"] = sensorValues[i].rawValueB;
+                sensor["calibrated_value_b"] = sensorValues[i].calibratedValueB;
+                sensor["modbus_value_b"] = sensorValues[i].modbusValueB;
                 sensor["modbus_register_b"] = configuredSensors[i].modbusRegister + 1;
             }
             
-            if (configuredSensors[i].rawValueC != 0) {
-                sensor["raw_value_c"] = configuredSensors[i].rawValueC;
-                sensor["calibrated_value_c"] = configuredSensors[i].calibratedValueC;
-                sensor["modbus_value_c"] = configuredSensors[i].modbusValueC;
+            if (sensorValues[i].rawValueC != 0) {
+                sensor["raw_value_c"] = sensorValues[i].rawValueC;
+                sensor["calibrated_value_c"] = sensorValues[i].calibratedValueC;
+                sensor["modbus_value_c"] = sensorValues[i].modbusValueC;
                 sensor["modbus_register_c"] = configuredSensors[i].modbusRegister + 2;
             }
+            addVibrationJson(sensor, configuredSensors[i], sensorValues[i].vibration, true);
+            
+            // EZO read statistics
+            if (configuredSensors[i].driver == &ezoDriver) {
+                const EzoProbeStats& stats = sensorValues[i].ezoStats;
+                JsonObject ezo = sensor.createNestedObject("ezo");
+                ezo["reads"] = stats.reads;
+                ezo["errors"] = stats.errors;
+                ezo["last_latency_ms"] = stats.lastLatencyMs;
+                ezo["max_latency_ms"] = stats.maxLatencyMs;
+                if (stats.compensated) {
+                    ezo["compensation_c"] = stats.compensationC;
+                    ezo["compensation_sensor"] = configuredSensors[i].ezoCompensation;
+                }
+            }
             
             // Timing information
-            sensor["last_read_time"] = configuredSensors[i].lastReadTime;
+            sensor["last_read_time"] = sensorValues[i].lastReadTime;
             sensor["update_interval"] = configuredSensors[i].updateInterval;
             
             // Calibration settings
@@ -6155,9 +6514,10 @@ void sendJSONSensorData(WiFiClient& client) {
     // Add system information
     doc["system_time"] = millis();
     doc["num_configured_sensors"] = numConfiguredSensors;
-    doc["queue_sizes"]["i2c"] = i2cQueueSize;
-    doc["queue_sizes"]["uart"] = uartQueueSize;
-    doc["queue_sizes"]["onewire"] = oneWireQueueSize;
+    doc["scheduler_pending"] = sensorScheduler.getPendingCount();
+    doc["modbus_image"]["version"] = registerStore.getVersion();
+    doc["modbus_image"]["writes_per_sec"] = registerStore.getPublishRate();
+    doc["modbus_image"]["writes_total"] = registerStore.getTotalPublished();
     
     String response;
     serializeJson(doc, response);
@@ -6321,23 +6681,20 @@ void handlePOSTSetOutput(WiFiClient& client, String body) {
     if (outputIndex >= 0 && outputIndex < 8 && (state == 0 || state == 1)) {
         ioStatus.dOut[outputIndex] = state;
         digitalWrite(DIGITAL_OUTPUTS[outputIndex], config.doInvert[outputIndex] ? !state : state);
+        modbusImage.coilWrite(outputIndex, state);
         
         // Find the corresponding IOPin and update it
         uint8_t gpPin = DIGITAL_OUTPUTS[outputIndex];
         for (int i = 0; i < ioConfig.pinCount; i++) {
             if (ioConfig.pins[i].gpPin == gpPin) {
                 ioConfig.pins[i].currentState = (state == 1);
+                ruleEngine.markPinDirty(i);  // Rules driving this pin get the last word, as before
                 
                 // Write state to Modbus holding register (state monitoring)
-                if (ioConfig.pins[i].modbusRegister > 0 && connectedClients > 0) {
-                    for (int c = 0; c < MAX_MODBUS_CLIENTS; c++) {
-                        if (modbusClients[c].connected) {
-                            modbusClients[c].server.holdingRegisterWrite(ioConfig.pins[i].modbusRegister, state ? 1 : 0);
-                            Serial.printf("[Web UI] GP%d state written to Modbus register %d: %d\n", 
-                                         gpPin, ioConfig.pins[i].modbusRegister, state ? 1 : 0);
-                            break;
-                        }
-                    }
+                if (ioConfig.pins[i].modbusRegister > 0) {
+                    writeOwnHoldingRegister(ioConfig.pins[i].modbusRegister, state ? 1 : 0);
+                    Serial.printf("[Web UI] GP%d state written to Modbus register %d: %d\n", 
+                                 gpPin, ioConfig.pins[i].modbusRegister, state ? 1 : 0);
                 }
                 break;
             }
@@ -6384,6 +6741,10 @@ void handlePOSTUnlockPin(WiFiClient& client, String body) {
     for (int i = 0; i < ioConfig.pinCount; i++) {
         if (ioConfig.pins[i].gpPin == gpPin) {
             ioConfig.pins[i].externallyLocked = false;
+            // Leave a non-zero value so a client writing 0 again is seen as a new lock
+            if (ioConfig.pins[i].modbusRegister > 0) {
+                writeOwnHoldingRegister(ioConfig.pins[i].modbusRegister, 1);
+            }
             found = true;
             Serial.printf("[Web UI] GP%d UNLOCKED via web interface\n", gpPin);
             
@@ -6444,6 +6805,7 @@ void handlePOSTIOConfig(WiFiClient& client, String body) {
             ioPin.latched = pin["latched"] | false;
             ioPin.modbusRegister = pin["modbusRegister"] | 0xFFFF;
             ioPin.currentState = pin["currentState"] | false;
+            ioPin.heldByGlobalRule = false;
             ioPin.ruleCount = 0;
             
             // Deserialize rules if present
@@ -6453,61 +6815,7 @@ void handlePOSTIOConfig(WiFiClient& client, String body) {
                     if (ioPin.ruleCount >= 5) break;  // Max 5 rules per pin (see IOPin.rules[5] in sys_init.h)
                     
                     IORule& ioRule = ioPin.rules[ioPin.ruleCount];
-                    
-                    ioRule.id = rule["id"] | 1;
-                    ioRule.enabled = rule["enabled"] | true;
-                    strlcpy(ioRule.description, rule["description"] | "", sizeof(ioRule.description));
-                    ioRule.priority = rule["priority"] | 1;
-                    ioRule.trigger.conditionCount = 0;
-                    
-                    // Deserialize trigger conditions
-                    if (rule.containsKey("trigger") && rule["trigger"].is<JsonObject>()) {
-                        JsonObject trigger = rule["trigger"];
-                        if (trigger.containsKey("conditions") && trigger["conditions"].is<JsonArray>()) {
-                            JsonArray conditionsArray = trigger["conditions"];
-                            for (JsonObject condition : conditionsArray) {
-                                if (ioRule.trigger.conditionCount >= 3) break;
-                                
-                                ConditionClause& clause = ioRule.trigger.conditions[ioRule.trigger.conditionCount];
-                                
-                                clause.modbusRegister = condition["register"] | 0;
-                                clause.triggerValue = condition["value"] | 0;
-                                
-                                const char* condStr = condition["condition"] | "==";
-                                if (strcmp(condStr, "==") == 0) clause.condition = TriggerCondition::EQUAL;
-                                else if (strcmp(condStr, "!=") == 0) clause.condition = TriggerCondition::NOT_EQUAL;
-                                else if (strcmp(condStr, "<") == 0) clause.condition = TriggerCondition::LESS_THAN;
-                                else if (strcmp(condStr, ">") == 0) clause.condition = TriggerCondition::GREATER_THAN;
-                                else if (strcmp(condStr, "<=") == 0) clause.condition = TriggerCondition::LESS_EQUAL;
-                                else if (strcmp(condStr, ">=") == 0) clause.condition = TriggerCondition::GREATER_EQUAL;
-                                else clause.condition = TriggerCondition::EQUAL;
-                                
-                                const char* opStr = condition["nextOperator"] | "AND";
-                                clause.nextOperator = (strcmp(opStr, "OR") == 0) ? LogicOperator::OR : LogicOperator::AND;
-                                
-                                ioRule.trigger.conditionCount++;
-                            }
-                        }
-                    }
-                    
-                    ioRule.trigger.lastTriggeredState = false;
-                    ioRule.lastExecutionTime = 0;
-                    
-                    // Deserialize action
-                    if (rule.containsKey("action") && rule["action"].is<JsonObject>()) {
-                        JsonObject action = rule["action"];
-                        const char* actionTypeStr = action["type"] | "set_output";
-                        
-                        if (strcmp(actionTypeStr, "set_output") == 0) ioRule.action.type = IOActionType::SET_OUTPUT;
-                        else if (strcmp(actionTypeStr, "toggle_output") == 0) ioRule.action.type = IOActionType::TOGGLE_OUTPUT;
-                        else if (strcmp(actionTypeStr, "pulse_output") == 0) ioRule.action.type = IOActionType::PULSE_OUTPUT;
-                        else if (strcmp(actionTypeStr, "set_and_latch") == 0) ioRule.action.type = IOActionType::SET_AND_LATCH;
-                        else if (strcmp(actionTypeStr, "follow_condition") == 0) ioRule.action.type = IOActionType::FOLLOW_CONDITION;
-                        else ioRule.action.type = IOActionType::SET_OUTPUT;
-                        
-                        ioRule.action.value = action["value"] | false;
-                        ioRule.action.pulseDurationMs = action["pulseDuration"] | 100;
-                    }
+                    parseRuleJSON(rule, ioRule, ioPin.ruleCount);
                     
                     ioPin.ruleCount++;
                     Serial.printf("[IO Config] Loaded rule: GP%d rule %d with %d conditions\n",
@@ -6522,11 +6830,28 @@ void handlePOSTIOConfig(WiFiClient& client, String body) {
             ioConfig.pinCount++;
         }
         
+        // Global rules are only replaced when the body carries them
+        if (doc["globalRules"].is<JsonArray>()) {
+            ioConfig.globalRuleCount = 0;
+            for (JsonObject rule : doc["globalRules"].as<JsonArray>()) {
+                if (ioConfig.globalRuleCount >= MAX_IO_RULES) break;
+                parseRuleJSON(rule, ioConfig.globalRules[ioConfig.globalRuleCount], ioConfig.globalRuleCount);
+                ioConfig.globalRuleCount++;
+            }
+        }
+        if (doc.containsKey("globalScanPeriodMs")) {
+            uint16_t periodMs = doc["globalScanPeriodMs"] | IO_GLOBAL_SCAN_PERIOD_MS;
+            ioConfig.globalScanPeriodMs = periodMs > 0 ? periodMs : IO_GLOBAL_SCAN_PERIOD_MS;
+        }
+        
         // Save and apply configuration
         saveIOConfig();
         applyIOConfigToPins();
+        ruleEngine.compile(ioConfig);
+        globalRuleScan.setPeriod(ioConfig.globalScanPeriodMs * 1000UL);
         
-        Serial.printf("[IO Config] Saved %d pins\n", ioConfig.pinCount);
+        Serial.printf("[IO Config] Saved %d pins, %d active rules (%d global)\n",
+                     ioConfig.pinCount, ruleEngine.getRuleCount(), ruleEngine.getGlobalCount());
         
         client.println("HTTP/1.1 200 OK");
         client.println("Content-Type: application/json");
@@ -6680,6 +7005,16 @@ void handlePOSTSensorConfig(WiFiClient& client, String body) {
         // Check for Modbus register conflicts
         int modbusReg = sensor["modbusRegister"] | -1;
         Serial.printf("Checking sensor '%s' Modbus register: %d\n", sensorName, modbusReg);
+        if (modbusReg >= REGISTER_STORE_INPUT_REGISTERS) {
+            Serial.printf("Modbus register %d is outside the input register image\n", modbusReg);
+            client.println("HTTP/1.1 400 Bad Request");
+            client.println("Content-Type: application/json");
+            client.println("Connection: close");
+            client.println();
+            client.printf("{\"success\":false,\"error\":\"Modbus register %d out of range (0-%d)\"}",
+                          modbusReg, REGISTER_STORE_INPUT_REGISTERS - 1);
+            return;
+        }
         if (modbusReg >= 0) {
             // Check if this register is already used
             for (int i = 0; i < usedRegisterCount; i++) {
@@ -6771,6 +7106,11 @@ void handlePOSTSensorConfig(WiFiClient& client, String body) {
         configuredSensors[numConfiguredSensors].dataPin = sensor["dataPin"] | -1;
         configuredSensors[numConfiguredSensors].uartTxPin = sensor["uartTxPin"] | -1;
         configuredSensors[numConfiguredSensors].uartRxPin = sensor["uartRxPin"] | -1;
+        configuredSensors[numConfiguredSensors].uartBaud = sensor["uartBaud"] | sensor["baudRate"] | (int)UART_DEFAULT_BAUD;
+        const char* uartFraming = sensor["uartFraming"] | "8N1";
+        strncpy(configuredSensors[numConfiguredSensors].uartFraming, uartFraming,
+                sizeof(configuredSensors[numConfiguredSensors].uartFraming) - 1);
+        configuredSensors[numConfiguredSensors].uartFraming[sizeof(configuredSensors[numConfiguredSensors].uartFraming) - 1] = '\0';
         configuredSensors[numConfiguredSensors].analogPin = sensor["analogPin"] | -1;
         configuredSensors[numConfiguredSensors].oneWirePin = sensor["oneWirePin"] | -1;
         configuredSensors[numConfiguredSensors].digitalPin = sensor["digitalPin"] | -1;
@@ -6784,6 +7124,20 @@ void handlePOSTSensorConfig(WiFiClient& client, String body) {
         configuredSensors[numConfiguredSensors].oneWireInterval = sensor["oneWireInterval"] | 5; // Default 5 seconds
         configuredSensors[numConfiguredSensors].oneWireConversionTime = sensor["oneWireConversionTime"] | 750; // Default 750ms
         configuredSensors[numConfiguredSensors].oneWireAutoMode = sensor["oneWireAutoMode"] | true; // Default auto mode on
+        const char* owRom = sensor["oneWireRom"] | "";  // Empty = by position on the pin
+        strncpy(configuredSensors[numConfiguredSensors].oneWireRom, owRom,
+                sizeof(configuredSensors[numConfiguredSensors].oneWireRom) - 1);
+        configuredSensors[numConfiguredSensors].oneWireRom[sizeof(configuredSensors[numConfiguredSensors].oneWireRom) - 1] = '\0';
+        configuredSensors[numConfiguredSensors].oneWireResolution = sensor["oneWireResolution"] | DS18B20_MAX_RESOLUTION; // 9-12 bit
+        configuredSensors[numConfiguredSensors].fftPoints = sensor["fftPoints"] | VIBRATION_FFT_MIN_POINTS; // 256 or 512
+        const char* bands = sensor["vibrationBands"] | "";  // Empty = VIBRATION_DEFAULT_BANDS
+        strncpy(configuredSensors[numConfiguredSensors].vibrationBands, bands,
+                sizeof(configuredSensors[numConfiguredSensors].vibrationBands) - 1);
+        configuredSensors[numConfiguredSensors].vibrationBands[sizeof(configuredSensors[numConfiguredSensors].vibrationBands) - 1] = '\0';
+        const char* ezoComp = sensor["ezoCompensation"] | "";  // Temperature source for EZO reads, empty = none
+        strncpy(configuredSensors[numConfiguredSensors].ezoCompensation, ezoComp,
+                sizeof(configuredSensors[numConfiguredSensors].ezoCompensation) - 1);
+        configuredSensors[numConfiguredSensors].ezoCompensation[sizeof(configuredSensors[numConfiguredSensors].ezoCompensation) - 1] = '\0';
         configuredSensors[numConfiguredSensors].lastOneWireCmd = 0; // Initialize timing
         
         // SPI specific configuration - for LIS3DH_SPI and other SPI sensors
@@ -6842,6 +7196,7 @@ void handlePOSTSensorConfig(WiFiClient& client, String body) {
         strncpy(configuredSensors[numConfiguredSensors].calibrationExpressionC, expressionC, 
                 sizeof(configuredSensors[numConfiguredSensors].calibrationExpressionC) - 1);
         configuredSensors[numConfiguredSensors].calibrationExpressionC[sizeof(configuredSensors[numConfiguredSensors].calibrationExpressionC) - 1] = '\0';
+        configuredSensors[numConfiguredSensors].fixedPoint = sensor["fixedPoint"] | false;
         
         // Data parsing configuration
         if (sensor.containsKey("dataParsing") && sensor["dataParsing"].is<JsonObject>()) {
@@ -6886,8 +7241,7 @@ void handlePOSTSensorConfig(WiFiClient& client, String body) {
         }
         
         // Initialize EZO state
-        configuredSensors[numConfiguredSensors].cmdPending = false;
-        configuredSensors[numConfiguredSensors].lastCmdSent = 0;
+        configuredSensors[numConfiguredSensors].ezoStats = {};
         configuredSensors[numConfiguredSensors].response[0] = '\0';
         configuredSensors[numConfiguredSensors].calibrationData[0] = '\0';
         
@@ -6961,6 +7315,7 @@ void handlePOSTSensorCommand(WiFiClient& client, String body) {
                     bool state = (value == "1" || value.equalsIgnoreCase("HIGH"));
                     ioStatus.dOut[pinNum] = state;
                     digitalWrite(DIGITAL_OUTPUTS[pinNum], config.doInvert[pinNum] ? !state : state);
+                    modbusImage.coilWrite(pinNum, state);
                     response = pin + " set to " + (state ? "HIGH" : "LOW");
                 } else {
                     success = false;
@@ -6981,7 +7336,7 @@ void handlePOSTSensorCommand(WiFiClient& client, String body) {
                 int pinNum = pin.substring(2).toInt();
                 if (pinNum >= 0 && pinNum < 3) {
                     uint32_t rawValue = analogRead(ANALOG_INPUTS[pinNum]);
-                    uint16_t millivolts = (rawValue * 3300UL) / 4095UL;
+                    uint16_t millivolts = adc12ToMillivolts((uint16_t)rawValue);
                     response = pin + " = " + String(millivolts) + " mV";
                 } else {
                     success = false;
@@ -7183,22 +7538,24 @@ void handlePOSTSensorPoll(WiFiClient& client, String body) {
     } else if (protocol == "UART") {
         int txPin = doc["uartTxPin"] | 0;
         int rxPin = doc["uartRxPin"] | 1;
-        int baudRate = doc["baudRate"] | 9600;
+        int baudRate = doc["uartBaud"] | doc["baudRate"] | (int)UART_DEFAULT_BAUD;
+        uint16_t framing = uartFramingFromString(doc["uartFraming"] | "8N1");
+        SerialUART* uart = uartSensorEngine.detachPort(txPin, rxPin);  // Core 1 is parked
         
-        if (txPin < 0 || txPin > 28 || rxPin < 0 || rxPin > 28) {
-            errorMsg = "Invalid UART pins. TX and RX must be 0-28";
+        if (uart == nullptr) {
+            errorMsg = "Invalid UART pins. TX/RX must be a UART0 or UART1 pin pair";
         } else {
             addTerminalLog("POLL [UART] Testing UART on TX:GP" + String(txPin) + ", RX:GP" + String(rxPin));
             
             // Initialize UART with specified pins
-            Serial1.setTX(txPin);
-            Serial1.setRX(rxPin);
-            Serial1.begin(baudRate);
+            uart->setTX(txPin);
+            uart->setRX(rxPin);
+            uart->begin(baudRate, framing);
             delay(100); // Allow UART to stabilize
             
             // Clear any pending data
-            while (Serial1.available()) {
-                Serial1.read();
+            while (uart->available()) {
+                uart->read();
             }
             
             // Send command if provided
@@ -7209,8 +7566,8 @@ void handlePOSTSensorPoll(WiFiClient& client, String body) {
                 }
                 
                 addTerminalLog("POLL [UART] TX: " + command);
-                Serial1.print(cmdToSend);
-                Serial1.flush();
+                uart->print(cmdToSend);
+                uart->flush();
                 
                 // Wait for response (up to 2 seconds)
                 unsigned long startTime = millis();
@@ -7218,8 +7575,8 @@ void handlePOSTSensorPoll(WiFiClient& client, String body) {
                 bool gotResponse = false;
                 
                 while (millis() - startTime < 2000) {
-                    if (Serial1.available()) {
-                        char c = Serial1.read();
+                    if (uart->available()) {
+                        char c = uart->read();
                         if (c >= 32 && c <= 126) { // Printable characters
                             response += c;
                             gotResponse = true;
@@ -7249,7 +7606,7 @@ void handlePOSTSensorPoll(WiFiClient& client, String body) {
                 errorMsg = "No command specified for UART test";
             }
             
-            Serial1.end();
+            uart->end();
         }
     } else {
         errorMsg = "Protocol not supported: " + protocol;
@@ -7303,36 +7660,18 @@ void updateIOpins() {
                 ioStatus.dIn[i] = rawValue;
             }
         }
+        registerStore.setDiscreteInput(i, ioStatus.dIn[i]);
     }
     
     // Update digital outputs - account for inversion
     for (int i = 0; i < 8; i++) {
-        // Check the coil state for each client and update if any client changed an output
+        // All connections write the same coil, so a difference means a client changed the output
         bool logicalState = ioStatus.dOut[i];
-        bool stateChanged = false;
-        
-        // First detect if any client has changed the state
-        for (int j = 0; j < MAX_MODBUS_CLIENTS; j++) {
-            if (modbusClients[j].connected) {
-                bool clientCoilState = modbusClients[j].server.coilRead(i);
-                if (clientCoilState != logicalState) {
-                    // A client has changed this output's state, update our logical state
-                    logicalState = clientCoilState;
-                    ioStatus.dOut[i] = logicalState;
-                    stateChanged = true;
-                    break;  // We found a change, no need to check other clients
-                }
-            }
-        }
-        
-        // If state changed, synchronize all clients to the new state
-        if (stateChanged) {
-            Serial.printf("Output %d state changed to %d, synchronizing all clients\n", i, logicalState);
-            for (int j = 0; j < MAX_MODBUS_CLIENTS; j++) {
-                if (modbusClients[j].connected) {
-                    modbusClients[j].server.coilWrite(i, logicalState);
-                }
-            }
+        bool coilState = modbusImage.coilRead(i) == 1;
+        if (coilState != logicalState) {
+            logicalState = coilState;
+            ioStatus.dOut[i] = logicalState;
+            LOG_INFO("Output %d state changed to %d via Modbus\n", i, logicalState);
         }
         
         // Apply inversion only to the physical pin, not to the logical state
@@ -7348,41 +7687,12 @@ void updateIOpins() {
     // Update analog inputs, using millivolts format
     for (int i = 0; i < 3; i++) {
         uint32_t rawValue = analogRead(ANALOG_INPUTS[i]);
-        uint16_t valueToWrite = (rawValue * 3300UL) / 4095UL;
+        uint16_t valueToWrite = adc12ToMillivolts((uint16_t)rawValue);
         ioStatus.aIn[i] = valueToWrite;
+        registerStore.setInputRegister(i, valueToWrite);
     }
     
-    // Read ANALOG_CUSTOM sensors - handle analog voltage sensors directly here
-    for (int i = 0; i < numConfiguredSensors; i++) {
-        if (!configuredSensors[i].enabled) continue;
-        
-        // Check if sensor should be read based on updateInterval
-        unsigned long currentTime = millis();
-        if (currentTime - configuredSensors[i].lastReadTime >= configuredSensors[i].updateInterval) {
-            
-            if (strncmp(configuredSensors[i].protocol, "Analog", 6) == 0) {
-                // Read analog voltage sensor
-                int pin = configuredSensors[i].analogPin;
-                if (pin >= 0 && pin < 32) {
-                    uint32_t rawADC = analogRead(pin);
-                    float voltage = (rawADC * 3.3) / 4095.0;
-                    
-                    // Store raw and calibrated values to BOTH configuredSensors AND ioStatus
-                    // This ensures data flows to web UI and Modbus
-                    configuredSensors[i].rawValue = voltage;
-                    float calibrated = applyCalibration(voltage, configuredSensors[i]);
-                    configuredSensors[i].calibratedValue = calibrated;
-                    configuredSensors[i].modbusValue = (int)(calibrated * 100);
-                    configuredSensors[i].lastReadTime = currentTime;
-                    
-                    // Also store to ioStatus for web UI compatibility
-                    if (i < 3) {
-                        ioStatus.aIn[i] = (uint16_t)(calibrated * 1000); // mV format
-                    }
-                }
-            }
-        }
-    }
+    // ANALOG_CUSTOM sensors are sampled on core 1 (updateAnalogSensors)
     
     // I2C Sensor Reading - Dynamic sensor configuration
     static uint32_t sensorReadTime = 0;
@@ -7396,10 +7706,8 @@ void updateIOpins() {
         // Print IP address every 30 seconds for easy reference
         static uint32_t ipPrintTime = 0;
         if (millis() - ipPrintTime > 30000) {
-            Serial.println("========================================");
-            Serial.print("Device IP Address: ");
-            Serial.println(eth.localIP());
-            Serial.println("========================================");
+            LOG_INFO("========================================\nDevice IP Address: %s\n========================================\n",
+                     eth.localIP().toString().c_str());
             ipPrintTime = millis();
         }
         
@@ -7407,58 +7715,33 @@ void updateIOpins() {
     }
 }
 
-void updateIOForClient(int clientIndex) {
-    // Update Modbus registers with current IO state, actual pin states measured in updateIOpins()
-    
-    // Update digital inputs
-    for (int i = 0; i < 8; i++) {
-        modbusClients[clientIndex].server.discreteInputWrite(i, ioStatus.dIn[i]);
-    }
-        
-    // Update analog inputs
-    for (int i = 0; i < 3; i++) {
-        modbusClients[clientIndex].server.inputRegisterWrite(i, ioStatus.aIn[i]);
+void storeSensorRegisters() {
+    // Producer for the sensor input registers; called when a new snapshot arrives.
+    // Walks the addresses the directory gives to sensors (channels A-C, then any
+    // LIS3DH feature block), so the image matches what the rules read.
+    for (uint16_t i = 0; i < registerDirectory.getSensorAddressCount(); i++) {
+        uint16_t reg = registerDirectory.getSensorAddress(i);
+        registerStore.setInputRegister(reg, (uint16_t)readRegisterValue(reg));
     }
-    
-    // I2C Sensor Data Modbus Mapping - Convert float values to 16-bit integers
-    // PLACEHOLDER SENSORS - COMMENTED OUT (only enable when simulation is on or real sensors added)
-    // uint16_t temp_x_100 = (uint16_t)(ioStatus.temperature * 100);
-    // uint16_t hum_x_100 = (uint16_t)(ioStatus.humidity * 100);
-
-    // modbusClients[clientIndex].server.inputRegisterWrite(3, temp_x_100); // Temperature
-    // modbusClients[clientIndex].server.inputRegisterWrite(4, hum_x_100); // Humidity
-    
-    // Update Modbus registers with configured sensor values
-    for (int i = 0; i < numConfiguredSensors; i++) {
-        if (configuredSensors[i].enabled && configuredSensors[i].modbusRegister >= 0) {
-            // Primary value (temperature for SHT30, X for LIS3DH)
-            modbusClients[clientIndex].server.inputRegisterWrite(configuredSensors[i].modbusRegister, configuredSensors[i].modbusValue);
+}
 
-            // Multi-output sensors (SHT30 humidity, BME280 pressure, LIS3DH Y-axis, etc.)
-            if (strcmp(configuredSensors[i].type, "SHT30") == 0) {
-                // Always write humidity to next register
-                modbusClients[clientIndex].server.inputRegisterWrite(configuredSensors[i].modbusRegister + 1, configuredSensors[i].modbusValueB);
-            } else if (strcmp(configuredSensors[i].type, "LIS3DH") == 0) {
-                // 3-axis accelerometer: X, Y, Z on consecutive registers
-                modbusClients[clientIndex].server.inputRegisterWrite(configuredSensors[i].modbusRegister + 1, configuredSensors[i].modbusValueB);
-                modbusClients[clientIndex].server.inputRegisterWrite(configuredSensors[i].modbusRegister + 2, configuredSensors[i].modbusValueC);
-            }
-            // Future: Add BME280 (temp, hum, pressure) and other multi-output sensors here
-        }
-    }
+void updateModbusImage() {
+    // Publish registers that changed since the last pass (IO from updateIOpins(), sensors from the snapshot)
+    registerStore.publish(modbusImage);
     
     // Check coils 100-107 for latch reset commands
     for (int i = 0; i < 8; i++) {
-        if (modbusClients[clientIndex].server.coilRead(100 + i)) {
+        if (modbusImage.coilRead(100 + i) == 1) {
             // If coil is set to 1, reset the corresponding latch
             if (config.diLatch[i] && ioStatus.dInLatched[i]) {
                 ioStatus.dInLatched[i] = false;
                 // Update the input state based on the raw input state
                 ioStatus.dIn[i] = ioStatus.dInRaw[i];
-                Serial.printf("Reset latch for digital input %d via Modbus coil %d\n", i, 100 + i);
+                registerStore.setDiscreteInput(i, ioStatus.dIn[i]);
+                LOG_INFO("Reset latch for digital input %d via Modbus coil %d\n", i, 100 + i);
             }
             // Reset the coil back to 0 after processing
-            modbusClients[clientIndex].server.coilWrite(100 + i, false);
+            modbusImage.coilWrite(100 + i, false);
         }
     }
 }
@@ -0,0 +1,276 @@
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <NativeSim.h>
+#include <unity.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * LIS3DH streaming vs network servicing (native environment)
+ *
+ * Runs the firmware as NativeMain does: setup()/loop() on the main thread,
+ * setup1()/loop1() on a second one, here with two simulated LIS3DH sensors
+ * streaming 256- and 512-sample FIFO windows on separate I2C pin pairs. The
+ * tests run on a third thread as an outside client, sending HTTP and Modbus
+ * TCP requests spread over several windows; every response must be complete
+ * within RESPONSE_BOUND_MS. The accelerometer driver runs inside
+ * i2cBusManager transactions without masking interrupts, so a burst read on
+ * core 1 must never hold off core 0.
+ *
+ *   pio test -e native -f test_lis3dh_network
+ *
+ * The clock runs in realtime mode so bus time and request latency are real.
+ */
+
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+static const int PORT_OFFSET = 17000;
+static const int HTTP_PORT = 80 + PORT_OFFSET;
+static const int MODBUS_PORT = 502 + PORT_OFFSET;
+
+// Wall-clock bound, left generous so scheduling noise on a loaded CI host
+// cannot trip it: a core 0 held off for a whole window (640 ms for 256
+// samples at 400 Hz) or a spectrum still fails; the slowest response is
+// reported so shorter stalls show up in the log
+static const uint32_t RESPONSE_BOUND_MS = 250;
+static const uint32_t REQUEST_SPACING_MS = 100;  // Also covers the 50 ms the HTTP handler waits before closing
+static const int REQUESTS = 30;                  // ~3 s, more than two 512-sample windows at 400 Hz
+static const uint32_t WARMUP_MS = 1500;          // First windows complete before the requests start
+
+static const char* SENSORS_JSON =
+    "{\"sensors\":["
+    "{\"enabled\":true,\"name\":\"acc\",\"type\":\"LIS3DH\",\"protocol\":\"I2C\",\"i2cAddress\":24,"
+    "\"modbusRegister\":12,\"sdaPin\":4,\"sclPin\":5,\"updateInterval\":1000,\"fftPoints\":256},"
+    "{\"enabled\":true,\"name\":\"acc2\",\"type\":\"LIS3DH\",\"protocol\":\"I2C\",\"i2cAddress\":25,"
+    "\"modbusRegister\":40,\"sdaPin\":8,\"sclPin\":9,\"updateInterval\":1000,\"fftPoints\":512}"
+    "]}";
+
+static std::atomic<bool> core0StopRequested{false};
+static std::atomic<bool> core1StopRequested{false};
+static int testFailures = 0;
+// Input register blocks: three means plus VIBRATION_FEATURE_REGISTERS (27 each)
+static const uint16_t ACC_REGISTER = 12;
+static const uint16_t ACC2_REGISTER = 40;
+static const uint16_t RMS_OFFSET = 3;            // X/Y/Z RMS follow the three means
+static const uint16_t READ_COUNT = 6;
+
+static char fsRoot[] = "/tmp/lis3dh_network_XXXXXX";
+
+static uint32_t elapsedMs(std::chrono::steady_clock::time_point start) {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    // A lost request fails the bound instead of hanging the test
+    timeval timeout = { 1, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// HTTP: headers plus Content-Length bytes; anything else: `expected` bytes
+static bool responseComplete(const std::string& response, size_t expected) {
+    if (expected > 0) {
+        return response.size() >= expected;
+    }
+    size_t headerEnd = response.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) return false;
+    size_t field = response.find("Content-Length: ");
+    if (field == std::string::npos || field > headerEnd) return false;
+    size_t contentLength = strtoul(response.c_str() + field + 16, nullptr, 10);
+    return response.size() >= headerEnd + 4 + contentLength;
+}
+
+/**
+ * Send a request and wait for the complete response
+ * @return milliseconds from send to the last byte, UINT32_MAX if it never completed
+ */
+static uint32_t exchange(int fd, const void* request, size_t length, std::string& response, size_t expected) {
+    response.clear();
+    auto start = std::chrono::steady_clock::now();
+    if (send(fd, request, length, 0) != (ssize_t)length) {
+        return UINT32_MAX;
+    }
+    while (!responseComplete(response, expected)) {
+        char buffer[1024];
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return UINT32_MAX;
+        }
+        response.append(buffer, n);
+    }
+    return elapsedMs(start);
+}
+
+static uint32_t httpGet(const char* path, std::string& response) {
+    int fd = connectTo(HTTP_PORT);
+    if (fd < 0) return UINT32_MAX;
+    char request[128];
+    int length = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: test\r\nConnection: close\r\n\r\n", path);
+    uint32_t elapsed = exchange(fd, request, length, response, 0);
+    close(fd);
+    return elapsed;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// Requests spread over several windows of both sensors are each answered in time
+void test_http_served_while_streaming(void) {
+    uint32_t worst = 0;
+    for (int i = 0; i < REQUESTS; i++) {
+        std::string response;
+        uint32_t elapsed = httpGet("/iostatus", response);
+        TEST_ASSERT_TRUE_MESSAGE(elapsed != UINT32_MAX, "/iostatus not answered");
+        TEST_ASSERT_TRUE_MESSAGE(response.rfind("HTTP/1.1 200", 0) == 0, "/iostatus failed");
+        if (elapsed > worst) worst = elapsed;
+        delay(REQUEST_SPACING_MS);
+    }
+    char message[64];
+    snprintf(message, sizeof(message), "slowest /iostatus: %u ms", (unsigned)worst);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN_UINT32_MESSAGE(RESPONSE_BOUND_MS, worst, "HTTP request held off by LIS3DH reads");
+}
+
+/**
+ * Read Input Registers (FC04) on an open Modbus TCP connection
+ * @return milliseconds until the complete response, UINT32_MAX if it never completed
+ */
+static uint32_t readInputRegisters(int fd, uint16_t transaction, uint16_t address, std::string& response) {
+    const uint8_t request[] = { (uint8_t)(transaction >> 8), (uint8_t)transaction, 0, 0, 0, 6, 1, 0x04,
+                                (uint8_t)(address >> 8), (uint8_t)address, 0, READ_COUNT };
+    return exchange(fd, request, sizeof(request), response, 9 + 2 * READ_COUNT);
+}
+
+static uint16_t responseRegister(const std::string& response, int index) {
+    return ((uint8_t)response[9 + 2 * index] << 8) | (uint8_t)response[10 + 2 * index];
+}
+
+// Modbus TCP on a kept-open connection, alternating between the two sensors' blocks
+void test_modbus_served_while_streaming(void) {
+    int fd = connectTo(MODBUS_PORT);
+    TEST_ASSERT_TRUE_MESSAGE(fd >= 0, "Modbus connect failed");
+
+    uint32_t worst = 0;
+    for (int i = 0; i < REQUESTS; i++) {
+        // Means and X/Y/Z RMS of acc, then of acc2
+        std::string response;
+        uint32_t elapsed = readInputRegisters(fd, i, (i % 2) ? ACC2_REGISTER : ACC_REGISTER, response);
+        if (elapsed == UINT32_MAX) close(fd);
+        TEST_ASSERT_TRUE_MESSAGE(elapsed != UINT32_MAX, "Modbus request not answered");
+        TEST_ASSERT_EQUAL_UINT8(0x04, (uint8_t)response[7]);
+        TEST_ASSERT_EQUAL_UINT8(2 * READ_COUNT, (uint8_t)response[8]);
+        if (elapsed > worst) worst = elapsed;
+        delay(REQUEST_SPACING_MS);
+    }
+    close(fd);
+    char message[64];
+    snprintf(message, sizeof(message), "slowest Modbus read: %u ms", (unsigned)worst);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN_UINT32_MESSAGE(RESPONSE_BOUND_MS, worst, "Modbus request held off by LIS3DH reads");
+}
+
+// Each sensor's block carries its own window features; neither shadows the other
+void test_modbus_sensor_blocks(void) {
+    int fd = connectTo(MODBUS_PORT);
+    TEST_ASSERT_TRUE_MESSAGE(fd >= 0, "Modbus connect failed");
+
+    const uint16_t blocks[] = { ACC_REGISTER, ACC2_REGISTER };
+    for (uint16_t block : blocks) {
+        std::string response;
+        uint32_t elapsed = readInputRegisters(fd, block, block, response);
+        if (elapsed == UINT32_MAX) close(fd);
+        TEST_ASSERT_TRUE_MESSAGE(elapsed != UINT32_MAX, "Modbus request not answered");
+        TEST_ASSERT_EQUAL_UINT8(2 * READ_COUNT, (uint8_t)response[8]);
+        for (int axis = 0; axis < 3; axis++) {
+            char message[48];
+            snprintf(message, sizeof(message), "no RMS at input register %u", (unsigned)(block + RMS_OFFSET + axis));
+            TEST_ASSERT_TRUE_MESSAGE(responseRegister(response, RMS_OFFSET + axis) != 0, message);
+        }
+    }
+    close(fd);
+}
+
+// The windows were really streamed while the requests above were served
+void test_windows_completed(void) {
+    std::string response;
+    TEST_ASSERT_TRUE_MESSAGE(httpGet("/sensors/data", response) != UINT32_MAX, "/sensors/data not answered");
+    TEST_ASSERT_TRUE_MESSAGE(response.find("\"raw_data_string\":\"n=256 ") != std::string::npos,
+                             "no 256-sample window from acc");
+    TEST_ASSERT_TRUE_MESSAGE(response.find("\"raw_data_string\":\"n=512 ") != std::string::npos,
+                             "no 512-sample window from acc2");
+}
+
+// Test client thread; stops loop() when done
+static void runTests() {
+    delay(WARMUP_MS);
+    UNITY_BEGIN();
+    RUN_TEST(test_http_served_while_streaming);
+    RUN_TEST(test_modbus_served_while_streaming);
+    RUN_TEST(test_modbus_sensor_blocks);
+    RUN_TEST(test_windows_completed);
+    testFailures = UNITY_END();
+    core0StopRequested = true;
+}
+
+int main(int argc, char** argv) {
+    if (mkdtemp(fsRoot) == nullptr) {
+        perror("mkdtemp");
+        return 1;
+    }
+    std::string sensorsPath = std::string(fsRoot) + "/sensors.json";
+    FILE* file = fopen(sensorsPath.c_str(), "w");
+    if (file == nullptr) {
+        perror(sensorsPath.c_str());
+        return 1;
+    }
+    fputs(SENSORS_JSON, file);
+    fclose(file);
+
+    LittleFS.setRoot(fsRoot);
+    NativeHAL::setClockMode(NativeHAL::ClockMode::REALTIME);
+    NativeHAL::setPortOffset(PORT_OFFSET);
+    NativeHAL::setSerialQuiet(true);
+    NativeSim::installDefaultDevices();
+
+    std::thread core1([] {
+        setup1();
+        while (!core1StopRequested.load()) {
+            loop1();
+        }
+    });
+    setup();
+
+    std::thread client(runTests);
+    while (!core0StopRequested.load()) {
+        loop();
+    }
+    client.join();
+    core1StopRequested = true;
+    core1.join();
+
+    unlink(sensorsPath.c_str());
+    rmdir(fsRoot);
+    return testFailures;
+}